@@ -0,0 +1,115 @@
+#include "emulator/arena.h"
+
+#include <assert.h>
+#include <stdalign.h>
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Each allocation is preceded by a header identifying the arena it came from,
+// or NULL if it came from the heap
+typedef struct {
+  alignas(ARENA_ALIGNMENT) Arena *arena;
+} ArenaHeader;
+
+struct _Arena {
+  unsigned char *block;
+  size_t capacity;
+  size_t used;
+  atomic_size_t references;  // One per live allocation plus one for the owner
+};
+
+static _Thread_local Arena *current_arena = NULL;
+
+static void ArenaRelease(Arena *arena) {
+  if (atomic_fetch_sub(&arena->references, 1u) == 1u) {
+    free(arena->block);
+    free(arena);
+  }
+}
+
+static size_t ArenaRoundUp(size_t size) {
+  return (size + ARENA_ALIGNMENT - 1u) & ~(size_t)(ARENA_ALIGNMENT - 1u);
+}
+
+Arena *ArenaAllocate(size_t capacity) {
+  Arena *arena = (Arena *)malloc(sizeof(Arena));
+  if (arena == NULL) {
+    return NULL;
+  }
+
+  arena->capacity = ArenaRoundUp(capacity);
+  arena->block = aligned_alloc(ARENA_ALIGNMENT, arena->capacity);
+  if (arena->block == NULL) {
+    free(arena);
+    return NULL;
+  }
+
+  memset(arena->block, 0, arena->capacity);
+  arena->used = 0u;
+  atomic_init(&arena->references, 1u);
+
+  return arena;
+}
+
+Arena *ArenaMakeCurrent(Arena *arena) {
+  Arena *previous = current_arena;
+  current_arena = arena;
+  return previous;
+}
+
+void *ArenaCalloc(size_t count, size_t size) {
+  if (size != 0u && count > SIZE_MAX / size) {
+    return NULL;
+  }
+
+  size_t allocation_size = ArenaRoundUp(count * size);
+  if (allocation_size > SIZE_MAX - sizeof(ArenaHeader)) {
+    return NULL;
+  }
+
+  allocation_size += sizeof(ArenaHeader);
+
+  ArenaHeader *header;
+  Arena *arena = current_arena;
+  if (arena != NULL && arena->capacity - arena->used >= allocation_size) {
+    // The block was zeroed when the arena was allocated
+    header = (ArenaHeader *)(arena->block + arena->used);
+    arena->used += allocation_size;
+    atomic_fetch_add(&arena->references, 1u);
+  } else {
+    header = aligned_alloc(ARENA_ALIGNMENT, allocation_size);
+    if (header == NULL) {
+      return NULL;
+    }
+
+    memset(header, 0, allocation_size);
+    arena = NULL;
+  }
+
+  header->arena = arena;
+
+  return header + 1;
+}
+
+void ArenaFreeAllocation(void *allocation) {
+  if (allocation == NULL) {
+    return;
+  }
+
+  ArenaHeader *header = (ArenaHeader *)allocation - 1;
+  if (header->arena == NULL) {
+    free(header);
+  } else {
+    ArenaRelease(header->arena);
+  }
+}
+
+size_t ArenaUsed(const Arena *arena) { return arena->used; }
+
+void ArenaFree(Arena *arena) {
+  assert(current_arena != arena);
+  ArenaRelease(arena);
+}
\ No newline at end of file
@@ -0,0 +1,35 @@
+#ifndef _WEBGBA_EMULATOR_ARENA_
+#define _WEBGBA_EMULATOR_ARENA_
+
+#include <stddef.h>
+
+// A single contiguous block from which component state is carved in
+// allocation order. Every allocation is zeroed and aligned to a cache line.
+typedef struct _Arena Arena;
+
+#define ARENA_ALIGNMENT 64u
+
+Arena *ArenaAllocate(size_t capacity);
+
+// Directs ArenaCalloc calls made on the calling thread to the arena and
+// returns the arena that was previously current. Passing NULL directs them to
+// the heap.
+Arena *ArenaMakeCurrent(Arena *arena);
+
+// A drop in replacement for calloc that allocates from the current arena,
+// falling back to the heap when there is none or it is full
+void *ArenaCalloc(size_t count, size_t size);
+
+// A drop in replacement for free for memory returned by ArenaCalloc. Memory
+// inside of an arena is only released along with the whole arena.
+void ArenaFreeAllocation(void *allocation);
+
+// Returns the number of bytes of the arena that have been handed out
+size_t ArenaUsed(const Arena *arena);
+
+// The arena is released once it has been freed and every allocation made
+// from it has been freed as well, so objects carved from it may outlive the
+// call.
+void ArenaFree(Arena *arena);
+
+#endif  // _WEBGBA_EMULATOR_ARENA_
\ No newline at end of file
@@ -0,0 +1,57 @@
+extern "C" {
+#include "emulator/arena.h"
+}
+
+#include <cstdint>
+
+#include "googletest/include/gtest/gtest.h"
+
+TEST(ArenaTest, HeapAllocation) {
+  unsigned char *allocation = (unsigned char *)ArenaCalloc(3u, 7u);
+  ASSERT_NE(nullptr, allocation);
+  EXPECT_EQ(0u, (uintptr_t)allocation % ARENA_ALIGNMENT);
+  for (size_t i = 0u; i < 21u; i++) {
+    EXPECT_EQ(0u, allocation[i]);
+  }
+  ArenaFreeAllocation(allocation);
+}
+
+TEST(ArenaTest, ArenaAllocation) {
+  Arena *arena = ArenaAllocate(1024u);
+  ASSERT_NE(nullptr, arena);
+  EXPECT_EQ(0u, ArenaUsed(arena));
+
+  EXPECT_EQ(nullptr, ArenaMakeCurrent(arena));
+  unsigned char *first = (unsigned char *)ArenaCalloc(1u, 1u);
+  unsigned char *second = (unsigned char *)ArenaCalloc(1u, 100u);
+  EXPECT_EQ(arena, ArenaMakeCurrent(nullptr));
+
+  ASSERT_NE(nullptr, first);
+  ASSERT_NE(nullptr, second);
+  EXPECT_EQ(0u, (uintptr_t)first % ARENA_ALIGNMENT);
+  EXPECT_EQ(0u, (uintptr_t)second % ARENA_ALIGNMENT);
+  EXPECT_EQ(first + 2u * ARENA_ALIGNMENT, second);
+  EXPECT_EQ(5u * ARENA_ALIGNMENT, ArenaUsed(arena));
+
+  // Freeing memory inside of the arena does nothing
+  ArenaFreeAllocation(first);
+  ArenaFreeAllocation(second);
+  EXPECT_EQ(5u * ARENA_ALIGNMENT, ArenaUsed(arena));
+
+  ArenaFree(arena);
+}
+
+TEST(ArenaTest, FallsBackToHeapWhenFull) {
+  Arena *arena = ArenaAllocate(256u);
+  ASSERT_NE(nullptr, arena);
+
+  ArenaMakeCurrent(arena);
+  void *allocation = ArenaCalloc(1u, 512u);
+  ArenaMakeCurrent(nullptr);
+
+  ASSERT_NE(nullptr, allocation);
+  EXPECT_EQ(0u, ArenaUsed(arena));
+  ArenaFreeAllocation(allocation);
+
+  ArenaFree(arena);
+}
\ No newline at end of file
@@ -1,10 +1,12 @@
 #include "emulator/cpu/arm7tdmi/arm7tdmi.h"
 
 #include <assert.h>
-#include <stdlib.h>
+#include <string.h>
 
+#include "emulator/arena.h"
 #include "emulator/cpu/arm7tdmi/decoders/arm/execute.h"
 #include "emulator/cpu/arm7tdmi/decoders/thumb/execute.h"
+#include "emulator/cpu/arm7tdmi/decoders/thumb/threaded.h"
 #include "emulator/cpu/arm7tdmi/exceptions.h"
 #include "emulator/cpu/arm7tdmi/registers.h"
 #include "util/macros.h"
@@ -73,6 +75,10 @@ static uint32_t Arm7TdmiStepThumb(Arm7Tdmi* cpu, Memory* memory,
                                   uint32_t cycles_executed) {
   assert(cycles_executed < cpu->cycles_to_run);
 
+#ifdef WEBGBA_THUMB_THREADED_DISPATCH
+  return ThumbThreadedExecute(&cpu->registers, memory, &cpu->cycles_to_run,
+                              cycles_executed);
+#else
   do {
     codegen_assert(cpu->registers.current.user.cpsr.thumb);
     cycles_executed += 1u;
@@ -90,6 +96,7 @@ static uint32_t Arm7TdmiStepThumb(Arm7Tdmi* cpu, Memory* memory,
            cycles_executed < cpu->cycles_to_run);
 
   return cycles_executed;
+#endif  // WEBGBA_THUMB_THREADED_DISPATCH
 }
 
 static uint32_t Arm7TdmiInterrupt(Arm7Tdmi* cpu, Memory* memory,
@@ -123,11 +130,15 @@ static uint32_t Arm7TdmiInterrupt(Arm7Tdmi* cpu, Memory* memory,
 
 bool Arm7TdmiAllocate(Arm7Tdmi** cpu, InterruptLine** rst, InterruptLine** fiq,
                       InterruptLine** irq) {
-  *cpu = (Arm7Tdmi*)calloc(1, sizeof(Arm7Tdmi));
+  *cpu = (Arm7Tdmi*)ArenaCalloc(1, sizeof(Arm7Tdmi));
   if (cpu == NULL) {
     return false;
   }
 
+#ifdef WEBGBA_THUMB_THREADED_DISPATCH
+  ThumbThreadedInitialize();
+#endif  // WEBGBA_THUMB_THREADED_DISPATCH
+
   ArmLoadProgramCounter(&(*cpu)->registers, 0x0u);
   (*cpu)->registers.current.user.cpsr.mode = MODE_SVC;
   (*cpu)->reference_count = 4u;
@@ -135,7 +146,7 @@ bool Arm7TdmiAllocate(Arm7Tdmi** cpu, InterruptLine** rst, InterruptLine** fiq,
   *rst = InterruptLineAllocate(*cpu, Arm7TdmiSetLevelRst,
                                Arm7TdmiInterruptLineFree);
   if (*rst == NULL) {
-    free(*cpu);
+    ArenaFreeAllocation(*cpu);
     return false;
   }
 
@@ -143,7 +154,7 @@ bool Arm7TdmiAllocate(Arm7Tdmi** cpu, InterruptLine** rst, InterruptLine** fiq,
                                Arm7TdmiInterruptLineFree);
   if (*rst == NULL) {
     InterruptLineFree(*rst);
-    free(*cpu);
+    ArenaFreeAllocation(*cpu);
     return false;
   }
 
@@ -152,7 +163,7 @@ bool Arm7TdmiAllocate(Arm7Tdmi** cpu, InterruptLine** rst, InterruptLine** fiq,
   if (*irq == NULL) {
     InterruptLineFree(*fiq);
     InterruptLineFree(*rst);
-    free(*cpu);
+    ArenaFreeAllocation(*cpu);
     return false;
   }
 
@@ -173,15 +184,38 @@ uint32_t Arm7TdmiStep(Arm7Tdmi* cpu, Memory* memory, uint32_t num_cycles) {
     }
   }
 
+  ArmMaterializeFlags(&cpu->registers);
+
   return cycles_executed;
 }
 
 void Arm7TdmiHalt(Arm7Tdmi* cpu) { cpu->cycles_to_run = 0u; }
 
+void Arm7TdmiSetIrqLevel(Arm7Tdmi* cpu, bool raised) {
+  Arm7TdmiSetLevelIrq(cpu, raised);
+}
+
+void Arm7TdmiReset(Arm7Tdmi* cpu) {
+  memset(&cpu->registers, 0, sizeof(ArmAllRegisters));
+  ArmLoadProgramCounter(&cpu->registers, 0x0u);
+  cpu->registers.current.user.cpsr.mode = MODE_SVC;
+  cpu->cycles_to_run = 0u;
+}
+
+void Arm7TdmiCopyState(Arm7Tdmi* destination, const Arm7Tdmi* source) {
+  destination->registers = source->registers;
+  destination->cycles_to_run = source->cycles_to_run;
+}
+
+void Arm7TdmiRetain(Arm7Tdmi* cpu) {
+  assert(cpu->reference_count != UINT16_MAX);
+  cpu->reference_count += 1u;
+}
+
 void Arm7TdmiFree(Arm7Tdmi* cpu) {
   assert(cpu->reference_count != 0);
   cpu->reference_count -= 1u;
   if (cpu->reference_count == 0u) {
-    free(cpu);
+    ArenaFreeAllocation(cpu);
   }
 }
\ No newline at end of file
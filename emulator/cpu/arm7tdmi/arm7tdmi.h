@@ -13,6 +13,16 @@ uint32_t Arm7TdmiStep(Arm7Tdmi* cpu, Memory* memory, uint32_t num_cycles);
 
 void Arm7TdmiHalt(Arm7Tdmi* cpu);
 
+// Sets the level of the IRQ line without going through its InterruptLine
+void Arm7TdmiSetIrqLevel(Arm7Tdmi* cpu, bool raised);
+
+// Restores the power on register state. Interrupt lines are left lowered.
+void Arm7TdmiReset(Arm7Tdmi* cpu);
+
+// Copies the register state of another CPU, including its interrupt levels
+void Arm7TdmiCopyState(Arm7Tdmi* destination, const Arm7Tdmi* source);
+
+void Arm7TdmiRetain(Arm7Tdmi* cpu);
 void Arm7TdmiFree(Arm7Tdmi* cpu);
 
 #endif  // _WEBGBA_EMULATOR_CPU_ARM7TDMI_ARM7TDMI_
\ No newline at end of file
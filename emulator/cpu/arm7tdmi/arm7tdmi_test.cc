@@ -321,4 +321,19 @@ TEST_F(ExecuteTest, RSTPreemptsAll) {
   uint32_t value;
   EXPECT_TRUE(Load32LE(memory_, 0x300u, &value));
   EXPECT_EQ(0x300u, value);
+}
+
+TEST_F(ExecuteTest, Reset) {
+  AddInstruction("0x0F00A0E3");  // mov r0, #15
+  AddInstruction("0x0F00A0E3");  // mov r0, #15
+  Run(1u);
+
+  ASSERT_TRUE(Store32LE(memory_, 0x200u, 0u));
+
+  Arm7TdmiReset(cpu_);
+  Run(2u);
+
+  uint32_t value;
+  EXPECT_TRUE(Load32LE(memory_, 0x200u, &value));
+  EXPECT_EQ(0x200u, value);
 }
\ No newline at end of file
@@ -11,7 +11,6 @@
 #include "emulator/cpu/arm7tdmi/instructions/coprocessor_data_operation.h"
 #include "emulator/cpu/arm7tdmi/instructions/coprocessor_data_transfer.h"
 #include "emulator/cpu/arm7tdmi/instructions/coprocessor_register_transfer.h"
-#include "emulator/cpu/arm7tdmi/instructions/data_processing.h"
 #include "emulator/cpu/arm7tdmi/instructions/load_store_register_byte.h"
 #include "emulator/cpu/arm7tdmi/instructions/move_status_register.h"
 #include "emulator/cpu/arm7tdmi/instructions/multiply.h"
@@ -20,6 +19,7 @@
 #include "emulator/cpu/arm7tdmi/instructions/single_data_swap.h"
 #include "emulator/cpu/arm7tdmi/instructions/swi.h"
 #include "emulator/memory/memory.h"
+#include "tools/arm_opcode_decoder/data_processing.h"
 #include "tools/arm_opcode_decoder/decoder.h"
 #include "util/macros.h"
 
@@ -28,93 +28,34 @@ ArmInstructionExecute(uint32_t next_instruction, ArmAllRegisters* registers,
                       Memory* memory) {
   codegen_assert(!registers->current.user.cpsr.thumb);
 
-  if (!ArmInstructionShouldExecute(registers->current.user.cpsr,
-                                   next_instruction)) {
-    ArmAdvanceProgramCounter(registers);
-    return;
+  if ((next_instruction >> 28u) != 14u) {  // ARM_CONDITION_AL
+    ArmMaterializeFlags(registers);
+    if (!ArmInstructionShouldExecute(registers->current.user.cpsr,
+                                     next_instruction)) {
+      ArmAdvanceProgramCounter(registers);
+      return;
+    }
   }
 
   ArmRegisterIndex rd_msw, rd_lsw, rd, rn, rm, rs;
-  uint32_t operand1, operand2, offset_32;
+  uint32_t operand2, offset_32;
   uint_fast32_t branch_offset;
   uint_fast16_t register_list, offset_16;
   uint_fast8_t offset_8;
-  bool shifter_carry_out, control, flags;
+  bool control, flags;
 
   ArmOpcode opcode = ArmDecodeOpcode(next_instruction);
+  if (ArmDataProcessingExecute(opcode, next_instruction, registers)) {
+    return;
+  }
+
+  // Load and store offsets shifted with RRX are the only operands below that
+  // read the flags. Instructions that read the CPSR materialize it themselves.
+  if ((next_instruction & 0x0E000FF0u) == 0x06000060u) {
+    ArmMaterializeCarryFlag(registers);
+  }
+
   switch (opcode) {
-    case ARM_OPCODE_ADC:
-      ArmOperandDataProcessingOperand2(next_instruction,
-                                       &registers->current.user, &rd, &operand1,
-                                       &operand2, &shifter_carry_out);
-      ArmADC(registers, rd, operand1, operand2);
-      break;
-    case ARM_OPCODE_ADC_I32:
-      ArmOperandDataProcessingImmediate(
-          next_instruction, &registers->current.user, &rd, &operand1, &operand2,
-          &shifter_carry_out);
-      ArmADC(registers, rd, operand1, operand2);
-      break;
-    case ARM_OPCODE_ADCS:
-      ArmOperandDataProcessingOperand2(next_instruction,
-                                       &registers->current.user, &rd, &operand1,
-                                       &operand2, &shifter_carry_out);
-      ArmADCS(registers, rd, operand1, operand2);
-      break;
-    case ARM_OPCODE_ADCS_I32:
-      ArmOperandDataProcessingImmediate(
-          next_instruction, &registers->current.user, &rd, &operand1, &operand2,
-          &shifter_carry_out);
-      ArmADCS(registers, rd, operand1, operand2);
-      break;
-    case ARM_OPCODE_ADD:
-      ArmOperandDataProcessingOperand2(next_instruction,
-                                       &registers->current.user, &rd, &operand1,
-                                       &operand2, &shifter_carry_out);
-      ArmADD(registers, rd, operand1, operand2);
-      break;
-    case ARM_OPCODE_ADD_I32:
-      ArmOperandDataProcessingImmediate(
-          next_instruction, &registers->current.user, &rd, &operand1, &operand2,
-          &shifter_carry_out);
-      ArmADD(registers, rd, operand1, operand2);
-      break;
-    case ARM_OPCODE_ADDS:
-      ArmOperandDataProcessingOperand2(next_instruction,
-                                       &registers->current.user, &rd, &operand1,
-                                       &operand2, &shifter_carry_out);
-      ArmADDS(registers, rd, operand1, operand2);
-      break;
-    case ARM_OPCODE_ADDS_I32:
-      ArmOperandDataProcessingImmediate(
-          next_instruction, &registers->current.user, &rd, &operand1, &operand2,
-          &shifter_carry_out);
-      ArmADDS(registers, rd, operand1, operand2);
-      break;
-    case ARM_OPCODE_AND:
-      ArmOperandDataProcessingOperand2(next_instruction,
-                                       &registers->current.user, &rd, &operand1,
-                                       &operand2, &shifter_carry_out);
-      ArmAND(registers, rd, operand1, operand2);
-      break;
-    case ARM_OPCODE_AND_I32:
-      ArmOperandDataProcessingImmediate(
-          next_instruction, &registers->current.user, &rd, &operand1, &operand2,
-          &shifter_carry_out);
-      ArmAND(registers, rd, operand1, operand2);
-      break;
-    case ARM_OPCODE_ANDS:
-      ArmOperandDataProcessingOperand2(next_instruction,
-                                       &registers->current.user, &rd, &operand1,
-                                       &operand2, &shifter_carry_out);
-      ArmANDS(registers, rd, operand1, operand2, shifter_carry_out);
-      break;
-    case ARM_OPCODE_ANDS_I32:
-      ArmOperandDataProcessingImmediate(
-          next_instruction, &registers->current.user, &rd, &operand1, &operand2,
-          &shifter_carry_out);
-      ArmANDS(registers, rd, operand1, operand2, shifter_carry_out);
-      break;
     case ARM_OPCODE_B_FWD:
       ArmOperandBranchForward(next_instruction, &branch_offset);
       ArmB(registers, branch_offset);
@@ -123,30 +64,6 @@ ArmInstructionExecute(uint32_t next_instruction, ArmAllRegisters* registers,
       ArmOperandBranchReverse(next_instruction, &branch_offset);
       ArmB(registers, branch_offset);
       break;
-    case ARM_OPCODE_BIC:
-      ArmOperandDataProcessingOperand2(next_instruction,
-                                       &registers->current.user, &rd, &operand1,
-                                       &operand2, &shifter_carry_out);
-      ArmBIC(registers, rd, operand1, operand2);
-      break;
-    case ARM_OPCODE_BIC_I32:
-      ArmOperandDataProcessingImmediate(
-          next_instruction, &registers->current.user, &rd, &operand1, &operand2,
-          &shifter_carry_out);
-      ArmBIC(registers, rd, operand1, operand2);
-      break;
-    case ARM_OPCODE_BICS:
-      ArmOperandDataProcessingOperand2(next_instruction,
-                                       &registers->current.user, &rd, &operand1,
-                                       &operand2, &shifter_carry_out);
-      ArmBICS(registers, rd, operand1, operand2, shifter_carry_out);
-      break;
-    case ARM_OPCODE_BICS_I32:
-      ArmOperandDataProcessingImmediate(
-          next_instruction, &registers->current.user, &rd, &operand1, &operand2,
-          &shifter_carry_out);
-      ArmBICS(registers, rd, operand1, operand2, shifter_carry_out);
-      break;
     case ARM_OPCODE_BL_FWD:
       ArmOperandBranchForward(next_instruction, &branch_offset);
       ArmBL(registers, branch_offset);
@@ -162,54 +79,6 @@ ArmInstructionExecute(uint32_t next_instruction, ArmAllRegisters* registers,
     case ARM_OPCODE_CDP:
       ArmCDP(registers);
       break;
-    case ARM_OPCODE_CMN:
-      ArmOperandDataProcessingOperand2(next_instruction,
-                                       &registers->current.user, &rd, &operand1,
-                                       &operand2, &shifter_carry_out);
-      ArmCMN(registers, rd, operand1, operand2);
-      break;
-    case ARM_OPCODE_CMN_I32:
-      ArmOperandDataProcessingImmediate(
-          next_instruction, &registers->current.user, &rd, &operand1, &operand2,
-          &shifter_carry_out);
-      ArmCMN(registers, rd, operand1, operand2);
-      break;
-    case ARM_OPCODE_CMP:
-      ArmOperandDataProcessingOperand2(next_instruction,
-                                       &registers->current.user, &rd, &operand1,
-                                       &operand2, &shifter_carry_out);
-      ArmCMP(registers, rd, operand1, operand2);
-      break;
-    case ARM_OPCODE_CMP_I32:
-      ArmOperandDataProcessingImmediate(
-          next_instruction, &registers->current.user, &rd, &operand1, &operand2,
-          &shifter_carry_out);
-      ArmCMP(registers, rd, operand1, operand2);
-      break;
-    case ARM_OPCODE_EOR:
-      ArmOperandDataProcessingOperand2(next_instruction,
-                                       &registers->current.user, &rd, &operand1,
-                                       &operand2, &shifter_carry_out);
-      ArmEOR(registers, rd, operand1, operand2);
-      break;
-    case ARM_OPCODE_EOR_I32:
-      ArmOperandDataProcessingImmediate(
-          next_instruction, &registers->current.user, &rd, &operand1, &operand2,
-          &shifter_carry_out);
-      ArmEOR(registers, rd, operand1, operand2);
-      break;
-    case ARM_OPCODE_EORS:
-      ArmOperandDataProcessingOperand2(next_instruction,
-                                       &registers->current.user, &rd, &operand1,
-                                       &operand2, &shifter_carry_out);
-      ArmEORS(registers, rd, operand1, operand2, shifter_carry_out);
-      break;
-    case ARM_OPCODE_EORS_I32:
-      ArmOperandDataProcessingImmediate(
-          next_instruction, &registers->current.user, &rd, &operand1, &operand2,
-          &shifter_carry_out);
-      ArmEORS(registers, rd, operand1, operand2, shifter_carry_out);
-      break;
     case ARM_OPCODE_LDC:
       ArmLDC(registers);
       break;
@@ -612,30 +481,6 @@ ArmInstructionExecute(uint32_t next_instruction, ArmAllRegisters* registers,
       ArmOperandMultiplyAccumulate(next_instruction, &rd, &rm, &rs, &rn);
       ArmMLAS(registers, rd, rm, rs, rn);
       break;
-    case ARM_OPCODE_MOV:
-      ArmOperandDataProcessingOperand2(next_instruction,
-                                       &registers->current.user, &rd, &operand1,
-                                       &operand2, &shifter_carry_out);
-      ArmMOV(registers, rd, operand2);
-      break;
-    case ARM_OPCODE_MOV_I32:
-      ArmOperandDataProcessingImmediate(
-          next_instruction, &registers->current.user, &rd, &operand1, &operand2,
-          &shifter_carry_out);
-      ArmMOV(registers, rd, operand2);
-      break;
-    case ARM_OPCODE_MOVS:
-      ArmOperandDataProcessingOperand2(next_instruction,
-                                       &registers->current.user, &rd, &operand1,
-                                       &operand2, &shifter_carry_out);
-      ArmMOVS(registers, rd, operand2, shifter_carry_out);
-      break;
-    case ARM_OPCODE_MOVS_I32:
-      ArmOperandDataProcessingImmediate(
-          next_instruction, &registers->current.user, &rd, &operand1, &operand2,
-          &shifter_carry_out);
-      ArmMOVS(registers, rd, operand2, shifter_carry_out);
-      break;
     case ARM_OPCODE_MRC:
       ArmMRC(registers);
       break;
@@ -677,126 +522,6 @@ ArmInstructionExecute(uint32_t next_instruction, ArmAllRegisters* registers,
       ArmOperandMultiply(next_instruction, &rd, &rm, &rs);
       ArmMULS(registers, rd, rm, rs);
       break;
-    case ARM_OPCODE_MVN:
-      ArmOperandDataProcessingOperand2(next_instruction,
-                                       &registers->current.user, &rd, &operand1,
-                                       &operand2, &shifter_carry_out);
-      ArmMVN(registers, rd, operand2);
-      break;
-    case ARM_OPCODE_MVN_I32:
-      ArmOperandDataProcessingImmediate(
-          next_instruction, &registers->current.user, &rd, &operand1, &operand2,
-          &shifter_carry_out);
-      ArmMVN(registers, rd, operand2);
-      break;
-    case ARM_OPCODE_MVNS:
-      ArmOperandDataProcessingOperand2(next_instruction,
-                                       &registers->current.user, &rd, &operand1,
-                                       &operand2, &shifter_carry_out);
-      ArmMVNS(registers, rd, operand2, shifter_carry_out);
-      break;
-    case ARM_OPCODE_MVNS_I32:
-      ArmOperandDataProcessingImmediate(
-          next_instruction, &registers->current.user, &rd, &operand1, &operand2,
-          &shifter_carry_out);
-      ArmMVNS(registers, rd, operand2, shifter_carry_out);
-      break;
-    case ARM_OPCODE_ORR:
-      ArmOperandDataProcessingOperand2(next_instruction,
-                                       &registers->current.user, &rd, &operand1,
-                                       &operand2, &shifter_carry_out);
-      ArmORR(registers, rd, operand1, operand2);
-      break;
-    case ARM_OPCODE_ORR_I32:
-      ArmOperandDataProcessingImmediate(
-          next_instruction, &registers->current.user, &rd, &operand1, &operand2,
-          &shifter_carry_out);
-      ArmORR(registers, rd, operand1, operand2);
-      break;
-    case ARM_OPCODE_ORRS:
-      ArmOperandDataProcessingOperand2(next_instruction,
-                                       &registers->current.user, &rd, &operand1,
-                                       &operand2, &shifter_carry_out);
-      ArmORRS(registers, rd, operand1, operand2, shifter_carry_out);
-      break;
-    case ARM_OPCODE_ORRS_I32:
-      ArmOperandDataProcessingImmediate(
-          next_instruction, &registers->current.user, &rd, &operand1, &operand2,
-          &shifter_carry_out);
-      ArmORRS(registers, rd, operand1, operand2, shifter_carry_out);
-      break;
-    case ARM_OPCODE_RSB:
-      ArmOperandDataProcessingOperand2(next_instruction,
-                                       &registers->current.user, &rd, &operand1,
-                                       &operand2, &shifter_carry_out);
-      ArmRSB(registers, rd, operand1, operand2);
-      break;
-    case ARM_OPCODE_RSB_I32:
-      ArmOperandDataProcessingImmediate(
-          next_instruction, &registers->current.user, &rd, &operand1, &operand2,
-          &shifter_carry_out);
-      ArmRSB(registers, rd, operand1, operand2);
-      break;
-    case ARM_OPCODE_RSBS:
-      ArmOperandDataProcessingOperand2(next_instruction,
-                                       &registers->current.user, &rd, &operand1,
-                                       &operand2, &shifter_carry_out);
-      ArmRSBS(registers, rd, operand1, operand2);
-      break;
-    case ARM_OPCODE_RSBS_I32:
-      ArmOperandDataProcessingImmediate(
-          next_instruction, &registers->current.user, &rd, &operand1, &operand2,
-          &shifter_carry_out);
-      ArmRSBS(registers, rd, operand1, operand2);
-      break;
-    case ARM_OPCODE_RSC:
-      ArmOperandDataProcessingOperand2(next_instruction,
-                                       &registers->current.user, &rd, &operand1,
-                                       &operand2, &shifter_carry_out);
-      ArmRSC(registers, rd, operand1, operand2);
-      break;
-    case ARM_OPCODE_RSC_I32:
-      ArmOperandDataProcessingImmediate(
-          next_instruction, &registers->current.user, &rd, &operand1, &operand2,
-          &shifter_carry_out);
-      ArmRSC(registers, rd, operand1, operand2);
-      break;
-    case ARM_OPCODE_RSCS:
-      ArmOperandDataProcessingOperand2(next_instruction,
-                                       &registers->current.user, &rd, &operand1,
-                                       &operand2, &shifter_carry_out);
-      ArmRSCS(registers, rd, operand1, operand2);
-      break;
-    case ARM_OPCODE_RSCS_I32:
-      ArmOperandDataProcessingImmediate(
-          next_instruction, &registers->current.user, &rd, &operand1, &operand2,
-          &shifter_carry_out);
-      ArmRSCS(registers, rd, operand1, operand2);
-      break;
-    case ARM_OPCODE_SBC:
-      ArmOperandDataProcessingOperand2(next_instruction,
-                                       &registers->current.user, &rd, &operand1,
-                                       &operand2, &shifter_carry_out);
-      ArmSBC(registers, rd, operand1, operand2);
-      break;
-    case ARM_OPCODE_SBC_I32:
-      ArmOperandDataProcessingImmediate(
-          next_instruction, &registers->current.user, &rd, &operand1, &operand2,
-          &shifter_carry_out);
-      ArmSBC(registers, rd, operand1, operand2);
-      break;
-    case ARM_OPCODE_SBCS:
-      ArmOperandDataProcessingOperand2(next_instruction,
-                                       &registers->current.user, &rd, &operand1,
-                                       &operand2, &shifter_carry_out);
-      ArmSBCS(registers, rd, operand1, operand2);
-      break;
-    case ARM_OPCODE_SBCS_I32:
-      ArmOperandDataProcessingImmediate(
-          next_instruction, &registers->current.user, &rd, &operand1, &operand2,
-          &shifter_carry_out);
-      ArmSBCS(registers, rd, operand1, operand2);
-      break;
     case ARM_OPCODE_SMLAL:
       ArmOperandMultiplyLong(next_instruction, &rd_lsw, &rd_msw, &rm, &rs);
       ArmSMLAL(registers, rd_lsw, rd_msw, rm, rs);
@@ -1084,30 +809,6 @@ ArmInstructionExecute(uint32_t next_instruction, ArmAllRegisters* registers,
       ArmOperandLoadStoreImmediate(next_instruction, &rd, &rn, &offset_16);
       ArmSTRT_IAW(registers, memory, rd, rn, offset_16);
       break;
-    case ARM_OPCODE_SUB:
-      ArmOperandDataProcessingOperand2(next_instruction,
-                                       &registers->current.user, &rd, &operand1,
-                                       &operand2, &shifter_carry_out);
-      ArmSUB(registers, rd, operand1, operand2);
-      break;
-    case ARM_OPCODE_SUB_I32:
-      ArmOperandDataProcessingImmediate(
-          next_instruction, &registers->current.user, &rd, &operand1, &operand2,
-          &shifter_carry_out);
-      ArmSUB(registers, rd, operand1, operand2);
-      break;
-    case ARM_OPCODE_SUBS:
-      ArmOperandDataProcessingOperand2(next_instruction,
-                                       &registers->current.user, &rd, &operand1,
-                                       &operand2, &shifter_carry_out);
-      ArmSUBS(registers, rd, operand1, operand2);
-      break;
-    case ARM_OPCODE_SUBS_I32:
-      ArmOperandDataProcessingImmediate(
-          next_instruction, &registers->current.user, &rd, &operand1, &operand2,
-          &shifter_carry_out);
-      ArmSUBS(registers, rd, operand1, operand2);
-      break;
     case ARM_OPCODE_SWI:
       ArmSWI(registers);
       break;
@@ -1119,30 +820,6 @@ ArmInstructionExecute(uint32_t next_instruction, ArmAllRegisters* registers,
       ArmOperandSingleDataSwap(next_instruction, &rd, &rm, &rn);
       ArmSWPB(registers, memory, rd, rm, rn);
       break;
-    case ARM_OPCODE_TEQ:
-      ArmOperandDataProcessingOperand2(next_instruction,
-                                       &registers->current.user, &rd, &operand1,
-                                       &operand2, &shifter_carry_out);
-      ArmTEQ(registers, rd, operand1, operand2, shifter_carry_out);
-      break;
-    case ARM_OPCODE_TEQ_I32:
-      ArmOperandDataProcessingImmediate(
-          next_instruction, &registers->current.user, &rd, &operand1, &operand2,
-          &shifter_carry_out);
-      ArmTEQ(registers, rd, operand1, operand2, shifter_carry_out);
-      break;
-    case ARM_OPCODE_TST:
-      ArmOperandDataProcessingOperand2(next_instruction,
-                                       &registers->current.user, &rd, &operand1,
-                                       &operand2, &shifter_carry_out);
-      ArmTST(registers, rd, operand1, operand2, shifter_carry_out);
-      break;
-    case ARM_OPCODE_TST_I32:
-      ArmOperandDataProcessingImmediate(
-          next_instruction, &registers->current.user, &rd, &operand1, &operand2,
-          &shifter_carry_out);
-      ArmTST(registers, rd, operand1, operand2, shifter_carry_out);
-      break;
     case ARM_OPCODE_UMLAL:
       ArmOperandMultiplyLong(next_instruction, &rd_lsw, &rd_msw, &rm, &rs);
       ArmUMLAL(registers, rd_lsw, rd_msw, rm, rs);
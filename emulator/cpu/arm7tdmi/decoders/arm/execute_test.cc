@@ -123,12 +123,14 @@ class ExecuteTest : public testing::TestWithParam<uint16_t> {
   void RunInstruction(std::string instruction_hex) {
     uint32_t next_instruction = ToInstruction(instruction_hex);
     ArmInstructionExecute(next_instruction, &registers_, memory_);
+    ArmMaterializeFlags(&registers_);
   }
 
   // Assumes little-endian hex string
   void RunInstructionBadMemory(std::string instruction_hex) {
     uint32_t next_instruction = ToInstruction(instruction_hex);
     ArmInstructionExecute(next_instruction, &registers_, memory_fails_);
+    ArmMaterializeFlags(&registers_);
   }
 
   static std::vector<char> memory_space_;
@@ -4097,4 +4099,296 @@ TEST_F(ExecuteTest, SWP_FAILS) {
 TEST_F(ExecuteTest, SWPB_FAILS) {
   RunInstructionBadMemory("0x900041E1");  // swpb r0, r0, [r1]
   EXPECT_TRUE(ArmIsDataAbort(registers_));
+}
+
+static void ReferenceDataProcessing(uint32_t instruction,
+                                    ArmAllRegisters *registers) {
+  ArmRegisterIndex rd;
+  uint32_t operand1, operand2;
+  bool shifter_carry_out;
+  if (instruction & (1u << 25u)) {
+    ArmOperandDataProcessingImmediate(instruction, &registers->current.user,
+                                      &rd, &operand1, &operand2,
+                                      &shifter_carry_out);
+  } else {
+    ArmOperandDataProcessingOperand2(instruction, &registers->current.user,
+                                     &rd, &operand1, &operand2,
+                                     &shifter_carry_out);
+  }
+
+  bool s = instruction & (1u << 20u);
+  switch ((instruction >> 21u) & 0xFu) {
+    case 0u:
+      if (s) {
+        ArmANDS(registers, rd, operand1, operand2, shifter_carry_out);
+      } else {
+        ArmAND(registers, rd, operand1, operand2);
+      }
+      break;
+    case 1u:
+      if (s) {
+        ArmEORS(registers, rd, operand1, operand2, shifter_carry_out);
+      } else {
+        ArmEOR(registers, rd, operand1, operand2);
+      }
+      break;
+    case 2u:
+      if (s) {
+        ArmSUBS(registers, rd, operand1, operand2);
+      } else {
+        ArmSUB(registers, rd, operand1, operand2);
+      }
+      break;
+    case 3u:
+      if (s) {
+        ArmRSBS(registers, rd, operand1, operand2);
+      } else {
+        ArmRSB(registers, rd, operand1, operand2);
+      }
+      break;
+    case 4u:
+      if (s) {
+        ArmADDS(registers, rd, operand1, operand2);
+      } else {
+        ArmADD(registers, rd, operand1, operand2);
+      }
+      break;
+    case 5u:
+      if (s) {
+        ArmADCS(registers, rd, operand1, operand2);
+      } else {
+        ArmADC(registers, rd, operand1, operand2);
+      }
+      break;
+    case 6u:
+      if (s) {
+        ArmSBCS(registers, rd, operand1, operand2);
+      } else {
+        ArmSBC(registers, rd, operand1, operand2);
+      }
+      break;
+    case 7u:
+      if (s) {
+        ArmRSCS(registers, rd, operand1, operand2);
+      } else {
+        ArmRSC(registers, rd, operand1, operand2);
+      }
+      break;
+    case 8u:
+      ArmTST(registers, rd, operand1, operand2, shifter_carry_out);
+      break;
+    case 9u:
+      ArmTEQ(registers, rd, operand1, operand2, shifter_carry_out);
+      break;
+    case 10u:
+      ArmCMP(registers, rd, operand1, operand2);
+      break;
+    case 11u:
+      ArmCMN(registers, rd, operand1, operand2);
+      break;
+    case 12u:
+      if (s) {
+        ArmORRS(registers, rd, operand1, operand2, shifter_carry_out);
+      } else {
+        ArmORR(registers, rd, operand1, operand2);
+      }
+      break;
+    case 13u:
+      if (s) {
+        ArmMOVS(registers, rd, operand2, shifter_carry_out);
+      } else {
+        ArmMOV(registers, rd, operand2);
+      }
+      break;
+    case 14u:
+      if (s) {
+        ArmBICS(registers, rd, operand1, operand2, shifter_carry_out);
+      } else {
+        ArmBIC(registers, rd, operand1, operand2);
+      }
+      break;
+    case 15u:
+      if (s) {
+        ArmMVNS(registers, rd, operand2, shifter_carry_out);
+      } else {
+        ArmMVN(registers, rd, operand2);
+      }
+      break;
+  }
+}
+
+TEST_F(ExecuteTest, DataProcessingMatchesReference) {
+  registers_.current.user.gprs.r1 = 0x80000001u;
+  registers_.current.user.gprs.r2 = 0xF000000Fu;
+
+  const uint32_t shift_amounts[] = {0u, 1u, 4u, 31u, 32u, 33u, 0x120u};
+  for (uint32_t opcode = 0u; opcode < 32u; opcode++) {
+    if ((opcode & 0x19u) == 0x10u) {
+      continue;  // TST, TEQ, CMP, and CMN without S are not data processing
+    }
+
+    std::vector<uint32_t> operands;
+    for (uint32_t shift = 0u; shift < 4u; shift++) {
+      for (uint32_t amount : {0u, 1u, 4u, 31u}) {
+        operands.push_back((amount << 7u) | (shift << 5u) | 0x2u);
+        operands.push_back((amount << 7u) | (shift << 5u) | 0xFu);
+      }
+      operands.push_back((4u << 8u) | (shift << 5u) | 0x10u | 0x2u);
+      operands.push_back((4u << 8u) | (shift << 5u) | 0x10u | 0xFu);
+    }
+    for (uint32_t immediate : {0x0FFu, 0x1FFu, 0x4F0u, 0xF01u}) {
+      operands.push_back((1u << 25u) | immediate);
+    }
+
+    for (uint32_t operand : operands) {
+      for (uint32_t rn : {1u, 15u}) {
+        for (uint32_t amount : shift_amounts) {
+          for (bool carry : {false, true}) {
+            uint32_t instruction = 0xE0000000u | (opcode << 20u) |
+                                   (rn << 16u) | (3u << 12u) | operand;
+            registers_.current.user.gprs.r4 = amount;
+            registers_.current.user.cpsr.carry = carry;
+
+            ArmAllRegisters expected = registers_;
+            ReferenceDataProcessing(instruction, &expected);
+
+            ArmAllRegisters actual = registers_;
+            ArmInstructionExecute(instruction, &actual, memory_);
+            ArmMaterializeFlags(&actual);
+
+            ASSERT_EQ(0, memcmp(&expected, &actual, sizeof(ArmAllRegisters)))
+                << std::hex << instruction;
+          }
+        }
+      }
+    }
+  }
+}
+
+TEST_F(ExecuteTest, DataProcessingHandComputed) {
+  // Flags are packed as NZCV from the most significant bit down
+  struct {
+    uint32_t instruction;
+    uint32_t r1, r2, r4;
+    uint8_t flags;
+    uint32_t expected_r3, expected_pc;
+    uint8_t expected_flags;
+  } cases[] = {
+      // movs r3, r2
+      {0xE1B03002u, 0u, 0x80000000u, 0u, 0x3u, 0x80000000u, 0x10Cu, 0xBu},
+      // movs r3, r2, lsl #1
+      {0xE1B03082u, 0u, 0x80000001u, 0u, 0x0u, 0x2u, 0x10Cu, 0x2u},
+      // movs r3, r2, lsr #32
+      {0xE1B03022u, 0u, 0x80000000u, 0u, 0x0u, 0x0u, 0x10Cu, 0x6u},
+      // movs r3, r2, asr #32
+      {0xE1B03042u, 0u, 0x80000000u, 0u, 0x0u, 0xFFFFFFFFu, 0x10Cu, 0xAu},
+      // movs r3, r2, rrx
+      {0xE1B03062u, 0u, 0x2u, 0u, 0x2u, 0x80000001u, 0x10Cu, 0x8u},
+      // movs r3, r2, ror #4
+      {0xE1B03262u, 0u, 0xFu, 0u, 0x0u, 0xF0000000u, 0x10Cu, 0xAu},
+      // movs r3, r2, lsl r4
+      {0xE1B03412u, 0u, 0x1u, 0u, 0x3u, 0x1u, 0x10Cu, 0x3u},
+      // movs r3, r2, lsr r4
+      {0xE1B03432u, 0u, 0x80000000u, 32u, 0x0u, 0x0u, 0x10Cu, 0x6u},
+      // movs r3, r2, ror r4
+      {0xE1B03472u, 0u, 0x80000000u, 32u, 0x0u, 0x80000000u, 0x10Cu, 0xAu},
+      // movs r3, #0xF000000F
+      {0xE3B032FFu, 0u, 0u, 0u, 0x0u, 0xF000000Fu, 0x10Cu, 0xAu},
+      // movs r3, #0xFF
+      {0xE3B030FFu, 0u, 0u, 0u, 0x2u, 0xFFu, 0x10Cu, 0x2u},
+      // ands r3, r1, r2, lsl #1
+      {0xE0113082u, 0xFFFFFFFFu, 0x80000000u, 0u, 0x0u, 0x0u, 0x10Cu, 0x6u},
+      // tst r1, r2, lsr #1
+      {0xE11100A2u, 0x40000000u, 0x80000001u, 0u, 0x0u, 0x0u, 0x10Cu, 0x2u},
+      // adds r3, r1, r2
+      {0xE0913002u, 0x7FFFFFFFu, 0x1u, 0u, 0x0u, 0x80000000u, 0x10Cu, 0x9u},
+      // subs r3, r1, r2
+      {0xE0513002u, 0x1u, 0x2u, 0u, 0x0u, 0xFFFFFFFFu, 0x10Cu, 0x8u},
+      // adcs r3, r1, r2, rrx
+      {0xE0B13062u, 0xFFFFFFFFu, 0x1u, 0u, 0x2u, 0x80000000u, 0x10Cu, 0xAu},
+      // add r3, pc, #4
+      {0xE28F3004u, 0u, 0u, 0u, 0xFu, 0x10Cu, 0x10Cu, 0xFu},
+      // add r3, pc, r2, lsl r4
+      {0xE08F3412u, 0u, 0u, 0u, 0x0u, 0x10Cu, 0x10Cu, 0x0u},
+      // mov r3, pc, lsl r4
+      {0xE1A0341Fu, 0u, 0u, 0u, 0x0u, 0x10Cu, 0x10Cu, 0x0u},
+      // mov r3, pc
+      {0xE1A0300Fu, 0u, 0u, 0u, 0x0u, 0x108u, 0x10Cu, 0x0u},
+      // mov pc, r2
+      {0xE1A0F002u, 0u, 0x200u, 0u, 0x0u, 0x0u, 0x208u, 0x0u},
+      // add pc, pc, #4
+      {0xE28FF004u, 0u, 0u, 0u, 0x0u, 0x0u, 0x114u, 0x0u},
+  };
+
+  for (const auto &test : cases) {
+    ArmAllRegisters registers = registers_;
+    registers.current.user.gprs.r1 = test.r1;
+    registers.current.user.gprs.r2 = test.r2;
+    registers.current.user.gprs.r4 = test.r4;
+    registers.current.user.cpsr.negative = test.flags & 0x8u;
+    registers.current.user.cpsr.zero = test.flags & 0x4u;
+    registers.current.user.cpsr.carry = test.flags & 0x2u;
+    registers.current.user.cpsr.overflow = test.flags & 0x1u;
+
+    ArmInstructionExecute(test.instruction, &registers, memory_);
+    ArmMaterializeFlags(&registers);
+
+    EXPECT_EQ(test.expected_r3, registers.current.user.gprs.r3)
+        << std::hex << test.instruction;
+    EXPECT_EQ(test.expected_pc, registers.current.user.gprs.pc)
+        << std::hex << test.instruction;
+    uint8_t flags = (registers.current.user.cpsr.negative << 3u) |
+                    (registers.current.user.cpsr.zero << 2u) |
+                    (registers.current.user.cpsr.carry << 1u) |
+                    registers.current.user.cpsr.overflow;
+    EXPECT_EQ(test.expected_flags, flags) << std::hex << test.instruction;
+  }
+}
+
+TEST_F(ExecuteTest, FlagsStayDeferred) {
+  registers_.current.user.gprs.r0 = 0x2FCu;
+  registers_.current.user.gprs.r1 = 1u;
+  registers_.current.user.gprs.r2 = 2u;
+
+  ArmInstructionExecute(0xE1510002u, &registers_, memory_);  // cmp r1, r2
+  EXPECT_EQ(ARM_LAZY_FLAGS_SUB, registers_.lazy_flags.operation);
+
+  ArmInstructionExecute(0xE5903000u, &registers_, memory_);  // ldr r3, [r0]
+  EXPECT_EQ(ARM_LAZY_FLAGS_SUB, registers_.lazy_flags.operation);
+
+  // add r3, r1, r2, lsl #2
+  ArmInstructionExecute(0xE0813102u, &registers_, memory_);
+  EXPECT_EQ(ARM_LAZY_FLAGS_SUB, registers_.lazy_flags.operation);
+  EXPECT_EQ(9u, registers_.current.user.gprs.r3);
+
+  ArmMaterializeFlags(&registers_);
+  EXPECT_TRUE(registers_.current.user.cpsr.negative);
+  EXPECT_FALSE(registers_.current.user.cpsr.carry);
+}
+
+TEST_F(ExecuteTest, ShiftersReadDeferredCarry) {
+  registers_.current.user.gprs.r1 = 1u;
+  registers_.current.user.gprs.r2 = 2u;
+
+  // The carry flag in the CPSR is stale while the flags of cmp are deferred
+  ArmInstructionExecute(0xE1510002u, &registers_, memory_);  // cmp r1, r2
+  registers_.current.user.cpsr.carry = true;
+  // add r3, r0, r2, rrx
+  ArmInstructionExecute(0xE0803062u, &registers_, memory_);
+  EXPECT_EQ(1u, registers_.current.user.gprs.r3);
+
+  ArmInstructionExecute(0xE1520001u, &registers_, memory_);  // cmp r2, r1
+  registers_.current.user.cpsr.carry = false;
+  ArmInstructionExecute(0xE1B03002u, &registers_, memory_);  // movs r3, r2
+  ArmMaterializeFlags(&registers_);
+  EXPECT_TRUE(registers_.current.user.cpsr.carry);
+
+  ASSERT_TRUE(Store32LE(nullptr, 0x300u, 7u));
+  registers_.current.user.gprs.r0 = 0x100u;
+  registers_.current.user.gprs.r4 = 0x400u;
+  ArmInstructionExecute(0xE1510002u, &registers_, memory_);  // cmp r1, r2
+  registers_.current.user.cpsr.carry = true;
+  // ldr r3, [r0, r4, rrx]
+  ArmInstructionExecute(0xE7903064u, &registers_, memory_);
+  EXPECT_EQ(7u, registers_.current.user.gprs.r3);
 }
\ No newline at end of file
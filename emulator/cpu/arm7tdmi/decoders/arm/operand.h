@@ -93,142 +93,297 @@ static inline void ArmOperandDataProcessingImmediate(
   *shifter_carry_out = (*operand2 >> 31u) & 0x1u;
 }
 
-static inline void ArmOperandDataProcessingOperand2(
+static inline void ArmOperandDataProcessingImmediateShift(
     uint32_t instruction, const ArmUserRegisters *registers,
-    ArmRegisterIndex *Rd, uint32_t *operand1, uint32_t *operand2,
-    bool *shifter_carry_out) {
+    ArmRegisterIndex *Rd, uint32_t *operand1, uint32_t *shifted_value,
+    uint_fast8_t *shift_amount) {
   *Rd = (ArmRegisterIndex)((instruction >> 12u) & 0xFu);
 
   ArmRegisterIndex Rn = (ArmRegisterIndex)((instruction >> 16u) & 0xFu);
   *operand1 = registers->gprs.gprs[Rn];
 
   ArmRegisterIndex Rm = (ArmRegisterIndex)(instruction & 0xFu);
-  instruction = (instruction >> 4u) & 0xFFu;
+  *shifted_value = registers->gprs.gprs[Rm];
+
+  *shift_amount = (instruction >> 7u) & 0x1Fu;
+}
+
+static inline void ArmOperandDataProcessingRegisterShift(
+    uint32_t instruction, const ArmUserRegisters *registers,
+    ArmRegisterIndex *Rd, uint32_t *operand1, uint32_t *shifted_value,
+    uint_fast8_t *shift_amount) {
+  *Rd = (ArmRegisterIndex)((instruction >> 12u) & 0xFu);
+
+  ArmRegisterIndex Rn = (ArmRegisterIndex)((instruction >> 16u) & 0xFu);
+  *operand1 = registers->gprs.gprs[Rn];
+
+  // ARM defines specifying R15 for Rn to be unpredictable
+  if (Rn == REGISTER_R15) {
+    *operand1 += 4u;
+  }
 
-  uint32_t shifted_value = registers->gprs.gprs[Rm];
+  ArmRegisterIndex Rm = (ArmRegisterIndex)(instruction & 0xFu);
+  *shifted_value = registers->gprs.gprs[Rm];
+
+  // ARM defines specifying R15 for Rm to be unpredictable
+  if (Rm == REGISTER_R15) {
+    *shifted_value += 4u;
+  }
 
-  bool immediate;
+  ArmRegisterIndex Rs = (ArmRegisterIndex)((instruction >> 8u) & 0xFu);
+  *shift_amount = (uint8_t)registers->gprs.gprs[Rs];
+}
+
+static inline void ArmOperandDataProcessingLSLImmediate(
+    uint32_t instruction, const ArmUserRegisters *registers,
+    ArmRegisterIndex *Rd, uint32_t *operand1, uint32_t *operand2,
+    bool *shifter_carry_out) {
+  uint32_t shifted_value;
   uint_fast8_t shift_amount;
-  if (instruction & 0x1u) {
-    // ARM defines specifying R15 for Rn to be unpredictable
-    if (Rn == REGISTER_R15) {
-      *operand1 += 4u;
-    }
-    // ARM defines specifying R15 for Rn to be unpredictable
-    if (Rm == REGISTER_R15) {
-      shifted_value += 4u;
+  ArmOperandDataProcessingImmediateShift(instruction, registers, Rd, operand1,
+                                         &shifted_value, &shift_amount);
+
+  if (shift_amount == 0u) {
+    *shifter_carry_out = registers->cpsr.carry;
+    *operand2 = shifted_value;
+    return;
+  }
+
+  *shifter_carry_out = (shifted_value >> (32u - shift_amount)) & 0x1u;
+  *operand2 = shifted_value << shift_amount;
+}
+
+static inline void ArmOperandDataProcessingLSLRegister(
+    uint32_t instruction, const ArmUserRegisters *registers,
+    ArmRegisterIndex *Rd, uint32_t *operand1, uint32_t *operand2,
+    bool *shifter_carry_out) {
+  uint32_t shifted_value;
+  uint_fast8_t shift_amount;
+  ArmOperandDataProcessingRegisterShift(instruction, registers, Rd, operand1,
+                                        &shifted_value, &shift_amount);
+
+  if (shift_amount == 0u) {
+    *shifter_carry_out = registers->cpsr.carry;
+    *operand2 = shifted_value;
+    return;
+  }
+
+  if (shift_amount == 32u) {
+    *shifter_carry_out = shifted_value & 0x1u;
+    *operand2 = 0u;
+    return;
+  }
+
+  if (shift_amount > 32u) {
+    *shifter_carry_out = false;
+    *operand2 = 0u;
+    return;
+  }
+
+  *shifter_carry_out = (shifted_value >> (32u - shift_amount)) & 0x1u;
+  *operand2 = shifted_value << shift_amount;
+}
+
+static inline void ArmOperandDataProcessingLSRImmediate(
+    uint32_t instruction, const ArmUserRegisters *registers,
+    ArmRegisterIndex *Rd, uint32_t *operand1, uint32_t *operand2,
+    bool *shifter_carry_out) {
+  uint32_t shifted_value;
+  uint_fast8_t shift_amount;
+  ArmOperandDataProcessingImmediateShift(instruction, registers, Rd, operand1,
+                                         &shifted_value, &shift_amount);
+
+  // LSR #0 is used to encode LSR #32
+  if (shift_amount == 0u) {
+    *shifter_carry_out = (shifted_value >> 31u) & 0x1u;
+    *operand2 = 0u;
+    return;
+  }
+
+  *shifter_carry_out = (shifted_value >> (shift_amount - 1u)) & 0x1u;
+  *operand2 = shifted_value >> shift_amount;
+}
+
+static inline void ArmOperandDataProcessingLSRRegister(
+    uint32_t instruction, const ArmUserRegisters *registers,
+    ArmRegisterIndex *Rd, uint32_t *operand1, uint32_t *operand2,
+    bool *shifter_carry_out) {
+  uint32_t shifted_value;
+  uint_fast8_t shift_amount;
+  ArmOperandDataProcessingRegisterShift(instruction, registers, Rd, operand1,
+                                        &shifted_value, &shift_amount);
+
+  if (shift_amount == 0u) {
+    *shifter_carry_out = registers->cpsr.carry;
+    *operand2 = shifted_value;
+    return;
+  }
+
+  if (shift_amount == 32u) {
+    *shifter_carry_out = (shifted_value >> 31u) & 0x1u;
+    *operand2 = 0u;
+    return;
+  }
+
+  if (shift_amount > 32u) {
+    *shifter_carry_out = false;
+    *operand2 = 0u;
+    return;
+  }
+
+  *shifter_carry_out = (shifted_value >> (shift_amount - 1u)) & 0x1u;
+  *operand2 = shifted_value >> shift_amount;
+}
+
+static inline void ArmOperandDataProcessingASRImmediate(
+    uint32_t instruction, const ArmUserRegisters *registers,
+    ArmRegisterIndex *Rd, uint32_t *operand1, uint32_t *operand2,
+    bool *shifter_carry_out) {
+  uint32_t shifted_value;
+  uint_fast8_t shift_amount;
+  ArmOperandDataProcessingImmediateShift(instruction, registers, Rd, operand1,
+                                         &shifted_value, &shift_amount);
+
+  // ASR #0 is used to encode ASR #32
+  if (shift_amount == 0u) {
+    if (shifted_value >> 31u) {
+      *shifter_carry_out = true;
+      *operand2 = 0xFFFFFFFFu;
+    } else {
+      *shifter_carry_out = false;
+      *operand2 = 0u;
     }
-    ArmRegisterIndex Rs = (ArmRegisterIndex)(instruction >> 0x4u);
-    assert(REGISTER_R0 <= Rm && Rm <= REGISTER_R15);
-    shift_amount = (uint8_t)registers->gprs.gprs[Rs];
-    immediate = false;
-  } else {
-    shift_amount = instruction >> 3u;
-    immediate = true;
+    return;
   }
 
-  uint_fast8_t shift = (instruction >> 1u) & 0x3u;
-  switch (shift) {
-    case 0u:  // LSL
-      if (shift_amount == 0u) {
-        *shifter_carry_out = registers->cpsr.carry;
-        *operand2 = shifted_value;
-        break;
-      }
+  *shifter_carry_out = (shifted_value >> (shift_amount - 1u)) & 0x1u;
 
-      if (shift_amount == 32u) {
-        *shifter_carry_out = shifted_value & 0x1u;
-        *operand2 = 0u;
-        break;
-      }
+  // Technically this triggers implementation defined behavior in C
+  *operand2 = ((int32_t)shifted_value) >> shift_amount;
+}
 
-      if (shift_amount > 32u) {
-        *shifter_carry_out = false;
-        *operand2 = 0u;
-        break;
-      }
+static inline void ArmOperandDataProcessingASRRegister(
+    uint32_t instruction, const ArmUserRegisters *registers,
+    ArmRegisterIndex *Rd, uint32_t *operand1, uint32_t *operand2,
+    bool *shifter_carry_out) {
+  uint32_t shifted_value;
+  uint_fast8_t shift_amount;
+  ArmOperandDataProcessingRegisterShift(instruction, registers, Rd, operand1,
+                                        &shifted_value, &shift_amount);
 
-      *shifter_carry_out = (shifted_value >> (32u - shift_amount)) & 0x1u;
-      *operand2 = shifted_value << shift_amount;
-      break;
-    case 1u:  // LSR
-      if (shift_amount == 0u) {
-        if (!immediate) {
-          *shifter_carry_out = registers->cpsr.carry;
-          *operand2 = shifted_value;
-          break;
-        }
+  if (shift_amount == 0u) {
+    *shifter_carry_out = registers->cpsr.carry;
+    *operand2 = shifted_value;
+    return;
+  }
 
-        shift_amount = 32u;
-      }
+  if (shift_amount >= 32u) {
+    if (shifted_value >> 31u) {
+      *shifter_carry_out = true;
+      *operand2 = 0xFFFFFFFFu;
+    } else {
+      *shifter_carry_out = false;
+      *operand2 = 0u;
+    }
+    return;
+  }
 
-      if (shift_amount == 32u) {
-        *shifter_carry_out = (shifted_value >> 31u) & 0x1u;
-        *operand2 = 0u;
-        break;
-      }
+  *shifter_carry_out = (shifted_value >> (shift_amount - 1u)) & 0x1u;
 
-      if (shift_amount > 32u) {
-        *shifter_carry_out = false;
-        *operand2 = 0u;
-        break;
-      }
+  // Technically this triggers implementation defined behavior in C
+  *operand2 = ((int32_t)shifted_value) >> shift_amount;
+}
 
-      *shifter_carry_out = (shifted_value >> (shift_amount - 1u)) & 0x1u;
-      *operand2 = shifted_value >> shift_amount;
-      break;
-    case 2u:  // ASR
-      if (shift_amount == 0u) {
-        if (!immediate) {
-          *shifter_carry_out = registers->cpsr.carry;
-          *operand2 = shifted_value;
-          break;
-        }
+static inline void ArmOperandDataProcessingRORImmediate(
+    uint32_t instruction, const ArmUserRegisters *registers,
+    ArmRegisterIndex *Rd, uint32_t *operand1, uint32_t *operand2,
+    bool *shifter_carry_out) {
+  uint32_t shifted_value;
+  uint_fast8_t shift_amount;
+  ArmOperandDataProcessingImmediateShift(instruction, registers, Rd, operand1,
+                                         &shifted_value, &shift_amount);
 
-        shift_amount = 32u;
-      }
+  // ROR #0 is used to encode RRX
+  if (shift_amount == 0u) {
+    *shifter_carry_out = shifted_value & 0x1u;
+    *operand2 = (registers->cpsr.carry << 31u) | (shifted_value >> 1u);
+    return;
+  }
 
-      if (shift_amount >= 32u) {
-        if (shifted_value >> 31u) {
-          *shifter_carry_out = true;
-          *operand2 = 0xFFFFFFFFu;
-        } else {
-          *shifter_carry_out = false;
-          *operand2 = 0u;
-        }
-        break;
-      }
+  *shifter_carry_out = (shifted_value >> (shift_amount - 1u)) & 0x1u;
+  *operand2 = (shifted_value >> shift_amount) |
+              (shifted_value << (32u - shift_amount));
+}
 
-      *shifter_carry_out = (shifted_value >> (shift_amount - 1u)) & 0x1u;
+static inline void ArmOperandDataProcessingRORRegister(
+    uint32_t instruction, const ArmUserRegisters *registers,
+    ArmRegisterIndex *Rd, uint32_t *operand1, uint32_t *operand2,
+    bool *shifter_carry_out) {
+  uint32_t shifted_value;
+  uint_fast8_t shift_amount;
+  ArmOperandDataProcessingRegisterShift(instruction, registers, Rd, operand1,
+                                        &shifted_value, &shift_amount);
 
-      // Technically this triggers implementation defined behavior in C
-      *operand2 = ((int32_t)shifted_value) >> shift_amount;
-      break;
-    case 3u:
-      if (shift_amount == 0u) {
-        if (immediate) {
-          // RRX
-          *shifter_carry_out = shifted_value & 0x1u;
-          *operand2 = (registers->cpsr.carry << 31u) | (shifted_value >> 1u);
-        } else {
-          *shifter_carry_out = registers->cpsr.carry;
-          *operand2 = shifted_value;
-        }
-        break;
-      }
+  if (shift_amount == 0u) {
+    *shifter_carry_out = registers->cpsr.carry;
+    *operand2 = shifted_value;
+    return;
+  }
 
-      shift_amount &= 0x1Fu;
+  shift_amount &= 0x1Fu;
 
-      if (shift_amount == 0u) {
-        *shifter_carry_out = (shifted_value >> 31u) & 0x1u;
-        *operand2 = shifted_value;
-        break;
-      }
+  if (shift_amount == 0u) {
+    *shifter_carry_out = (shifted_value >> 31u) & 0x1u;
+    *operand2 = shifted_value;
+    return;
+  }
 
-      // ROR
-      *shifter_carry_out = (shifted_value >> (shift_amount - 1u)) & 0x1u;
-      *operand2 = (shifted_value >> shift_amount) |
-                  (shifted_value << (32u - shift_amount));
+  *shifter_carry_out = (shifted_value >> (shift_amount - 1u)) & 0x1u;
+  *operand2 = (shifted_value >> shift_amount) |
+              (shifted_value << (32u - shift_amount));
+}
+
+static inline void ArmOperandDataProcessingOperand2(
+    uint32_t instruction, const ArmUserRegisters *registers,
+    ArmRegisterIndex *Rd, uint32_t *operand1, uint32_t *operand2,
+    bool *shifter_carry_out) {
+  uint_fast8_t shift = (instruction >> 4u) & 0x7u;
+  switch (shift) {
+    case 0u:
+      ArmOperandDataProcessingLSLImmediate(instruction, registers, Rd,
+                                           operand1, operand2,
+                                           shifter_carry_out);
+      break;
+    case 1u:
+      ArmOperandDataProcessingLSLRegister(instruction, registers, Rd, operand1,
+                                          operand2, shifter_carry_out);
+      break;
+    case 2u:
+      ArmOperandDataProcessingLSRImmediate(instruction, registers, Rd,
+                                           operand1, operand2,
+                                           shifter_carry_out);
+      break;
+    case 3u:
+      ArmOperandDataProcessingLSRRegister(instruction, registers, Rd, operand1,
+                                          operand2, shifter_carry_out);
+      break;
+    case 4u:
+      ArmOperandDataProcessingASRImmediate(instruction, registers, Rd,
+                                           operand1, operand2,
+                                           shifter_carry_out);
+      break;
+    case 5u:
+      ArmOperandDataProcessingASRRegister(instruction, registers, Rd, operand1,
+                                          operand2, shifter_carry_out);
+      break;
+    case 6u:
+      ArmOperandDataProcessingRORImmediate(instruction, registers, Rd,
+                                           operand1, operand2,
+                                           shifter_carry_out);
+      break;
+    case 7u:
+      ArmOperandDataProcessingRORRegister(instruction, registers, Rd, operand1,
+                                          operand2, shifter_carry_out);
       break;
     default:
       codegen_assert(false);
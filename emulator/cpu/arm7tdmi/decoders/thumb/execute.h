@@ -59,26 +59,26 @@ ThumbInstructionExecute(uint16_t next_instruction, ArmAllRegisters* registers,
       break;
     case THUMB_OPCODE_ADDS:
       ThumbOperandAddSubtractRegister(next_instruction, &rd, &rn, &rm);
-      ArmADDS(registers, rd, registers->current.user.gprs.gprs[rn],
-              registers->current.user.gprs.gprs[rm]);
+      ArmADDSLazy(registers, rd, registers->current.user.gprs.gprs[rn],
+                  registers->current.user.gprs.gprs[rm]);
       break;
     case THUMB_OPCODE_ADDS_I3:
       ThumbOperandAddSubtractImmediate(next_instruction, &rd, &rn,
                                        &immediate_8);
-      ArmADDS(registers, rd, registers->current.user.gprs.gprs[rn],
-              immediate_8);
+      ArmADDSLazy(registers, rd, registers->current.user.gprs.gprs[rn],
+                  immediate_8);
       break;
     case THUMB_OPCODE_ADDS_I8:
       ThumbOperandAddSubtractCompareMoveImmediate(next_instruction, &rd,
                                                   &immediate_8);
-      ArmADDS(registers, rd, registers->current.user.gprs.gprs[rd],
-              immediate_8);
+      ArmADDSLazy(registers, rd, registers->current.user.gprs.gprs[rd],
+                  immediate_8);
       break;
     case THUMB_OPCODE_ANDS:
       ThumbOperandDataProcessingRegister(next_instruction, &rd, &rm);
-      ArmANDS(registers, rd, registers->current.user.gprs.gprs[rd],
-              registers->current.user.gprs.gprs[rm],
-              registers->current.user.cpsr.carry);
+      ArmANDSLazy(registers, rd, registers->current.user.gprs.gprs[rd],
+                  registers->current.user.gprs.gprs[rm],
+                  ArmCarryFlag(registers));
       break;
     case THUMB_OPCODE_ASRS:
       ThumbOperandDataProcessingRegister(next_instruction, &rd, &rm);
@@ -95,6 +95,7 @@ ThumbInstructionExecute(uint16_t next_instruction, ArmAllRegisters* registers,
     case THUMB_OPCODE_B_FWD_COND:
       ThumbOperandConditionalForwardBranch(next_instruction, &condition,
                                            &branch_offset_32);
+      ArmMaterializeFlags(registers);
       if (ThumbShouldBranch(registers->current.user.cpsr, condition)) {
         ArmB(registers, branch_offset_32);
       } else {
@@ -108,6 +109,7 @@ ThumbInstructionExecute(uint16_t next_instruction, ArmAllRegisters* registers,
     case THUMB_OPCODE_B_REV_COND:
       ThumbOperandConditionalReverseBranch(next_instruction, &condition,
                                            &branch_offset_32);
+      ArmMaterializeFlags(registers);
       if (ThumbShouldBranch(registers->current.user.cpsr, condition)) {
         ArmB(registers, branch_offset_32);
       } else {
@@ -116,9 +118,9 @@ ThumbInstructionExecute(uint16_t next_instruction, ArmAllRegisters* registers,
       break;
     case THUMB_OPCODE_BICS:
       ThumbOperandDataProcessingRegister(next_instruction, &rd, &rm);
-      ArmBICS(registers, rd, registers->current.user.gprs.gprs[rd],
-              registers->current.user.gprs.gprs[rm],
-              registers->current.user.cpsr.carry);
+      ArmBICSLazy(registers, rd, registers->current.user.gprs.gprs[rd],
+                  registers->current.user.gprs.gprs[rm],
+                  ArmCarryFlag(registers));
       break;
     case THUMB_OPCODE_BL:
       ThumbOperandBranchLink(next_instruction, &branch_offset_16);
@@ -138,30 +140,30 @@ ThumbInstructionExecute(uint16_t next_instruction, ArmAllRegisters* registers,
       break;
     case THUMB_OPCODE_CMN:
       ThumbOperandDataProcessingRegister(next_instruction, &rn, &rm);
-      ArmCMN(registers, REGISTER_R0, registers->current.user.gprs.gprs[rn],
-             registers->current.user.gprs.gprs[rm]);
+      ArmCMNLazy(registers, REGISTER_R0, registers->current.user.gprs.gprs[rn],
+                 registers->current.user.gprs.gprs[rm]);
       break;
     case THUMB_OPCODE_CMP:
       ThumbOperandDataProcessingRegister(next_instruction, &rn, &rm);
-      ArmCMP(registers, REGISTER_R0, registers->current.user.gprs.gprs[rn],
-             registers->current.user.gprs.gprs[rm]);
+      ArmCMPLazy(registers, REGISTER_R0, registers->current.user.gprs.gprs[rn],
+                 registers->current.user.gprs.gprs[rm]);
       break;
     case THUMB_OPCODE_CMP_I8:
       ThumbOperandAddSubtractCompareMoveImmediate(next_instruction, &rn,
                                                   &immediate_8);
-      ArmCMP(registers, REGISTER_R0, registers->current.user.gprs.gprs[rn],
-             immediate_8);
+      ArmCMPLazy(registers, REGISTER_R0, registers->current.user.gprs.gprs[rn],
+                 immediate_8);
       break;
     case THUMB_OPCODE_CMP_ANY:
       ThumbOperandSpecialDataProcessing(next_instruction, &rn, &rm);
-      ArmCMP(registers, REGISTER_R0, registers->current.user.gprs.gprs[rn],
-             registers->current.user.gprs.gprs[rm]);
+      ArmCMPLazy(registers, REGISTER_R0, registers->current.user.gprs.gprs[rn],
+                 registers->current.user.gprs.gprs[rm]);
       break;
     case THUMB_OPCODE_EORS:
       ThumbOperandDataProcessingRegister(next_instruction, &rd, &rm);
-      ArmEORS(registers, rd, registers->current.user.gprs.gprs[rd],
-              registers->current.user.gprs.gprs[rm],
-              registers->current.user.cpsr.carry);
+      ArmEORSLazy(registers, rd, registers->current.user.gprs.gprs[rd],
+                  registers->current.user.gprs.gprs[rm],
+                  ArmCarryFlag(registers));
       break;
     case THUMB_OPCODE_LDMIA:
       ThumbOperandLoadStoreMultiple(next_instruction, &rn, &register_list);
@@ -242,7 +244,7 @@ ThumbInstructionExecute(uint16_t next_instruction, ArmAllRegisters* registers,
     case THUMB_OPCODE_MOVS_I8:
       ThumbOperandAddSubtractCompareMoveImmediate(next_instruction, &rd,
                                                   &immediate_8);
-      ArmMOVS(registers, rd, immediate_8, registers->current.user.cpsr.carry);
+      ArmMOVSLazy(registers, rd, immediate_8, ArmCarryFlag(registers));
       break;
     case THUMB_OPCODE_MULS:
       ThumbOperandDataProcessingRegister(next_instruction, &rd, &rm);
@@ -250,18 +252,18 @@ ThumbInstructionExecute(uint16_t next_instruction, ArmAllRegisters* registers,
       break;
     case THUMB_OPCODE_MVNS:
       ThumbOperandDataProcessingRegister(next_instruction, &rd, &rm);
-      ArmMVNS(registers, rd, registers->current.user.gprs.gprs[rm],
-              registers->current.user.cpsr.carry);
+      ArmMVNSLazy(registers, rd, registers->current.user.gprs.gprs[rm],
+                  ArmCarryFlag(registers));
       break;
     case THUMB_OPCODE_NEGS:
       ThumbOperandDataProcessingRegister(next_instruction, &rd, &rm);
-      ArmRSBS(registers, rd, registers->current.user.gprs.gprs[rm], 0u);
+      ArmRSBSLazy(registers, rd, registers->current.user.gprs.gprs[rm], 0u);
       break;
     case THUMB_OPCODE_ORRS:
       ThumbOperandDataProcessingRegister(next_instruction, &rd, &rm);
-      ArmORRS(registers, rd, registers->current.user.gprs.gprs[rd],
-              registers->current.user.gprs.gprs[rm],
-              registers->current.user.cpsr.carry);
+      ArmORRSLazy(registers, rd, registers->current.user.gprs.gprs[rd],
+                  registers->current.user.gprs.gprs[rm],
+                  ArmCarryFlag(registers));
       break;
     case THUMB_OPCODE_POP:
       ThumbOperandPopRegisterList(next_instruction, &register_list);
@@ -325,29 +327,29 @@ ThumbInstructionExecute(uint16_t next_instruction, ArmAllRegisters* registers,
       break;
     case THUMB_OPCODE_SUBS:
       ThumbOperandAddSubtractRegister(next_instruction, &rd, &rn, &rm);
-      ArmSUBS(registers, rd, registers->current.user.gprs.gprs[rn],
-              registers->current.user.gprs.gprs[rm]);
+      ArmSUBSLazy(registers, rd, registers->current.user.gprs.gprs[rn],
+                  registers->current.user.gprs.gprs[rm]);
       break;
     case THUMB_OPCODE_SUBS_I3:
       ThumbOperandAddSubtractImmediate(next_instruction, &rd, &rn,
                                        &immediate_8);
-      ArmSUBS(registers, rd, registers->current.user.gprs.gprs[rn],
-              immediate_8);
+      ArmSUBSLazy(registers, rd, registers->current.user.gprs.gprs[rn],
+                  immediate_8);
       break;
     case THUMB_OPCODE_SUBS_I8:
       ThumbOperandAddSubtractCompareMoveImmediate(next_instruction, &rd,
                                                   &immediate_8);
-      ArmSUBS(registers, rd, registers->current.user.gprs.gprs[rd],
-              immediate_8);
+      ArmSUBSLazy(registers, rd, registers->current.user.gprs.gprs[rd],
+                  immediate_8);
       break;
     case THUMB_OPCODE_SWI:
       ArmSWI(registers);
       break;
     case THUMB_OPCODE_TST:
       ThumbOperandDataProcessingRegister(next_instruction, &rn, &rm);
-      ArmTST(registers, REGISTER_R0, registers->current.user.gprs.gprs[rn],
-             registers->current.user.gprs.gprs[rm],
-             registers->current.user.cpsr.carry);
+      ArmTSTLazy(registers, REGISTER_R0, registers->current.user.gprs.gprs[rn],
+                 registers->current.user.gprs.gprs[rm],
+                 ArmCarryFlag(registers));
       break;
     default:
       codegen_assert(false);
@@ -151,12 +151,14 @@ class ExecuteTest : public testing::TestWithParam<uint16_t> {
   void RunInstruction(std::string instruction_hex) {
     uint16_t instruction = ToInstruction(instruction_hex);
     ThumbInstructionExecute(instruction, &registers_, memory_);
+    ArmMaterializeFlags(&registers_);
   }
 
   // Assumes little-endian hex string
   void RunInstructionBadMemory(std::string instruction_hex) {
     uint16_t instruction = ToInstruction(instruction_hex);
     ThumbInstructionExecute(instruction, &registers_, memory_fails_);
+    ArmMaterializeFlags(&registers_);
   }
 
   static std::vector<char> memory_space_;
@@ -9,6 +9,7 @@
 
 static inline void ThumbASRS_I(ArmAllRegisters *registers, ArmRegisterIndex Rd,
                                ArmRegisterIndex Rm, uint_fast8_t shift_amount) {
+  ArmMaterializeFlags(registers);
   codegen_assert(registers->current.user.cpsr.thumb);
   assert(Rd <= REGISTER_R7);
   assert(Rm <= REGISTER_R7);
@@ -40,6 +41,7 @@ static inline void ThumbASRS_I(ArmAllRegisters *registers, ArmRegisterIndex Rd,
 
 static inline void ThumbASRS_R(ArmAllRegisters *registers, ArmRegisterIndex Rd,
                                ArmRegisterIndex Rs) {
+  ArmMaterializeFlags(registers);
   codegen_assert(registers->current.user.cpsr.thumb);
   assert(Rd <= REGISTER_R7);
   assert(Rs <= REGISTER_R7);
@@ -70,6 +72,7 @@ static inline void ThumbASRS_R(ArmAllRegisters *registers, ArmRegisterIndex Rd,
 
 static inline void ThumbLSLS_I(ArmAllRegisters *registers, ArmRegisterIndex Rd,
                                ArmRegisterIndex Rm, uint_fast8_t shift_amount) {
+  ArmMaterializeFlags(registers);
   codegen_assert(registers->current.user.cpsr.thumb);
   assert(Rd <= REGISTER_R7);
   assert(Rm <= REGISTER_R7);
@@ -95,6 +98,7 @@ static inline void ThumbLSLS_I(ArmAllRegisters *registers, ArmRegisterIndex Rd,
 
 static inline void ThumbLSLS_R(ArmAllRegisters *registers, ArmRegisterIndex Rd,
                                ArmRegisterIndex Rs) {
+  ArmMaterializeFlags(registers);
   codegen_assert(registers->current.user.cpsr.thumb);
   assert(Rd <= REGISTER_R7);
   assert(Rs <= REGISTER_R7);
@@ -123,6 +127,7 @@ static inline void ThumbLSLS_R(ArmAllRegisters *registers, ArmRegisterIndex Rd,
 
 static inline void ThumbLSRS_I(ArmAllRegisters *registers, ArmRegisterIndex Rd,
                                ArmRegisterIndex Rm, uint_fast8_t shift_amount) {
+  ArmMaterializeFlags(registers);
   codegen_assert(registers->current.user.cpsr.thumb);
   assert(Rd <= REGISTER_R7);
   assert(Rm <= REGISTER_R7);
@@ -149,6 +154,7 @@ static inline void ThumbLSRS_I(ArmAllRegisters *registers, ArmRegisterIndex Rd,
 
 static inline void ThumbLSRS_R(ArmAllRegisters *registers, ArmRegisterIndex Rd,
                                ArmRegisterIndex Rs) {
+  ArmMaterializeFlags(registers);
   codegen_assert(registers->current.user.cpsr.thumb);
   assert(Rd <= REGISTER_R7);
   assert(Rs <= REGISTER_R7);
@@ -177,6 +183,7 @@ static inline void ThumbLSRS_R(ArmAllRegisters *registers, ArmRegisterIndex Rd,
 
 static inline void ThumbRORS(ArmAllRegisters *registers, ArmRegisterIndex Rd,
                              ArmRegisterIndex Rs) {
+  ArmMaterializeFlags(registers);
   codegen_assert(registers->current.user.cpsr.thumb);
   assert(Rd <= REGISTER_R7);
   assert(Rs <= REGISTER_R7);
@@ -0,0 +1,597 @@
+#include "emulator/cpu/arm7tdmi/decoders/thumb/threaded.h"
+
+#include <assert.h>
+#include <pthread.h>
+
+#include "emulator/cpu/arm7tdmi/decoders/thumb/branch_link.h"
+#include "emulator/cpu/arm7tdmi/decoders/thumb/condition.h"
+#include "emulator/cpu/arm7tdmi/decoders/thumb/load.h"
+#include "emulator/cpu/arm7tdmi/decoders/thumb/operand.h"
+#include "emulator/cpu/arm7tdmi/decoders/thumb/shift.h"
+#include "emulator/cpu/arm7tdmi/exceptions.h"
+#include "emulator/cpu/arm7tdmi/instructions/block_data_transfer.h"
+#include "emulator/cpu/arm7tdmi/instructions/branch.h"
+#include "emulator/cpu/arm7tdmi/instructions/branch_exchange.h"
+#include "emulator/cpu/arm7tdmi/instructions/data_processing.h"
+#include "emulator/cpu/arm7tdmi/instructions/load_store_register_byte.h"
+#include "emulator/cpu/arm7tdmi/instructions/multiply.h"
+#include "emulator/cpu/arm7tdmi/instructions/signed_data_transfer.h"
+#include "emulator/cpu/arm7tdmi/instructions/swi.h"
+#include "tools/thumb_opcode_decoder/decoder.h"
+#include "util/macros.h"
+
+#define THUMB_NUM_ENCODINGS 65536u
+
+// Handlers are numbered the same as their ThumbOpcode with the exception of
+// the handlers below which specialize an opcode based on its operands.
+typedef enum {
+  THUMB_HANDLER_LDMIA_NO_WRITEBACK = THUMB_OPCODE_UNDEF + 1u,
+  THUMB_NUM_HANDLERS,
+} ThumbHandler;
+
+typedef struct {
+  uint8_t handler;
+  uint8_t rd;
+  uint8_t rn;
+  union {
+    uint8_t rm;
+    uint8_t condition;
+  };
+  uint32_t immediate;
+} ThumbThreadedInstruction;
+
+static_assert(sizeof(ThumbThreadedInstruction) == 8u,
+              "sizeof(ThumbThreadedInstruction) != 8u");
+
+static ThumbThreadedInstruction thumb_instructions[THUMB_NUM_ENCODINGS];
+static pthread_once_t thumb_instructions_once = PTHREAD_ONCE_INIT;
+
+static void ThumbThreadedDecode(uint16_t instruction,
+                                ThumbThreadedInstruction *decoded) {
+  ArmRegisterIndex rd = REGISTER_R0, rn = REGISTER_R0, rm = REGISTER_R0;
+  uint_fast32_t branch_offset_32 = 0u;
+  uint_fast8_t condition = 0u, immediate_8 = 0u;
+  uint_fast16_t immediate_16 = 0u, register_list = 0u;
+
+  ThumbOpcode opcode = ThumbDecodeOpcode(instruction);
+  decoded->handler = opcode;
+  decoded->condition = 0u;
+  decoded->immediate = 0u;
+
+  switch (opcode) {
+    case THUMB_OPCODE_ADCS:
+    case THUMB_OPCODE_ANDS:
+    case THUMB_OPCODE_ASRS:
+    case THUMB_OPCODE_BICS:
+    case THUMB_OPCODE_EORS:
+    case THUMB_OPCODE_LSLS:
+    case THUMB_OPCODE_LSRS:
+    case THUMB_OPCODE_MULS:
+    case THUMB_OPCODE_MVNS:
+    case THUMB_OPCODE_NEGS:
+    case THUMB_OPCODE_ORRS:
+    case THUMB_OPCODE_RORS:
+    case THUMB_OPCODE_SBCS:
+      ThumbOperandDataProcessingRegister(instruction, &rd, &rm);
+      break;
+    case THUMB_OPCODE_CMN:
+    case THUMB_OPCODE_CMP:
+    case THUMB_OPCODE_TST:
+      ThumbOperandDataProcessingRegister(instruction, &rn, &rm);
+      break;
+    case THUMB_OPCODE_ADD_ANY:
+    case THUMB_OPCODE_MOV_ANY:
+      ThumbOperandSpecialDataProcessing(instruction, &rd, &rm);
+      break;
+    case THUMB_OPCODE_CMP_ANY:
+      ThumbOperandSpecialDataProcessing(instruction, &rn, &rm);
+      break;
+    case THUMB_OPCODE_ADD_PC:
+    case THUMB_OPCODE_ADD_SP:
+      ThumbOperandAddToSPOrPC(instruction, &rd, &immediate_16);
+      decoded->immediate = immediate_16;
+      break;
+    case THUMB_OPCODE_ADD_SP_I7:
+    case THUMB_OPCODE_SUB_SP_I7:
+      ThumbOperandAdjustStackPointer(instruction, &immediate_16);
+      decoded->immediate = immediate_16;
+      break;
+    case THUMB_OPCODE_ADDS:
+    case THUMB_OPCODE_SUBS:
+      ThumbOperandAddSubtractRegister(instruction, &rd, &rn, &rm);
+      break;
+    case THUMB_OPCODE_ADDS_I3:
+    case THUMB_OPCODE_SUBS_I3:
+      ThumbOperandAddSubtractImmediate(instruction, &rd, &rn, &immediate_8);
+      decoded->immediate = immediate_8;
+      break;
+    case THUMB_OPCODE_ADDS_I8:
+    case THUMB_OPCODE_MOVS_I8:
+    case THUMB_OPCODE_SUBS_I8:
+      ThumbOperandAddSubtractCompareMoveImmediate(instruction, &rd,
+                                                  &immediate_8);
+      decoded->immediate = immediate_8;
+      break;
+    case THUMB_OPCODE_CMP_I8:
+      ThumbOperandAddSubtractCompareMoveImmediate(instruction, &rn,
+                                                  &immediate_8);
+      decoded->immediate = immediate_8;
+      break;
+    case THUMB_OPCODE_ASRS_I5:
+    case THUMB_OPCODE_LSLS_I5:
+    case THUMB_OPCODE_LSRS_I5:
+      ThumbOperandShiftByImmediate(instruction, &rd, &rm, &immediate_8);
+      decoded->immediate = immediate_8;
+      break;
+    case THUMB_OPCODE_B_FWD:
+      ThumbOperandForwardBranch(instruction, &branch_offset_32);
+      decoded->immediate = branch_offset_32;
+      break;
+    case THUMB_OPCODE_B_REV:
+      ThumbOperandReverseBranch(instruction, &branch_offset_32);
+      decoded->immediate = branch_offset_32;
+      break;
+    case THUMB_OPCODE_B_FWD_COND:
+      ThumbOperandConditionalForwardBranch(instruction, &condition,
+                                           &branch_offset_32);
+      decoded->immediate = branch_offset_32;
+      break;
+    case THUMB_OPCODE_B_REV_COND:
+      ThumbOperandConditionalReverseBranch(instruction, &condition,
+                                           &branch_offset_32);
+      decoded->immediate = branch_offset_32;
+      break;
+    case THUMB_OPCODE_BL:
+      ThumbOperandBranchLink(instruction, &immediate_16);
+      decoded->immediate = immediate_16;
+      break;
+    case THUMB_OPCODE_BL_FWD:
+      ThumbOperandForwardBranchLink(instruction, &branch_offset_32);
+      decoded->immediate = branch_offset_32;
+      break;
+    case THUMB_OPCODE_BL_REV:
+      ThumbOperandReverseBranchLink(instruction, &branch_offset_32);
+      decoded->immediate = branch_offset_32;
+      break;
+    case THUMB_OPCODE_BX:
+      ThumbOperandBranchExchange(instruction, &rm);
+      break;
+    case THUMB_OPCODE_LDMIA:
+      ThumbOperandLoadStoreMultiple(instruction, &rn, &register_list);
+      if (register_list & (1u << rn)) {
+        decoded->handler = THUMB_HANDLER_LDMIA_NO_WRITEBACK;
+      }
+      decoded->immediate = register_list;
+      break;
+    case THUMB_OPCODE_STMIA:
+      ThumbOperandLoadStoreMultiple(instruction, &rn, &register_list);
+      decoded->immediate = register_list;
+      break;
+    case THUMB_OPCODE_LDR:
+    case THUMB_OPCODE_LDRB:
+    case THUMB_OPCODE_LDRH:
+    case THUMB_OPCODE_LDRSB:
+    case THUMB_OPCODE_LDRSH:
+    case THUMB_OPCODE_STR:
+    case THUMB_OPCODE_STRB:
+    case THUMB_OPCODE_STRH:
+      ThumbOperandLoadStoreRegisterOffset(instruction, &rd, &rn, &rm);
+      break;
+    case THUMB_OPCODE_LDR_I5:
+    case THUMB_OPCODE_STR_I5:
+      ThumbOperandLoadStoreWordImmediateOffset(instruction, &rd, &rn,
+                                               &immediate_8);
+      decoded->immediate = immediate_8;
+      break;
+    case THUMB_OPCODE_LDRB_I5:
+    case THUMB_OPCODE_STRB_I5:
+      ThumbOperandLoadStoreByteImmediateOffset(instruction, &rd, &rn,
+                                               &immediate_8);
+      decoded->immediate = immediate_8;
+      break;
+    case THUMB_OPCODE_LDRH_I5:
+    case THUMB_OPCODE_STRH_I5:
+      ThumbOperandLoadStoreHalfWordImmediateOffset(instruction, &rd, &rn,
+                                                   &immediate_8);
+      decoded->immediate = immediate_8;
+      break;
+    case THUMB_OPCODE_LDR_PC_OFFSET_I8:
+      ThumbOperandLoadPCRelative(instruction, &rd, &immediate_16);
+      decoded->immediate = immediate_16;
+      break;
+    case THUMB_OPCODE_LDR_SP_OFFSET_I8:
+    case THUMB_OPCODE_STR_SP_OFFSET_I8:
+      ThumbOperandLoadStoreSPRelative(instruction, &rd, &immediate_16);
+      decoded->immediate = immediate_16;
+      break;
+    case THUMB_OPCODE_POP:
+      ThumbOperandPopRegisterList(instruction, &register_list);
+      decoded->immediate = register_list;
+      break;
+    case THUMB_OPCODE_PUSH:
+      ThumbOperandPushRegisterList(instruction, &register_list);
+      decoded->immediate = register_list;
+      break;
+    case THUMB_OPCODE_SWI:
+      break;
+    default:
+      codegen_assert(false);
+    case THUMB_OPCODE_UNDEF:
+      break;
+  }
+
+  decoded->rd = rd;
+  decoded->rn = rn;
+  if (opcode == THUMB_OPCODE_B_FWD_COND || opcode == THUMB_OPCODE_B_REV_COND) {
+    decoded->condition = condition;
+  } else {
+    decoded->rm = rm;
+  }
+}
+
+static void ThumbThreadedBuildTable() {
+  for (uint32_t i = 0u; i < THUMB_NUM_ENCODINGS; i++) {
+    ThumbThreadedDecode(i, &thumb_instructions[i]);
+  }
+}
+
+void ThumbThreadedInitialize() {
+  pthread_once(&thumb_instructions_once, ThumbThreadedBuildTable);
+}
+
+// Each handler ends in its own copy of this dispatch sequence so that the
+// indirect jump to the next handler is predicted separately for every handler.
+#define THUMB_THREADED_DISPATCH()                                         \
+  do {                                                                    \
+    if (registers->execution_control.mode != 1u ||                        \
+        *cycles_to_run <= cycles_executed) {                              \
+      return cycles_executed;                                             \
+    }                                                                     \
+    codegen_assert(registers->current.user.cpsr.thumb);                   \
+    cycles_executed += 1u;                                                \
+    uint16_t next_instruction;                                            \
+    if (!Load16LE(memory, ArmCurrentInstruction(registers),               \
+                  &next_instruction)) {                                   \
+      ArmExceptionPrefetchABT(registers);                                 \
+      return cycles_executed;                                             \
+    }                                                                     \
+    next = &thumb_instructions[next_instruction];                         \
+    goto *handlers[next->handler];                                        \
+  } while (0)
+
+uint32_t ThumbThreadedExecute(ArmAllRegisters *registers, Memory *memory,
+                              const uint32_t *cycles_to_run,
+                              uint32_t cycles_executed) {
+  static const void *const handlers[THUMB_NUM_HANDLERS] = {
+      [THUMB_OPCODE_ADCS] = &&adcs,
+      [THUMB_OPCODE_ADD_ANY] = &&add_any,
+      [THUMB_OPCODE_ADD_PC] = &&add_pc,
+      [THUMB_OPCODE_ADD_SP] = &&add_sp,
+      [THUMB_OPCODE_ADD_SP_I7] = &&add_sp_i7,
+      [THUMB_OPCODE_ADDS] = &&adds,
+      [THUMB_OPCODE_ADDS_I3] = &&adds_i3,
+      [THUMB_OPCODE_ADDS_I8] = &&adds_i8,
+      [THUMB_OPCODE_ANDS] = &&ands,
+      [THUMB_OPCODE_ASRS] = &&asrs,
+      [THUMB_OPCODE_ASRS_I5] = &&asrs_i5,
+      [THUMB_OPCODE_B_FWD] = &&b,
+      [THUMB_OPCODE_B_FWD_COND] = &&b_cond,
+      [THUMB_OPCODE_B_REV] = &&b,
+      [THUMB_OPCODE_B_REV_COND] = &&b_cond,
+      [THUMB_OPCODE_BICS] = &&bics,
+      [THUMB_OPCODE_BL] = &&bl,
+      [THUMB_OPCODE_BL_FWD] = &&bl_prefix,
+      [THUMB_OPCODE_BL_REV] = &&bl_prefix,
+      [THUMB_OPCODE_BX] = &&bx,
+      [THUMB_OPCODE_CMN] = &&cmn,
+      [THUMB_OPCODE_CMP] = &&cmp,
+      [THUMB_OPCODE_CMP_I8] = &&cmp_i8,
+      [THUMB_OPCODE_CMP_ANY] = &&cmp,
+      [THUMB_OPCODE_EORS] = &&eors,
+      [THUMB_OPCODE_LDMIA] = &&ldmia,
+      [THUMB_OPCODE_LDR] = &&ldr,
+      [THUMB_OPCODE_LDR_I5] = &&ldr_i,
+      [THUMB_OPCODE_LDR_PC_OFFSET_I8] = &&ldr_pc_offset_i8,
+      [THUMB_OPCODE_LDR_SP_OFFSET_I8] = &&ldr_sp_offset_i8,
+      [THUMB_OPCODE_LDRB] = &&ldrb,
+      [THUMB_OPCODE_LDRB_I5] = &&ldrb_i,
+      [THUMB_OPCODE_LDRH] = &&ldrh,
+      [THUMB_OPCODE_LDRH_I5] = &&ldrh_i,
+      [THUMB_OPCODE_LDRSB] = &&ldrsb,
+      [THUMB_OPCODE_LDRSH] = &&ldrsh,
+      [THUMB_OPCODE_LSLS] = &&lsls,
+      [THUMB_OPCODE_LSLS_I5] = &&lsls_i5,
+      [THUMB_OPCODE_LSRS] = &&lsrs,
+      [THUMB_OPCODE_LSRS_I5] = &&lsrs_i5,
+      [THUMB_OPCODE_MOV_ANY] = &&mov_any,
+      [THUMB_OPCODE_MOVS_I8] = &&movs_i8,
+      [THUMB_OPCODE_MULS] = &&muls,
+      [THUMB_OPCODE_MVNS] = &&mvns,
+      [THUMB_OPCODE_NEGS] = &&negs,
+      [THUMB_OPCODE_ORRS] = &&orrs,
+      [THUMB_OPCODE_POP] = &&pop,
+      [THUMB_OPCODE_PUSH] = &&push,
+      [THUMB_OPCODE_RORS] = &&rors,
+      [THUMB_OPCODE_SBCS] = &&sbcs,
+      [THUMB_OPCODE_STMIA] = &&stmia,
+      [THUMB_OPCODE_STR] = &&str,
+      [THUMB_OPCODE_STR_I5] = &&str_i,
+      [THUMB_OPCODE_STR_SP_OFFSET_I8] = &&str_sp_offset_i8,
+      [THUMB_OPCODE_STRB] = &&strb,
+      [THUMB_OPCODE_STRB_I5] = &&strb_i,
+      [THUMB_OPCODE_STRH] = &&strh,
+      [THUMB_OPCODE_STRH_I5] = &&strh_i,
+      [THUMB_OPCODE_SUB_SP_I7] = &&sub_sp_i7,
+      [THUMB_OPCODE_SUBS] = &&subs,
+      [THUMB_OPCODE_SUBS_I3] = &&subs_i3,
+      [THUMB_OPCODE_SUBS_I8] = &&subs_i8,
+      [THUMB_OPCODE_SWI] = &&swi,
+      [THUMB_OPCODE_TST] = &&tst,
+      [THUMB_OPCODE_UNDEF] = &&undef,
+      [THUMB_HANDLER_LDMIA_NO_WRITEBACK] = &&ldmia_no_writeback,
+  };
+
+  uint32_t *gprs = registers->current.user.gprs.gprs;
+  const ThumbThreadedInstruction *next;
+
+  THUMB_THREADED_DISPATCH();
+
+adcs:
+  ArmADCS(registers, next->rd, gprs[next->rd], gprs[next->rm]);
+  THUMB_THREADED_DISPATCH();
+
+add_any:
+  ArmADD(registers, next->rd, gprs[next->rd], gprs[next->rm]);
+  THUMB_THREADED_DISPATCH();
+
+add_pc:
+  ArmADD(registers, next->rd, gprs[REGISTER_R15] & 0xFFFFFFFCu,
+         next->immediate);
+  THUMB_THREADED_DISPATCH();
+
+add_sp:
+  ArmADD(registers, next->rd, gprs[REGISTER_R13], next->immediate);
+  THUMB_THREADED_DISPATCH();
+
+add_sp_i7:
+  ArmADD(registers, REGISTER_R13, gprs[REGISTER_R13], next->immediate);
+  THUMB_THREADED_DISPATCH();
+
+adds:
+  ArmADDSLazy(registers, next->rd, gprs[next->rn], gprs[next->rm]);
+  THUMB_THREADED_DISPATCH();
+
+adds_i3:
+  ArmADDSLazy(registers, next->rd, gprs[next->rn], next->immediate);
+  THUMB_THREADED_DISPATCH();
+
+adds_i8:
+  ArmADDSLazy(registers, next->rd, gprs[next->rd], next->immediate);
+  THUMB_THREADED_DISPATCH();
+
+ands:
+  ArmANDSLazy(registers, next->rd, gprs[next->rd], gprs[next->rm],
+              ArmCarryFlag(registers));
+  THUMB_THREADED_DISPATCH();
+
+asrs:
+  ThumbASRS_R(registers, next->rd, next->rm);
+  THUMB_THREADED_DISPATCH();
+
+asrs_i5:
+  ThumbASRS_I(registers, next->rd, next->rm, next->immediate);
+  THUMB_THREADED_DISPATCH();
+
+b:
+  ArmB(registers, next->immediate);
+  THUMB_THREADED_DISPATCH();
+
+b_cond:
+  ArmMaterializeFlags(registers);
+  if (ThumbShouldBranch(registers->current.user.cpsr, next->condition)) {
+    ArmB(registers, next->immediate);
+  } else {
+    ArmAdvanceProgramCounter(registers);
+  }
+  THUMB_THREADED_DISPATCH();
+
+bics:
+  ArmBICSLazy(registers, next->rd, gprs[next->rd], gprs[next->rm],
+              ArmCarryFlag(registers));
+  THUMB_THREADED_DISPATCH();
+
+bl:
+  ThumbBL2(registers, next->immediate);
+  THUMB_THREADED_DISPATCH();
+
+bl_prefix:
+  ThumbBL1(registers, next->immediate);
+  THUMB_THREADED_DISPATCH();
+
+bx:
+  ArmBX(registers, next->rm);
+  THUMB_THREADED_DISPATCH();
+
+cmn:
+  ArmCMNLazy(registers, REGISTER_R0, gprs[next->rn], gprs[next->rm]);
+  THUMB_THREADED_DISPATCH();
+
+cmp:
+  ArmCMPLazy(registers, REGISTER_R0, gprs[next->rn], gprs[next->rm]);
+  THUMB_THREADED_DISPATCH();
+
+cmp_i8:
+  ArmCMPLazy(registers, REGISTER_R0, gprs[next->rn], next->immediate);
+  THUMB_THREADED_DISPATCH();
+
+eors:
+  ArmEORSLazy(registers, next->rd, gprs[next->rd], gprs[next->rm],
+              ArmCarryFlag(registers));
+  THUMB_THREADED_DISPATCH();
+
+ldmia:
+  ArmLDMIAW(registers, memory, next->rn, next->immediate);
+  THUMB_THREADED_DISPATCH();
+
+ldmia_no_writeback:
+  ArmLDMIA(registers, memory, next->rn, next->immediate);
+  THUMB_THREADED_DISPATCH();
+
+ldr:
+  ArmLDR_IB(registers, memory, next->rd, next->rn, gprs[next->rm]);
+  THUMB_THREADED_DISPATCH();
+
+ldr_i:
+  ArmLDR_IB(registers, memory, next->rd, next->rn, next->immediate);
+  THUMB_THREADED_DISPATCH();
+
+ldr_pc_offset_i8:
+  ThumbLDR_PC_IB(registers, memory, next->rd, next->immediate);
+  THUMB_THREADED_DISPATCH();
+
+ldr_sp_offset_i8:
+  ArmLDR_IB(registers, memory, next->rd, REGISTER_R13, next->immediate);
+  THUMB_THREADED_DISPATCH();
+
+ldrb:
+  ArmLDRB_IB(registers, memory, next->rd, next->rn, gprs[next->rm]);
+  THUMB_THREADED_DISPATCH();
+
+ldrb_i:
+  ArmLDRB_IB(registers, memory, next->rd, next->rn, next->immediate);
+  THUMB_THREADED_DISPATCH();
+
+ldrh:
+  ArmLDRH_IB(registers, memory, next->rd, next->rn, gprs[next->rm]);
+  THUMB_THREADED_DISPATCH();
+
+ldrh_i:
+  ArmLDRH_IB(registers, memory, next->rd, next->rn, next->immediate);
+  THUMB_THREADED_DISPATCH();
+
+ldrsb:
+  ArmLDRSB_IB(registers, memory, next->rd, next->rn, gprs[next->rm]);
+  THUMB_THREADED_DISPATCH();
+
+ldrsh:
+  ArmLDRSH_IB(registers, memory, next->rd, next->rn, gprs[next->rm]);
+  THUMB_THREADED_DISPATCH();
+
+lsls:
+  ThumbLSLS_R(registers, next->rd, next->rm);
+  THUMB_THREADED_DISPATCH();
+
+lsls_i5:
+  ThumbLSLS_I(registers, next->rd, next->rm, next->immediate);
+  THUMB_THREADED_DISPATCH();
+
+lsrs:
+  ThumbLSRS_R(registers, next->rd, next->rm);
+  THUMB_THREADED_DISPATCH();
+
+lsrs_i5:
+  ThumbLSRS_I(registers, next->rd, next->rm, next->immediate);
+  THUMB_THREADED_DISPATCH();
+
+mov_any:
+  ArmMOV(registers, next->rd, gprs[next->rm]);
+  THUMB_THREADED_DISPATCH();
+
+movs_i8:
+  ArmMOVSLazy(registers, next->rd, next->immediate, ArmCarryFlag(registers));
+  THUMB_THREADED_DISPATCH();
+
+muls:
+  ArmMULS(registers, next->rd, next->rd, next->rm);
+  THUMB_THREADED_DISPATCH();
+
+mvns:
+  ArmMVNSLazy(registers, next->rd, gprs[next->rm], ArmCarryFlag(registers));
+  THUMB_THREADED_DISPATCH();
+
+negs:
+  ArmRSBSLazy(registers, next->rd, gprs[next->rm], 0u);
+  THUMB_THREADED_DISPATCH();
+
+orrs:
+  ArmORRSLazy(registers, next->rd, gprs[next->rd], gprs[next->rm],
+              ArmCarryFlag(registers));
+  THUMB_THREADED_DISPATCH();
+
+pop:
+  ThumbPOP(registers, memory, next->immediate);
+  THUMB_THREADED_DISPATCH();
+
+push:
+  ThumbPUSH(registers, memory, next->immediate);
+  THUMB_THREADED_DISPATCH();
+
+rors:
+  ThumbRORS(registers, next->rd, next->rm);
+  THUMB_THREADED_DISPATCH();
+
+sbcs:
+  ArmSBCS(registers, next->rd, gprs[next->rd], gprs[next->rm]);
+  THUMB_THREADED_DISPATCH();
+
+stmia:
+  ArmSTMIAW(registers, memory, next->rn, next->immediate);
+  THUMB_THREADED_DISPATCH();
+
+str:
+  ArmSTR_IB(registers, memory, next->rd, next->rn, gprs[next->rm]);
+  THUMB_THREADED_DISPATCH();
+
+str_i:
+  ArmSTR_IB(registers, memory, next->rd, next->rn, next->immediate);
+  THUMB_THREADED_DISPATCH();
+
+str_sp_offset_i8:
+  ArmSTR_IB(registers, memory, next->rd, REGISTER_R13, next->immediate);
+  THUMB_THREADED_DISPATCH();
+
+strb:
+  ArmSTRB_IB(registers, memory, next->rd, next->rn, gprs[next->rm]);
+  THUMB_THREADED_DISPATCH();
+
+strb_i:
+  ArmSTRB_IB(registers, memory, next->rd, next->rn, next->immediate);
+  THUMB_THREADED_DISPATCH();
+
+strh:
+  ArmSTRH_IB(registers, memory, next->rd, next->rn, gprs[next->rm]);
+  THUMB_THREADED_DISPATCH();
+
+strh_i:
+  ArmSTRH_IB(registers, memory, next->rd, next->rn, next->immediate);
+  THUMB_THREADED_DISPATCH();
+
+sub_sp_i7:
+  ArmSUB(registers, REGISTER_R13, gprs[REGISTER_R13], next->immediate);
+  THUMB_THREADED_DISPATCH();
+
+subs:
+  ArmSUBSLazy(registers, next->rd, gprs[next->rn], gprs[next->rm]);
+  THUMB_THREADED_DISPATCH();
+
+subs_i3:
+  ArmSUBSLazy(registers, next->rd, gprs[next->rn], next->immediate);
+  THUMB_THREADED_DISPATCH();
+
+subs_i8:
+  ArmSUBSLazy(registers, next->rd, gprs[next->rd], next->immediate);
+  THUMB_THREADED_DISPATCH();
+
+swi:
+  ArmSWI(registers);
+  THUMB_THREADED_DISPATCH();
+
+tst:
+  ArmTSTLazy(registers, REGISTER_R0, gprs[next->rn], gprs[next->rm],
+             ArmCarryFlag(registers));
+  THUMB_THREADED_DISPATCH();
+
+undef:
+  ArmExceptionUND(registers);
+  THUMB_THREADED_DISPATCH();
+}
@@ -0,0 +1,25 @@
+#ifndef _WEBGBA_EMULATOR_CPU_ARM7TDMI_DECODERS_THUMB_THREADED_
+#define _WEBGBA_EMULATOR_CPU_ARM7TDMI_DECODERS_THUMB_THREADED_
+
+#include <stdint.h>
+
+#include "emulator/cpu/arm7tdmi/registers.h"
+#include "emulator/memory/memory.h"
+
+// Alternate Thumb interpreter core which predecodes every one of the 65,536
+// possible Thumb encodings into a handler and its operands and then dispatches
+// between handlers with computed gotos instead of a single central switch.
+//
+// ThumbThreadedInitialize must be called at least once before the first call
+// to ThumbThreadedExecute. It is safe to call from multiple threads.
+void ThumbThreadedInitialize();
+
+// Executes instructions until the processor leaves Thumb mode, an interrupt
+// becomes pending, an instruction fetch aborts, or cycles_executed reaches the
+// value pointed to by cycles_to_run. Since instructions may halt the processor
+// the value pointed to by cycles_to_run is reloaded after every instruction.
+uint32_t ThumbThreadedExecute(ArmAllRegisters *registers, Memory *memory,
+                              const uint32_t *cycles_to_run,
+                              uint32_t cycles_executed);
+
+#endif  // _WEBGBA_EMULATOR_CPU_ARM7TDMI_DECODERS_THUMB_THREADED_
@@ -0,0 +1,169 @@
+extern "C" {
+#include "emulator/cpu/arm7tdmi/decoders/thumb/execute.h"
+#include "emulator/cpu/arm7tdmi/decoders/thumb/threaded.h"
+}
+
+#include <cstring>
+#include <tuple>
+#include <vector>
+
+#include "googletest/include/gtest/gtest.h"
+
+class ThreadedTest : public testing::Test {
+ public:
+  static void SetUpTestSuite() { ThumbThreadedInitialize(); }
+
+  void SetUp() override {
+    memory_ = MemoryAllocate(nullptr, Load32LE, Load16LE, Load8, Store32LE,
+                             Store16LE, Store8, nullptr);
+    ASSERT_NE(nullptr, memory_);
+
+    memset(&registers_, 0, sizeof(ArmAllRegisters));
+    registers_.current.user.cpsr.mode = MODE_SVC;
+    registers_.current.user.cpsr.thumb = true;
+    registers_.current.spsr.mode = MODE_USR;
+    for (uint32_t i = 0u; i < 13u; i++) {
+      registers_.current.user.gprs.gprs[i] = 0x03000000u + i * 0x104u;
+    }
+    registers_.current.user.gprs.sp = 0x03007F00u;
+    registers_.current.user.gprs.lr = 0x08000200u;
+    registers_.current.user.gprs.pc = 0x08000108u;
+    registers_.execution_control.thumb = true;
+
+    fetch_address_ = ArmCurrentInstruction(&registers_);
+    fetch_fails_ = false;
+    stores_.clear();
+  }
+
+  void TearDown() override { MemoryFree(memory_); }
+
+ protected:
+  typedef std::tuple<uint32_t, uint32_t, uint32_t> StoreRecord;
+
+  static uint32_t ValueAt(uint32_t address) {
+    return ((address * 0x9E3779B1u) ^ (address >> 7u)) & 0xFFFFFFFCu;
+  }
+
+  static bool Load32LE(const void *context, uint32_t address, uint32_t *value) {
+    *value = ValueAt(address);
+    return true;
+  }
+
+  static bool Load16LE(const void *context, uint32_t address, uint16_t *value) {
+    if (address == fetch_address_) {
+      *value = instruction_;
+      return !fetch_fails_;
+    }
+    *value = ValueAt(address);
+    return true;
+  }
+
+  static bool Load8(const void *context, uint32_t address, uint8_t *value) {
+    *value = ValueAt(address);
+    return true;
+  }
+
+  static bool Store32LE(void *context, uint32_t address, uint32_t value) {
+    stores_.emplace_back(address, value, 32u);
+    return true;
+  }
+
+  static bool Store16LE(void *context, uint32_t address, uint16_t value) {
+    stores_.emplace_back(address, value, 16u);
+    return true;
+  }
+
+  static bool Store8(void *context, uint32_t address, uint8_t value) {
+    stores_.emplace_back(address, value, 8u);
+    if (halt_on_store_ != nullptr) {
+      *halt_on_store_ = 0u;
+    }
+    return true;
+  }
+
+  static uint16_t instruction_;
+  static uint32_t fetch_address_;
+  static bool fetch_fails_;
+  static uint32_t *halt_on_store_;
+  static std::vector<StoreRecord> stores_;
+  ArmAllRegisters registers_;
+  Memory *memory_;
+};
+
+uint16_t ThreadedTest::instruction_ = 0u;
+uint32_t ThreadedTest::fetch_address_ = 0u;
+bool ThreadedTest::fetch_fails_ = false;
+uint32_t *ThreadedTest::halt_on_store_ = nullptr;
+std::vector<ThreadedTest::StoreRecord> ThreadedTest::stores_;
+
+TEST_F(ThreadedTest, MatchesExecute) {
+  for (uint32_t flags = 0u; flags < 16u; flags += 5u) {
+    registers_.current.user.cpsr.negative = flags & 8u;
+    registers_.current.user.cpsr.zero = flags & 4u;
+    registers_.current.user.cpsr.carry = flags & 2u;
+    registers_.current.user.cpsr.overflow = flags & 1u;
+
+    for (uint32_t i = 0u; i <= UINT16_MAX; i++) {
+      instruction_ = i;
+
+      ArmAllRegisters expected_registers = registers_;
+      stores_.clear();
+      ThumbInstructionExecute(i, &expected_registers, memory_);
+      std::vector<StoreRecord> expected_stores = stores_;
+
+      ArmAllRegisters actual_registers = registers_;
+      stores_.clear();
+      uint32_t cycles_to_run = 1u;
+      EXPECT_EQ(1u, ThumbThreadedExecute(&actual_registers, memory_,
+                                         &cycles_to_run, 0u));
+
+      ASSERT_EQ(0, memcmp(&expected_registers, &actual_registers,
+                          sizeof(ArmAllRegisters)))
+          << "instruction " << i << " flags " << flags;
+      ASSERT_EQ(expected_stores, stores_)
+          << "instruction " << i << " flags " << flags;
+    }
+  }
+}
+
+TEST_F(ThreadedTest, RunsUntilCyclesExhausted) {
+  instruction_ = 0xE7FEu;  // b .
+  uint32_t cycles_to_run = 100u;
+  EXPECT_EQ(100u,
+            ThumbThreadedExecute(&registers_, memory_, &cycles_to_run, 10u));
+  EXPECT_EQ(0x08000108u, registers_.current.user.gprs.pc);
+}
+
+TEST_F(ThreadedTest, StopsOnHalt) {
+  instruction_ = 0x7000u;  // strb r0, [r0, #0]
+  uint32_t cycles_to_run = 100u;
+  halt_on_store_ = &cycles_to_run;
+  EXPECT_EQ(1u, ThumbThreadedExecute(&registers_, memory_, &cycles_to_run, 0u));
+  EXPECT_EQ(1u, stores_.size());
+  halt_on_store_ = nullptr;
+}
+
+TEST_F(ThreadedTest, StopsOnModeChange) {
+  instruction_ = 0x4700u;  // bx r0
+  registers_.current.user.gprs.r0 = 0x08000000u;
+  uint32_t cycles_to_run = 100u;
+  EXPECT_EQ(1u, ThumbThreadedExecute(&registers_, memory_, &cycles_to_run, 0u));
+  EXPECT_FALSE(registers_.current.user.cpsr.thumb);
+  EXPECT_EQ(0u, registers_.execution_control.mode);
+}
+
+TEST_F(ThreadedTest, StopsOnPendingInterrupt) {
+  instruction_ = 0xE7FEu;  // b .
+  registers_.execution_control.irq = true;
+  uint32_t cycles_to_run = 100u;
+  EXPECT_EQ(5u, ThumbThreadedExecute(&registers_, memory_, &cycles_to_run, 5u));
+}
+
+TEST_F(ThreadedTest, PrefetchAbort) {
+  instruction_ = 0xE7FEu;  // b .
+  fetch_fails_ = true;
+  uint32_t cycles_to_run = 100u;
+  EXPECT_EQ(1u, ThumbThreadedExecute(&registers_, memory_, &cycles_to_run, 0u));
+  EXPECT_EQ(MODE_ABT, registers_.current.user.cpsr.mode);
+  EXPECT_FALSE(registers_.current.user.cpsr.thumb);
+}
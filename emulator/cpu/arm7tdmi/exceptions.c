@@ -3,6 +3,7 @@
 void ArmExceptionDataABT(ArmAllRegisters* registers) {
   uint32_t aborted_instruction = ArmCurrentInstruction(registers);
 
+  ArmMaterializeFlags(registers);
   ArmProgramStatusRegister old_cpsr = registers->current.user.cpsr;
   ArmProgramStatusRegister next_status = old_cpsr;
   next_status.mode = MODE_ABT;
@@ -19,6 +20,7 @@ void ArmExceptionDataABT(ArmAllRegisters* registers) {
 void ArmExceptionPrefetchABT(ArmAllRegisters* registers) {
   uint32_t aborted_instruction = ArmCurrentInstruction(registers);
 
+  ArmMaterializeFlags(registers);
   ArmProgramStatusRegister old_cpsr = registers->current.user.cpsr;
   ArmProgramStatusRegister next_status = old_cpsr;
   next_status.mode = MODE_ABT;
@@ -37,6 +39,7 @@ void ArmExceptionFIQ(ArmAllRegisters* registers) {
   // to by the program counter is actually the next instruction to be executed.
   uint32_t next_instruction = ArmCurrentInstruction(registers);
 
+  ArmMaterializeFlags(registers);
   ArmProgramStatusRegister old_cpsr = registers->current.user.cpsr;
   ArmProgramStatusRegister next_status = old_cpsr;
   next_status.mode = MODE_FIQ;
@@ -56,6 +59,7 @@ void ArmExceptionIRQ(ArmAllRegisters* registers) {
   // to by the program counter is actually the next instruction to be executed.
   uint32_t next_instruction = ArmCurrentInstruction(registers);
 
+  ArmMaterializeFlags(registers);
   ArmProgramStatusRegister old_cpsr = registers->current.user.cpsr;
   ArmProgramStatusRegister next_status = old_cpsr;
   next_status.mode = MODE_IRQ;
@@ -70,6 +74,7 @@ void ArmExceptionIRQ(ArmAllRegisters* registers) {
 }
 
 void ArmExceptionRST(ArmAllRegisters* registers) {
+  ArmMaterializeFlags(registers);
   ArmProgramStatusRegister old_cpsr = registers->current.user.cpsr;
   ArmProgramStatusRegister next_status = old_cpsr;
   next_status.mode = MODE_SVC;
@@ -84,6 +89,7 @@ void ArmExceptionRST(ArmAllRegisters* registers) {
 void ArmExceptionSWI(ArmAllRegisters* registers) {
   uint32_t next_instruction = ArmNextInstruction(registers);
 
+  ArmMaterializeFlags(registers);
   ArmProgramStatusRegister old_cpsr = registers->current.user.cpsr;
   ArmProgramStatusRegister next_status = old_cpsr;
   next_status.mode = MODE_SVC;
@@ -100,6 +106,7 @@ void ArmExceptionSWI(ArmAllRegisters* registers) {
 void ArmExceptionUND(ArmAllRegisters* registers) {
   uint32_t next_instruction = ArmNextInstruction(registers);
 
+  ArmMaterializeFlags(registers);
   ArmProgramStatusRegister old_cpsr = registers->current.user.cpsr;
   ArmProgramStatusRegister next_status = old_cpsr;
   next_status.mode = MODE_UND;
@@ -1,6 +1,7 @@
 #include "emulator/cpu/arm7tdmi/instructions/block_data_transfer.h"
 
 #include <assert.h>
+#include <stddef.h>
 
 #include "emulator/cpu/arm7tdmi/exceptions.h"
 #include "emulator/cpu/arm7tdmi/instructions/address_mode.h"
@@ -54,15 +55,25 @@ static inline void ArmLDM(ArmAllRegisters *registers, const Memory *memory,
 
     uint_fast16_t register_list_mutable = register_list;
 
-    bool success;
+    // Transfers contained in a single memory bank cannot abort
+    const uint32_t *block =
+        MemoryGetReadRange(memory, load_address & 0xFFFFFFFCu, size);
+
+    bool success = true;
     int i;
-    while (NextRegister(&register_list_mutable, &i)) {
-      success = ArmLoad32LE(memory, load_address,
-                            &registers->current.user.gprs.gprs[i]);
-      if (!success) {
-        break;
+    if (block != NULL) {
+      while (NextRegister(&register_list_mutable, &i)) {
+        registers->current.user.gprs.gprs[i] = *block++;
+      }
+    } else {
+      while (NextRegister(&register_list_mutable, &i)) {
+        success = ArmLoad32LE(memory, load_address,
+                              &registers->current.user.gprs.gprs[i]);
+        if (!success) {
+          break;
+        }
+        load_address += 4u;
       }
-      load_address += 4u;
     }
 
     writeback = writeback && (register_list & (1u << Rn)) == 0u;
@@ -122,6 +133,7 @@ static inline void ArmLDMS(ArmAllRegisters *registers, const Memory *memory,
   bool load_spsr = load_pc && mode_has_spsr;
   bool load_usr_mode = !load_spsr && mode_has_spsr;
 
+  ArmMaterializeFlags(registers);
   ArmProgramStatusRegister original_cpsr = registers->current.user.cpsr;
   if (load_usr_mode) {
     ArmProgramStatusRegister temporary_cpsr = registers->current.user.cpsr;
@@ -359,6 +371,10 @@ static inline void ArmSTM(ArmAllRegisters *registers, Memory *memory,
 
     uint_fast16_t register_list_mutable = register_list;
 
+    // Transfers contained in a single memory bank cannot abort
+    uint32_t *block =
+        MemoryGetWriteRange(memory, load_address & 0xFFFFFFFCu, size);
+
     bool success = true;
     int i;
     while (NextRegister(&register_list_mutable, &i)) {
@@ -389,6 +405,11 @@ static inline void ArmSTM(ArmAllRegisters *registers, Memory *memory,
         }
       }
 
+      if (block != NULL) {
+        *block++ = value;
+        continue;
+      }
+
       success = ArmStore32LE(memory, load_address, value);
       if (!success) {
         break;
@@ -459,6 +480,7 @@ static inline void ArmSTMS(ArmAllRegisters *registers, Memory *memory,
   bool change_to_usr = registers->current.user.cpsr.mode != MODE_USR ||
                        registers->current.user.cpsr.mode != MODE_SYS;
 
+  ArmMaterializeFlags(registers);
   ArmProgramStatusRegister original_cpsr = registers->current.user.cpsr;
   if (change_to_usr) {
     ArmProgramStatusRegister temporary_cpsr = registers->current.user.cpsr;
@@ -1678,7 +1678,7 @@ TEST_P(StmTest, SvcArmSTMSDA) {
 
 TEST_P(StmTest, SvcArmSTMSDB) {
   registers_.current.user.gprs.r0 = 0x140u;
-  registers_.current.user.cpsr.mode = MODE_SVC;
+  registers_.current.user.cpsr.mode = MODE_USR;
   ArmProgramStatusRegister new_status = registers_.current.user.cpsr;
   new_status.mode = MODE_SVC;
   ArmLoadCPSR(&registers_, new_status);
@@ -1697,7 +1697,7 @@ TEST_P(StmTest, SvcArmSTMSDAW) {
   }
 
   registers_.current.user.gprs.r0 = 0x13Cu;
-  registers_.current.user.cpsr.mode = MODE_SVC;
+  registers_.current.user.cpsr.mode = MODE_USR;
   ArmProgramStatusRegister new_status = registers_.current.user.cpsr;
   new_status.mode = MODE_SVC;
   ArmLoadCPSR(&registers_, new_status);
@@ -1724,7 +1724,7 @@ TEST_P(StmTest, SvcArmSTMSDBW) {
   }
 
   registers_.current.user.gprs.r0 = 0x140u;
-  registers_.current.user.cpsr.mode = MODE_SVC;
+  registers_.current.user.cpsr.mode = MODE_USR;
   ArmProgramStatusRegister new_status = registers_.current.user.cpsr;
   new_status.mode = MODE_SVC;
   ArmLoadCPSR(&registers_, new_status);
@@ -1747,7 +1747,7 @@ TEST_P(StmTest, SvcArmSTMSDBW) {
 
 TEST_P(StmTest, SvcArmSTMSIA) {
   registers_.current.user.gprs.r0 = 0x100u;
-  registers_.current.user.cpsr.mode = MODE_SVC;
+  registers_.current.user.cpsr.mode = MODE_USR;
   ArmProgramStatusRegister new_status = registers_.current.user.cpsr;
   new_status.mode = MODE_SVC;
   ArmLoadCPSR(&registers_, new_status);
@@ -1762,7 +1762,7 @@ TEST_P(StmTest, SvcArmSTMSIA) {
 
 TEST_P(StmTest, SvcArmSTMSIB) {
   registers_.current.user.gprs.r0 = 0xFCu;
-  registers_.current.user.cpsr.mode = MODE_SVC;
+  registers_.current.user.cpsr.mode = MODE_USR;
   ArmProgramStatusRegister new_status = registers_.current.user.cpsr;
   new_status.mode = MODE_SVC;
   ArmLoadCPSR(&registers_, new_status);
@@ -1781,7 +1781,7 @@ TEST_P(StmTest, SvcArmSTMSIAW) {
   }
 
   registers_.current.user.gprs.r0 = 0x100u;
-  registers_.current.user.cpsr.mode = MODE_SVC;
+  registers_.current.user.cpsr.mode = MODE_USR;
   ArmProgramStatusRegister new_status = registers_.current.user.cpsr;
   new_status.mode = MODE_SVC;
   ArmLoadCPSR(&registers_, new_status);
@@ -1807,7 +1807,7 @@ TEST_P(StmTest, SvcArmSTMSIBW) {
   }
 
   registers_.current.user.gprs.r0 = 0xFCu;
-  registers_.current.user.cpsr.mode = MODE_SVC;
+  registers_.current.user.cpsr.mode = MODE_USR;
   ArmProgramStatusRegister new_status = registers_.current.user.cpsr;
   new_status.mode = MODE_SVC;
   ArmLoadCPSR(&registers_, new_status);
@@ -2395,3 +2395,117 @@ INSTANTIATE_TEST_SUITE_P(MemoryFailsTestModule, MemoryFailsTest,
                          testing::Range(std::numeric_limits<uint16_t>::min(),
                                         std::numeric_limits<uint16_t>::max(),
                                         51u));
+
+class BankedMemoryTest : public testing::Test {
+ public:
+  void SetUp() override {
+    registers_ = CreateArmAllRegisters();
+    memory_bank_ = MemoryBankAllocate(0x200u, 1u, nullptr);
+    ASSERT_NE(nullptr, memory_bank_);
+    ASSERT_TRUE(MemoryBankTrackWrites(memory_bank_, 0x100u));
+    memory_ = MemoryAllocateWithBanks(nullptr, &memory_bank_, 1u, Load32LE,
+                                      Load16LE, Load8, Store32LE, Store16LE,
+                                      Store8, nullptr);
+    ASSERT_NE(nullptr, memory_);
+  }
+
+  void TearDown() override { MemoryFree(memory_); }
+
+ protected:
+  static bool Load32LE(const void *context, uint32_t address, uint32_t *value) {
+    EXPECT_FALSE(true);
+    return false;
+  }
+
+  static bool Load16LE(const void *context, uint32_t address, uint16_t *value) {
+    EXPECT_FALSE(true);
+    return false;
+  }
+
+  static bool Load8(const void *context, uint32_t address, uint8_t *value) {
+    EXPECT_FALSE(true);
+    return false;
+  }
+
+  static bool Store32LE(void *context, uint32_t address, uint32_t value) {
+    EXPECT_FALSE(true);
+    return false;
+  }
+
+  static bool Store16LE(void *context, uint32_t address, uint16_t value) {
+    EXPECT_FALSE(true);
+    return false;
+  }
+
+  static bool Store8(void *context, uint32_t address, uint8_t value) {
+    EXPECT_FALSE(true);
+    return false;
+  }
+
+  ArmAllRegisters registers_;
+  MemoryBank *memory_bank_;
+  Memory *memory_;
+};
+
+TEST_F(BankedMemoryTest, ArmSTMDBWThenLDMIAW) {
+  uint32_t first = MemoryBankPageGeneration(memory_bank_, 0x0u);
+  uint32_t second = MemoryBankPageGeneration(memory_bank_, 0x100u);
+
+  registers_.current.user.gprs.r0 = 1u;
+  registers_.current.user.gprs.r1 = 2u;
+  registers_.current.user.gprs.r2 = 3u;
+  registers_.current.user.gprs.r13 = 0x3000108u;
+  ArmSTMDBW(&registers_, memory_, REGISTER_R13, 0x7u);
+  EXPECT_EQ(0x30000FCu, registers_.current.user.gprs.r13);
+  EXPECT_EQ(4u, registers_.current.user.gprs.pc);
+  EXPECT_NE(first, MemoryBankPageGeneration(memory_bank_, 0x0u));
+  EXPECT_NE(second, MemoryBankPageGeneration(memory_bank_, 0x100u));
+
+  uint32_t value;
+  MemoryBankLoad32LE(memory_bank_, 0xFCu, &value);
+  EXPECT_EQ(1u, value);
+  MemoryBankLoad32LE(memory_bank_, 0x100u, &value);
+  EXPECT_EQ(2u, value);
+  MemoryBankLoad32LE(memory_bank_, 0x104u, &value);
+  EXPECT_EQ(3u, value);
+
+  registers_.current.user.gprs.r0 = 0u;
+  registers_.current.user.gprs.r1 = 0u;
+  registers_.current.user.gprs.r2 = 0u;
+  ArmLDMIAW(&registers_, memory_, REGISTER_R13, 0x7u);
+  EXPECT_EQ(1u, registers_.current.user.gprs.r0);
+  EXPECT_EQ(2u, registers_.current.user.gprs.r1);
+  EXPECT_EQ(3u, registers_.current.user.gprs.r2);
+  EXPECT_EQ(0x3000108u, registers_.current.user.gprs.r13);
+  EXPECT_EQ(8u, registers_.current.user.gprs.pc);
+}
+
+TEST_F(BankedMemoryTest, ArmSTMIAThenLDMIAWrapping) {
+  registers_.current.user.gprs.r0 = 0x30001FEu;
+  registers_.current.user.gprs.r1 = 1u;
+  registers_.current.user.gprs.r2 = 2u;
+  ArmSTMIA(&registers_, memory_, REGISTER_R0, 0x6u);
+  EXPECT_EQ(0x30001FEu, registers_.current.user.gprs.r0);
+
+  uint32_t value;
+  MemoryBankLoad32LE(memory_bank_, 0x1FCu, &value);
+  EXPECT_EQ(1u, value);
+  MemoryBankLoad32LE(memory_bank_, 0x0u, &value);
+  EXPECT_EQ(2u, value);
+
+  registers_.current.user.gprs.r1 = 0u;
+  registers_.current.user.gprs.r2 = 0u;
+  ArmLDMIA(&registers_, memory_, REGISTER_R0, 0x6u);
+  EXPECT_EQ(1u, registers_.current.user.gprs.r1);
+  EXPECT_EQ(2u, registers_.current.user.gprs.r2);
+}
+
+TEST_F(BankedMemoryTest, ArmLDMIAWIncludingBase) {
+  MemoryBankStore32LE(memory_bank_, 0x10u, 0x1234u);
+  MemoryBankStore32LE(memory_bank_, 0x14u, 0x5678u);
+
+  registers_.current.user.gprs.r0 = 0x2000010u;
+  ArmLDMIAW(&registers_, memory_, REGISTER_R0, 0x3u);
+  EXPECT_EQ(0x1234u, registers_.current.user.gprs.r0);
+  EXPECT_EQ(0x5678u, registers_.current.user.gprs.r1);
+}
\ No newline at end of file
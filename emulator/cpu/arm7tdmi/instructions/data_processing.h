@@ -6,6 +6,7 @@
 
 static inline uint64_t ArmADC(ArmAllRegisters *registers, ArmRegisterIndex Rd,
                               uint32_t operand1, uint32_t operand2) {
+  ArmMaterializeCarryFlag(registers);
   uint64_t sum = (uint64_t)operand1 + (uint64_t)operand2 +
                  (uint64_t)registers->current.user.cpsr.carry;
   ArmAdvanceProgramCounter(registers);
@@ -15,6 +16,7 @@ static inline uint64_t ArmADC(ArmAllRegisters *registers, ArmRegisterIndex Rd,
 
 static inline void ArmADCS(ArmAllRegisters *registers, ArmRegisterIndex Rd,
                            uint32_t operand1, uint32_t operand2) {
+  ArmMaterializeFlags(registers);
   if (Rd != REGISTER_R15) {
     int64_t sum_s = (int64_t)(int32_t)operand1 + (int64_t)(int32_t)operand2 +
                     (int64_t)registers->current.user.cpsr.carry;
@@ -41,6 +43,7 @@ static inline uint64_t ArmADD(ArmAllRegisters *registers, ArmRegisterIndex Rd,
 
 static inline void ArmADDS(ArmAllRegisters *registers, ArmRegisterIndex Rd,
                            uint32_t operand1, uint32_t operand2) {
+  ArmMaterializeFlags(registers);
   if (Rd != REGISTER_R15) {
     int64_t sum_s = (int64_t)(int32_t)operand1 + (int64_t)(int32_t)operand2;
     uint64_t sum = ArmADD(registers, Rd, operand1, operand2);
@@ -67,6 +70,7 @@ static inline uint32_t ArmAND(ArmAllRegisters *registers, ArmRegisterIndex Rd,
 static inline void ArmANDS(ArmAllRegisters *registers, ArmRegisterIndex Rd,
                            uint32_t operand1, uint32_t operand2,
                            bool operand2_carry) {
+  ArmMaterializeFlags(registers);
   if (Rd != REGISTER_R15) {
     uint32_t result = ArmAND(registers, Rd, operand1, operand2);
     registers->current.user.cpsr.negative = ArmNegativeFlagUInt32(result);
@@ -90,6 +94,7 @@ static inline uint32_t ArmBIC(ArmAllRegisters *registers, ArmRegisterIndex Rd,
 static inline void ArmBICS(ArmAllRegisters *registers, ArmRegisterIndex Rd,
                            uint32_t operand1, uint32_t operand2,
                            bool operand2_carry) {
+  ArmMaterializeFlags(registers);
   if (Rd != REGISTER_R15) {
     uint32_t result = ArmBIC(registers, Rd, operand1, operand2);
     registers->current.user.cpsr.negative = ArmNegativeFlagUInt32(result);
@@ -104,6 +109,7 @@ static inline void ArmBICS(ArmAllRegisters *registers, ArmRegisterIndex Rd,
 
 static inline void ArmCMN(ArmAllRegisters *registers, ArmRegisterIndex Rd,
                           uint32_t operand1, uint32_t operand2) {
+  ArmMaterializeFlags(registers);
   // ARM defines specifying any value for Rd other than R0 to be unpredictable
   if (Rd != REGISTER_R15) {
     uint64_t sum = (uint64_t)operand1 + (uint64_t)operand2;
@@ -122,6 +128,7 @@ static inline void ArmCMN(ArmAllRegisters *registers, ArmRegisterIndex Rd,
 
 static inline void ArmCMP(ArmAllRegisters *registers, ArmRegisterIndex Rd,
                           uint32_t operand1, uint32_t operand2) {
+  ArmMaterializeFlags(registers);
   // ARM defines specifying any value for Rd other than R0 to be unpredictable
   if (Rd != REGISTER_R15) {
     uint64_t difference = (uint64_t)operand1 - (uint64_t)operand2;
@@ -150,6 +157,7 @@ static inline uint32_t ArmEOR(ArmAllRegisters *registers, ArmRegisterIndex Rd,
 static inline void ArmEORS(ArmAllRegisters *registers, ArmRegisterIndex Rd,
                            uint32_t operand1, uint32_t operand2,
                            bool operand2_carry) {
+  ArmMaterializeFlags(registers);
   if (Rd != REGISTER_R15) {
     uint32_t result = ArmEOR(registers, Rd, operand1, operand2);
     registers->current.user.cpsr.negative = ArmNegativeFlagUInt32(result);
@@ -171,6 +179,7 @@ static inline uint32_t ArmMOV(ArmAllRegisters *registers, ArmRegisterIndex Rd,
 
 static inline void ArmMOVS(ArmAllRegisters *registers, ArmRegisterIndex Rd,
                            uint32_t operand2, bool operand2_carry) {
+  ArmMaterializeFlags(registers);
   if (Rd != REGISTER_R15) {
     uint32_t result = ArmMOV(registers, Rd, operand2);
     registers->current.user.cpsr.negative = ArmNegativeFlagUInt32(result);
@@ -192,6 +201,7 @@ static inline uint32_t ArmMVN(ArmAllRegisters *registers, ArmRegisterIndex Rd,
 
 static inline void ArmMVNS(ArmAllRegisters *registers, ArmRegisterIndex Rd,
                            uint32_t operand2, bool operand2_carry) {
+  ArmMaterializeFlags(registers);
   if (Rd != REGISTER_R15) {
     uint32_t result = ArmMVN(registers, Rd, operand2);
     registers->current.user.cpsr.negative = ArmNegativeFlagUInt32(result);
@@ -215,6 +225,7 @@ static inline uint32_t ArmORR(ArmAllRegisters *registers, ArmRegisterIndex Rd,
 static inline void ArmORRS(ArmAllRegisters *registers, ArmRegisterIndex Rd,
                            uint32_t operand1, uint32_t operand2,
                            bool operand2_carry) {
+  ArmMaterializeFlags(registers);
   if (Rd != REGISTER_R15) {
     uint32_t result = ArmORR(registers, Rd, operand1, operand2);
     registers->current.user.cpsr.negative = ArmNegativeFlagUInt32(result);
@@ -237,6 +248,7 @@ static inline uint64_t ArmRSB(ArmAllRegisters *registers, ArmRegisterIndex Rd,
 
 static inline void ArmRSBS(ArmAllRegisters *registers, ArmRegisterIndex Rd,
                            uint32_t operand1, uint32_t operand2) {
+  ArmMaterializeFlags(registers);
   if (Rd != REGISTER_R15) {
     int64_t difference_s =
         (int64_t)(int32_t)operand2 - (int64_t)(int32_t)operand1;
@@ -255,6 +267,7 @@ static inline void ArmRSBS(ArmAllRegisters *registers, ArmRegisterIndex Rd,
 
 static inline uint64_t ArmRSC(ArmAllRegisters *registers, ArmRegisterIndex Rd,
                               uint32_t operand1, uint32_t operand2) {
+  ArmMaterializeCarryFlag(registers);
   uint64_t difference = (uint64_t)operand2 - (uint64_t)operand1 -
                         (uint64_t)!registers->current.user.cpsr.carry;
   ArmAdvanceProgramCounter(registers);
@@ -264,6 +277,7 @@ static inline uint64_t ArmRSC(ArmAllRegisters *registers, ArmRegisterIndex Rd,
 
 static inline void ArmRSCS(ArmAllRegisters *registers, ArmRegisterIndex Rd,
                            uint32_t operand1, uint32_t operand2) {
+  ArmMaterializeFlags(registers);
   if (Rd != REGISTER_R15) {
     int64_t difference_s = (int64_t)(int32_t)operand2 -
                            (int64_t)(int32_t)operand1 -
@@ -284,6 +298,7 @@ static inline void ArmRSCS(ArmAllRegisters *registers, ArmRegisterIndex Rd,
 
 static inline uint64_t ArmSBC(ArmAllRegisters *registers, ArmRegisterIndex Rd,
                               uint32_t operand1, uint32_t operand2) {
+  ArmMaterializeCarryFlag(registers);
   uint64_t difference = (uint64_t)operand1 - (uint64_t)operand2 -
                         (uint64_t)!registers->current.user.cpsr.carry;
   ArmAdvanceProgramCounter(registers);
@@ -293,6 +308,7 @@ static inline uint64_t ArmSBC(ArmAllRegisters *registers, ArmRegisterIndex Rd,
 
 static inline void ArmSBCS(ArmAllRegisters *registers, ArmRegisterIndex Rd,
                            uint32_t operand1, uint32_t operand2) {
+  ArmMaterializeFlags(registers);
   if (Rd != REGISTER_R15) {
     int64_t difference_s = (int64_t)(int32_t)operand1 -
                            (int64_t)(int32_t)operand2 -
@@ -321,6 +337,7 @@ static inline uint64_t ArmSUB(ArmAllRegisters *registers, ArmRegisterIndex Rd,
 
 static inline void ArmSUBS(ArmAllRegisters *registers, ArmRegisterIndex Rd,
                            uint32_t operand1, uint32_t operand2) {
+  ArmMaterializeFlags(registers);
   if (Rd != REGISTER_R15) {
     int64_t difference_s =
         (int64_t)(int32_t)operand1 - (int64_t)(int32_t)operand2;
@@ -340,6 +357,7 @@ static inline void ArmSUBS(ArmAllRegisters *registers, ArmRegisterIndex Rd,
 static inline void ArmTEQ(ArmAllRegisters *registers, ArmRegisterIndex Rd,
                           uint32_t operand1, uint32_t operand2,
                           bool operand2_carry) {
+  ArmMaterializeFlags(registers);
   // ARM defines specifying any value for Rd other than R0 to be unpredictable
   if (Rd != REGISTER_R15) {
     uint32_t result = operand1 ^ operand2;
@@ -356,6 +374,7 @@ static inline void ArmTEQ(ArmAllRegisters *registers, ArmRegisterIndex Rd,
 static inline void ArmTST(ArmAllRegisters *registers, ArmRegisterIndex Rd,
                           uint32_t operand1, uint32_t operand2,
                           bool operand2_carry) {
+  ArmMaterializeFlags(registers);
   // ARM defines specifying any value for Rd other than R0 to be unpredictable
   if (Rd != REGISTER_R15) {
     uint32_t result = operand1 & operand2;
@@ -369,4 +388,172 @@ static inline void ArmTST(ArmAllRegisters *registers, ArmRegisterIndex Rd,
   }
 }
 
+// Variants of the flag setting instructions which defer computing the
+// condition flags until they are read. See ArmMaterializeFlags.
+
+static inline void ArmADDSLazy(ArmAllRegisters *registers, ArmRegisterIndex Rd,
+                               uint32_t operand1, uint32_t operand2) {
+  if (Rd != REGISTER_R15) {
+    uint32_t sum = operand1 + operand2;
+    ArmAdvanceProgramCounter(registers);
+    registers->current.user.gprs.gprs[Rd] = sum;
+    ArmDeferFlags(registers, ARM_LAZY_FLAGS_ADD, sum, operand1, operand2);
+  } else {
+    ArmADDS(registers, Rd, operand1, operand2);
+  }
+}
+
+static inline void ArmANDSLazy(ArmAllRegisters *registers, ArmRegisterIndex Rd,
+                               uint32_t operand1, uint32_t operand2,
+                               bool operand2_carry) {
+  if (Rd != REGISTER_R15) {
+    uint32_t result = operand1 & operand2;
+    ArmAdvanceProgramCounter(registers);
+    registers->current.user.gprs.gprs[Rd] = result;
+    ArmDeferNegativeAndZeroFlags(registers, result);
+    registers->current.user.cpsr.carry = operand2_carry;
+  } else {
+    ArmANDS(registers, Rd, operand1, operand2, operand2_carry);
+  }
+}
+
+static inline void ArmBICSLazy(ArmAllRegisters *registers, ArmRegisterIndex Rd,
+                               uint32_t operand1, uint32_t operand2,
+                               bool operand2_carry) {
+  if (Rd != REGISTER_R15) {
+    uint32_t result = operand1 & ~operand2;
+    ArmAdvanceProgramCounter(registers);
+    registers->current.user.gprs.gprs[Rd] = result;
+    ArmDeferNegativeAndZeroFlags(registers, result);
+    registers->current.user.cpsr.carry = operand2_carry;
+  } else {
+    ArmBICS(registers, Rd, operand1, operand2, operand2_carry);
+  }
+}
+
+static inline void ArmCMNLazy(ArmAllRegisters *registers, ArmRegisterIndex Rd,
+                              uint32_t operand1, uint32_t operand2) {
+  if (Rd != REGISTER_R15) {
+    ArmDeferFlags(registers, ARM_LAZY_FLAGS_ADD, operand1 + operand2, operand1,
+                  operand2);
+    ArmAdvanceProgramCounter(registers);
+  } else {
+    ArmCMN(registers, Rd, operand1, operand2);
+  }
+}
+
+static inline void ArmCMPLazy(ArmAllRegisters *registers, ArmRegisterIndex Rd,
+                              uint32_t operand1, uint32_t operand2) {
+  if (Rd != REGISTER_R15) {
+    ArmDeferFlags(registers, ARM_LAZY_FLAGS_SUB, operand1 - operand2, operand1,
+                  operand2);
+    ArmAdvanceProgramCounter(registers);
+  } else {
+    ArmCMP(registers, Rd, operand1, operand2);
+  }
+}
+
+static inline void ArmEORSLazy(ArmAllRegisters *registers, ArmRegisterIndex Rd,
+                               uint32_t operand1, uint32_t operand2,
+                               bool operand2_carry) {
+  if (Rd != REGISTER_R15) {
+    uint32_t result = operand1 ^ operand2;
+    ArmAdvanceProgramCounter(registers);
+    registers->current.user.gprs.gprs[Rd] = result;
+    ArmDeferNegativeAndZeroFlags(registers, result);
+    registers->current.user.cpsr.carry = operand2_carry;
+  } else {
+    ArmEORS(registers, Rd, operand1, operand2, operand2_carry);
+  }
+}
+
+static inline void ArmMOVSLazy(ArmAllRegisters *registers, ArmRegisterIndex Rd,
+                               uint32_t operand2, bool operand2_carry) {
+  if (Rd != REGISTER_R15) {
+    ArmAdvanceProgramCounter(registers);
+    registers->current.user.gprs.gprs[Rd] = operand2;
+    ArmDeferNegativeAndZeroFlags(registers, operand2);
+    registers->current.user.cpsr.carry = operand2_carry;
+  } else {
+    ArmMOVS(registers, Rd, operand2, operand2_carry);
+  }
+}
+
+static inline void ArmMVNSLazy(ArmAllRegisters *registers, ArmRegisterIndex Rd,
+                               uint32_t operand2, bool operand2_carry) {
+  if (Rd != REGISTER_R15) {
+    uint32_t result = ~operand2;
+    ArmAdvanceProgramCounter(registers);
+    registers->current.user.gprs.gprs[Rd] = result;
+    ArmDeferNegativeAndZeroFlags(registers, result);
+    registers->current.user.cpsr.carry = operand2_carry;
+  } else {
+    ArmMVNS(registers, Rd, operand2, operand2_carry);
+  }
+}
+
+static inline void ArmORRSLazy(ArmAllRegisters *registers, ArmRegisterIndex Rd,
+                               uint32_t operand1, uint32_t operand2,
+                               bool operand2_carry) {
+  if (Rd != REGISTER_R15) {
+    uint32_t result = operand1 | operand2;
+    ArmAdvanceProgramCounter(registers);
+    registers->current.user.gprs.gprs[Rd] = result;
+    ArmDeferNegativeAndZeroFlags(registers, result);
+    registers->current.user.cpsr.carry = operand2_carry;
+  } else {
+    ArmORRS(registers, Rd, operand1, operand2, operand2_carry);
+  }
+}
+
+static inline void ArmRSBSLazy(ArmAllRegisters *registers, ArmRegisterIndex Rd,
+                               uint32_t operand1, uint32_t operand2) {
+  if (Rd != REGISTER_R15) {
+    uint32_t difference = operand2 - operand1;
+    ArmAdvanceProgramCounter(registers);
+    registers->current.user.gprs.gprs[Rd] = difference;
+    ArmDeferFlags(registers, ARM_LAZY_FLAGS_SUB, difference, operand2,
+                  operand1);
+  } else {
+    ArmRSBS(registers, Rd, operand1, operand2);
+  }
+}
+
+static inline void ArmSUBSLazy(ArmAllRegisters *registers, ArmRegisterIndex Rd,
+                               uint32_t operand1, uint32_t operand2) {
+  if (Rd != REGISTER_R15) {
+    uint32_t difference = operand1 - operand2;
+    ArmAdvanceProgramCounter(registers);
+    registers->current.user.gprs.gprs[Rd] = difference;
+    ArmDeferFlags(registers, ARM_LAZY_FLAGS_SUB, difference, operand1,
+                  operand2);
+  } else {
+    ArmSUBS(registers, Rd, operand1, operand2);
+  }
+}
+
+static inline void ArmTEQLazy(ArmAllRegisters *registers, ArmRegisterIndex Rd,
+                              uint32_t operand1, uint32_t operand2,
+                              bool operand2_carry) {
+  if (Rd != REGISTER_R15) {
+    ArmDeferNegativeAndZeroFlags(registers, operand1 ^ operand2);
+    registers->current.user.cpsr.carry = operand2_carry;
+    ArmAdvanceProgramCounter(registers);
+  } else {
+    ArmTEQ(registers, Rd, operand1, operand2, operand2_carry);
+  }
+}
+
+static inline void ArmTSTLazy(ArmAllRegisters *registers, ArmRegisterIndex Rd,
+                              uint32_t operand1, uint32_t operand2,
+                              bool operand2_carry) {
+  if (Rd != REGISTER_R15) {
+    ArmDeferNegativeAndZeroFlags(registers, operand1 & operand2);
+    registers->current.user.cpsr.carry = operand2_carry;
+    ArmAdvanceProgramCounter(registers);
+  } else {
+    ArmTST(registers, Rd, operand1, operand2, operand2_carry);
+  }
+}
+
 #endif  // _WEBGBA_EMULATOR_CPU_ARM7TDMI_INSTRUCTIONS_DATA_PROCESSING_
\ No newline at end of file
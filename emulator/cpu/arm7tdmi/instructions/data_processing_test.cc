@@ -1720,4 +1720,77 @@ TEST(ArmTST, R15ToUSR) {
   registers.current.user.gprs.r15 = 0u;
   registers.current.user.cpsr.mode = 0;
   EXPECT_TRUE(ArmPrivilegedRegistersAreZero(registers.current));
-}
\ No newline at end of file
+}
+TEST(ArmLazyFlags, MatchesEager) {
+  const uint32_t values[] = {0u,          1u,          2u,
+                             0x7FFFFFFFu, 0x80000000u, 0x80000001u,
+                             0xFFFFFFFEu, 0xFFFFFFFFu};
+  for (uint32_t operand1 : values) {
+    for (uint32_t operand2 : values) {
+      for (uint32_t flags = 0u; flags < 16u; flags++) {
+        auto initial = CreateArmAllRegisters();
+        initial.current.user.cpsr.value = flags << 28u;
+
+        auto expected = initial;
+        auto actual = initial;
+
+        ArmADDS(&expected, REGISTER_R1, operand1, operand2);
+        ArmADDSLazy(&actual, REGISTER_R1, operand1, operand2);
+        ArmSUBS(&expected, REGISTER_R2, operand1, operand2);
+        ArmSUBSLazy(&actual, REGISTER_R2, operand1, operand2);
+        ArmMaterializeFlags(&actual);
+        EXPECT_EQ(0, memcmp(&expected, &actual, sizeof(ArmAllRegisters)));
+
+        ArmRSBS(&expected, REGISTER_R3, operand1, operand2);
+        ArmRSBSLazy(&actual, REGISTER_R3, operand1, operand2);
+        ArmMaterializeFlags(&actual);
+        EXPECT_EQ(0, memcmp(&expected, &actual, sizeof(ArmAllRegisters)));
+
+        ArmCMP(&expected, REGISTER_R0, operand1, operand2);
+        ArmCMPLazy(&actual, REGISTER_R0, operand1, operand2);
+        ArmMaterializeFlags(&actual);
+        EXPECT_EQ(0, memcmp(&expected, &actual, sizeof(ArmAllRegisters)));
+
+        ArmCMN(&expected, REGISTER_R0, operand1, operand2);
+        ArmCMNLazy(&actual, REGISTER_R0, operand1, operand2);
+        ArmANDS(&expected, REGISTER_R4, operand1, operand2, operand1 & 1u);
+        ArmANDSLazy(&actual, REGISTER_R4, operand1, operand2, operand1 & 1u);
+        ArmMaterializeFlags(&actual);
+        EXPECT_EQ(0, memcmp(&expected, &actual, sizeof(ArmAllRegisters)));
+
+        ArmSUBS(&expected, REGISTER_R5, operand1, operand2);
+        ArmSUBSLazy(&actual, REGISTER_R5, operand1, operand2);
+        ArmEORS(&expected, REGISTER_R5, operand1, operand2, operand2 & 1u);
+        ArmEORSLazy(&actual, REGISTER_R5, operand1, operand2, operand2 & 1u);
+        ArmORRS(&expected, REGISTER_R6, operand1, operand2, false);
+        ArmORRSLazy(&actual, REGISTER_R6, operand1, operand2, false);
+        ArmBICS(&expected, REGISTER_R7, operand1, operand2, true);
+        ArmBICSLazy(&actual, REGISTER_R7, operand1, operand2, true);
+        ArmMaterializeFlags(&actual);
+        EXPECT_EQ(0, memcmp(&expected, &actual, sizeof(ArmAllRegisters)));
+
+        ArmMOVS(&expected, REGISTER_R8, operand2, true);
+        ArmMOVSLazy(&actual, REGISTER_R8, operand2, true);
+        ArmMVNS(&expected, REGISTER_R9, operand2, false);
+        ArmMVNSLazy(&actual, REGISTER_R9, operand2, false);
+        ArmTST(&expected, REGISTER_R0, operand1, operand2, true);
+        ArmTSTLazy(&actual, REGISTER_R0, operand1, operand2, true);
+        ArmTEQ(&expected, REGISTER_R0, operand1, operand2, false);
+        ArmTEQLazy(&actual, REGISTER_R0, operand1, operand2, false);
+        ArmMaterializeFlags(&actual);
+        EXPECT_EQ(0, memcmp(&expected, &actual, sizeof(ArmAllRegisters)));
+
+        // Instructions that read the flags must observe the deferred values
+        ArmCMPLazy(&actual, REGISTER_R0, operand1, operand2);
+        ArmCMP(&expected, REGISTER_R0, operand1, operand2);
+        ArmADCS(&expected, REGISTER_R10, operand1, operand2);
+        ArmADCS(&actual, REGISTER_R10, operand1, operand2);
+        ArmADDSLazy(&actual, REGISTER_R11, operand1, operand2);
+        ArmADDS(&expected, REGISTER_R11, operand1, operand2);
+        ArmSBCS(&expected, REGISTER_R12, operand1, operand2);
+        ArmSBCS(&actual, REGISTER_R12, operand1, operand2);
+        EXPECT_EQ(0, memcmp(&expected, &actual, sizeof(ArmAllRegisters)));
+      }
+    }
+  }
+}
@@ -100,6 +100,7 @@ static inline void ArmLDRT(ArmAllRegisters *registers, const Memory *memory,
                            ArmRegisterIndex Rd, ArmRegisterIndex Rn,
                            uint_fast16_t offset, ArmAddressMode address_mode,
                            bool writeback) {
+  ArmMaterializeFlags(registers);
   ArmProgramStatusRegister current_status = registers->current.user.cpsr;
   ArmProgramStatusRegister temporary_status = current_status;
   temporary_status.mode = MODE_USR;
@@ -270,6 +271,7 @@ static inline void ArmLDRBT(ArmAllRegisters *registers, const Memory *memory,
                             ArmRegisterIndex Rd, ArmRegisterIndex Rn,
                             uint_fast16_t offset, ArmAddressMode address_mode,
                             bool writeback) {
+  ArmMaterializeFlags(registers);
   ArmProgramStatusRegister current_status = registers->current.user.cpsr;
   ArmProgramStatusRegister temporary_status = current_status;
   temporary_status.mode = MODE_USR;
@@ -443,6 +445,7 @@ static inline void ArmSTRT(ArmAllRegisters *registers, Memory *memory,
                            ArmRegisterIndex Rd, ArmRegisterIndex Rn,
                            uint_fast16_t offset, ArmAddressMode address_mode,
                            bool writeback) {
+  ArmMaterializeFlags(registers);
   ArmProgramStatusRegister current_status = registers->current.user.cpsr;
   ArmProgramStatusRegister temporary_status = current_status;
   temporary_status.mode = MODE_USR;
@@ -619,6 +622,7 @@ static inline void ArmSTRBT(ArmAllRegisters *registers, Memory *memory,
                             ArmRegisterIndex Rd, ArmRegisterIndex Rn,
                             uint_fast16_t offset, ArmAddressMode address_mode,
                             bool writeback) {
+  ArmMaterializeFlags(registers);
   ArmProgramStatusRegister current_status = registers->current.user.cpsr;
   ArmProgramStatusRegister temporary_status = current_status;
   temporary_status.mode = MODE_USR;
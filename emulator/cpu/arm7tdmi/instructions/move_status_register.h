@@ -5,6 +5,7 @@
 
 static inline void ArmMRS_CPSR(ArmAllRegisters *registers,
                                ArmRegisterIndex Rd) {
+  ArmMaterializeFlags(registers);
   ArmAdvanceProgramCounter(registers);
   ArmLoadGPSR(registers, Rd, registers->current.user.cpsr.value);
 }
@@ -17,6 +18,7 @@ static inline void ArmMRS_SPSR(ArmAllRegisters *registers,
 
 static inline void ArmMSR_CPSR(ArmAllRegisters *registers, bool control,
                                bool flags, uint32_t value) {
+  ArmMaterializeFlags(registers);
   ArmProgramStatusRegister requested_status;
   requested_status.value = value;
 
@@ -15,6 +15,7 @@ static inline uint32_t ArmMUL(ArmAllRegisters *registers, ArmRegisterIndex Rd,
 
 static inline void ArmMULS(ArmAllRegisters *registers, ArmRegisterIndex Rd,
                            ArmRegisterIndex Rm, ArmRegisterIndex Rs) {
+  ArmMaterializeFlags(registers);
   uint32_t product = ArmMUL(registers, Rd, Rm, Rs);
   registers->current.user.cpsr.zero = ArmZeroFlagUInt32(product);
   registers->current.user.cpsr.negative = ArmNegativeFlagUInt32(product);
@@ -34,6 +35,7 @@ static inline uint32_t ArmMLA(ArmAllRegisters *registers, ArmRegisterIndex Rd,
 static inline void ArmMLAS(ArmAllRegisters *registers, ArmRegisterIndex Rd,
                            ArmRegisterIndex Rm, ArmRegisterIndex Rs,
                            ArmRegisterIndex Rn) {
+  ArmMaterializeFlags(registers);
   uint32_t product = ArmMLA(registers, Rd, Rm, Rs, Rn);
   registers->current.user.cpsr.zero = ArmZeroFlagUInt32(product);
   registers->current.user.cpsr.negative = ArmNegativeFlagUInt32(product);
@@ -18,6 +18,7 @@ static inline uint64_t ArmUMULL(ArmAllRegisters *registers,
 static inline void ArmUMULLS(ArmAllRegisters *registers, ArmRegisterIndex RdLo,
                              ArmRegisterIndex RdHi, ArmRegisterIndex Rm,
                              ArmRegisterIndex Rs) {
+  ArmMaterializeFlags(registers);
   uint64_t product = ArmUMULL(registers, RdLo, RdHi, Rm, Rs);
   registers->current.user.cpsr.zero = ArmZeroFlagUInt64(product);
   registers->current.user.cpsr.negative = ArmNegativeFlagUInt64(product);
@@ -39,6 +40,7 @@ static inline uint64_t ArmUMLAL(ArmAllRegisters *registers,
 static inline void ArmUMLALS(ArmAllRegisters *registers, ArmRegisterIndex RdLo,
                              ArmRegisterIndex RdHi, ArmRegisterIndex Rm,
                              ArmRegisterIndex Rs) {
+  ArmMaterializeFlags(registers);
   uint64_t result = ArmUMLAL(registers, RdLo, RdHi, Rm, Rs);
   registers->current.user.cpsr.zero = ArmZeroFlagUInt64(result);
   registers->current.user.cpsr.negative = ArmNegativeFlagUInt64(result);
@@ -58,6 +60,7 @@ static inline int64_t ArmSMULL(ArmAllRegisters *registers,
 static inline void ArmSMULLS(ArmAllRegisters *registers, ArmRegisterIndex RdLo,
                              ArmRegisterIndex RdHi, ArmRegisterIndex Rm,
                              ArmRegisterIndex Rs) {
+  ArmMaterializeFlags(registers);
   int64_t product = ArmSMULL(registers, RdLo, RdHi, Rm, Rs);
   registers->current.user.cpsr.zero = ArmZeroFlagInt64(product);
   registers->current.user.cpsr.negative = ArmNegativeFlagInt64(product);
@@ -80,6 +83,7 @@ static inline int64_t ArmSMLAL(ArmAllRegisters *registers,
 static inline void ArmSMLALS(ArmAllRegisters *registers, ArmRegisterIndex RdLo,
                              ArmRegisterIndex RdHi, ArmRegisterIndex Rm,
                              ArmRegisterIndex Rs) {
+  ArmMaterializeFlags(registers);
   int64_t result = ArmSMLAL(registers, RdLo, RdHi, Rm, Rs);
   registers->current.user.cpsr.zero = ArmZeroFlagInt64(result);
   registers->current.user.cpsr.negative = ArmNegativeFlagInt64(result);
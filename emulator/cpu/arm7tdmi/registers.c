@@ -63,6 +63,10 @@ void ArmLoadCPSR(ArmAllRegisters* registers, ArmProgramStatusRegister cpsr) {
   }
 
   registers->current.user.cpsr = cpsr;
+  registers->lazy_flags.result = 0u;
+  registers->lazy_flags.operand1 = 0u;
+  registers->lazy_flags.operand2 = 0u;
+  registers->lazy_flags.operation = ARM_LAZY_FLAGS_NONE;
   registers->execution_control.thumb = cpsr.thumb;
   registers->execution_control.irq =
       registers->execution_control.irq_raised && !cpsr.irq_disable;
@@ -149,12 +149,28 @@ typedef struct {
   bool fiq_raised;
 } ArmExecutionControl;
 
+#define ARM_LAZY_FLAGS_NONE 0u
+#define ARM_LAZY_FLAGS_NZ 1u
+#define ARM_LAZY_FLAGS_ADD 2u
+#define ARM_LAZY_FLAGS_SUB 3u
+
+// Non-architectural state used to defer computing the condition flags until
+// they are read. While operation is not ARM_LAZY_FLAGS_NONE, the flags it
+// covers in cpsr are stale and must be materialized before they are used.
+typedef struct {
+  uint32_t result;
+  uint32_t operand1;
+  uint32_t operand2;
+  uint32_t operation;
+} ArmLazyFlags;
+
 typedef struct {
   ArmPrivilegedRegisters current;
   uint32_t banked_splrs[6][2];
   uint32_t banked_fiq_gprs[5];
   ArmProgramStatusRegister banked_spsrs[6];
   ArmExecutionControl execution_control;
+  ArmLazyFlags lazy_flags;
 } ArmAllRegisters;
 
 static inline uint32_t ArmNextInstruction(const ArmAllRegisters* registers) {
@@ -192,6 +208,75 @@ static inline void ArmLoadGPSR(ArmAllRegisters* registers,
   }
 }
 
+static inline void ArmMaterializeFlags(ArmAllRegisters* registers) {
+  if (registers->lazy_flags.operation == ARM_LAZY_FLAGS_NONE) {
+    return;
+  }
+
+  uint32_t result = registers->lazy_flags.result;
+  uint32_t operand1 = registers->lazy_flags.operand1;
+  uint32_t operand2 = registers->lazy_flags.operand2;
+
+  uint32_t flags = (result & 0x80000000u) | ((uint32_t)(result == 0u) << 30u);
+  switch (registers->lazy_flags.operation) {
+    case ARM_LAZY_FLAGS_NZ:
+      flags |= registers->current.user.cpsr.value & 0x30000000u;
+      break;
+    case ARM_LAZY_FLAGS_ADD:
+      flags |= (uint32_t)(result < operand1) << 29u;
+      flags |= ((~(operand1 ^ operand2) & (operand1 ^ result)) >> 3u) &
+               0x10000000u;
+      break;
+    case ARM_LAZY_FLAGS_SUB:
+      flags |= (uint32_t)(operand1 >= operand2) << 29u;
+      flags |=
+          (((operand1 ^ operand2) & (operand1 ^ result)) >> 3u) & 0x10000000u;
+      break;
+  }
+
+  registers->current.user.cpsr.value =
+      (registers->current.user.cpsr.value & 0x0FFFFFFFu) | flags;
+  registers->lazy_flags.result = 0u;
+  registers->lazy_flags.operand1 = 0u;
+  registers->lazy_flags.operand2 = 0u;
+  registers->lazy_flags.operation = ARM_LAZY_FLAGS_NONE;
+}
+
+// Records the result of an addition or subtraction whose flags are computed
+// the next time they are read. Replaces any pending flags.
+static inline void ArmDeferFlags(ArmAllRegisters* registers, uint32_t operation,
+                                 uint32_t result, uint32_t operand1,
+                                 uint32_t operand2) {
+  assert(operation == ARM_LAZY_FLAGS_ADD || operation == ARM_LAZY_FLAGS_SUB);
+  registers->lazy_flags.result = result;
+  registers->lazy_flags.operand1 = operand1;
+  registers->lazy_flags.operand2 = operand2;
+  registers->lazy_flags.operation = operation;
+}
+
+// Materializes any pending flags only if the carry flag is among them, so that
+// it may be read directly from the CPSR
+static inline void ArmMaterializeCarryFlag(ArmAllRegisters* registers) {
+  if (registers->lazy_flags.operation > ARM_LAZY_FLAGS_NZ) {
+    ArmMaterializeFlags(registers);
+  }
+}
+
+// Records a result whose negative and zero flags are computed the next time
+// they are read. The carry and overflow flags are left unchanged.
+static inline void ArmDeferNegativeAndZeroFlags(ArmAllRegisters* registers,
+                                                uint32_t result) {
+  ArmMaterializeCarryFlag(registers);
+  registers->lazy_flags.result = result;
+  registers->lazy_flags.operation = ARM_LAZY_FLAGS_NZ;
+}
+
+static inline bool ArmCarryFlag(ArmAllRegisters* registers) {
+  ArmMaterializeCarryFlag(registers);
+  return registers->current.user.cpsr.carry;
+}
+
+// Discards any pending flags
 void ArmLoadCPSR(ArmAllRegisters* registers, ArmProgramStatusRegister cpsr);
 
 #endif  // _WEBGBA_EMULATOR_CPU_ARM7TDMI_REGISTERS_
\ No newline at end of file
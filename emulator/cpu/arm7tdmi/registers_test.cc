@@ -52,6 +52,11 @@ bool ArmPrivilegedRegistersAreZero(const ArmAllRegisters& regs) {
   return !memcmp(&zero.current, &regs.current, sizeof(ArmPrivilegedRegisters));
 }
 
+bool ArmAllRegistersAreZero(const ArmAllRegisters& regs) {
+  auto zero = CreateArmAllRegisters();
+  return !memcmp(&zero, &regs, sizeof(ArmAllRegisters));
+}
+
 class ArmLoadCPSRTest : public testing::TestWithParam<unsigned> {
  public:
   void SetUp() override {
@@ -669,4 +674,88 @@ TEST(ArmAdvanceProgramCounterTest, ArmAdvanceProgramCounterThumb) {
   registers.current.user.cpsr.thumb = true;
   ArmAdvanceProgramCounter(&registers);
   EXPECT_EQ(0x102u, ArmCurrentInstruction(&registers));
-}
\ No newline at end of file
+}
+
+TEST(ArmMaterializeFlagsTest, NoneLeavesFlagsUnchanged) {
+  auto registers = CreateArmAllRegisters();
+  registers.current.user.cpsr.value = 0xF000001Fu;
+  ArmMaterializeFlags(&registers);
+  EXPECT_EQ(0xF000001Fu, registers.current.user.cpsr.value);
+}
+
+TEST(ArmMaterializeFlagsTest, NegativeAndZero) {
+  auto registers = CreateArmAllRegisters();
+  registers.current.user.cpsr.value = 0x3000001Fu;
+  ArmDeferNegativeAndZeroFlags(&registers, 0u);
+  ArmMaterializeFlags(&registers);
+  EXPECT_EQ(0x7000001Fu, registers.current.user.cpsr.value);
+
+  ArmDeferNegativeAndZeroFlags(&registers, 0x80000000u);
+  ArmMaterializeFlags(&registers);
+  EXPECT_EQ(0xB000001Fu, registers.current.user.cpsr.value);
+
+  registers.current.user.cpsr.value = 0u;
+  EXPECT_TRUE(ArmAllRegistersAreZero(registers));
+}
+
+TEST(ArmMaterializeFlagsTest, Add) {
+  auto registers = CreateArmAllRegisters();
+  ArmDeferFlags(&registers, ARM_LAZY_FLAGS_ADD, 0u, 0x80000000u, 0x80000000u);
+  ArmMaterializeFlags(&registers);
+  EXPECT_FALSE(registers.current.user.cpsr.negative);
+  EXPECT_TRUE(registers.current.user.cpsr.zero);
+  EXPECT_TRUE(registers.current.user.cpsr.carry);
+  EXPECT_TRUE(registers.current.user.cpsr.overflow);
+
+  ArmDeferFlags(&registers, ARM_LAZY_FLAGS_ADD, 0x80000000u, 0x7FFFFFFFu, 1u);
+  ArmMaterializeFlags(&registers);
+  EXPECT_TRUE(registers.current.user.cpsr.negative);
+  EXPECT_FALSE(registers.current.user.cpsr.zero);
+  EXPECT_FALSE(registers.current.user.cpsr.carry);
+  EXPECT_TRUE(registers.current.user.cpsr.overflow);
+
+  registers.current.user.cpsr.value = 0u;
+  EXPECT_TRUE(ArmAllRegistersAreZero(registers));
+}
+
+TEST(ArmMaterializeFlagsTest, Subtract) {
+  auto registers = CreateArmAllRegisters();
+  ArmDeferFlags(&registers, ARM_LAZY_FLAGS_SUB, 0u, 1u, 1u);
+  ArmMaterializeFlags(&registers);
+  EXPECT_FALSE(registers.current.user.cpsr.negative);
+  EXPECT_TRUE(registers.current.user.cpsr.zero);
+  EXPECT_TRUE(registers.current.user.cpsr.carry);
+  EXPECT_FALSE(registers.current.user.cpsr.overflow);
+
+  ArmDeferFlags(&registers, ARM_LAZY_FLAGS_SUB, 0x7FFFFFFFu, 0x80000000u, 1u);
+  ArmMaterializeFlags(&registers);
+  EXPECT_FALSE(registers.current.user.cpsr.negative);
+  EXPECT_FALSE(registers.current.user.cpsr.zero);
+  EXPECT_TRUE(registers.current.user.cpsr.carry);
+  EXPECT_TRUE(registers.current.user.cpsr.overflow);
+
+  ArmDeferFlags(&registers, ARM_LAZY_FLAGS_SUB, 0xFFFFFFFFu, 0u, 1u);
+  ArmMaterializeFlags(&registers);
+  EXPECT_TRUE(registers.current.user.cpsr.negative);
+  EXPECT_FALSE(registers.current.user.cpsr.zero);
+  EXPECT_FALSE(registers.current.user.cpsr.carry);
+  EXPECT_FALSE(registers.current.user.cpsr.overflow);
+
+  registers.current.user.cpsr.value = 0u;
+  EXPECT_TRUE(ArmAllRegistersAreZero(registers));
+}
+
+TEST(ArmMaterializeFlagsTest, LoadCPSRDiscardsPendingFlags) {
+  auto registers = CreateArmAllRegisters();
+  registers.current.user.cpsr.mode = MODE_USR;
+  ArmDeferFlags(&registers, ARM_LAZY_FLAGS_SUB, 0u, 1u, 1u);
+
+  ArmProgramStatusRegister cpsr;
+  cpsr.value = MODE_USR;
+  ArmLoadCPSR(&registers, cpsr);
+  ArmMaterializeFlags(&registers);
+  EXPECT_EQ(MODE_USR, registers.current.user.cpsr.value);
+
+  registers.current.user.cpsr.value = 0u;
+  EXPECT_TRUE(ArmAllRegistersAreZero(registers));
+}
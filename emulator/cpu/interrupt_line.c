@@ -1,6 +1,6 @@
 #include "emulator/cpu/interrupt_line.h"
 
-#include <stdlib.h>
+#include "emulator/arena.h"
 
 struct _InterruptLine {
   InterruptLineSetLevelFunction set_level;
@@ -11,7 +11,8 @@ struct _InterruptLine {
 InterruptLine *InterruptLineAllocate(void *context,
                                      InterruptLineSetLevelFunction set_level,
                                      InterruptLineContextFree free_context) {
-  InterruptLine *result = (InterruptLine *)malloc(sizeof(InterruptLine));
+  InterruptLine *result =
+      (InterruptLine *)ArenaCalloc(1u, sizeof(InterruptLine));
   if (result == NULL) {
     return NULL;
   }
@@ -31,5 +32,5 @@ void InterruptLineFree(InterruptLine *interrupt_line) {
   if (interrupt_line->free_context) {
     interrupt_line->free_context(interrupt_line->context);
   }
-  free(interrupt_line);
+  ArenaFreeAllocation(interrupt_line);
 }
\ No newline at end of file
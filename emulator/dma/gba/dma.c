@@ -1,7 +1,9 @@
 #include "emulator/dma/gba/dma.h"
 
 #include <assert.h>
-#include <stdlib.h>
+#include <string.h>
+
+#include "emulator/arena.h"
 
 #define DMA0SAD_OFFSET 0x00u
 #define DMA0DAD_OFFSET 0x04u
@@ -69,16 +71,28 @@ struct _GbaDmaUnit {
   uint32_t current_destination[GBA_NUM_DMA_UNITS];
   uint16_t transfers_remaining[GBA_NUM_DMA_UNITS];
   GbaDmaUnitRegisters registers;
+#ifdef WEBGBA_DIRECT_SIGNALS
+  GbaSignals *signals;
+#else
   DmaStatus *dma_status;
+#endif  // WEBGBA_DIRECT_SIGNALS
   GbaPlatform *platform;
   uint16_t reference_count;
 };
 
+static inline void GbaDmaUnitSetStatus(GbaDmaUnit *dma_unit, bool active) {
+#ifdef WEBGBA_DIRECT_SIGNALS
+  GbaSignalsSetDmaActive(dma_unit->signals, active);
+#else
+  DmaStatusSet(dma_unit->dma_status, active);
+#endif  // WEBGBA_DIRECT_SIGNALS
+}
+
 static void GbaDmaUnitClearActive(GbaDmaUnit *dma_unit, uint_fast8_t index) {
   assert(index < GBA_NUM_DMA_UNITS);
   unsigned unset_bit_mask = ~(1u << index);
   dma_unit->active &= unset_bit_mask;
-  DmaStatusSet(dma_unit->dma_status, dma_unit->active);
+  GbaDmaUnitSetStatus(dma_unit, dma_unit->active);
 }
 
 static void GbaDmaUnitSetActiveBitTo(GbaDmaUnit *dma_unit, uint_fast8_t index,
@@ -86,7 +100,7 @@ static void GbaDmaUnitSetActiveBitTo(GbaDmaUnit *dma_unit, uint_fast8_t index,
   assert(index < GBA_NUM_DMA_UNITS);
   GbaDmaUnitClearActive(dma_unit, index);
   dma_unit->active |= (unsigned)active << index;
-  DmaStatusSet(dma_unit->dma_status, dma_unit->active);
+  GbaDmaUnitSetStatus(dma_unit, dma_unit->active);
 }
 
 static bool GbaDmaUnitIsActiveByIndex(const GbaDmaUnit *dma_unit,
@@ -259,14 +273,37 @@ static bool GbaDmaUnitRegistersStore8(void *context, uint32_t address,
   return true;
 }
 
+static const uint16_t *GbaDmaUnitRegisterStorage(const void *context,
+                                                 uint32_t address) {
+  const GbaDmaUnit *dma_unit = (const GbaDmaUnit *)context;
+
+  switch (address) {
+    case DMA0CNT_H_OFFSET:
+      return &dma_unit->registers.units[0].control.value;
+    case DMA1CNT_H_OFFSET:
+      return &dma_unit->registers.units[1].control.value;
+    case DMA2CNT_H_OFFSET:
+      return &dma_unit->registers.units[2].control.value;
+    case DMA3CNT_H_OFFSET:
+      return &dma_unit->registers.units[3].control.value;
+  }
+
+  return NULL;
+}
+
 void GbaDmaUnitMemoryFree(void *context) {
   GbaDmaUnit *dma_unit = (GbaDmaUnit *)context;
   GbaDmaUnitRelease(dma_unit);
 }
 
+#ifdef WEBGBA_DIRECT_SIGNALS
+bool GbaDmaUnitAllocate(GbaSignals *signals, GbaPlatform *platform,
+                        GbaDmaUnit **dma_unit, Memory **registers) {
+#else
 bool GbaDmaUnitAllocate(DmaStatus *dma_status, GbaPlatform *platform,
                         GbaDmaUnit **dma_unit, Memory **registers) {
-  *dma_unit = (GbaDmaUnit *)calloc(1, sizeof(GbaDmaUnit));
+#endif  // WEBGBA_DIRECT_SIGNALS
+  *dma_unit = (GbaDmaUnit *)ArenaCalloc(1, sizeof(GbaDmaUnit));
   if (*dma_unit == NULL) {
     return false;
   }
@@ -277,21 +314,51 @@ bool GbaDmaUnitAllocate(DmaStatus *dma_status, GbaPlatform *platform,
                      GbaDmaUnitRegistersStore32LE, GbaDmaUnitRegistersStore16LE,
                      GbaDmaUnitRegistersStore8, GbaDmaUnitMemoryFree);
   if (*registers == NULL) {
-    free(*dma_unit);
+    ArenaFreeAllocation(*dma_unit);
     return false;
   }
 
-  DmaStatusSet(dma_status, false);
+  MemorySetRegisterStorage(*registers, GbaDmaUnitRegisterStorage);
 
+#ifdef WEBGBA_DIRECT_SIGNALS
+  (*dma_unit)->signals = signals;
+  GbaSignalsRetain(signals);
+#else
   (*dma_unit)->dma_status = dma_status;
+#endif  // WEBGBA_DIRECT_SIGNALS
   (*dma_unit)->platform = platform;
   (*dma_unit)->reference_count = 2u;
 
+  GbaDmaUnitSetStatus(*dma_unit, false);
   GbaPlatformRetain(platform);
 
   return true;
 }
 
+void GbaDmaUnitReset(GbaDmaUnit *dma_unit) {
+  dma_unit->active = 0u;
+  memset(dma_unit->enabled, 0, sizeof(dma_unit->enabled));
+  memset(dma_unit->current_source, 0, sizeof(dma_unit->current_source));
+  memset(dma_unit->current_destination, 0,
+         sizeof(dma_unit->current_destination));
+  memset(dma_unit->transfers_remaining, 0,
+         sizeof(dma_unit->transfers_remaining));
+  memset(&dma_unit->registers, 0, sizeof(GbaDmaUnitRegisters));
+  GbaDmaUnitSetStatus(dma_unit, false);
+}
+
+void GbaDmaUnitCopyState(GbaDmaUnit *destination, const GbaDmaUnit *source) {
+  destination->active = source->active;
+  memcpy(destination->enabled, source->enabled, sizeof(source->enabled));
+  memcpy(destination->current_source, source->current_source,
+         sizeof(source->current_source));
+  memcpy(destination->current_destination, source->current_destination,
+         sizeof(source->current_destination));
+  memcpy(destination->transfers_remaining, source->transfers_remaining,
+         sizeof(source->transfers_remaining));
+  destination->registers = source->registers;
+}
+
 uint32_t GbaDmaUnitStep(GbaDmaUnit *dma_unit, Memory *memory,
                         uint32_t num_cycles) {
   assert(num_cycles != 0u);
@@ -411,9 +478,13 @@ void GbaDmaUnitRelease(GbaDmaUnit *dma_unit) {
   assert(dma_unit->reference_count != 0u);
   dma_unit->reference_count -= 1u;
   if (dma_unit->reference_count == 0u) {
+#ifdef WEBGBA_DIRECT_SIGNALS
+    GbaSignalsRelease(dma_unit->signals);
+#else
     DmaStatusFree(dma_unit->dma_status);
+#endif  // WEBGBA_DIRECT_SIGNALS
     GbaPlatformRelease(dma_unit->platform);
-    free(dma_unit);
+    ArenaFreeAllocation(dma_unit);
   }
 }
 
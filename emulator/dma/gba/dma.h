@@ -4,11 +4,24 @@
 #include "emulator/dma/status.h"
 #include "emulator/memory/memory.h"
 #include "emulator/platform/gba/platform.h"
+#include "emulator/platform/gba/signals.h"
 
 typedef struct _GbaDmaUnit GbaDmaUnit;
 
+#ifdef WEBGBA_DIRECT_SIGNALS
+bool GbaDmaUnitAllocate(GbaSignals *signals, GbaPlatform *platform,
+                        GbaDmaUnit **dma_unit, Memory **registers);
+#else
 bool GbaDmaUnitAllocate(DmaStatus *dma_status, GbaPlatform *platform,
                         GbaDmaUnit **dma_unit, Memory **registers);
+#endif  // WEBGBA_DIRECT_SIGNALS
+
+// Cancels all transfers and restores the power on registers
+void GbaDmaUnitReset(GbaDmaUnit *dma_unit);
+
+// Copies the registers and transfers in progress of another DMA unit without
+// signaling the DMA status
+void GbaDmaUnitCopyState(GbaDmaUnit *destination, const GbaDmaUnit *source);
 
 // Step
 uint32_t GbaDmaUnitStep(GbaDmaUnit *dma_unit, Memory *memory,
@@ -402,6 +402,26 @@ TEST_F(DmaUnitTest, GbaDmaUnitRegistersLoad32LE) {
 
 TEST_F(DmaUnitTest, DefaultUnitIsInactive) { EXPECT_FALSE(active_); }
 
+TEST_F(DmaUnitTest, Reset) {
+  EnableDma(/*index=*/0u, /*source=*/0u, /*dest=*/16u, /*transfer_count=*/1u,
+            /*transfer_words=*/true, /*src_addr_mode=*/GBA_DMA_ADDR_INCREMENT,
+            /*dest_addr_mode=*/GBA_DMA_ADDR_INCREMENT,
+            /*trigger=*/GBA_DMA_IMMEDIATE, /*repeat=*/false, /*irq=*/true);
+  EnableDma(/*index=*/3u, /*source=*/0u, /*dest=*/16u, /*transfer_count=*/1u,
+            /*transfer_words=*/true, /*src_addr_mode=*/GBA_DMA_ADDR_INCREMENT,
+            /*dest_addr_mode=*/GBA_DMA_ADDR_INCREMENT,
+            /*trigger=*/GBA_DMA_VBLANK, /*repeat=*/true, /*irq=*/false);
+  EXPECT_TRUE(active_);
+
+  GbaDmaUnitReset(dma_unit_);
+  EXPECT_FALSE(active_);
+  CheckDmaIsDisabled(0u);
+  CheckDmaIsDisabled(3u);
+
+  GbaDmaUnitSignalVBlank(dma_unit_);
+  EXPECT_FALSE(active_);
+}
+
 TEST_F(DmaUnitTest, TestDmaIrq0) {
   EXPECT_TRUE(Store32LEStatic(nullptr, 0u, 0x12345678u));
   EnableDma(/*index=*/0u, /*source=*/0u, /*dest=*/16u, /*transfer_count=*/1u,
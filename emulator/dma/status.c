@@ -1,6 +1,6 @@
 #include "emulator/dma/status.h"
 
-#include <stdlib.h>
+#include "emulator/arena.h"
 
 struct _DmaStatus {
   DmaStatusSetFunction set;
@@ -10,7 +10,7 @@ struct _DmaStatus {
 
 DmaStatus *DmaStatusAllocate(void *context, DmaStatusSetFunction set,
                              DmaStatusContextFree free_context) {
-  DmaStatus *result = (DmaStatus *)malloc(sizeof(DmaStatus));
+  DmaStatus *result = (DmaStatus *)ArenaCalloc(1u, sizeof(DmaStatus));
   if (result == NULL) {
     return NULL;
   }
@@ -30,5 +30,5 @@ void DmaStatusFree(DmaStatus *dma_status) {
   if (dma_status->free_context) {
     dma_status->free_context(dma_status->context);
   }
-  free(dma_status);
+  ArenaFreeAllocation(dma_status);
 }
\ No newline at end of file
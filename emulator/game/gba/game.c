@@ -1,9 +1,18 @@
 #include "emulator/game/gba/game.h"
 
 #include <assert.h>
+#include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 
+#if defined(__unix__) || defined(__APPLE__)
+#include <errno.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif  // defined(__unix__) || defined(__APPLE__)
+
 #define GBA_GAME_MAX_SIZE 0x2000000u  // 32MB
 
 bool GbaGameLoad(const unsigned char *rom_data, uint32_t rom_size,
@@ -17,15 +26,177 @@ bool GbaGameLoad(const unsigned char *rom_data, uint32_t rom_size,
     return false;
   }
 
-  for (uint32_t i = 0u; i < rom_size; i++) {
-    MemoryBankStore8(*game_rom, i, (char)rom_data[i]);
+  MemoryBankWrite(*game_rom, 0u, rom_data, rom_size);
+  MemoryBankIgnoreWrites(*game_rom);
+
+  // Save storage is not implemented yet nor is storage detection, so just
+  // treat all games as if they have no save storage
+  *save_storage_type = SAVE_STORAGE_NONE;
+
+  return true;
+}
+
+static void GbaGameFree(void *storage) { free(storage); }
+
+#if defined(__unix__) || defined(__APPLE__)
+
+static void GbaGameUnmap(void *storage) {
+  munmap(storage, GBA_GAME_MAX_SIZE);
+}
+
+static void *GbaGameMapFile(int fd, uint32_t rom_size) {
+  // The whole cartridge is reserved first so that the bytes past the end of
+  // the file read as zero, then the file is mapped over the start of it
+  void *storage = mmap(NULL, GBA_GAME_MAX_SIZE, PROT_READ,
+                       MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+  if (storage == MAP_FAILED) {
+    return NULL;
+  }
+
+  if (mmap(storage, rom_size, PROT_READ, MAP_PRIVATE | MAP_FIXED, fd, 0) ==
+      MAP_FAILED) {
+    munmap(storage, GBA_GAME_MAX_SIZE);
+    return NULL;
   }
 
-  MemoryBankIgnoreWrites(*game_rom);
+  return storage;
+}
+
+static void *GbaGameReadFile(int fd, uint32_t rom_size) {
+  unsigned char *storage = calloc(1u, GBA_GAME_MAX_SIZE);
+  if (storage == NULL) {
+    return NULL;
+  }
+
+  uint32_t bytes_read = 0u;
+  while (bytes_read < rom_size) {
+    ssize_t result =
+        pread(fd, storage + bytes_read, rom_size - bytes_read, bytes_read);
+    if (result < 0 && errno == EINTR) {
+      continue;
+    }
+
+    if (result <= 0) {
+      free(storage);
+      return NULL;
+    }
+
+    bytes_read += result;
+  }
+
+  return storage;
+}
+
+static bool GbaGameOpenFile(const char *path, uint32_t *rom_size,
+                            void **storage,
+                            MemoryBankReleaseFunction *release) {
+  int fd = open(path, O_RDONLY);
+  if (fd < 0) {
+    return false;
+  }
+
+  struct stat file_stat;
+  if (fstat(fd, &file_stat) != 0 || !S_ISREG(file_stat.st_mode) ||
+      file_stat.st_size <= 0 || file_stat.st_size > GBA_GAME_MAX_SIZE) {
+    close(fd);
+    return false;
+  }
+
+  *rom_size = file_stat.st_size;
+
+  *release = GbaGameUnmap;
+  *storage = GbaGameMapFile(fd, *rom_size);
+  if (*storage == NULL) {
+    *release = GbaGameFree;
+    *storage = GbaGameReadFile(fd, *rom_size);
+  }
+
+  close(fd);
+
+  return *storage != NULL;
+}
+
+#else
+
+static bool GbaGameOpenFile(const char *path, uint32_t *rom_size,
+                            void **storage,
+                            MemoryBankReleaseFunction *release) {
+  FILE *file = fopen(path, "rb");
+  if (file == NULL) {
+    return false;
+  }
+
+  long file_size = -1;
+  if (fseek(file, 0, SEEK_END) == 0) {
+    file_size = ftell(file);
+  }
+
+  if (file_size <= 0 || file_size > (long)GBA_GAME_MAX_SIZE ||
+      fseek(file, 0, SEEK_SET) != 0) {
+    fclose(file);
+    return false;
+  }
+
+  *rom_size = file_size;
+
+  *release = GbaGameFree;
+  *storage = calloc(1u, GBA_GAME_MAX_SIZE);
+  if (*storage != NULL && fread(*storage, 1u, *rom_size, file) != *rom_size) {
+    free(*storage);
+    *storage = NULL;
+  }
+
+  fclose(file);
+
+  return *storage != NULL;
+}
+
+#endif  // defined(__unix__) || defined(__APPLE__)
+
+bool GbaGameLoadFile(const char *path, uint32_t *rom_size,
+                     SaveStorageType *save_storage_type,
+                     MemoryBank **game_rom) {
+  void *storage;
+  MemoryBankReleaseFunction release;
+  if (!GbaGameOpenFile(path, rom_size, &storage, &release)) {
+    return false;
+  }
+
+  *game_rom = MemoryBankAllocateExternal(storage, GBA_GAME_MAX_SIZE, release);
+  if (*game_rom == NULL) {
+    release(storage);
+    return false;
+  }
 
   // Save storage is not implemented yet nor is storage detection, so just
   // treat all games as if they have no save storage
   *save_storage_type = SAVE_STORAGE_NONE;
 
+  return true;
+}
+
+bool GbaGameReload(const unsigned char *rom_data, uint32_t rom_size,
+                   uint32_t previous_rom_size,
+                   SaveStorageType *save_storage_type, MemoryBank *game_rom) {
+  if (rom_size > GBA_GAME_MAX_SIZE) {
+    return false;
+  }
+
+  // A ROM shared with a cloned emulator or mapped from a file is replaced
+  // rather than overwritten
+  if (!MemoryBankDetach(game_rom)) {
+    return false;
+  }
+
+  MemoryBankWrite(game_rom, 0u, rom_data, rom_size);
+
+  // Only the bytes that could have been written by the previous ROM need to
+  // be cleared
+  if (rom_size < previous_rom_size) {
+    MemoryBankZero(game_rom, rom_size, previous_rom_size - rom_size);
+  }
+
+  *save_storage_type = SAVE_STORAGE_NONE;
+
   return true;
 }
\ No newline at end of file
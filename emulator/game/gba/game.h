@@ -19,4 +19,16 @@ typedef enum {
 bool GbaGameLoad(const unsigned char *rom_data, uint32_t rom_size,
                  SaveStorageType *save_storage_type, MemoryBank **game_rom);
 
+// Maps the ROM in the file read only instead of copying it so that its pages
+// are only read from disk as they are used. Falls back to reading the whole
+// file at once if it cannot be mapped or the platform does not support
+// mapping files. Fails unless path names a regular file that is not empty.
+bool GbaGameLoadFile(const char *path, uint32_t *rom_size,
+                     SaveStorageType *save_storage_type, MemoryBank **game_rom);
+
+// Replaces the contents of a ROM previously returned by GbaGameLoad
+bool GbaGameReload(const unsigned char *rom_data, uint32_t rom_size,
+                   uint32_t previous_rom_size,
+                   SaveStorageType *save_storage_type, MemoryBank *game_rom);
+
 #endif  // _WEBGBA_EMULATOR_GAME_GBA_GAME_
\ No newline at end of file
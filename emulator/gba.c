@@ -2,18 +2,23 @@
 
 #include <assert.h>
 #include <stdatomic.h>
-#include <stdlib.h>
 
+#include "emulator/arena.h"
 #include "emulator/cpu/arm7tdmi/arm7tdmi.h"
 #include "emulator/dma/gba/dma.h"
 #include "emulator/game/gba/game.h"
 #include "emulator/memory/gba/memory.h"
 #include "emulator/peripherals/gba/peripherals.h"
 #include "emulator/platform/gba/platform.h"
+#include "emulator/platform/gba/signals.h"
 #include "emulator/ppu/gba/ppu.h"
 #include "emulator/sound/gba/sound.h"
 #include "emulator/timers/gba/timers.h"
 
+// Room for all of the component state including EWRAM, IWRAM, and the PPU
+// memory. Anything that does not fit falls back to the heap.
+#define GBA_EMULATOR_ARENA_SIZE (512u * 1024u)
+
 struct _GbaEmulator {
   bool cpu_active;
   bool dma_active;
@@ -27,7 +32,11 @@ struct _GbaEmulator {
   GbaPlatform *platform;
   PowerState power_state;
   bool dma_state;
-  uint_fast8_t reference_count;
+#ifdef WEBGBA_DIRECT_SIGNALS
+  GbaSignals *signals;  // Kept alive by the platform
+#endif  // WEBGBA_DIRECT_SIGNALS
+  uint32_t rom_size;
+  Arena *arena;
 };
 
 static void GbaEmulatorUpdateActiveBits(GbaEmulator *emulator) {
@@ -47,6 +56,41 @@ static void GbaEmulatorUpdateActiveBits(GbaEmulator *emulator) {
   }
 }
 
+#ifdef WEBGBA_DIRECT_SIGNALS
+static bool GbaEmulatorAllocatePlatformAndDma(GbaEmulator *emulator,
+                                              InterruptLine *irq,
+                                              Memory **platform_registers,
+                                              Memory **dma_unit_registers) {
+  // The platform and DMA unit raise the IRQ and report their status through
+  // the status word instead
+  InterruptLineFree(irq);
+
+  GbaSignals *signals = GbaSignalsAllocate(emulator->cpu);
+  if (signals == NULL) {
+    return false;
+  }
+
+  bool success =
+      GbaPlatformAllocate(signals, &emulator->platform, platform_registers);
+  if (!success) {
+    GbaSignalsRelease(signals);
+    return false;
+  }
+
+  success = GbaDmaUnitAllocate(signals, emulator->platform, &emulator->dma,
+                               dma_unit_registers);
+  if (!success) {
+    GbaPlatformRelease(emulator->platform);
+    GbaSignalsRelease(signals);
+    return false;
+  }
+
+  emulator->signals = signals;
+  GbaSignalsRelease(signals);
+
+  return true;
+}
+#else
 static void GbaEmulatorPowerSet(void *context, PowerState power_state) {
   GbaEmulator *emulator = (GbaEmulator *)context;
   emulator->power_state = power_state;
@@ -58,11 +102,6 @@ static void GbaEmulatorPowerSet(void *context, PowerState power_state) {
   GbaEmulatorUpdateActiveBits(emulator);
 }
 
-static void GbaEmulatorPowerFree(void *context) {
-  GbaEmulator *emulator = (GbaEmulator *)context;
-  GbaEmulatorFree(emulator);
-}
-
 static void GbaEmulatorDmaStatusSet(void *context, bool active) {
   GbaEmulator *emulator = (GbaEmulator *)context;
 
@@ -74,69 +113,78 @@ static void GbaEmulatorDmaStatusSet(void *context, bool active) {
   GbaEmulatorUpdateActiveBits(emulator);
 }
 
-static void GbaEmulatorDmaStatusFree(void *context) {
-  GbaEmulator *emulator = (GbaEmulator *)context;
-  GbaEmulatorFree(emulator);
-}
+static bool GbaEmulatorAllocatePlatformAndDma(GbaEmulator *emulator,
+                                              InterruptLine *irq,
+                                              Memory **platform_registers,
+                                              Memory **dma_unit_registers) {
+  // The emulator owns the components which own the power and DMA status
+  // objects, so those objects do not hold a reference to the emulator
+  Power *power = PowerAllocate(emulator, GbaEmulatorPowerSet, NULL);
+  if (power == NULL) {
+    InterruptLineFree(irq);
+    return false;
+  }
 
-bool GbaEmulatorAllocate(const unsigned char *rom_data, uint32_t rom_size,
-                         GbaEmulator **emulator, GamePad **gamepad) {
-  *emulator = malloc(sizeof(GbaEmulator));
-  if (*emulator == NULL) {
+  bool success =
+      GbaPlatformAllocate(power, irq, &emulator->platform, platform_registers);
+  if (!success) {
+    PowerFree(power);
+    InterruptLineFree(irq);
     return false;
   }
 
-  (*emulator)->reference_count = 3;
+  DmaStatus *dma_status =
+      DmaStatusAllocate(emulator, GbaEmulatorDmaStatusSet, NULL);
+  if (dma_status == NULL) {
+    GbaPlatformRelease(emulator->platform);
+    return false;
+  }
+
+  success = GbaDmaUnitAllocate(dma_status, emulator->platform, &emulator->dma,
+                               dma_unit_registers);
+  if (!success) {
+    DmaStatusFree(dma_status);
+    GbaPlatformRelease(emulator->platform);
+    return false;
+  }
+
+  return true;
+}
+#endif  // WEBGBA_DIRECT_SIGNALS
+
+static bool GbaEmulatorAllocateComponents(MemoryBank *game_rom,
+                                          uint32_t rom_size,
+                                          GbaEmulator **emulator,
+                                          GamePad **gamepad) {
+  // Allocated first so that the fields read on every slice lead the arena,
+  // followed immediately by the CPU
+  *emulator = ArenaCalloc(1u, sizeof(GbaEmulator));
+  if (*emulator == NULL) {
+    MemoryBankFree(game_rom);
+    return false;
+  }
 
   InterruptLine *rst;
   InterruptLine *fiq;
   InterruptLine *irq;
   bool success = Arm7TdmiAllocate(&(*emulator)->cpu, &rst, &fiq, &irq);
   if ((*emulator)->cpu == NULL) {
-    free(*emulator);
+    MemoryBankFree(game_rom);
+    ArenaFreeAllocation(*emulator);
     return false;
   }
 
   InterruptLineFree(rst);
   InterruptLineFree(fiq);
 
-  Power *power =
-      PowerAllocate(*emulator, GbaEmulatorPowerSet, GbaEmulatorPowerFree);
-  if (power == NULL) {
-    Arm7TdmiFree((*emulator)->cpu);
-    InterruptLineFree(irq);
-    free(*emulator);
-    return false;
-  }
-
   Memory *platform_registers;
-  success = GbaPlatformAllocate(power, irq, &(*emulator)->platform,
-                                &platform_registers);
-  if (!success) {
-    PowerFree(power);
-    Arm7TdmiFree((*emulator)->cpu);
-    InterruptLineFree(irq);
-    free(*emulator);
-    return false;
-  }
-
-  DmaStatus *dma_status = DmaStatusAllocate(*emulator, GbaEmulatorDmaStatusSet,
-                                            GbaEmulatorDmaStatusFree);
-  if (dma_status == NULL) {
-    Arm7TdmiFree((*emulator)->cpu);
-    GbaPlatformRelease((*emulator)->platform);
-    free(*emulator);
-    return false;
-  }
-
   Memory *dma_unit_registers;
-  success = GbaDmaUnitAllocate(dma_status, (*emulator)->platform,
-                               &(*emulator)->dma, &dma_unit_registers);
+  success = GbaEmulatorAllocatePlatformAndDma(
+      *emulator, irq, &platform_registers, &dma_unit_registers);
   if (!success) {
-    DmaStatusFree(dma_status);
     Arm7TdmiFree((*emulator)->cpu);
-    GbaPlatformRelease((*emulator)->platform);
-    free(*emulator);
+    MemoryBankFree(game_rom);
+    ArenaFreeAllocation(*emulator);
     return false;
   }
 
@@ -147,7 +195,8 @@ bool GbaEmulatorAllocate(const unsigned char *rom_data, uint32_t rom_size,
     GbaDmaUnitRelease((*emulator)->dma);
     Arm7TdmiFree((*emulator)->cpu);
     GbaPlatformRelease((*emulator)->platform);
-    free(*emulator);
+    MemoryBankFree(game_rom);
+    ArenaFreeAllocation(*emulator);
     return false;
   }
 
@@ -159,24 +208,12 @@ bool GbaEmulatorAllocate(const unsigned char *rom_data, uint32_t rom_size,
     GbaDmaUnitRelease((*emulator)->dma);
     Arm7TdmiFree((*emulator)->cpu);
     GbaPlatformRelease((*emulator)->platform);
-    free(*emulator);
-    return false;
-  }
-
-  SaveStorageType storage_type;
-  MemoryBank *game_rom;
-  success = GbaGameLoad(rom_data, rom_size, &storage_type, &game_rom);
-  if (!success) {
-    GbaTimersFree((*emulator)->timers);
-    GbaSpuRelease((*emulator)->spu);
-    GbaDmaUnitRelease((*emulator)->dma);
-    Arm7TdmiFree((*emulator)->cpu);
-    GbaPlatformRelease((*emulator)->platform);
-    free(*emulator);
+    MemoryBankFree(game_rom);
+    ArenaFreeAllocation(*emulator);
     return false;
   }
 
-  // TODO: Implement SRAM
+  (*emulator)->rom_size = rom_size;
 
   Memory *peripherals_registers;
   success =
@@ -189,7 +226,7 @@ bool GbaEmulatorAllocate(const unsigned char *rom_data, uint32_t rom_size,
     GbaDmaUnitRelease((*emulator)->dma);
     Arm7TdmiFree((*emulator)->cpu);
     GbaPlatformRelease((*emulator)->platform);
-    free(*emulator);
+    ArenaFreeAllocation(*emulator);
     return false;
   }
 
@@ -209,7 +246,7 @@ bool GbaEmulatorAllocate(const unsigned char *rom_data, uint32_t rom_size,
     GbaDmaUnitRelease((*emulator)->dma);
     Arm7TdmiFree((*emulator)->cpu);
     GbaPlatformRelease((*emulator)->platform);
-    free(*emulator);
+    ArenaFreeAllocation(*emulator);
     return false;
   }
 
@@ -230,13 +267,133 @@ bool GbaEmulatorAllocate(const unsigned char *rom_data, uint32_t rom_size,
     GbaDmaUnitRelease((*emulator)->dma);
     Arm7TdmiFree((*emulator)->cpu);
     GbaPlatformRelease((*emulator)->platform);
-    free(*emulator);
+    ArenaFreeAllocation(*emulator);
     return false;
   }
 
   return true;
 }
 
+static bool GbaEmulatorAllocateInArena(MemoryBank *game_rom, uint32_t rom_size,
+                                       GbaEmulator **emulator,
+                                       GamePad **gamepad) {
+  Arena *arena = ArenaAllocate(GBA_EMULATOR_ARENA_SIZE);
+  if (arena == NULL) {
+    MemoryBankFree(game_rom);
+    return false;
+  }
+
+  Arena *previous_arena = ArenaMakeCurrent(arena);
+  bool success =
+      GbaEmulatorAllocateComponents(game_rom, rom_size, emulator, gamepad);
+  ArenaMakeCurrent(previous_arena);
+
+  if (!success) {
+    ArenaFree(arena);
+    return false;
+  }
+
+  (*emulator)->arena = arena;
+
+  return true;
+}
+
+bool GbaEmulatorAllocate(const unsigned char *rom_data, uint32_t rom_size,
+                         GbaEmulator **emulator, GamePad **gamepad) {
+  // The ROM is large and never written so it is kept out of the arena
+  SaveStorageType storage_type;
+  MemoryBank *game_rom;
+  Arena *previous_arena = ArenaMakeCurrent(NULL);
+  bool success = GbaGameLoad(rom_data, rom_size, &storage_type, &game_rom);
+  ArenaMakeCurrent(previous_arena);
+  if (!success) {
+    return false;
+  }
+
+  // TODO: Implement SRAM
+
+  return GbaEmulatorAllocateInArena(game_rom, rom_size, emulator, gamepad);
+}
+
+bool GbaEmulatorAllocateFromFile(const char *path, GbaEmulator **emulator,
+                                 GamePad **gamepad) {
+  SaveStorageType storage_type;
+  MemoryBank *game_rom;
+  uint32_t rom_size;
+  Arena *previous_arena = ArenaMakeCurrent(NULL);
+  bool success = GbaGameLoadFile(path, &rom_size, &storage_type, &game_rom);
+  ArenaMakeCurrent(previous_arena);
+  if (!success) {
+    return false;
+  }
+
+  return GbaEmulatorAllocateInArena(game_rom, rom_size, emulator, gamepad);
+}
+
+bool GbaEmulatorClone(const GbaEmulator *emulator, GbaEmulator **clone,
+                      GamePad **gamepad) {
+  MemoryBank *game_rom =
+      MemoryBankShare(MemoryGetBank(emulator->memory, 0x08000000u));
+  if (game_rom == NULL) {
+    return false;
+  }
+
+  bool success =
+      GbaEmulatorAllocateInArena(game_rom, emulator->rom_size, clone, gamepad);
+  if (!success) {
+    return false;
+  }
+
+  (*clone)->cpu_active = emulator->cpu_active;
+  (*clone)->dma_active = emulator->dma_active;
+  (*clone)->power_state = emulator->power_state;
+  (*clone)->dma_state = emulator->dma_state;
+#ifdef WEBGBA_DIRECT_SIGNALS
+  (*clone)->signals->power_state = emulator->signals->power_state;
+  (*clone)->signals->dma_active = emulator->signals->dma_active;
+#endif  // WEBGBA_DIRECT_SIGNALS
+
+  Arm7TdmiCopyState((*clone)->cpu, emulator->cpu);
+  GbaPlatformCopyState((*clone)->platform, emulator->platform);
+  GbaDmaUnitCopyState((*clone)->dma, emulator->dma);
+  GbaSpuCopyState((*clone)->spu, emulator->spu);
+  GbaTimersCopyState((*clone)->timers, emulator->timers);
+  GbaPeripheralsCopyState((*clone)->peripherals, emulator->peripherals);
+  GbaPpuCopyState((*clone)->ppu, emulator->ppu);
+  GbaMemoryCopyState((*clone)->memory, emulator->memory);
+
+  return true;
+}
+
+void GbaEmulatorReset(GbaEmulator *emulator) {
+  // The power and DMA status callbacks triggered by the platform and DMA unit
+  // resets restore the power state and the active bits
+  Arm7TdmiReset(emulator->cpu);
+  GbaPlatformReset(emulator->platform);
+  GbaDmaUnitReset(emulator->dma);
+  GbaSpuReset(emulator->spu);
+  GbaTimersReset(emulator->timers);
+  GbaPeripheralsReset(emulator->peripherals);
+  GbaPpuReset(emulator->ppu);
+  GbaMemoryReset(emulator->memory);
+}
+
+bool GbaEmulatorLoadRom(GbaEmulator *emulator, const unsigned char *rom_data,
+                        uint32_t rom_size) {
+  SaveStorageType storage_type;
+  bool success = GbaGameReload(rom_data, rom_size, emulator->rom_size,
+                               &storage_type,
+                               MemoryGetBank(emulator->memory, 0x08000000u));
+  if (!success) {
+    return false;
+  }
+
+  emulator->rom_size = rom_size;
+  GbaEmulatorReset(emulator);
+
+  return true;
+}
+
 void GbaEmulatorStep(GbaEmulator *emulator, Screen *screen,
                      const GbaGraphicsRenderOptions *graphics_renderer,
                      GbaEmulatorRenderAudioSample audio_sample_callback) {
@@ -253,9 +410,28 @@ void GbaEmulatorStep(GbaEmulator *emulator, Screen *screen,
       GbaPpuSetRenderMode(emulator->ppu, RENDER_MODE_SOFTWARE_PIXELS,
                           graphics_renderer->opengl_render_scale);
       break;
+    case GBA_RENDERER_SCANLINES_SOFTWARE_THREADED:
+      GbaPpuSetRenderMode(emulator->ppu, RENDER_MODE_SOFTWARE_ROWS_THREADED,
+                          graphics_renderer->opengl_render_scale);
+      break;
+    case GBA_RENDERER_SCANLINES_SOFTWARE_BANDS:
+      GbaPpuSetRenderMode(emulator->ppu, RENDER_MODE_SOFTWARE_ROWS_BANDS,
+                          graphics_renderer->opengl_render_scale);
+      break;
+    case GBA_RENDERER_NONE:
+      GbaPpuSetRenderMode(emulator->ppu, RENDER_MODE_NONE,
+                          graphics_renderer->opengl_render_scale);
+      break;
   }
 
   for (;;) {
+#ifdef WEBGBA_DIRECT_SIGNALS
+    // Picks up the power and DMA changes made during the previous slice
+    emulator->power_state = emulator->signals->power_state;
+    emulator->dma_state = emulator->signals->dma_active;
+    GbaEmulatorUpdateActiveBits(emulator);
+#endif  // WEBGBA_DIRECT_SIGNALS
+
     uint32_t cycles_elapsed = GbaTimersCyclesUntilNextWake(emulator->timers);
 
     uint32_t next_ppu_wake = GbaPpuCyclesUntilNextWake(emulator->ppu);
@@ -263,11 +439,6 @@ void GbaEmulatorStep(GbaEmulator *emulator, Screen *screen,
       cycles_elapsed = next_ppu_wake;
     }
 
-    uint32_t next_spu_wake = GbaSpuCyclesUntilNextWake(emulator->spu);
-    if (next_spu_wake < cycles_elapsed) {
-      cycles_elapsed = next_spu_wake;
-    }
-
     if (emulator->cpu_active) {
       assert(!emulator->dma_active);
       cycles_elapsed =
@@ -280,13 +451,19 @@ void GbaEmulatorStep(GbaEmulator *emulator, Screen *screen,
       break;
     }
 
-    GbaTimersStep(emulator->timers, cycles_elapsed);
+    // The SPU is stepped first so that FIFO samples popped by timer overflows
+    // land after the audio for the cycles that preceded them
     GbaSpuStep(emulator->spu, cycles_elapsed, audio_sample_callback);
+    GbaTimersStep(emulator->timers, cycles_elapsed);
     if (GbaPpuStep(emulator->ppu, screen, cycles_elapsed)) {
-      ScreenRenderToFramebuffer(screen, true);
+      if (graphics_renderer->renderer != GBA_RENDERER_NONE) {
+        ScreenRenderToFramebuffer(screen, true);
+      }
       break;
     }
   }
+
+  GbaSpuFlush(emulator->spu);
 }
 
 void GbaEmulatorReloadContext(GbaEmulator *emulator) {
@@ -294,17 +471,16 @@ void GbaEmulatorReloadContext(GbaEmulator *emulator) {
 }
 
 void GbaEmulatorFree(GbaEmulator *emulator) {
-  assert(emulator->reference_count != 0);
-  emulator->reference_count -= 1u;
-  if (emulator->reference_count == 0u) {
-    GbaPlatformRelease(emulator->platform);
-    Arm7TdmiFree(emulator->cpu);
-    MemoryFree(emulator->memory);
-    GbaDmaUnitRelease(emulator->dma);
-    GbaPpuFree(emulator->ppu);
-    GbaSpuRelease(emulator->spu);
-    GbaTimersFree(emulator->timers);
-    GbaPeripheralsFree(emulator->peripherals);
-    free(emulator);
-  }
+  // Releasing the components frees the parts of them that live on the heap
+  Arena *arena = emulator->arena;
+  GbaPlatformRelease(emulator->platform);
+  Arm7TdmiFree(emulator->cpu);
+  MemoryFree(emulator->memory);
+  GbaDmaUnitRelease(emulator->dma);
+  GbaPpuFree(emulator->ppu);
+  GbaSpuRelease(emulator->spu);
+  GbaTimersFree(emulator->timers);
+  GbaPeripheralsFree(emulator->peripherals);
+  ArenaFreeAllocation(emulator);
+  ArenaFree(arena);
 }
\ No newline at end of file
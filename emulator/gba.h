@@ -9,10 +9,33 @@
 
 typedef struct _GbaEmulator GbaEmulator;
 
-// TODO: Make ROMs reloadable without tearing down emulator.
 bool GbaEmulatorAllocate(const unsigned char *rom_data, uint32_t rom_size,
                          GbaEmulator **emulator, GamePad **gamepad);
 
+// Maps the ROM at path instead of reading it up front so that even the
+// largest ROMs start immediately and are paged in as they are used. Platforms
+// without mmap read the whole file instead.
+bool GbaEmulatorAllocateFromFile(const char *path, GbaEmulator **emulator,
+                                 GamePad **gamepad);
+
+// Creates an independent copy of a running emulator along with a gamepad
+// for it. The copy shares the ROM with the original but nothing else, so the
+// two may be stepped and freed on different threads. GbaEmulatorStep returns
+// at the end of a frame so the first frame of the clone is drawn in full,
+// unless the emulator was stopped partway through a frame. In that case the
+// clone draws nothing until the next frame begins.
+bool GbaEmulatorClone(const GbaEmulator *emulator, GbaEmulator **clone,
+                      GamePad **gamepad);
+
+// Returns the emulator to its power on state without reallocating it
+void GbaEmulatorReset(GbaEmulator *emulator);
+
+// Replaces the ROM in place and resets the emulator. On failure the emulator
+// is left unchanged. Save storage is not emulated yet, so there is no save
+// data to be preserved or reset and the save type of the new ROM is ignored.
+bool GbaEmulatorLoadRom(GbaEmulator *emulator, const unsigned char *rom_data,
+                        uint32_t rom_size);
+
 // Callback type for one sample's worth of audio data
 typedef void (*GbaEmulatorRenderAudioSample)(int16_t left, int16_t right);
 
@@ -20,6 +43,9 @@ typedef enum {
   GBA_RENDERER_SCANLINES_SOFTWARE,
   GBA_RENDERER_SCANLINES_OPENGL,
   GBA_RENDERER_PIXELS_SOFTWARE,
+  GBA_RENDERER_SCANLINES_SOFTWARE_THREADED,
+  GBA_RENDERER_SCANLINES_SOFTWARE_BANDS,
+  GBA_RENDERER_NONE,  // Emulates the frame without drawing or presenting it
 } GbaGraphicsRenderer;
 
 typedef struct {
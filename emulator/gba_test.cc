@@ -2,6 +2,12 @@ extern "C" {
 #include "emulator/gba.h"
 }
 
+#include <unistd.h>
+
+#include <cstdlib>
+#include <thread>
+#include <vector>
+
 #include "googletest/include/gtest/gtest.h"
 
 class GbaEmulatorTest : public testing::Test {
@@ -22,6 +28,83 @@ class GbaEmulatorTest : public testing::Test {
   static void AudioCallback(int16_t left, int16_t right) {}
 
  protected:
+  // Steps a program with inner_renderer while the BIOS boots into it and with
+  // outer_renderer before and after that, alongside a clone that is only ever
+  // drawn with the software scanline renderer. Frames skipped with
+  // GBA_RENDERER_NONE must leave the screen untouched, and every other frame
+  // must match the clone's.
+  void ExpectMatchesSoftwareRendering(GbaGraphicsRenderer outer_renderer,
+                                      GbaGraphicsRenderer inner_renderer) {
+    // Writes red into the backdrop color once the BIOS has booted into it,
+    // which happens while frames are still being skipped
+    static const uint32_t program[] = {
+        0xE3A00301u,  // mov r0, #0x04000000
+        0xE3A01000u,  // mov r1, #0
+        0xE1C010B0u,  // strh r1, [r0]
+        0xE3A02405u,  // mov r2, #0x05000000
+        0xE3A0101Fu,  // mov r1, #0x1F
+        0xE1C210B0u,  // strh r1, [r2]
+        0xEAFFFFFEu,  // b .
+    };
+
+    GbaEmulator *gba;
+    GamePad *gamepad;
+    ASSERT_TRUE(GbaEmulatorAllocate((const unsigned char *)program,
+                                    sizeof(program), &gba, &gamepad));
+
+    GbaEmulator *reference;
+    GamePad *reference_gamepad;
+    ASSERT_TRUE(GbaEmulatorClone(gba, &reference, &reference_gamepad));
+
+    Screen *reference_screen = ScreenAllocate();
+    ASSERT_TRUE(reference_screen);
+
+    std::vector<uint32_t> pixels(240u * 160u);
+    ScreenAttachPixelBuffer(screen_, pixels.data(), 240u, 160u,
+                            SCREEN_PIXEL_FORMAT_XRGB8888, 240u * 4u, false);
+
+    std::vector<uint32_t> reference_pixels(240u * 160u);
+    ScreenAttachPixelBuffer(reference_screen, reference_pixels.data(), 240u,
+                            160u, SCREEN_PIXEL_FORMAT_XRGB8888, 240u * 4u,
+                            false);
+
+    GbaGraphicsRenderOptions options;
+    options.opengl_render_scale = 1u;
+
+    GbaGraphicsRenderOptions reference_options;
+    reference_options.renderer = GBA_RENDERER_SCANLINES_SOFTWARE;
+    reference_options.opengl_render_scale = 1u;
+
+    const std::vector<uint32_t> untouched(pixels.size(), 0x12345678u);
+
+    for (int i = 0; i < 154; i++) {
+      options.renderer = (10 <= i && i < 150) ? inner_renderer : outer_renderer;
+
+      pixels.assign(pixels.size(), 0x12345678u);
+      GbaEmulatorStep(gba, screen_, &options, AudioCallback);
+      GbaEmulatorStep(reference, reference_screen, &reference_options,
+                      AudioCallback);
+
+      if (options.renderer == GBA_RENDERER_NONE) {
+        EXPECT_EQ(untouched, pixels);
+      } else {
+        EXPECT_EQ(reference_pixels, pixels);
+      }
+    }
+
+    ScreenAttachPixelBuffer(screen_, nullptr, 240u, 160u,
+                            SCREEN_PIXEL_FORMAT_XRGB8888, 240u * 4u, false);
+
+    // The program's backdrop is drawn rather than the BIOS's
+    EXPECT_EQ(0xFF0000u, pixels[0u]);
+
+    GbaEmulatorFree(gba);
+    GamePadFree(gamepad);
+    GbaEmulatorFree(reference);
+    GamePadFree(reference_gamepad);
+    ScreenFree(reference_screen);
+  }
+
   GbaEmulator *gba_;
   GamePad *gamepad_;
   Screen *screen_;
@@ -32,4 +115,248 @@ TEST_F(GbaEmulatorTest, EmptyTest) {
   options.renderer = GBA_RENDERER_PIXELS_SOFTWARE;
   options.opengl_render_scale = 1u;
   GbaEmulatorStep(gba_, screen_, &options, AudioCallback);
+}
+
+TEST_F(GbaEmulatorTest, SkipRendering) {
+  static const GbaGraphicsRenderer renderers[] = {
+      GBA_RENDERER_SCANLINES_SOFTWARE, GBA_RENDERER_SCANLINES_SOFTWARE_THREADED,
+      GBA_RENDERER_SCANLINES_SOFTWARE_BANDS};
+
+  // Renderers that snapshot video memory rely on the writes made while
+  // rendering was skipped still being marked dirty
+  for (GbaGraphicsRenderer renderer : renderers) {
+    ExpectMatchesSoftwareRendering(renderer, GBA_RENDERER_NONE);
+  }
+}
+
+TEST_F(GbaEmulatorTest, ThreadedSoftwareRendering) {
+  ExpectMatchesSoftwareRendering(GBA_RENDERER_SCANLINES_SOFTWARE,
+                                 GBA_RENDERER_SCANLINES_SOFTWARE_THREADED);
+}
+
+TEST_F(GbaEmulatorTest, SoftwareRenderingInBands) {
+  ExpectMatchesSoftwareRendering(GBA_RENDERER_SCANLINES_SOFTWARE,
+                                 GBA_RENDERER_SCANLINES_SOFTWARE_BANDS);
+}
+
+TEST_F(GbaEmulatorTest, HBlankDma) {
+  // Copies red into the backdrop color on every HBlank, halting the CPU for
+  // each transfer, while the CPU turns forced blank on for the bottom half of
+  // the screen and off for the top
+  static const uint32_t program[] = {
+      0xE3A00301u,  // mov r0, #0x04000000
+      0xE28020D4u,  // add r2, r0, #0xD4
+      0xE28F303Cu,  // adr r3, color
+      0xE5823000u,  // str r3, [r2]
+      0xE3A04405u,  // mov r4, #0x05000000
+      0xE5824004u,  // str r4, [r2, #4]
+      0xE59F5030u,  // ldr r5, control
+      0xE5825008u,  // str r5, [r2, #8]
+      0xE3A01000u,  // top: mov r1, #0
+      0xE1C010B0u,  // strh r1, [r0]
+      0xE1D060B6u,  // wait_bottom: ldrh r6, [r0, #6]
+      0xE3560050u,  // cmp r6, #80
+      0x3AFFFFFCu,  // blo wait_bottom
+      0xE3A01080u,  // mov r1, #0x80
+      0xE1C010B0u,  // strh r1, [r0]
+      0xE1D060B6u,  // wait_top: ldrh r6, [r0, #6]
+      0xE3560050u,  // cmp r6, #80
+      0x2AFFFFFCu,  // bhs wait_top
+      0xEAFFFFF4u,  // b top
+      0x0000001Fu,  // color: red
+      0xA3400001u,  // control: HBlank, repeat, fixed addresses, 1 halfword
+  };
+
+  GbaEmulator *gba;
+  GamePad *gamepad;
+  ASSERT_TRUE(GbaEmulatorAllocate((const unsigned char *)program,
+                                  sizeof(program), &gba, &gamepad));
+
+  std::vector<uint32_t> pixels(240u * 160u);
+  ScreenAttachPixelBuffer(screen_, pixels.data(), 240u, 160u,
+                          SCREEN_PIXEL_FORMAT_XRGB8888, 240u * 4u, false);
+
+  GbaGraphicsRenderOptions options;
+  options.renderer = GBA_RENDERER_SCANLINES_SOFTWARE;
+  options.opengl_render_scale = 1u;
+
+  // Leaves time for the BIOS to boot into the program
+  for (int i = 0; i < 200; i++) {
+    GbaEmulatorStep(gba, screen_, &options, AudioCallback);
+  }
+
+  // The bottom half is only blanked if the CPU resumes between transfers
+  EXPECT_EQ(0xFF0000u, pixels[40u * 240u]);
+  EXPECT_EQ(0u, pixels[120u * 240u]);
+
+  ScreenAttachPixelBuffer(screen_, nullptr, 240u, 160u,
+                          SCREEN_PIXEL_FORMAT_XRGB8888, 240u * 4u, false);
+
+  GbaEmulatorFree(gba);
+  GamePadFree(gamepad);
+}
+
+TEST_F(GbaEmulatorTest, Reset) {
+  GbaGraphicsRenderOptions options;
+  options.renderer = GBA_RENDERER_NONE;
+  options.opengl_render_scale = 1u;
+  GbaEmulatorStep(gba_, screen_, &options, AudioCallback);
+  GbaEmulatorReset(gba_);
+  GbaEmulatorStep(gba_, screen_, &options, AudioCallback);
+}
+
+TEST_F(GbaEmulatorTest, LoadRom) {
+  static const unsigned char rom[200] = {};
+  EXPECT_TRUE(GbaEmulatorLoadRom(gba_, rom, 200u));
+  EXPECT_TRUE(GbaEmulatorLoadRom(gba_, rom, 50u));
+  EXPECT_FALSE(GbaEmulatorLoadRom(gba_, rom, 0x2000001u));
+
+  GbaGraphicsRenderOptions options;
+  options.renderer = GBA_RENDERER_NONE;
+  options.opengl_render_scale = 1u;
+  GbaEmulatorStep(gba_, screen_, &options, AudioCallback);
+}
+
+TEST_F(GbaEmulatorTest, AllocateFromFile) {
+  GbaEmulator *gba;
+  GamePad *gamepad;
+  EXPECT_FALSE(GbaEmulatorAllocateFromFile("/nonexistent/game.gba", &gba,
+                                           &gamepad));
+  EXPECT_FALSE(GbaEmulatorAllocateFromFile("/tmp", &gba, &gamepad));
+
+  char path[] = "/tmp/webgba_rom_XXXXXX";
+  int fd = mkstemp(path);
+  ASSERT_GE(fd, 0);
+  EXPECT_FALSE(GbaEmulatorAllocateFromFile(path, &gba, &gamepad));
+
+  static const unsigned char rom[5000] = {};
+  ASSERT_EQ(5000, write(fd, rom, sizeof(rom)));
+  close(fd);
+
+  ASSERT_TRUE(GbaEmulatorAllocateFromFile(path, &gba, &gamepad));
+  unlink(path);
+
+  GbaGraphicsRenderOptions options;
+  options.renderer = GBA_RENDERER_NONE;
+  options.opengl_render_scale = 1u;
+  GbaEmulatorStep(gba, screen_, &options, AudioCallback);
+
+  GbaEmulator *clone;
+  GamePad *clone_gamepad;
+  ASSERT_TRUE(GbaEmulatorClone(gba, &clone, &clone_gamepad));
+
+  // Reloading replaces the mapping rather than writing through it
+  EXPECT_TRUE(GbaEmulatorLoadRom(gba, rom, 200u));
+  GbaEmulatorStep(gba, screen_, &options, AudioCallback);
+  GbaEmulatorStep(clone, screen_, &options, AudioCallback);
+
+  GbaEmulatorFree(gba);
+  GamePadFree(gamepad);
+  GbaEmulatorStep(clone, screen_, &options, AudioCallback);
+  GbaEmulatorFree(clone);
+  GamePadFree(clone_gamepad);
+}
+
+TEST_F(GbaEmulatorTest, Clone) {
+  static const GbaGraphicsRenderer renderers[] = {
+      GBA_RENDERER_SCANLINES_SOFTWARE, GBA_RENDERER_PIXELS_SOFTWARE,
+      GBA_RENDERER_SCANLINES_SOFTWARE_THREADED,
+      GBA_RENDERER_SCANLINES_SOFTWARE_BANDS};
+
+  Screen *clone_screen = ScreenAllocate();
+  ASSERT_TRUE(clone_screen);
+
+  std::vector<uint32_t> pixels(240u * 160u);
+  ScreenAttachPixelBuffer(screen_, pixels.data(), 240u, 160u,
+                          SCREEN_PIXEL_FORMAT_XRGB8888, 240u * 4u, false);
+
+  std::vector<uint32_t> clone_pixels(240u * 160u);
+  ScreenAttachPixelBuffer(clone_screen, clone_pixels.data(), 240u, 160u,
+                          SCREEN_PIXEL_FORMAT_XRGB8888, 240u * 4u, false);
+
+  for (GbaGraphicsRenderer renderer : renderers) {
+    GbaGraphicsRenderOptions options;
+    options.renderer = renderer;
+    options.opengl_render_scale = 1u;
+    GbaEmulatorStep(gba_, screen_, &options, AudioCallback);
+    GbaEmulatorStep(gba_, screen_, &options, AudioCallback);
+
+    GbaEmulator *clone;
+    GamePad *clone_gamepad;
+    ASSERT_TRUE(GbaEmulatorClone(gba_, &clone, &clone_gamepad));
+
+    // Clones are made between frames so the first frame of the clone covers
+    // the whole screen
+    for (int i = 0; i < 3; i++) {
+      clone_pixels.assign(clone_pixels.size(), 0x12345678u);
+      GbaEmulatorStep(gba_, screen_, &options, AudioCallback);
+      GbaEmulatorStep(clone, clone_screen, &options, AudioCallback);
+      EXPECT_EQ(pixels, clone_pixels);
+    }
+
+    GbaEmulatorFree(clone);
+    GamePadFree(clone_gamepad);
+  }
+
+  ScreenAttachPixelBuffer(screen_, nullptr, 240u, 160u,
+                          SCREEN_PIXEL_FORMAT_XRGB8888, 240u * 4u, false);
+  ScreenFree(clone_screen);
+}
+
+TEST_F(GbaEmulatorTest, CloneOutlivesOriginal) {
+  GbaEmulator *clone;
+  GamePad *clone_gamepad;
+  ASSERT_TRUE(GbaEmulatorClone(gba_, &clone, &clone_gamepad));
+
+  GbaEmulatorFree(gba_);
+  GamePadFree(gamepad_);
+  gba_ = clone;
+  gamepad_ = clone_gamepad;
+
+  GbaGraphicsRenderOptions options;
+  options.renderer = GBA_RENDERER_NONE;
+  options.opengl_render_scale = 1u;
+  GbaEmulatorStep(gba_, screen_, &options, AudioCallback);
+}
+
+TEST_F(GbaEmulatorTest, CloneRunsOnAnotherThread) {
+  GbaEmulator *clone;
+  GamePad *clone_gamepad;
+  ASSERT_TRUE(GbaEmulatorClone(gba_, &clone, &clone_gamepad));
+
+  GbaGraphicsRenderOptions options;
+  options.renderer = GBA_RENDERER_NONE;
+  options.opengl_render_scale = 1u;
+
+  std::thread thread([&]() {
+    Screen *clone_screen = ScreenAllocate();
+    ASSERT_TRUE(clone_screen);
+    GbaEmulatorStep(clone, clone_screen, &options, AudioCallback);
+    GbaEmulatorStep(clone, clone_screen, &options, AudioCallback);
+    GbaEmulatorFree(clone);
+    GamePadFree(clone_gamepad);
+    ScreenFree(clone_screen);
+  });
+
+  GbaEmulatorStep(gba_, screen_, &options, AudioCallback);
+  GbaEmulatorStep(gba_, screen_, &options, AudioCallback);
+  thread.join();
+}
+
+TEST_F(GbaEmulatorTest, LoadRomIntoClone) {
+  GbaEmulator *clone;
+  GamePad *clone_gamepad;
+  ASSERT_TRUE(GbaEmulatorClone(gba_, &clone, &clone_gamepad));
+
+  static const unsigned char rom[200] = {};
+  EXPECT_TRUE(GbaEmulatorLoadRom(clone, rom, 200u));
+
+  GbaGraphicsRenderOptions options;
+  options.renderer = GBA_RENDERER_NONE;
+  options.opengl_render_scale = 1u;
+  GbaEmulatorStep(clone, screen_, &options, AudioCallback);
+  GbaEmulatorStep(gba_, screen_, &options, AudioCallback);
+
+  GbaEmulatorFree(clone);
+  GamePadFree(clone_gamepad);
 }
\ No newline at end of file
@@ -1,9 +1,19 @@
 #include "emulator/memory/gba/io/io.h"
 
-#include <stdlib.h>
+#include "emulator/arena.h"
+
+#define IO_MEMORY_SIZE 0x400u
+
+// One entry per halfword of the I/O page. Loads of registers with storage are
+// served directly, everything else goes straight to the owning device.
+typedef struct {
+  const uint16_t* storage;
+  Memory* device;
+  uint32_t base;
+} IoRegister;
 
 typedef struct {
-  Memory* banks[32u];
+  IoRegister registers[IO_MEMORY_SIZE >> 1u];
   Memory* ppu;
   Memory* sound;
   Memory* dma;
@@ -12,91 +22,92 @@ typedef struct {
   Memory* platform;
 } IoMemory;
 
-static Memory* IoMemorySelectBank(const IoMemory* memory, uint32_t* address) {
-  uint32_t bank = *address >> 4u;
-
-  if (bank >= 32u) {
-    *address -= 0x200u;
-    return memory->platform;
+static const IoRegister* IoMemorySelectRegister(const IoMemory* memory,
+                                                uint32_t address) {
+  if (address >= IO_MEMORY_SIZE) {
+    return NULL;
   }
 
-  static const uint32_t bank_base[32] = {
-      0x000u,  // 0x000
-      0x000u,  // 0x010
-      0x000u,  // 0x020
-      0x000u,  // 0x030
-      0x000u,  // 0x040
-      0x000u,  // 0x050
-      0x060u,  // 0x060
-      0x060u,  // 0x070
-      0x060u,  // 0x080
-      0x060u,  // 0x090
-      0x060u,  // 0x0A0
-      0x0B0u,  // 0x0B0
-      0x0B0u,  // 0x0C0
-      0x0B0u,  // 0x0D0
-      0x0B0u,  // 0x0E0
-      0x0B0u,  // 0x0F0
-      0x100u,  // 0x100
-      0x100u,  // 0x110
-      0x120u,  // 0x120
-      0x120u,  // 0x130
-      0x120u,  // 0x140
-      0x120u,  // 0x150
-      0x120u,  // 0x160
-      0x120u,  // 0x170
-      0x120u,  // 0x180
-      0x120u,  // 0x190
-      0x120u,  // 0x1A0
-      0x120u,  // 0x1B0
-      0x120u,  // 0x1C0
-      0x120u,  // 0x1D0
-      0x120u,  // 0x1E0
-      0x120u,  // 0x1F0
-  };
-
-  *address -= bank_base[bank];
-
-  return memory->banks[bank];
+  return &memory->registers[address >> 1u];
 }
 
 static bool IoMemoryLoad32LE(const void* context, uint32_t address,
                              uint32_t* value) {
   const IoMemory* io_memory = (const IoMemory*)context;
-  Memory* memory = IoMemorySelectBank(io_memory, &address);
-  return Load32LE(memory, address, value);
+  const IoRegister* reg = IoMemorySelectRegister(io_memory, address);
+  if (reg == NULL) {
+    return Load32LE(io_memory->platform, address - 0x200u, value);
+  }
+
+  if ((address & 0x3u) == 0u && reg[0u].storage != NULL &&
+      reg[1u].storage != NULL) {
+    *value = ((uint32_t)*reg[1u].storage << 16u) | *reg[0u].storage;
+    return true;
+  }
+
+  return Load32LE(reg->device, address - reg->base, value);
 }
 
 static bool IoMemoryLoad16LE(const void* context, uint32_t address,
                              uint16_t* value) {
   const IoMemory* io_memory = (const IoMemory*)context;
-  Memory* memory = IoMemorySelectBank(io_memory, &address);
-  return Load16LE(memory, address, value);
+  const IoRegister* reg = IoMemorySelectRegister(io_memory, address);
+  if (reg == NULL) {
+    return Load16LE(io_memory->platform, address - 0x200u, value);
+  }
+
+  if ((address & 0x1u) == 0u && reg->storage != NULL) {
+    *value = *reg->storage;
+    return true;
+  }
+
+  return Load16LE(reg->device, address - reg->base, value);
 }
 
 static bool IoMemoryLoad8(const void* context, uint32_t address,
                           uint8_t* value) {
   const IoMemory* io_memory = (const IoMemory*)context;
-  Memory* memory = IoMemorySelectBank(io_memory, &address);
-  return Load8(memory, address, value);
+  const IoRegister* reg = IoMemorySelectRegister(io_memory, address);
+  if (reg == NULL) {
+    return Load8(io_memory->platform, address - 0x200u, value);
+  }
+
+  if (reg->storage != NULL) {
+    *value = *reg->storage >> ((address & 0x1u) << 3u);
+    return true;
+  }
+
+  return Load8(reg->device, address - reg->base, value);
 }
 
 static bool IoMemoryStore32LE(void* context, uint32_t address, uint32_t value) {
   IoMemory* io_memory = (IoMemory*)context;
-  Memory* memory = IoMemorySelectBank(io_memory, &address);
-  return Store32LE(memory, address, value);
+  const IoRegister* reg = IoMemorySelectRegister(io_memory, address);
+  if (reg == NULL) {
+    return Store32LE(io_memory->platform, address - 0x200u, value);
+  }
+
+  return Store32LE(reg->device, address - reg->base, value);
 }
 
 static bool IoMemoryStore16LE(void* context, uint32_t address, uint16_t value) {
   IoMemory* io_memory = (IoMemory*)context;
-  Memory* memory = IoMemorySelectBank(io_memory, &address);
-  return Store16LE(memory, address, value);
+  const IoRegister* reg = IoMemorySelectRegister(io_memory, address);
+  if (reg == NULL) {
+    return Store16LE(io_memory->platform, address - 0x200u, value);
+  }
+
+  return Store16LE(reg->device, address - reg->base, value);
 }
 
 static bool IoMemoryStore8(void* context, uint32_t address, uint8_t value) {
   IoMemory* io_memory = (IoMemory*)context;
-  Memory* memory = IoMemorySelectBank(io_memory, &address);
-  return Store8(memory, address, value);
+  const IoRegister* reg = IoMemorySelectRegister(io_memory, address);
+  if (reg == NULL) {
+    return Store8(io_memory->platform, address - 0x200u, value);
+  }
+
+  return Store8(reg->device, address - reg->base, value);
 }
 
 static void IoMemoryFree(void* context) {
@@ -107,48 +118,75 @@ static void IoMemoryFree(void* context) {
   MemoryFree(io_memory->timer);
   MemoryFree(io_memory->peripherals);
   MemoryFree(io_memory->platform);
-  free(io_memory);
+  ArenaFreeAllocation(io_memory);
 }
 
 Memory* IoMemoryAllocate(Memory* ppu, Memory* sound, Memory* dma, Memory* timer,
                          Memory* peripherals, Memory* platform) {
-  IoMemory* io_memory = (IoMemory*)malloc(sizeof(IoMemory));
+  IoMemory* io_memory = (IoMemory*)ArenaCalloc(1u, sizeof(IoMemory));
   if (io_memory == NULL) {
     return NULL;
   }
 
-  io_memory->banks[0x00u] = ppu;
-  io_memory->banks[0x01u] = ppu;
-  io_memory->banks[0x02u] = ppu;
-  io_memory->banks[0x03u] = ppu;
-  io_memory->banks[0x04u] = ppu;
-  io_memory->banks[0x05u] = ppu;
-  io_memory->banks[0x06u] = sound;
-  io_memory->banks[0x07u] = sound;
-  io_memory->banks[0x08u] = sound;
-  io_memory->banks[0x09u] = sound;
-  io_memory->banks[0x0Au] = sound;
-  io_memory->banks[0x0Bu] = dma;
-  io_memory->banks[0x0Cu] = dma;
-  io_memory->banks[0x0Du] = dma;
-  io_memory->banks[0x0Eu] = dma;
-  io_memory->banks[0x0Fu] = dma;
-  io_memory->banks[0x10u] = timer;
-  io_memory->banks[0x11u] = timer;
-  io_memory->banks[0x12u] = peripherals;
-  io_memory->banks[0x13u] = peripherals;
-  io_memory->banks[0x14u] = peripherals;
-  io_memory->banks[0x15u] = peripherals;
-  io_memory->banks[0x16u] = peripherals;
-  io_memory->banks[0x17u] = peripherals;
-  io_memory->banks[0x18u] = peripherals;
-  io_memory->banks[0x19u] = peripherals;
-  io_memory->banks[0x1Au] = peripherals;
-  io_memory->banks[0x1Bu] = peripherals;
-  io_memory->banks[0x1Cu] = peripherals;
-  io_memory->banks[0x1Du] = peripherals;
-  io_memory->banks[0x1Eu] = peripherals;
-  io_memory->banks[0x1Fu] = peripherals;
+  static const uint32_t bank_base[32] = {
+      0x000u,  // 0x000
+      0x000u,  // 0x010
+      0x000u,  // 0x020
+      0x000u,  // 0x030
+      0x000u,  // 0x040
+      0x000u,  // 0x050
+      0x060u,  // 0x060
+      0x060u,  // 0x070
+      0x060u,  // 0x080
+      0x060u,  // 0x090
+      0x060u,  // 0x0A0
+      0x0B0u,  // 0x0B0
+      0x0B0u,  // 0x0C0
+      0x0B0u,  // 0x0D0
+      0x0B0u,  // 0x0E0
+      0x0B0u,  // 0x0F0
+      0x100u,  // 0x100
+      0x100u,  // 0x110
+      0x120u,  // 0x120
+      0x120u,  // 0x130
+      0x120u,  // 0x140
+      0x120u,  // 0x150
+      0x120u,  // 0x160
+      0x120u,  // 0x170
+      0x120u,  // 0x180
+      0x120u,  // 0x190
+      0x120u,  // 0x1A0
+      0x120u,  // 0x1B0
+      0x120u,  // 0x1C0
+      0x120u,  // 0x1D0
+      0x120u,  // 0x1E0
+      0x120u,  // 0x1F0
+  };
+
+  Memory* banks[32u] = {
+      ppu,         ppu,         ppu,         ppu,         ppu,
+      ppu,         sound,       sound,       sound,       sound,
+      sound,       dma,         dma,         dma,         dma,
+      dma,         timer,       timer,       peripherals, peripherals,
+      peripherals, peripherals, peripherals, peripherals, peripherals,
+      peripherals, peripherals, peripherals, peripherals, peripherals,
+      peripherals, peripherals,
+  };
+
+  for (uint32_t address = 0u; address < IO_MEMORY_SIZE; address += 2u) {
+    IoRegister* reg = &io_memory->registers[address >> 1u];
+
+    uint32_t bank = address >> 4u;
+    if (bank >= 32u) {
+      reg->device = platform;
+      reg->base = 0x200u;
+    } else {
+      reg->device = banks[bank];
+      reg->base = bank_base[bank];
+    }
+
+    reg->storage = MemoryGetRegisterStorage(reg->device, address - reg->base);
+  }
 
   io_memory->ppu = ppu;
   io_memory->sound = sound;
@@ -161,7 +199,7 @@ Memory* IoMemoryAllocate(Memory* ppu, Memory* sound, Memory* dma, Memory* timer,
       io_memory, IoMemoryLoad32LE, IoMemoryLoad16LE, IoMemoryLoad8,
       IoMemoryStore32LE, IoMemoryStore16LE, IoMemoryStore8, IoMemoryFree);
   if (result == NULL) {
-    free(io_memory);
+    ArenaFreeAllocation(io_memory);
     return NULL;
   }
 
@@ -6,31 +6,16 @@ extern "C" {
 
 class IoMemoryTest : public testing::Test {
  public:
-  void SetUp() override {
-    banks_[0u] =
-        MemoryAllocate(banks_ + 0u, Load32LEFunc, Load16LEFunc, Load8Func,
-                       Store32LEFunc, Store16LEFunc, Store8Func, nullptr);
-    ASSERT_NE(nullptr, banks_[0u]);
-    banks_[1u] =
-        MemoryAllocate(banks_ + 1u, Load32LEFunc, Load16LEFunc, Load8Func,
-                       Store32LEFunc, Store16LEFunc, Store8Func, nullptr);
-    ASSERT_NE(nullptr, banks_[1u]);
-    banks_[2u] =
-        MemoryAllocate(banks_ + 2u, Load32LEFunc, Load16LEFunc, Load8Func,
-                       Store32LEFunc, Store16LEFunc, Store8Func, nullptr);
-    ASSERT_NE(nullptr, banks_[2u]);
-    banks_[3u] =
-        MemoryAllocate(banks_ + 3u, Load32LEFunc, Load16LEFunc, Load8Func,
-                       Store32LEFunc, Store16LEFunc, Store8Func, nullptr);
-    ASSERT_NE(nullptr, banks_[3u]);
-    banks_[4u] =
-        MemoryAllocate(banks_ + 4u, Load32LEFunc, Load16LEFunc, Load8Func,
-                       Store32LEFunc, Store16LEFunc, Store8Func, nullptr);
-    ASSERT_NE(nullptr, banks_[4u]);
-    banks_[5u] =
-        MemoryAllocate(banks_ + 5u, Load32LEFunc, Load16LEFunc, Load8Func,
-                       Store32LEFunc, Store16LEFunc, Store8Func, nullptr);
-    ASSERT_NE(nullptr, banks_[5u]);
+  void SetUp() override { Allocate(nullptr); }
+
+  void Allocate(RegisterStorageFunction peripherals_storage) {
+    for (size_t i = 0u; i < 6u; i++) {
+      banks_[i] =
+          MemoryAllocate(banks_ + i, Load32LEFunc, Load16LEFunc, Load8Func,
+                         Store32LEFunc, Store16LEFunc, Store8Func, nullptr);
+      ASSERT_NE(nullptr, banks_[i]);
+    }
+    MemorySetRegisterStorage(banks_[4u], peripherals_storage);
     io_ = IoMemoryAllocate(banks_[0u], banks_[1u], banks_[2u], banks_[3u],
                            banks_[4u], banks_[5u]);
     ASSERT_NE(nullptr, io_);
@@ -192,4 +177,42 @@ TEST_F(IoMemoryTest, PlatformBank) {
   for (uint32_t addr = 0x200u; addr < 0x100000u; addr++) {
     TestAddress(addr, 5u, addr - 0x200u, 0x12345678u, 0x4321u, 0xABu);
   }
+}
+
+static uint16_t register_storage[2u];
+
+static const uint16_t *RegisterStorageFunc(const void *context,
+                                           uint32_t address) {
+  return (address < 4u) ? &register_storage[address >> 1u] : nullptr;
+}
+
+TEST_F(IoMemoryTest, RegisterStorage) {
+  MemoryFree(io_);
+  Allocate(RegisterStorageFunc);
+
+  register_storage[0u] = 0x1234u;
+  register_storage[1u] = 0x5678u;
+
+  expected_bank_ = (size_t)-1;
+
+  uint32_t value32;
+  EXPECT_TRUE(Load32LE(io_, 0x120u, &value32));
+  EXPECT_EQ(0x56781234u, value32);
+
+  uint16_t value16;
+  EXPECT_TRUE(Load16LE(io_, 0x122u, &value16));
+  EXPECT_EQ(0x5678u, value16);
+
+  uint8_t value8;
+  EXPECT_TRUE(Load8(io_, 0x121u, &value8));
+  EXPECT_EQ(0x12u, value8);
+
+  expected_bank_ = 4u;
+  expected_address_ = 0u;
+  expected16_ = 0xABCDu;
+  expected_response_ = true;
+  EXPECT_TRUE(Store16LE(io_, 0x120u, 0xABCDu));
+  EXPECT_EQ(0x1234u, register_storage[0u]);
+
+  TestAddress(0x124u, 4u, 4u, 0x12345678u, 0x4321u, 0xABu);
 }
\ No newline at end of file
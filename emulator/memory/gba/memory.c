@@ -3,6 +3,7 @@
 #include <assert.h>
 #include <stdlib.h>
 
+#include "emulator/arena.h"
 #include "emulator/memory/gba/bad/bad.h"
 #include "emulator/memory/gba/bios/bios.h"
 #include "emulator/memory/gba/io/io.h"
@@ -10,6 +11,7 @@
 
 #define IWRAM_SIZE (32u * 1024u)
 #define EWRAM_SIZE (256u * 1024u)
+#define RAM_PAGE_SIZE 256u
 #define NUMBER_OF_MEMORY_BANKS 256u
 
 typedef struct {
@@ -20,6 +22,7 @@ typedef struct {
   Memory* vram;
   Memory* oam;
   Memory* bad;
+  MemoryBank* sram;
 } GbaMemory;
 
 static Memory* GbaMemorySelectBank(const GbaMemory* memory, uint32_t* address) {
@@ -144,7 +147,8 @@ static void GbaMemoryFree(void* context) {
   MemoryFree(gba_memory->vram);
   MemoryFree(gba_memory->oam);
   MemoryFree(gba_memory->bad);
-  free(gba_memory);
+  MemoryBankFree(gba_memory->sram);
+  ArenaFreeAllocation(gba_memory);
 }
 
 Memory* GbaMemoryAllocate(Memory* ppu_registers, Memory* sound_registers,
@@ -152,28 +156,28 @@ Memory* GbaMemoryAllocate(Memory* ppu_registers, Memory* sound_registers,
                           Memory* peripheral_registers,
                           Memory* platform_registers, Memory* palette,
                           Memory* vram, Memory* oam, MemoryBank* game) {
-  GbaMemory* gba_memory = (GbaMemory*)malloc(sizeof(GbaMemory));
+  GbaMemory* gba_memory = (GbaMemory*)ArenaCalloc(1u, sizeof(GbaMemory));
   if (gba_memory == NULL) {
     return NULL;
   }
 
   Memory* bad_internal = BadMemoryAllocate();
   if (bad_internal == NULL) {
-    free(gba_memory);
+    ArenaFreeAllocation(gba_memory);
     return false;
   }
 
   Memory* bad = OpenBusAllocate(bad_internal);
   if (bad == NULL) {
     MemoryFree(bad_internal);
-    free(gba_memory);
+    ArenaFreeAllocation(gba_memory);
     return NULL;
   }
 
   Memory* bios_internal = GBABiosAllocate();
   if (bios_internal == NULL) {
     MemoryFree(bad);
-    free(gba_memory);
+    ArenaFreeAllocation(gba_memory);
     return NULL;
   }
 
@@ -181,24 +185,27 @@ Memory* GbaMemoryAllocate(Memory* ppu_registers, Memory* sound_registers,
   if (bios == NULL) {
     MemoryFree(bios_internal);
     MemoryFree(bad);
-    free(gba_memory);
+    ArenaFreeAllocation(gba_memory);
     return NULL;
   }
 
+  // Code is copied into and run from RAM, so writes are tracked per page
   MemoryBank* iwram = MemoryBankAllocate(IWRAM_SIZE, 1u, NULL);
-  if (iwram == NULL) {
+  if (iwram == NULL || !MemoryBankTrackWrites(iwram, RAM_PAGE_SIZE)) {
+    MemoryBankFree(iwram);
     MemoryFree(bios);
     MemoryFree(bad);
-    free(gba_memory);
+    ArenaFreeAllocation(gba_memory);
     return NULL;
   }
 
   MemoryBank* ewram = MemoryBankAllocate(EWRAM_SIZE, 1u, NULL);
-  if (ewram == NULL) {
+  if (ewram == NULL || !MemoryBankTrackWrites(ewram, RAM_PAGE_SIZE)) {
+    MemoryBankFree(ewram);
     MemoryBankFree(iwram);
     MemoryFree(bios);
     MemoryFree(bad);
-    free(gba_memory);
+    ArenaFreeAllocation(gba_memory);
     return NULL;
   }
 
@@ -208,7 +215,7 @@ Memory* GbaMemoryAllocate(Memory* ppu_registers, Memory* sound_registers,
     MemoryBankFree(iwram);
     MemoryFree(bios);
     MemoryFree(bad);
-    free(gba_memory);
+    ArenaFreeAllocation(gba_memory);
     return NULL;
   }
 
@@ -222,7 +229,7 @@ Memory* GbaMemoryAllocate(Memory* ppu_registers, Memory* sound_registers,
     MemoryBankFree(iwram);
     MemoryFree(bios);
     MemoryFree(bad);
-    free(gba_memory);
+    ArenaFreeAllocation(gba_memory);
     return NULL;
   }
 
@@ -234,7 +241,7 @@ Memory* GbaMemoryAllocate(Memory* ppu_registers, Memory* sound_registers,
     MemoryBankFree(iwram);
     MemoryFree(bios);
     MemoryFree(bad);
-    free(gba_memory);
+    ArenaFreeAllocation(gba_memory);
     return NULL;
   }
 
@@ -265,6 +272,7 @@ Memory* GbaMemoryAllocate(Memory* ppu_registers, Memory* sound_registers,
   gba_memory->vram = vram;
   gba_memory->oam = oam;
   gba_memory->bad = bad;
+  gba_memory->sram = sram;
 
   MemoryBank** memory_banks =
       calloc(NUMBER_OF_MEMORY_BANKS, sizeof(MemoryBank*));
@@ -275,7 +283,7 @@ Memory* GbaMemoryAllocate(Memory* ppu_registers, Memory* sound_registers,
     MemoryBankFree(iwram);
     MemoryFree(bios);
     MemoryFree(bad);
-    free(gba_memory);
+    ArenaFreeAllocation(gba_memory);
     return NULL;
   }
 
@@ -302,9 +310,21 @@ Memory* GbaMemoryAllocate(Memory* ppu_registers, Memory* sound_registers,
     MemoryBankFree(iwram);
     MemoryFree(bios);
     MemoryFree(bad);
-    free(gba_memory);
+    ArenaFreeAllocation(gba_memory);
     return NULL;
   }
 
   return result;
+}
+
+void GbaMemoryReset(Memory* memory) {
+  MemoryBankZero(MemoryGetBank(memory, 0x02000000u), 0u, EWRAM_SIZE);
+  MemoryBankZero(MemoryGetBank(memory, 0x03000000u), 0u, IWRAM_SIZE);
+}
+
+void GbaMemoryCopyState(Memory* destination, const Memory* source) {
+  MemoryBankCopy(MemoryGetBank(destination, 0x02000000u),
+                 MemoryGetBank(source, 0x02000000u));
+  MemoryBankCopy(MemoryGetBank(destination, 0x03000000u),
+                 MemoryGetBank(source, 0x03000000u));
 }
\ No newline at end of file
@@ -9,4 +9,10 @@ Memory* GbaMemoryAllocate(Memory* ppu_registers, Memory* sound_registers,
                           Memory* platform_registers, Memory* palette,
                           Memory* vram, Memory* oam, MemoryBank* game);
 
+// Clears IWRAM and EWRAM
+void GbaMemoryReset(Memory* memory);
+
+// Copies IWRAM and EWRAM
+void GbaMemoryCopyState(Memory* destination, const Memory* source);
+
 #endif  // _WEBGBA_EMULATOR_MEMORY_GBA_MEMORY_
\ No newline at end of file
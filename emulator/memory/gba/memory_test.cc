@@ -288,6 +288,49 @@ TEST_F(GbaMemoryTest, IRamBank) {
   }
 }
 
+TEST_F(GbaMemoryTest, Reset) {
+  EXPECT_TRUE(Store32LE(memory_, 0x02000000u, 1u));
+  EXPECT_TRUE(Store32LE(memory_, 0x0203FFFCu, 2u));
+  EXPECT_TRUE(Store32LE(memory_, 0x03000000u, 3u));
+  EXPECT_TRUE(Store32LE(memory_, 0x03007FFCu, 4u));
+
+  GbaMemoryReset(memory_);
+
+  uint32_t value;
+  EXPECT_TRUE(Load32LE(memory_, 0x02000000u, &value));
+  EXPECT_EQ(0u, value);
+  EXPECT_TRUE(Load32LE(memory_, 0x0203FFFCu, &value));
+  EXPECT_EQ(0u, value);
+  EXPECT_TRUE(Load32LE(memory_, 0x03000000u, &value));
+  EXPECT_EQ(0u, value);
+  EXPECT_TRUE(Load32LE(memory_, 0x03007FFCu, &value));
+  EXPECT_EQ(0u, value);
+}
+
+TEST_F(GbaMemoryTest, RamPageGenerations) {
+  MemoryBank* ewram = MemoryGetBank(memory_, 0x02000000u);
+  ASSERT_NE(nullptr, ewram);
+  MemoryBank* iwram = MemoryGetBank(memory_, 0x03000000u);
+  ASSERT_NE(nullptr, iwram);
+
+  uint32_t ewram_first = MemoryBankPageGeneration(ewram, 0x02000000u);
+  uint32_t ewram_second = MemoryBankPageGeneration(ewram, 0x02000100u);
+  uint32_t iwram_first = MemoryBankPageGeneration(iwram, 0x03000000u);
+  uint32_t iwram_second = MemoryBankPageGeneration(iwram, 0x03000100u);
+
+  EXPECT_TRUE(Store32LE(memory_, 0x02000100u, 1u));
+  EXPECT_TRUE(Store16LE(memory_, 0x03000000u, 2u));
+
+  EXPECT_EQ(ewram_first, MemoryBankPageGeneration(ewram, 0x02000000u));
+  EXPECT_NE(ewram_second, MemoryBankPageGeneration(ewram, 0x02000100u));
+  EXPECT_NE(iwram_first, MemoryBankPageGeneration(iwram, 0x03000000u));
+  EXPECT_EQ(iwram_second, MemoryBankPageGeneration(iwram, 0x03000100u));
+
+  iwram_second = MemoryBankPageGeneration(iwram, 0x03000100u);
+  GbaMemoryReset(memory_);
+  EXPECT_NE(iwram_second, MemoryBankPageGeneration(iwram, 0x03000100u));
+}
+
 TEST_F(GbaMemoryTest, IoBank) {
   TestIoRegisterAddress(&ppu_registers_, 0x4000000u, 0x4000060u);
   TestIoRegisterAddress(&sound_registers_, 0x40000060u, 0x40000B0u);
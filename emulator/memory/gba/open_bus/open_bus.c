@@ -1,6 +1,6 @@
 #include "emulator/memory/gba/open_bus/open_bus.h"
 
-#include <stdlib.h>
+#include "emulator/arena.h"
 
 typedef struct {
   Memory *memory;
@@ -62,11 +62,12 @@ static bool OpenBusStore8(void *context, uint32_t address, uint8_t value) {
 
 static void OpenBusFree(void *context) {
   OpenBus *open_bus = (OpenBus *)context;
-  free(open_bus->memory);
+  MemoryFree(open_bus->memory);
+  ArenaFreeAllocation(open_bus);
 }
 
 Memory *OpenBusAllocate(Memory *memory) {
-  OpenBus *allocation = (OpenBus *)calloc(1, sizeof(OpenBus));
+  OpenBus *allocation = (OpenBus *)ArenaCalloc(1, sizeof(OpenBus));
   if (allocation == NULL) {
     return NULL;
   }
@@ -77,7 +78,7 @@ Memory *OpenBusAllocate(Memory *memory) {
                                   OpenBusLoad8, OpenBusStore32LE,
                                   OpenBusStore16LE, OpenBusStore8, OpenBusFree);
   if (result == NULL) {
-    free(allocation);
+    ArenaFreeAllocation(allocation);
   }
 
   return result;
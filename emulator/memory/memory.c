@@ -3,6 +3,8 @@
 #include <assert.h>
 #include <stdlib.h>
 
+#include "emulator/arena.h"
+
 struct _Memory {
   MemoryBank **memory_banks;
   uint32_t bank_shift;
@@ -13,6 +15,7 @@ struct _Memory {
   Store32LEFunction store_le_32;
   Store16LEFunction store_le_16;
   Store8Function store_8;
+  RegisterStorageFunction register_storage;
   MemoryContextFree free_context;
   void *context;
 };
@@ -42,7 +45,7 @@ Memory *MemoryAllocateWithBanks(void *context, MemoryBank **banks,
                                 MemoryContextFree free_context) {
   assert((num_banks & (num_banks - 1u)) == 0u);
 
-  Memory *result = (Memory *)malloc(sizeof(Memory));
+  Memory *result = (Memory *)ArenaCalloc(1u, sizeof(Memory));
   if (result == NULL) {
     return NULL;
   }
@@ -52,9 +55,9 @@ Memory *MemoryAllocateWithBanks(void *context, MemoryBank **banks,
     allocated_banks = 2u;
   }
 
-  result->memory_banks = calloc(allocated_banks, sizeof(MemoryBank *));
+  result->memory_banks = ArenaCalloc(allocated_banks, sizeof(MemoryBank *));
   if (result->memory_banks == NULL) {
-    free(result);
+    ArenaFreeAllocation(result);
     return NULL;
   }
 
@@ -92,6 +95,50 @@ Memory *MemoryAllocate(void *context, Load32LEFunction load_le_32,
                                  free_context);
 }
 
+MemoryBank *MemoryGetBank(const Memory *memory, uint32_t address) {
+  return memory->memory_banks[address >> memory->bank_shift];
+}
+
+const void *MemoryGetReadRange(const Memory *memory, uint32_t address,
+                               uint32_t size) {
+  const MemoryBank *memory_bank =
+      memory->memory_banks[address >> memory->bank_shift];
+  if (memory_bank == NULL ||
+      memory_bank !=
+          memory->memory_banks[(address + size - 1u) >> memory->bank_shift]) {
+    return NULL;
+  }
+
+  return MemoryBankReadRange(memory_bank, address, size);
+}
+
+void *MemoryGetWriteRange(Memory *memory, uint32_t address, uint32_t size) {
+  MemoryBank *memory_bank = memory->memory_banks[address >> memory->bank_shift];
+  if (memory_bank == NULL ||
+      memory_bank !=
+          memory->memory_banks[(address + size - 1u) >> memory->bank_shift]) {
+    return NULL;
+  }
+
+  return MemoryBankWriteRange(memory_bank, address, size);
+}
+
+void MemorySetRegisterStorage(Memory *memory,
+                              RegisterStorageFunction register_storage) {
+  memory->register_storage = register_storage;
+}
+
+const uint16_t *MemoryGetRegisterStorage(const Memory *memory,
+                                         uint32_t address) {
+  assert((address & 0x1u) == 0u);
+
+  if (memory->register_storage == NULL) {
+    return NULL;
+  }
+
+  return memory->register_storage(memory->context, address);
+}
+
 inline bool Load32LE(const Memory *memory, uint32_t address, uint32_t *value) {
   const MemoryBank *memory_bank =
       memory->memory_banks[address >> memory->bank_shift];
@@ -199,6 +246,6 @@ void MemoryFree(Memory *memory) {
     last = memory->memory_banks[i];
   }
 
-  free(memory->memory_banks);
-  free(memory);
+  ArenaFreeAllocation(memory->memory_banks);
+  ArenaFreeAllocation(memory);
 }
\ No newline at end of file
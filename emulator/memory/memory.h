@@ -17,6 +17,8 @@ typedef bool (*Store16LEFunction)(void *context, uint32_t address,
                                   uint16_t value);
 typedef bool (*Store8Function)(void *context, uint32_t address, uint8_t value);
 typedef void (*MemoryContextFree)(void *context);
+typedef const uint16_t *(*RegisterStorageFunction)(const void *context,
+                                                   uint32_t address);
 
 typedef struct _Memory Memory;
 Memory *MemoryAllocateWithBanks(void *context, MemoryBank **banks,
@@ -34,6 +36,23 @@ Memory *MemoryAllocate(void *context, Load32LEFunction load_le_32,
                        Store16LEFunction store_le_16, Store8Function store_8,
                        MemoryContextFree free_context);
 
+// Returns NULL if the address is not backed by a memory bank
+MemoryBank *MemoryGetBank(const Memory *memory, uint32_t address);
+
+// Returns NULL unless the size bytes starting at address are all backed by the
+// same memory bank without wrapping around it
+const void *MemoryGetReadRange(const Memory *memory, uint32_t address,
+                               uint32_t size);
+void *MemoryGetWriteRange(Memory *memory, uint32_t address, uint32_t size);
+
+// Registers the halfwords that 16-bit loads read without side effects
+void MemorySetRegisterStorage(Memory *memory,
+                              RegisterStorageFunction register_storage);
+
+// Returns NULL if the halfword at address has no register storage
+const uint16_t *MemoryGetRegisterStorage(const Memory *memory,
+                                         uint32_t address);
+
 bool Load32LE(const Memory *memory, uint32_t address, uint32_t *value);
 bool Load16LE(const Memory *memory, uint32_t address, uint16_t *value);
 bool Load8(const Memory *memory, uint32_t address, uint8_t *value);
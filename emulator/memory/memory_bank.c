@@ -1,54 +1,106 @@
 #include "emulator/memory/memory_bank.h"
 
 #include <assert.h>
+#include <stdatomic.h>
 #include <stdbool.h>
 #include <stdlib.h>
+#include <string.h>
+
+#include "emulator/arena.h"
+
+typedef struct {
+  atomic_uint reference_count;
+  MemoryBankReleaseFunction release;
+  uint32_t num_banks;
+  void *memory_banks[];
+} MemoryBankStorage;
 
 struct _MemoryBank {
   const void *read_bank;
   void *write_bank;
   uint32_t address_mask;
   MemoryBankWriteCallback callback;
-  void **memory_banks;
+  MemoryBankStorage *storage;
   void *write_sink;
-  uint32_t num_banks;
+  uint32_t *generations;
+  uint32_t generation_shift;
+  uint32_t num_generations;
+  uint32_t untracked_generation;
+  uint32_t current_bank;
   bool allow_writes;
 };
 
-MemoryBank *MemoryBankAllocate(uint32_t bank_size, uint32_t num_banks,
-                               MemoryBankWriteCallback write_callback) {
-  assert(bank_size != 0u && (bank_size & (bank_size - 1u)) == 0u);
-  assert(num_banks != 0u);
+// Untracked banks count every write against a single page. No bank is large
+// enough for any address to reach past the first page at this shift.
+#define UNTRACKED_GENERATION_SHIFT 31u
 
-  MemoryBank *result = calloc(1u, sizeof(MemoryBank));
-  if (result == NULL) {
-    return NULL;
+static void MemoryBankBumpGenerations(MemoryBank *memory_bank,
+                                      uint32_t first_page, uint32_t last_page) {
+  for (uint32_t page = first_page; page <= last_page; page++) {
+    memory_bank->generations[page] += 1u;
+  }
+}
+
+static void MemoryBankStorageRelease(MemoryBankStorage *storage) {
+  if (atomic_fetch_sub(&storage->reference_count, 1u) != 1u) {
+    return;
   }
 
-  result->memory_banks = calloc(num_banks, sizeof(void *));
-  if (result->memory_banks == NULL) {
-    MemoryBankFree(result);
+  if (storage->release != NULL) {
+    storage->release(storage->memory_banks[0u]);
+  } else {
+    for (uint32_t bank = 0u; bank < storage->num_banks; bank++) {
+      ArenaFreeAllocation(storage->memory_banks[bank]);
+    }
+  }
+
+  ArenaFreeAllocation(storage);
+}
+
+static MemoryBankStorage *MemoryBankStorageAllocate(uint32_t bank_size,
+                                                    uint32_t num_banks) {
+  MemoryBankStorage *storage =
+      ArenaCalloc(1u, sizeof(MemoryBankStorage) + num_banks * sizeof(void *));
+  if (storage == NULL) {
     return NULL;
   }
 
-  result->num_banks = num_banks;
+  atomic_init(&storage->reference_count, 1u);
 
   for (uint32_t bank = 0u; bank < num_banks; bank++) {
-    result->memory_banks[bank] = calloc(1u, bank_size);
-    if (result->memory_banks[bank] == NULL) {
-      MemoryBankFree(result);
+    storage->memory_banks[bank] = ArenaCalloc(1u, bank_size);
+    if (storage->memory_banks[bank] == NULL) {
+      MemoryBankStorageRelease(storage);
       return NULL;
     }
+
+    storage->num_banks += 1u;
+  }
+
+  return storage;
+}
+
+static MemoryBank *MemoryBankAllocateWithStorage(
+    MemoryBankStorage *storage, uint32_t bank_size,
+    MemoryBankWriteCallback write_callback) {
+  MemoryBank *result = ArenaCalloc(1u, sizeof(MemoryBank));
+  if (result == NULL) {
+    return NULL;
   }
 
+  // The write sink only absorbs ignored writes so it is kept out of any arena
   result->write_sink = calloc(1u, bank_size);
   if (result->write_sink == NULL) {
-    MemoryBankFree(result);
+    ArenaFreeAllocation(result);
     return NULL;
   }
 
+  result->storage = storage;
   result->address_mask = bank_size - 1u;
   result->callback = write_callback;
+  result->generations = &result->untracked_generation;
+  result->generation_shift = UNTRACKED_GENERATION_SHIFT;
+  result->num_generations = 1u;
   result->allow_writes = true;
 
   MemoryBankChangeBank(result, 0u);
@@ -56,6 +108,128 @@ MemoryBank *MemoryBankAllocate(uint32_t bank_size, uint32_t num_banks,
   return result;
 }
 
+MemoryBank *MemoryBankAllocate(uint32_t bank_size, uint32_t num_banks,
+                               MemoryBankWriteCallback write_callback) {
+  assert(bank_size != 0u && (bank_size & (bank_size - 1u)) == 0u);
+  assert(num_banks != 0u);
+
+  MemoryBankStorage *storage = MemoryBankStorageAllocate(bank_size, num_banks);
+  if (storage == NULL) {
+    return NULL;
+  }
+
+  MemoryBank *result =
+      MemoryBankAllocateWithStorage(storage, bank_size, write_callback);
+  if (result == NULL) {
+    MemoryBankStorageRelease(storage);
+    return NULL;
+  }
+
+  return result;
+}
+
+MemoryBank *MemoryBankAllocateExternal(void *storage, uint32_t bank_size,
+                                       MemoryBankReleaseFunction release) {
+  assert(bank_size != 0u && (bank_size & (bank_size - 1u)) == 0u);
+  assert(release != NULL);
+
+  MemoryBankStorage *external =
+      ArenaCalloc(1u, sizeof(MemoryBankStorage) + sizeof(void *));
+  if (external == NULL) {
+    return NULL;
+  }
+
+  atomic_init(&external->reference_count, 1u);
+  external->release = release;
+  external->num_banks = 1u;
+  external->memory_banks[0u] = storage;
+
+  // The caller keeps ownership of the storage on failure
+  MemoryBank *result = MemoryBankAllocateWithStorage(external, bank_size, NULL);
+  if (result == NULL) {
+    ArenaFreeAllocation(external);
+    return NULL;
+  }
+
+  MemoryBankIgnoreWrites(result);
+
+  return result;
+}
+
+MemoryBank *MemoryBankShare(const MemoryBank *memory_bank) {
+  assert(!memory_bank->allow_writes);
+
+  MemoryBank *result = MemoryBankAllocateWithStorage(
+      memory_bank->storage, memory_bank->address_mask + 1u,
+      memory_bank->callback);
+  if (result == NULL) {
+    return NULL;
+  }
+
+  atomic_fetch_add(&memory_bank->storage->reference_count, 1u);
+
+  MemoryBankIgnoreWrites(result);
+  MemoryBankChangeBank(result, memory_bank->current_bank);
+
+  return result;
+}
+
+bool MemoryBankDetach(MemoryBank *memory_bank) {
+  if (atomic_load(&memory_bank->storage->reference_count) == 1u &&
+      memory_bank->storage->release == NULL) {
+    return true;
+  }
+
+  MemoryBankStorage *storage = MemoryBankStorageAllocate(
+      memory_bank->address_mask + 1u, memory_bank->storage->num_banks);
+  if (storage == NULL) {
+    return false;
+  }
+
+  MemoryBankStorageRelease(memory_bank->storage);
+  memory_bank->storage = storage;
+
+  MemoryBankChangeBank(memory_bank, memory_bank->current_bank);
+
+  return true;
+}
+
+void MemoryBankCopy(MemoryBank *destination, const MemoryBank *source) {
+  assert(destination->address_mask == source->address_mask);
+  assert(destination->storage->num_banks == source->storage->num_banks);
+
+  for (uint32_t bank = 0u; bank < source->storage->num_banks; bank++) {
+    memcpy(destination->storage->memory_banks[bank],
+           source->storage->memory_banks[bank], source->address_mask + 1u);
+  }
+
+  MemoryBankChangeBank(destination, source->current_bank);
+}
+
+bool MemoryBankTrackWrites(MemoryBank *memory_bank, uint32_t page_size) {
+  assert(page_size != 0u && (page_size & (page_size - 1u)) == 0u);
+  assert(page_size <= memory_bank->address_mask + 1u);
+  assert(memory_bank->generations == &memory_bank->untracked_generation);
+
+  uint32_t num_generations = (memory_bank->address_mask + 1u) / page_size;
+  uint32_t *generations = ArenaCalloc(num_generations, sizeof(uint32_t));
+  if (generations == NULL) {
+    return false;
+  }
+
+  memory_bank->generations = generations;
+  memory_bank->generation_shift = __builtin_ctz(page_size);
+  memory_bank->num_generations = num_generations;
+
+  return true;
+}
+
+uint32_t MemoryBankPageGeneration(const MemoryBank *memory_bank,
+                                  uint32_t address) {
+  address &= memory_bank->address_mask;
+  return memory_bank->generations[address >> memory_bank->generation_shift];
+}
+
 void MemoryBankLoad32LE(const MemoryBank *memory_bank, uint32_t address,
                         uint32_t *value) {
   address &= memory_bank->address_mask;
@@ -99,6 +273,8 @@ void MemoryBankStore32LE(MemoryBank *memory_bank, uint32_t address,
   uint32_t *value_ptr = (uint32_t *)ptr;
   *value_ptr = value;
 
+  memory_bank->generations[address >> memory_bank->generation_shift] += 1u;
+
   if (memory_bank->callback) {
     memory_bank->callback(memory_bank, address, value);
   }
@@ -114,6 +290,8 @@ void MemoryBankStore16LE(MemoryBank *memory_bank, uint32_t address,
   uint16_t *value_ptr = (uint16_t *)ptr;
   *value_ptr = value;
 
+  memory_bank->generations[address >> memory_bank->generation_shift] += 1u;
+
   if (memory_bank->callback) {
     memory_bank->callback(memory_bank, address, value);
   }
@@ -129,26 +307,99 @@ void MemoryBankStore8(MemoryBank *memory_bank, uint32_t address,
   uint8_t *value_ptr = (uint8_t *)ptr;
   *value_ptr = value;
 
+  memory_bank->generations[address >> memory_bank->generation_shift] += 1u;
+
   if (memory_bank->callback) {
     memory_bank->callback(memory_bank, address, value);
   }
 }
 
+void MemoryBankWrite(MemoryBank *memory_bank, uint32_t address,
+                     const void *data, uint32_t size) {
+  assert(size <= memory_bank->address_mask + 1u);
+  assert(address <= memory_bank->address_mask + 1u - size);
+
+  uintptr_t ptr = (uintptr_t)memory_bank->read_bank;
+  ptr += address;
+
+  memcpy((void *)ptr, data, size);
+
+  if (size != 0u) {
+    MemoryBankBumpGenerations(
+        memory_bank, address >> memory_bank->generation_shift,
+        (address + size - 1u) >> memory_bank->generation_shift);
+  }
+}
+
+void MemoryBankZero(MemoryBank *memory_bank, uint32_t address, uint32_t size) {
+  assert(size <= memory_bank->address_mask + 1u);
+  assert(address <= memory_bank->address_mask + 1u - size);
+
+  uintptr_t ptr = (uintptr_t)memory_bank->read_bank;
+  ptr += address;
+
+  memset((void *)ptr, 0, size);
+
+  if (size != 0u) {
+    MemoryBankBumpGenerations(
+        memory_bank, address >> memory_bank->generation_shift,
+        (address + size - 1u) >> memory_bank->generation_shift);
+  }
+}
+
+const void *MemoryBankReadRange(const MemoryBank *memory_bank, uint32_t address,
+                                uint32_t size) {
+  assert(size != 0u);
+
+  address &= memory_bank->address_mask;
+  if (size - 1u > memory_bank->address_mask - address) {
+    return NULL;
+  }
+
+  uintptr_t ptr = (uintptr_t)memory_bank->read_bank;
+  ptr += address;
+
+  return (const void *)ptr;
+}
+
+void *MemoryBankWriteRange(MemoryBank *memory_bank, uint32_t address,
+                           uint32_t size) {
+  assert(size != 0u);
+
+  address &= memory_bank->address_mask;
+  if (size - 1u > memory_bank->address_mask - address ||
+      memory_bank->callback != NULL) {
+    return NULL;
+  }
+
+  MemoryBankBumpGenerations(
+      memory_bank, address >> memory_bank->generation_shift,
+      (address + size - 1u) >> memory_bank->generation_shift);
+
+  uintptr_t ptr = (uintptr_t)memory_bank->write_bank;
+  ptr += address;
+
+  return (void *)ptr;
+}
+
 void MemoryBankIgnoreWrites(MemoryBank *memory_bank) {
   memory_bank->write_bank = memory_bank->write_sink;
   memory_bank->allow_writes = false;
 }
 
 void MemoryBankChangeBank(MemoryBank *memory_bank, uint32_t bank) {
-  assert(bank < memory_bank->num_banks);
+  assert(bank < memory_bank->storage->num_banks);
 
-  memory_bank->read_bank = memory_bank->memory_banks[bank];
+  memory_bank->current_bank = bank;
+  memory_bank->read_bank = memory_bank->storage->memory_banks[bank];
 
   if (memory_bank->allow_writes) {
-    memory_bank->write_bank = memory_bank->memory_banks[bank];
+    memory_bank->write_bank = memory_bank->storage->memory_banks[bank];
   } else {
     memory_bank->write_bank = memory_bank->write_sink;
   }
+
+  MemoryBankBumpGenerations(memory_bank, 0u, memory_bank->num_generations - 1u);
 }
 
 void MemoryBankFree(MemoryBank *memory_bank) {
@@ -156,11 +407,11 @@ void MemoryBankFree(MemoryBank *memory_bank) {
     return;
   }
 
-  for (uint32_t bank = 0u; bank > memory_bank->num_banks; bank++) {
-    free(memory_bank->memory_banks[bank]);
+  if (memory_bank->generations != &memory_bank->untracked_generation) {
+    ArenaFreeAllocation(memory_bank->generations);
   }
 
-  free(memory_bank->memory_banks);
+  MemoryBankStorageRelease(memory_bank->storage);
   free(memory_bank->write_sink);
-  free(memory_bank);
+  ArenaFreeAllocation(memory_bank);
 }
\ No newline at end of file
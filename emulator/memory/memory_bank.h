@@ -1,6 +1,7 @@
 #ifndef _WEBGBA_EMULATOR_MEMORY_MEMORY_BANK_
 #define _WEBGBA_EMULATOR_MEMORY_MEMORY_BANK_
 
+#include <stdbool.h>
 #include <stdint.h>
 
 // A memory bank is a mirrored, contiguous region of memory which can be written
@@ -16,6 +17,14 @@ typedef void (*MemoryBankWriteCallback)(MemoryBank *memory_bank,
 MemoryBank *MemoryBankAllocate(uint32_t bank_size, uint32_t num_banks,
                                MemoryBankWriteCallback write_callback);
 
+typedef void (*MemoryBankReleaseFunction)(void *storage);
+
+// Returns a single bank that ignores writes and reads from storage of
+// bank_size bytes owned by the caller, such as a read only file mapping. The
+// release function is passed the storage once no bank reads from it.
+MemoryBank *MemoryBankAllocateExternal(void *storage, uint32_t bank_size,
+                                       MemoryBankReleaseFunction release);
+
 void MemoryBankLoad32LE(const MemoryBank *memory_bank, uint32_t address,
                         uint32_t *value);
 void MemoryBankLoad16LE(const MemoryBank *memory_bank, uint32_t address,
@@ -29,9 +38,50 @@ void MemoryBankStore16LE(MemoryBank *memory_bank, uint32_t address,
                          uint16_t value);
 void MemoryBankStore8(MemoryBank *memory_bank, uint32_t address, uint8_t value);
 
+// Fills the current bank directly, even if writes are being ignored, without
+// invoking the write callback. The range must not extend past the bank and
+// the bank must not read from external storage.
+void MemoryBankWrite(MemoryBank *memory_bank, uint32_t address,
+                     const void *data, uint32_t size);
+void MemoryBankZero(MemoryBank *memory_bank, uint32_t address, uint32_t size);
+
+// Returns the storage backing the size bytes starting at address so that they
+// may be read directly, or NULL if the range wraps around the end of the bank.
+const void *MemoryBankReadRange(const MemoryBank *memory_bank, uint32_t address,
+                                uint32_t size);
+
+// Returns the storage that the size bytes starting at address are stored to,
+// counting each page of the range as written, or NULL if the range wraps
+// around the end of the bank or the bank has a write callback.
+void *MemoryBankWriteRange(MemoryBank *memory_bank, uint32_t address,
+                           uint32_t size);
+
 void MemoryBankIgnoreWrites(MemoryBank *memory_bank);
 void MemoryBankChangeBank(MemoryBank *memory_bank, uint32_t bank);
 
+// Returns a bank that reads from the same storage as a bank that ignores
+// writes. The storage is freed along with the last bank that uses it, and
+// may be read from different threads.
+MemoryBank *MemoryBankShare(const MemoryBank *memory_bank);
+
+// Gives a shared bank zeroed storage of its own, leaving the banks it was
+// shared with unchanged. Does nothing if the bank's storage is not shared and
+// was not provided by the caller.
+bool MemoryBankDetach(MemoryBank *memory_bank);
+
+// Copies the contents and current bank of a bank of the same dimensions
+void MemoryBankCopy(MemoryBank *destination, const MemoryBank *source);
+
+// Counts the writes to each page of the bank so that caches of its contents,
+// such as decoded instructions, can be validated without scanning on every
+// store. The page size must be a power of two no larger than the bank.
+bool MemoryBankTrackWrites(MemoryBank *memory_bank, uint32_t page_size);
+
+// Changes whenever the page containing address may have been modified.
+// Untracked banks treat the entire bank as a single page.
+uint32_t MemoryBankPageGeneration(const MemoryBank *memory_bank,
+                                  uint32_t address);
+
 void MemoryBankFree(MemoryBank *MemoryBank);
 
 #endif  // _WEBGBA_EMULATOR_MEMORY_MEMORY_BANK_
\ No newline at end of file
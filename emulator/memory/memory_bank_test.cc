@@ -94,4 +94,228 @@ TEST_F(MemoryBankTest, ChangeBank) {
 
   MemoryBankLoad32LE(memory_bank_, 0u, &value);
   EXPECT_EQ(UINT32_MAX, value);
+}
+
+TEST_F(MemoryBankTest, Write) {
+  MemoryBankIgnoreWrites(memory_bank_);
+
+  const uint8_t data[4u] = {0x01u, 0x02u, 0x03u, 0x04u};
+  MemoryBankWrite(memory_bank_, 1020u, data, sizeof(data));
+
+  uint32_t value;
+  MemoryBankLoad32LE(memory_bank_, 1020u, &value);
+  EXPECT_EQ(0x04030201u, value);
+
+  MemoryBankChangeBank(memory_bank_, 1u);
+  MemoryBankLoad32LE(memory_bank_, 1020u, &value);
+  EXPECT_EQ(0u, value);
+}
+
+TEST_F(MemoryBankTest, Zero) {
+  expected_value_ = UINT32_MAX;
+  expected_address_ = 0u;
+  MemoryBankStore32LE(memory_bank_, 0u, UINT32_MAX);
+  expected_address_ = 4u;
+  MemoryBankStore32LE(memory_bank_, 4u, UINT32_MAX);
+
+  MemoryBankZero(memory_bank_, 2u, 4u);
+
+  uint32_t value;
+  MemoryBankLoad32LE(memory_bank_, 0u, &value);
+  EXPECT_EQ(0x0000FFFFu, value);
+  MemoryBankLoad32LE(memory_bank_, 4u, &value);
+  EXPECT_EQ(0xFFFF0000u, value);
+}
+
+TEST_F(MemoryBankTest, Share) {
+  const uint8_t data[4u] = {0x01u, 0x02u, 0x03u, 0x04u};
+  MemoryBankWrite(memory_bank_, 0u, data, sizeof(data));
+  MemoryBankIgnoreWrites(memory_bank_);
+
+  MemoryBank *shared = MemoryBankShare(memory_bank_);
+  ASSERT_NE(shared, nullptr);
+
+  uint32_t value;
+  MemoryBankLoad32LE(shared, 0u, &value);
+  EXPECT_EQ(0x04030201u, value);
+
+  MemoryBankFree(memory_bank_);
+  memory_bank_ = shared;
+
+  MemoryBankLoad32LE(memory_bank_, 0u, &value);
+  EXPECT_EQ(0x04030201u, value);
+
+  expected_value_ = UINT32_MAX;
+  expected_address_ = 0u;
+  MemoryBankStore32LE(memory_bank_, 0u, UINT32_MAX);
+  MemoryBankLoad32LE(memory_bank_, 0u, &value);
+  EXPECT_EQ(0x04030201u, value);
+}
+
+TEST_F(MemoryBankTest, Detach) {
+  const uint8_t data[4u] = {0x01u, 0x02u, 0x03u, 0x04u};
+  MemoryBankWrite(memory_bank_, 0u, data, sizeof(data));
+  MemoryBankIgnoreWrites(memory_bank_);
+
+  MemoryBank *shared = MemoryBankShare(memory_bank_);
+  ASSERT_NE(shared, nullptr);
+  ASSERT_TRUE(MemoryBankDetach(shared));
+
+  uint32_t value;
+  MemoryBankLoad32LE(shared, 0u, &value);
+  EXPECT_EQ(0u, value);
+
+  const uint8_t other_data[4u] = {0x05u, 0x06u, 0x07u, 0x08u};
+  MemoryBankWrite(shared, 0u, other_data, sizeof(other_data));
+  MemoryBankLoad32LE(shared, 0u, &value);
+  EXPECT_EQ(0x08070605u, value);
+
+  MemoryBankLoad32LE(memory_bank_, 0u, &value);
+  EXPECT_EQ(0x04030201u, value);
+
+  MemoryBankFree(shared);
+}
+
+TEST_F(MemoryBankTest, Copy) {
+  MemoryBank *copy = MemoryBankAllocate(1024u, 2u, nullptr);
+  ASSERT_NE(copy, nullptr);
+
+  expected_value_ = 1337u;
+  expected_address_ = 4u;
+  MemoryBankChangeBank(memory_bank_, 1u);
+  MemoryBankStore32LE(memory_bank_, 4u, 1337u);
+
+  MemoryBankCopy(copy, memory_bank_);
+
+  uint32_t value;
+  MemoryBankLoad32LE(copy, 4u, &value);
+  EXPECT_EQ(1337u, value);
+
+  MemoryBankChangeBank(copy, 0u);
+  MemoryBankLoad32LE(copy, 4u, &value);
+  EXPECT_EQ(0u, value);
+
+  MemoryBankFree(copy);
+}
+
+TEST_F(MemoryBankTest, TrackWrites) {
+  ASSERT_TRUE(MemoryBankTrackWrites(memory_bank_, 256u));
+
+  uint32_t first = MemoryBankPageGeneration(memory_bank_, 0u);
+  uint32_t second = MemoryBankPageGeneration(memory_bank_, 256u);
+
+  expected_value_ = 1337u;
+  expected_address_ = 4u;
+  MemoryBankStore32LE(memory_bank_, 4u, 1337u);
+  EXPECT_NE(first, MemoryBankPageGeneration(memory_bank_, 0u));
+  EXPECT_EQ(MemoryBankPageGeneration(memory_bank_, 0u),
+            MemoryBankPageGeneration(memory_bank_, 1024u));
+  EXPECT_EQ(second, MemoryBankPageGeneration(memory_bank_, 256u));
+
+  first = MemoryBankPageGeneration(memory_bank_, 0u);
+  uint32_t third = MemoryBankPageGeneration(memory_bank_, 512u);
+
+  const uint8_t data[4u] = {0x01u, 0x02u, 0x03u, 0x04u};
+  MemoryBankWrite(memory_bank_, 510u, data, sizeof(data));
+  EXPECT_EQ(first, MemoryBankPageGeneration(memory_bank_, 0u));
+  EXPECT_NE(second, MemoryBankPageGeneration(memory_bank_, 256u));
+  EXPECT_NE(third, MemoryBankPageGeneration(memory_bank_, 512u));
+
+  uint32_t fourth = MemoryBankPageGeneration(memory_bank_, 768u);
+  MemoryBankChangeBank(memory_bank_, 1u);
+  EXPECT_NE(fourth, MemoryBankPageGeneration(memory_bank_, 768u));
+}
+
+TEST_F(MemoryBankTest, UntrackedWrites) {
+  uint32_t generation = MemoryBankPageGeneration(memory_bank_, 0u);
+  EXPECT_EQ(generation, MemoryBankPageGeneration(memory_bank_, 768u));
+
+  expected_value_ = 1337u;
+  expected_address_ = 772u;
+  MemoryBankStore32LE(memory_bank_, 772u, 1337u);
+  EXPECT_NE(generation, MemoryBankPageGeneration(memory_bank_, 0u));
+}
+
+TEST_F(MemoryBankTest, ReadRange) {
+  expected_value_ = 1337u;
+  expected_address_ = 1020u;
+  MemoryBankStore32LE(memory_bank_, 1020u, 1337u);
+
+  const uint32_t *range =
+      (const uint32_t *)MemoryBankReadRange(memory_bank_, 2044u, 4u);
+  ASSERT_NE(nullptr, range);
+  EXPECT_EQ(1337u, *range);
+
+  EXPECT_EQ(range, MemoryBankReadRange(memory_bank_, 1020u, 4u));
+  EXPECT_NE(nullptr, MemoryBankReadRange(memory_bank_, 0u, 1024u));
+  EXPECT_EQ(nullptr, MemoryBankReadRange(memory_bank_, 1020u, 8u));
+  EXPECT_EQ(nullptr, MemoryBankReadRange(memory_bank_, 4u, 1024u));
+}
+
+TEST_F(MemoryBankTest, WriteRange) {
+  EXPECT_EQ(nullptr, MemoryBankWriteRange(memory_bank_, 0u, 4u));
+
+  MemoryBank *memory_bank = MemoryBankAllocate(1024u, 1u, nullptr);
+  ASSERT_NE(nullptr, memory_bank);
+  ASSERT_TRUE(MemoryBankTrackWrites(memory_bank, 256u));
+
+  uint32_t first = MemoryBankPageGeneration(memory_bank, 0u);
+  uint32_t second = MemoryBankPageGeneration(memory_bank, 256u);
+  uint32_t third = MemoryBankPageGeneration(memory_bank, 512u);
+
+  uint32_t *range = (uint32_t *)MemoryBankWriteRange(memory_bank, 1532u, 8u);
+  ASSERT_NE(nullptr, range);
+  range[0u] = 1u;
+  range[1u] = 2u;
+  EXPECT_EQ(first, MemoryBankPageGeneration(memory_bank, 0u));
+  EXPECT_NE(second, MemoryBankPageGeneration(memory_bank, 256u));
+  EXPECT_NE(third, MemoryBankPageGeneration(memory_bank, 512u));
+
+  uint32_t value;
+  MemoryBankLoad32LE(memory_bank, 508u, &value);
+  EXPECT_EQ(1u, value);
+  MemoryBankLoad32LE(memory_bank, 512u, &value);
+  EXPECT_EQ(2u, value);
+
+  EXPECT_EQ(nullptr, MemoryBankWriteRange(memory_bank, 1020u, 8u));
+
+  MemoryBankFree(memory_bank);
+}
+
+static int released_;
+
+static void Release(void *storage) { released_ += 1; }
+
+TEST_F(MemoryBankTest, External) {
+  alignas(uint32_t) uint8_t storage[1024u] = {0x01u, 0x02u, 0x03u, 0x04u};
+  released_ = 0;
+
+  MemoryBank *external = MemoryBankAllocateExternal(storage, 1024u, Release);
+  ASSERT_NE(nullptr, external);
+
+  uint32_t value;
+  MemoryBankLoad32LE(external, 1024u, &value);
+  EXPECT_EQ(0x04030201u, value);
+
+  MemoryBankStore32LE(external, 0u, 0u);
+  MemoryBankLoad32LE(external, 0u, &value);
+  EXPECT_EQ(0x04030201u, value);
+
+  MemoryBank *shared = MemoryBankShare(external);
+  ASSERT_NE(nullptr, shared);
+  MemoryBankFree(external);
+  EXPECT_EQ(0, released_);
+
+  MemoryBankLoad32LE(shared, 0u, &value);
+  EXPECT_EQ(0x04030201u, value);
+
+  ASSERT_TRUE(MemoryBankDetach(shared));
+  EXPECT_EQ(1, released_);
+  EXPECT_EQ(0x04030201u, *(uint32_t *)storage);
+
+  MemoryBankLoad32LE(shared, 0u, &value);
+  EXPECT_EQ(0u, value);
+
+  MemoryBankFree(shared);
+  EXPECT_EQ(1, released_);
 }
\ No newline at end of file
@@ -193,6 +193,31 @@ class MemoryWithBankTest : public testing::Test {
 
 void *MemoryWithBankTest::expected_context_;
 
+TEST_F(MemoryTest, GetBank) {
+  EXPECT_EQ(nullptr, MemoryGetBank(memory_, 0u));
+  EXPECT_EQ(nullptr, MemoryGetBank(memory_, UINT32_MAX));
+}
+
+TEST_F(MemoryTest, GetRange) {
+  EXPECT_EQ(nullptr, MemoryGetReadRange(memory_, 0u, 4u));
+  EXPECT_EQ(nullptr, MemoryGetWriteRange(memory_, 0u, 4u));
+}
+
+static uint16_t register_storage_value;
+
+static const uint16_t *RegisterStorageStatic(const void *context,
+                                             uint32_t address) {
+  EXPECT_EQ((void *)0x12345678u, context);
+  return (address == 2u) ? &register_storage_value : nullptr;
+}
+
+TEST_F(MemoryTest, RegisterStorage) {
+  EXPECT_EQ(nullptr, MemoryGetRegisterStorage(memory_, 2u));
+  MemorySetRegisterStorage(memory_, RegisterStorageStatic);
+  EXPECT_EQ(nullptr, MemoryGetRegisterStorage(memory_, 0u));
+  EXPECT_EQ(&register_storage_value, MemoryGetRegisterStorage(memory_, 2u));
+}
+
 TEST_F(MemoryWithBankTest, LoadStore32LE) {
   uint32_t value;
   EXPECT_TRUE(Load32LE(memory_, 0xDEADBEEFu, &value));
@@ -219,4 +244,37 @@ TEST_F(MemoryWithBankTest, LoadStore8) {
   EXPECT_TRUE(Store8(memory_, 0xDEADBEEFu, 128u));
   EXPECT_TRUE(Load8(memory_, 0xDEADBEEFu, &value));
   EXPECT_EQ(128u, value);
+}
+
+TEST_F(MemoryWithBankTest, GetBank) {
+  MemoryBank *memory_bank = MemoryGetBank(memory_, 0u);
+  ASSERT_NE(nullptr, memory_bank);
+  EXPECT_EQ(memory_bank, MemoryGetBank(memory_, UINT32_MAX));
+
+  MemoryBankStore32LE(memory_bank, 0u, 1337u);
+
+  uint32_t value;
+  EXPECT_TRUE(Load32LE(memory_, 0u, &value));
+  EXPECT_EQ(1337u, value);
+}
+
+TEST_F(MemoryWithBankTest, GetRange) {
+  EXPECT_TRUE(Store32LE(memory_, 0xDEADBEECu, 1337u));
+
+  uint32_t *write_range =
+      (uint32_t *)MemoryGetWriteRange(memory_, 0xDEADBEE8u, 8u);
+  ASSERT_NE(nullptr, write_range);
+  EXPECT_EQ(1337u, write_range[1u]);
+  write_range[0u] = 0xCAFEBABEu;
+
+  const uint32_t *read_range =
+      (const uint32_t *)MemoryGetReadRange(memory_, 0xDEADBEE8u, 8u);
+  EXPECT_EQ(write_range, read_range);
+
+  uint32_t value;
+  EXPECT_TRUE(Load32LE(memory_, 0xDEADBEE8u, &value));
+  EXPECT_EQ(0xCAFEBABEu, value);
+
+  EXPECT_EQ(nullptr, MemoryGetReadRange(memory_, 0xFFFFFFFCu, 8u));
+  EXPECT_EQ(nullptr, MemoryGetWriteRange(memory_, 0x3FCu, 8u));
 }
\ No newline at end of file
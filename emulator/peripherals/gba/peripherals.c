@@ -1,7 +1,9 @@
 #include "emulator/peripherals/gba/peripherals.h"
 
 #include <assert.h>
-#include <stdlib.h>
+#include <string.h>
+
+#include "emulator/arena.h"
 
 #define SIODATA32S_OFFSET 0x00u
 #define SIOMULTI0_OFFSET 0x00u
@@ -230,6 +232,43 @@ static bool GbaPeripheralsRegistersStore8Impl(GbaPeripherals *peripherals,
   return true;
 }
 
+static const uint16_t *GbaPeripheralsRegisterStorage(const void *context,
+                                                     uint32_t address) {
+  static const uint16_t zero = 0u;
+
+  const GbaPeripherals *peripherals = (const GbaPeripherals *)context;
+
+  switch (address) {
+    case SIOMULTI0_OFFSET:
+    case SIOMULTI1_OFFSET:
+    case SIOMULTI2_OFFSET:
+    case SIOMULTI3_OFFSET:
+    case IR_OFFSET:
+    case JOY_RECV_L_OFFSET:
+    case JOY_RECV_H_OFFSET:
+    case JOYSTAT_OFFSET:
+      return &zero;
+    case SIOCNT_OFFSET:
+      return &peripherals->registers.siocnt;
+    case SIOMLT_SEND_OFFSET:
+      return &peripherals->registers.siomlt_send;
+    case KEYINPUT_OFFSET:
+      return &peripherals->registers.keyinput.value;
+    case KEYCNT_OFFSET:
+      return &peripherals->registers.keycnt.value;
+    case RCNT_OFFSET:
+      return &peripherals->registers.rcnt;
+    case JOYCNT_OFFSET:
+      return &peripherals->registers.joycnt;
+    case JOY_TRANS_L_OFFSET:
+      return &peripherals->registers.joy_trans_half[0];
+    case JOY_TRANS_H_OFFSET:
+      return &peripherals->registers.joy_trans_half[1];
+  }
+
+  return NULL;
+}
+
 static bool GbaPeripheralsRegistersLoad32LE(const void *context,
                                             uint32_t address, uint32_t *value) {
   GbaPeripherals *peripherals = (GbaPeripherals *)context;
@@ -408,7 +447,7 @@ static void GbaPeripheralsMemoryFree(void *context) {
 
 bool GbaPeripheralsAllocate(GbaPlatform *platform, GbaPeripherals **peripherals,
                             GamePad **gamepad, Memory **registers) {
-  *peripherals = (GbaPeripherals *)calloc(1, sizeof(GbaPeripherals));
+  *peripherals = (GbaPeripherals *)ArenaCalloc(1, sizeof(GbaPeripherals));
   if (*peripherals == NULL) {
     return false;
   }
@@ -419,7 +458,7 @@ bool GbaPeripheralsAllocate(GbaPlatform *platform, GbaPeripherals **peripherals,
       GbaGamePadToggleB, GbaGamePadToggleL, GbaGamePadToggleR,
       GbaGamePadToggleStart, GbaGamePadToggleSelect, GbaPeripheralsMemoryFree);
   if (*gamepad == NULL) {
-    free(*peripherals);
+    ArenaFreeAllocation(*peripherals);
     return false;
   }
 
@@ -432,10 +471,12 @@ bool GbaPeripheralsAllocate(GbaPlatform *platform, GbaPeripherals **peripherals,
       GbaPeripheralsRegistersStore8, GbaPeripheralsMemoryFree);
   if (*registers == NULL) {
     GamePadFree(*gamepad);
-    free(*peripherals);
+    ArenaFreeAllocation(*peripherals);
     return false;
   }
 
+  MemorySetRegisterStorage(*registers, GbaPeripheralsRegisterStorage);
+
   (*peripherals)->registers.keyinput.up = true;
   (*peripherals)->registers.keyinput.down = true;
   (*peripherals)->registers.keyinput.left = true;
@@ -454,11 +495,24 @@ bool GbaPeripheralsAllocate(GbaPlatform *platform, GbaPeripherals **peripherals,
   return true;
 }
 
+void GbaPeripheralsReset(GbaPeripherals *peripherals) {
+  KeyInput keyinput = peripherals->registers.keyinput;
+  memset(&peripherals->registers, 0, sizeof(GbaPeripheralRegisters));
+  peripherals->registers.keyinput = keyinput;
+  peripherals->registers.rcnt = 0x8000u;
+}
+
+void GbaPeripheralsCopyState(GbaPeripherals *destination,
+                             const GbaPeripherals *source) {
+  destination->registers = source->registers;
+}
+
 void GbaPeripheralsFree(GbaPeripherals *peripherals) {
   assert(peripherals->reference_count != 0u);
   peripherals->reference_count -= 1u;
   if (peripherals->reference_count == 0u) {
-    free(peripherals);
+    GbaPlatformRelease(peripherals->platform);
+    ArenaFreeAllocation(peripherals);
   }
 }
 
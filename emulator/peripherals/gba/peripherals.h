@@ -10,6 +10,14 @@ typedef struct _GbaPeripherals GbaPeripherals;
 bool GbaPeripheralsAllocate(GbaPlatform *platform, GbaPeripherals **peripherals,
                             GamePad **gamepad, Memory **registers);
 
+// Restores the power on registers. Buttons that are held remain pressed.
+void GbaPeripheralsReset(GbaPeripherals *peripherals);
+
+// Copies the registers of another set of peripherals, including which buttons
+// are held
+void GbaPeripheralsCopyState(GbaPeripherals *destination,
+                             const GbaPeripherals *source);
+
 void GbaPeripheralsFree(GbaPeripherals *peripherals);
 
 #endif  // _WEBGBA_EMULATOR_PERIPHERALS_GBA_PERIPHERALS_
\ No newline at end of file
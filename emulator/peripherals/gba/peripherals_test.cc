@@ -330,6 +330,22 @@ TEST_F(PeripheralsTest, GbaPeripheralsRegistersLoad32LE) {
   EXPECT_FALSE(Load32LE(regs_, JOYSTAT_OFFSET + 4u, &contents));
 }
 
+TEST_F(PeripheralsTest, Reset) {
+  GamePadToggleA(gamepad_, true);
+  EXPECT_TRUE(Store16LE(regs_, KEYCNT_OFFSET, 0x4003u));
+  EXPECT_TRUE(Store16LE(regs_, RCNT_OFFSET, 0u));
+
+  GbaPeripheralsReset(peripherals_);
+
+  uint16_t value;
+  EXPECT_TRUE(Load16LE(regs_, KEYINPUT_OFFSET, &value));
+  EXPECT_EQ(0x03FEu, value);
+  EXPECT_TRUE(Load16LE(regs_, KEYCNT_OFFSET, &value));
+  EXPECT_EQ(0u, value);
+  EXPECT_TRUE(Load16LE(regs_, RCNT_OFFSET, &value));
+  EXPECT_EQ(0x8000u, value);
+}
+
 TEST_F(PeripheralsTest, GamePadInterruptDisabled) {
   GamePadToggleSelect(gamepad_, true);
   EXPECT_FALSE(raised_);
@@ -1,9 +1,11 @@
 #include "emulator/platform/gba/platform.h"
 
 #include <assert.h>
-#include <stdlib.h>
+#include <string.h>
 #include <strings.h>
 
+#include "emulator/arena.h"
+
 #define STOP_MASK 0x3080u
 
 #define IE_OFFSET 0x0u
@@ -71,8 +73,12 @@ typedef struct {
 struct _GbaPlatform {
   GbaPlatformRegisters registers;
   PowerState power_state;
+#ifdef WEBGBA_DIRECT_SIGNALS
+  GbaSignals *signals;
+#else
   Power *power;
   InterruptLine *interrupt_line;
+#endif  // WEBGBA_DIRECT_SIGNALS
   uint16_t reference_count;
 };
 
@@ -89,10 +95,22 @@ static bool GbaPlatformRegisterIsMemoryControl(uint32_t address) {
 
 static void GbaPlatformSetPowerState(GbaPlatform *platform,
                                      PowerState power_state) {
+#ifdef WEBGBA_DIRECT_SIGNALS
+  GbaSignalsSetPowerState(platform->signals, power_state);
+#else
   PowerSet(platform->power, power_state);
+#endif  // WEBGBA_DIRECT_SIGNALS
   platform->power_state = power_state;
 }
 
+static inline void GbaPlatformSetIrqLevel(GbaPlatform *platform, bool raised) {
+#ifdef WEBGBA_DIRECT_SIGNALS
+  GbaSignalsSetIrqLevel(platform->signals, raised);
+#else
+  InterruptLineSetLevel(platform->interrupt_line, raised);
+#endif  // WEBGBA_DIRECT_SIGNALS
+}
+
 static void GbaPlatformRegisterWriteMemoryControlByte(GbaPlatform *platform,
                                                       uint32_t address,
                                                       uint8_t value) {
@@ -223,12 +241,12 @@ static bool GbaPlatformRegistersStore16LEImpl(GbaPlatform *platform,
     case IE_OFFSET:
       platform->registers.interrupt_enable.value = value;
       raised = GbaIrqLineIsRaisedFunction(platform);
-      InterruptLineSetLevel(platform->interrupt_line, raised);
+      GbaPlatformSetIrqLevel(platform, raised);
       return true;
     case IF_OFFSET:
       platform->registers.interrupt_flags.value &= ~value;
       raised = GbaIrqLineIsRaisedFunction(platform);
-      InterruptLineSetLevel(platform->interrupt_line, raised);
+      GbaPlatformSetIrqLevel(platform, raised);
       return true;
     case WAITCNT_OFFSET:
       platform->registers.waitcnt.value = value & 0x7FFFu;
@@ -236,7 +254,7 @@ static bool GbaPlatformRegistersStore16LEImpl(GbaPlatform *platform,
     case IME_OFFSET:
       platform->registers.interrupt_master_enable.value = value & 1u;
       raised = GbaIrqLineIsRaisedFunction(platform);
-      InterruptLineSetLevel(platform->interrupt_line, raised);
+      GbaPlatformSetIrqLevel(platform, raised);
       return true;
     case POSTFLG_OFFSET:
       platform->registers.postflg = value;
@@ -352,20 +370,47 @@ static bool GbaPlatformRegistersStore8(void *context, uint32_t address,
   return result;
 }
 
+static const uint16_t *GbaPlatformRegisterStorage(const void *context,
+                                                  uint32_t address) {
+  const GbaPlatform *platform = (const GbaPlatform *)context;
+
+  switch (address) {
+    case IE_OFFSET:
+      return &platform->registers.interrupt_enable.value;
+    case IF_OFFSET:
+      return &platform->registers.interrupt_flags.value;
+    case WAITCNT_OFFSET:
+      return &platform->registers.waitcnt.value;
+    case IME_OFFSET:
+      return &platform->registers.interrupt_master_enable.value;
+  }
+
+  return NULL;
+}
+
 void GbaPlatformRegistersFree(void *context) {
   GbaPlatform *platform = (GbaPlatform *)context;
   GbaPlatformRelease(platform);
 }
 
+#ifdef WEBGBA_DIRECT_SIGNALS
+bool GbaPlatformAllocate(GbaSignals *signals, GbaPlatform **platform,
+                         Memory **registers) {
+#else
 bool GbaPlatformAllocate(Power *power, InterruptLine *irq_line,
                          GbaPlatform **platform, Memory **registers) {
-  *platform = (GbaPlatform *)calloc(1, sizeof(GbaPlatform));
+#endif  // WEBGBA_DIRECT_SIGNALS
+  *platform = (GbaPlatform *)ArenaCalloc(1, sizeof(GbaPlatform));
   if (*platform == NULL) {
     return false;
   }
 
+#ifdef WEBGBA_DIRECT_SIGNALS
+  (*platform)->signals = signals;
+#else
   (*platform)->power = power;
   (*platform)->interrupt_line = irq_line;
+#endif  // WEBGBA_DIRECT_SIGNALS
   (*platform)->reference_count = 2u;
 
   *registers = MemoryAllocate(
@@ -375,20 +420,37 @@ bool GbaPlatformAllocate(Power *power, InterruptLine *irq_line,
       GbaPlatformRegistersFree);
 
   if (*registers == NULL) {
-    free(*platform);
+    ArenaFreeAllocation(*platform);
     return false;
   }
 
+  MemorySetRegisterStorage(*registers, GbaPlatformRegisterStorage);
+
   GbaPlatformSetPowerState(*platform, POWER_STATE_RUN);
 
+#ifdef WEBGBA_DIRECT_SIGNALS
+  GbaSignalsRetain(signals);
+#endif  // WEBGBA_DIRECT_SIGNALS
+
   return true;
 }
 
+void GbaPlatformReset(GbaPlatform *platform) {
+  memset(&platform->registers, 0, sizeof(GbaPlatformRegisters));
+  GbaPlatformSetIrqLevel(platform, false);
+  GbaPlatformSetPowerState(platform, POWER_STATE_RUN);
+}
+
+void GbaPlatformCopyState(GbaPlatform *destination, const GbaPlatform *source) {
+  destination->registers = source->registers;
+  destination->power_state = source->power_state;
+}
+
 void GbaPlatformRaiseVBlankInterrupt(GbaPlatform *platform) {
   platform->registers.interrupt_flags.vblank = true;
 
   bool raised = GbaIrqLineIsRaisedFunction(platform);
-  InterruptLineSetLevel(platform->interrupt_line, raised);
+  GbaPlatformSetIrqLevel(platform, raised);
 
   if (platform->power_state == POWER_STATE_HALT && raised) {
     GbaPlatformSetPowerState(platform, POWER_STATE_RUN);
@@ -399,7 +461,7 @@ void GbaPlatformRaiseHBlankInterrupt(GbaPlatform *platform) {
   platform->registers.interrupt_flags.hblank = true;
 
   bool raised = GbaIrqLineIsRaisedFunction(platform);
-  InterruptLineSetLevel(platform->interrupt_line, raised);
+  GbaPlatformSetIrqLevel(platform, raised);
 
   if (platform->power_state == POWER_STATE_HALT && raised) {
     GbaPlatformSetPowerState(platform, POWER_STATE_RUN);
@@ -410,7 +472,7 @@ void GbaPlatformRaiseVBlankCountInterrupt(GbaPlatform *platform) {
   platform->registers.interrupt_flags.vblank_count = true;
 
   bool raised = GbaIrqLineIsRaisedFunction(platform);
-  InterruptLineSetLevel(platform->interrupt_line, raised);
+  GbaPlatformSetIrqLevel(platform, raised);
 
   if (platform->power_state == POWER_STATE_HALT && raised) {
     GbaPlatformSetPowerState(platform, POWER_STATE_RUN);
@@ -423,7 +485,7 @@ void GbaPlatformRaiseTimerInterrupt(GbaPlatform *platform, GbaTimerId timer) {
   platform->registers.interrupt_flags.timers |= 1u << timer;
 
   bool raised = GbaIrqLineIsRaisedFunction(platform);
-  InterruptLineSetLevel(platform->interrupt_line, raised);
+  GbaPlatformSetIrqLevel(platform, raised);
 
   if (platform->power_state == POWER_STATE_HALT && raised) {
     GbaPlatformSetPowerState(platform, POWER_STATE_RUN);
@@ -434,7 +496,7 @@ void GbaPlatformRaiseSerialInterrupt(GbaPlatform *platform) {
   platform->registers.interrupt_flags.serial = true;
 
   bool raised = GbaIrqLineIsRaisedFunction(platform);
-  InterruptLineSetLevel(platform->interrupt_line, raised);
+  GbaPlatformSetIrqLevel(platform, raised);
 
   if (platform->power_state != POWER_STATE_RUN) {
     static const uint16_t masks[3] = {0xFFu, 0xFFu, STOP_MASK};
@@ -453,7 +515,7 @@ void GbaPlatformRaiseDmaInterrupt(GbaPlatform *platform, GbaDmaId dma) {
   platform->registers.interrupt_flags.dmas |= 1u << dma;
 
   bool raised = GbaIrqLineIsRaisedFunction(platform);
-  InterruptLineSetLevel(platform->interrupt_line, raised);
+  GbaPlatformSetIrqLevel(platform, raised);
 
   if (platform->power_state == POWER_STATE_HALT && raised) {
     GbaPlatformSetPowerState(platform, POWER_STATE_RUN);
@@ -464,7 +526,7 @@ void GbaPlatformRaiseKeypadInterrupt(GbaPlatform *platform) {
   platform->registers.interrupt_flags.keypad = true;
 
   bool raised = GbaIrqLineIsRaisedFunction(platform);
-  InterruptLineSetLevel(platform->interrupt_line, raised);
+  GbaPlatformSetIrqLevel(platform, raised);
 
   if (platform->power_state != POWER_STATE_RUN) {
     static const uint16_t masks[3] = {0xFFu, 0xFFu, STOP_MASK};
@@ -481,7 +543,7 @@ void GbaPlatformRaiseCartridgeInterrupt(GbaPlatform *platform) {
   platform->registers.interrupt_flags.cartridge = true;
 
   bool raised = GbaIrqLineIsRaisedFunction(platform);
-  InterruptLineSetLevel(platform->interrupt_line, raised);
+  GbaPlatformSetIrqLevel(platform, raised);
 
   if (platform->power_state != POWER_STATE_RUN) {
     static const uint16_t masks[3] = {0xFFu, 0xFFu, STOP_MASK};
@@ -550,8 +612,12 @@ void GbaPlatformRelease(GbaPlatform *platform) {
 
   platform->reference_count -= 1u;
   if (platform->reference_count == 0u) {
+#ifdef WEBGBA_DIRECT_SIGNALS
+    GbaSignalsRelease(platform->signals);
+#else
     PowerFree(platform->power);
     InterruptLineFree(platform->interrupt_line);
-    free(platform);
+#endif  // WEBGBA_DIRECT_SIGNALS
+    ArenaFreeAllocation(platform);
   }
 }
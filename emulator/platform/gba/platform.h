@@ -5,12 +5,25 @@
 
 #include "emulator/cpu/interrupt_line.h"
 #include "emulator/memory/memory.h"
+#include "emulator/platform/gba/signals.h"
 #include "emulator/platform/power.h"
 
 typedef struct _GbaPlatform GbaPlatform;
 
+#ifdef WEBGBA_DIRECT_SIGNALS
+bool GbaPlatformAllocate(GbaSignals *signals, GbaPlatform **platform,
+                         Memory **registers);
+#else
 bool GbaPlatformAllocate(Power *power, InterruptLine *irq_line,
                          GbaPlatform **platform, Memory **registers);
+#endif  // WEBGBA_DIRECT_SIGNALS
+
+// Restores the power on registers, lowers the IRQ line and resumes running
+void GbaPlatformReset(GbaPlatform *platform);
+
+// Copies the registers and power state of another platform without signaling
+// the power or IRQ lines
+void GbaPlatformCopyState(GbaPlatform *destination, const GbaPlatform *source);
 
 // Interrupts
 void GbaPlatformRaiseVBlankInterrupt(GbaPlatform *platform);
@@ -99,6 +99,33 @@ TEST_F(PlatformTest, GbaPlatformInterruptAcknowledge) {
   EXPECT_EQ(0x3FFDu, value);
 }
 
+TEST_F(PlatformTest, GbaPlatformReset) {
+  EXPECT_TRUE(Store8(registers_, HALTCNT_OFFSET, 0u));
+  EXPECT_EQ(POWER_STATE_HALT, power_state_);
+
+  GbaPlatformReset(platform_);
+  EXPECT_EQ(POWER_STATE_RUN, power_state_);
+
+  EXPECT_TRUE(Store16LE(registers_, IME_OFFSET, 1u));
+  EXPECT_TRUE(Store16LE(registers_, IE_OFFSET, 1u));
+  EXPECT_TRUE(Store16LE(registers_, WAITCNT_OFFSET, 0x4317u));
+  GbaPlatformRaiseVBlankInterrupt(platform_);
+  EXPECT_TRUE(raised_);
+
+  GbaPlatformReset(platform_);
+  EXPECT_FALSE(raised_);
+
+  uint16_t value;
+  EXPECT_TRUE(Load16LE(registers_, IME_OFFSET, &value));
+  EXPECT_EQ(0u, value);
+  EXPECT_TRUE(Load16LE(registers_, IE_OFFSET, &value));
+  EXPECT_EQ(0u, value);
+  EXPECT_TRUE(Load16LE(registers_, IF_OFFSET, &value));
+  EXPECT_EQ(0u, value);
+  EXPECT_TRUE(Load16LE(registers_, WAITCNT_OFFSET, &value));
+  EXPECT_EQ(0u, value);
+}
+
 TEST_F(PlatformTest, GbaPlatformRaiseVBlankInterrupt) {
   GbaPlatformRaiseVBlankInterrupt(platform_);
   EXPECT_FALSE(raised_);
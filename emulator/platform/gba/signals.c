@@ -0,0 +1,34 @@
+#include "emulator/platform/gba/signals.h"
+
+#include <assert.h>
+
+#include "emulator/arena.h"
+
+GbaSignals *GbaSignalsAllocate(Arm7Tdmi *cpu) {
+  GbaSignals *signals = (GbaSignals *)ArenaCalloc(1u, sizeof(GbaSignals));
+  if (signals == NULL) {
+    return NULL;
+  }
+
+  signals->cpu = cpu;
+  signals->power_state = POWER_STATE_RUN;
+  signals->reference_count = 1u;
+
+  Arm7TdmiRetain(cpu);
+
+  return signals;
+}
+
+void GbaSignalsRetain(GbaSignals *signals) {
+  assert(signals->reference_count != UINT16_MAX);
+  signals->reference_count += 1u;
+}
+
+void GbaSignalsRelease(GbaSignals *signals) {
+  assert(signals->reference_count != 0u);
+  signals->reference_count -= 1u;
+  if (signals->reference_count == 0u) {
+    Arm7TdmiFree(signals->cpu);
+    ArenaFreeAllocation(signals);
+  }
+}
\ No newline at end of file
@@ -0,0 +1,47 @@
+#ifndef _WEBGBA_EMULATOR_PLATFORM_GBA_SIGNALS_
+#define _WEBGBA_EMULATOR_PLATFORM_GBA_SIGNALS_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "emulator/cpu/arm7tdmi/arm7tdmi.h"
+#include "emulator/platform/power.h"
+
+// The status word shared by the components of a GBA built with
+// WEBGBA_DIRECT_SIGNALS. The platform and DMA unit raise the IRQ line and
+// report power and DMA changes through direct calls on it in place of the
+// InterruptLine, Power, and DmaStatus objects, and the emulator reads the
+// power state and DMA activity back once per slice.
+typedef struct {
+  Arm7Tdmi *cpu;
+  PowerState power_state;
+  bool dma_active;
+  uint16_t reference_count;
+} GbaSignals;
+
+GbaSignals *GbaSignalsAllocate(Arm7Tdmi *cpu);
+
+static inline void GbaSignalsSetIrqLevel(GbaSignals *signals, bool raised) {
+  Arm7TdmiSetIrqLevel(signals->cpu, raised);
+}
+
+static inline void GbaSignalsSetPowerState(GbaSignals *signals,
+                                           PowerState power_state) {
+  signals->power_state = power_state;
+  if (power_state != POWER_STATE_RUN) {
+    Arm7TdmiHalt(signals->cpu);
+  }
+}
+
+static inline void GbaSignalsSetDmaActive(GbaSignals *signals, bool active) {
+  signals->dma_active = active;
+  if (active) {
+    Arm7TdmiHalt(signals->cpu);
+  }
+}
+
+// Reference Counting
+void GbaSignalsRetain(GbaSignals *signals);
+void GbaSignalsRelease(GbaSignals *signals);
+
+#endif  // _WEBGBA_EMULATOR_PLATFORM_GBA_SIGNALS_
\ No newline at end of file
@@ -0,0 +1,200 @@
+extern "C" {
+#include "emulator/platform/gba/signals.h"
+}
+
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+#include "googletest/include/gtest/gtest.h"
+
+#define IRQ_VECTOR 0x18u
+#define SIGNAL_ADDRESS 0x200u
+
+class SignalsTest : public testing::Test {
+ public:
+  void SetUp() override {
+    std::fill(memory_space_.begin(), memory_space_.end(), 0);
+    loaded_irq_vector_ = false;
+    on_store_ = nullptr;
+
+    AddInstruction(0x0u, 0xE5800200u);  // str r0, [r0, #0x200]
+    AddInstruction(0x4u, 0xEAFFFFFEu);  // b #0x4
+
+    memory_ = MemoryAllocate(nullptr, Load32LE, Load16LE, Load8, Store32LE,
+                             Store16LE, Store8, nullptr);
+    ASSERT_NE(nullptr, memory_);
+
+    ASSERT_TRUE(Arm7TdmiAllocate(&cpu_, &rst_, &fiq_, &irq_));
+
+    signals_ = GbaSignalsAllocate(cpu_);
+    ASSERT_NE(nullptr, signals_);
+  }
+
+  void TearDown() override {
+    GbaSignalsRelease(signals_);
+    MemoryFree(memory_);
+    Arm7TdmiFree(cpu_);
+    InterruptLineFree(rst_);
+    InterruptLineFree(fiq_);
+    InterruptLineFree(irq_);
+  }
+
+ protected:
+  static void AddInstruction(uint32_t address, uint32_t instruction) {
+    memcpy(memory_space_.data() + address, &instruction, sizeof(uint32_t));
+  }
+
+  static bool Load32LE(const void *context, uint32_t address, uint32_t *value) {
+    if (address + sizeof(uint32_t) - 1 >= memory_space_.size()) {
+      return false;
+    }
+
+    if (address == IRQ_VECTOR) {
+      loaded_irq_vector_ = true;
+    }
+
+    memcpy(value, memory_space_.data() + address, sizeof(uint32_t));
+    return true;
+  }
+
+  static bool Load16LE(const void *context, uint32_t address, uint16_t *value) {
+    if (address + sizeof(uint16_t) - 1 >= memory_space_.size()) {
+      return false;
+    }
+
+    memcpy(value, memory_space_.data() + address, sizeof(uint16_t));
+    return true;
+  }
+
+  static bool Load8(const void *context, uint32_t address, uint8_t *value) {
+    if (address >= memory_space_.size()) {
+      return false;
+    }
+
+    *value = memory_space_[address];
+    return true;
+  }
+
+  static bool Store32LE(void *context, uint32_t address, uint32_t value) {
+    if (address + sizeof(uint32_t) - 1 >= memory_space_.size()) {
+      return false;
+    }
+
+    if (address == SIGNAL_ADDRESS && on_store_ != nullptr) {
+      on_store_(signals_);
+    }
+
+    memcpy(memory_space_.data() + address, &value, sizeof(uint32_t));
+    return true;
+  }
+
+  static bool Store16LE(void *context, uint32_t address, uint16_t value) {
+    if (address + sizeof(uint16_t) - 1 >= memory_space_.size()) {
+      return false;
+    }
+
+    memcpy(memory_space_.data() + address, &value, sizeof(uint16_t));
+    return true;
+  }
+
+  static bool Store8(void *context, uint32_t address, uint8_t value) {
+    if (address >= memory_space_.size()) {
+      return false;
+    }
+
+    memory_space_[address] = value;
+    return true;
+  }
+
+  static std::vector<char> memory_space_;
+  static bool loaded_irq_vector_;
+  static void (*on_store_)(GbaSignals *signals);
+  static GbaSignals *signals_;
+
+  Arm7Tdmi *cpu_;
+  InterruptLine *rst_;
+  InterruptLine *fiq_;
+  InterruptLine *irq_;
+  Memory *memory_;
+};
+
+std::vector<char> SignalsTest::memory_space_(1024u, 0);
+bool SignalsTest::loaded_irq_vector_ = false;
+void (*SignalsTest::on_store_)(GbaSignals *signals) = nullptr;
+GbaSignals *SignalsTest::signals_ = nullptr;
+
+TEST_F(SignalsTest, Allocate) {
+  EXPECT_EQ(POWER_STATE_RUN, signals_->power_state);
+  EXPECT_FALSE(signals_->dma_active);
+  EXPECT_EQ(100u, Arm7TdmiStep(cpu_, memory_, 100u));
+}
+
+TEST_F(SignalsTest, IrqLevel) {
+  GbaSignalsSetIrqLevel(signals_, true);
+  GbaSignalsSetIrqLevel(signals_, false);
+  Arm7TdmiStep(cpu_, memory_, 10u);
+  EXPECT_FALSE(loaded_irq_vector_);
+
+  GbaSignalsSetIrqLevel(signals_, true);
+  Arm7TdmiStep(cpu_, memory_, 10u);
+  EXPECT_TRUE(loaded_irq_vector_);
+}
+
+TEST_F(SignalsTest, Halt) {
+  on_store_ = [](GbaSignals *signals) {
+    GbaSignalsSetPowerState(signals, POWER_STATE_HALT);
+  };
+  EXPECT_GT(100u, Arm7TdmiStep(cpu_, memory_, 100u));
+  EXPECT_EQ(POWER_STATE_HALT, signals_->power_state);
+
+  GbaSignalsSetPowerState(signals_, POWER_STATE_RUN);
+  EXPECT_EQ(POWER_STATE_RUN, signals_->power_state);
+  EXPECT_EQ(100u, Arm7TdmiStep(cpu_, memory_, 100u));
+}
+
+TEST_F(SignalsTest, Stop) {
+  on_store_ = [](GbaSignals *signals) {
+    GbaSignalsSetPowerState(signals, POWER_STATE_STOP);
+  };
+  EXPECT_GT(100u, Arm7TdmiStep(cpu_, memory_, 100u));
+  EXPECT_EQ(POWER_STATE_STOP, signals_->power_state);
+
+  GbaSignalsSetPowerState(signals_, POWER_STATE_RUN);
+  EXPECT_EQ(POWER_STATE_RUN, signals_->power_state);
+  EXPECT_EQ(100u, Arm7TdmiStep(cpu_, memory_, 100u));
+}
+
+TEST_F(SignalsTest, RunDoesNotHalt) {
+  on_store_ = [](GbaSignals *signals) {
+    GbaSignalsSetPowerState(signals, POWER_STATE_RUN);
+  };
+  EXPECT_EQ(100u, Arm7TdmiStep(cpu_, memory_, 100u));
+  EXPECT_EQ(POWER_STATE_RUN, signals_->power_state);
+}
+
+TEST_F(SignalsTest, DmaActiveHaltsAndResumes) {
+  on_store_ = [](GbaSignals *signals) {
+    GbaSignalsSetDmaActive(signals, true);
+  };
+  EXPECT_GT(100u, Arm7TdmiStep(cpu_, memory_, 100u));
+  EXPECT_TRUE(signals_->dma_active);
+
+  GbaSignalsSetDmaActive(signals_, false);
+  EXPECT_FALSE(signals_->dma_active);
+  EXPECT_EQ(100u, Arm7TdmiStep(cpu_, memory_, 100u));
+}
+
+TEST_F(SignalsTest, DmaInactiveDoesNotHalt) {
+  on_store_ = [](GbaSignals *signals) {
+    GbaSignalsSetDmaActive(signals, false);
+  };
+  EXPECT_EQ(100u, Arm7TdmiStep(cpu_, memory_, 100u));
+  EXPECT_FALSE(signals_->dma_active);
+}
+
+TEST_F(SignalsTest, Retain) {
+  GbaSignalsRetain(signals_);
+  GbaSignalsRelease(signals_);
+  EXPECT_EQ(POWER_STATE_RUN, signals_->power_state);
+}
\ No newline at end of file
@@ -1,6 +1,6 @@
 #include "emulator/platform/power.h"
 
-#include <stdlib.h>
+#include "emulator/arena.h"
 
 struct _Power {
   PowerSetFunction set;
@@ -10,7 +10,7 @@ struct _Power {
 
 Power *PowerAllocate(void *context, PowerSetFunction set,
                      PowerContextFree free_context) {
-  Power *result = (Power *)malloc(sizeof(Power));
+  Power *result = (Power *)ArenaCalloc(1u, sizeof(Power));
   if (result == NULL) {
     return NULL;
   }
@@ -30,5 +30,5 @@ void PowerFree(Power *power) {
   if (power->free_context) {
     power->free_context(power->context);
   }
-  free(power);
+  ArenaFreeAllocation(power);
 }
\ No newline at end of file
@@ -1,7 +1,8 @@
 #include "emulator/ppu/gba/io/io.h"
 
 #include <assert.h>
-#include <stdlib.h>
+
+#include "emulator/arena.h"
 
 #define DISPCNT_OFFSET 0x00u
 #define GREENSWP_OFFSET 0x02u
@@ -221,15 +222,37 @@ static bool GbaPpuIoStore8(void *context, uint32_t address, uint8_t value) {
   return true;
 }
 
+static const uint16_t *GbaPpuIoRegisterStorage(const void *context,
+                                               uint32_t address) {
+  const GbaPpuIo *io = (const GbaPpuIo *)context;
+
+  switch (address) {
+    case DISPCNT_OFFSET:
+    case GREENSWP_OFFSET:
+    case DISPSTAT_OFFSET:
+    case VCOUNT_OFFSET:
+    case BG0CNT_OFFSET:
+    case BG1CNT_OFFSET:
+    case BG2CNT_OFFSET:
+    case BG3CNT_OFFSET:
+    case WININ_OFFSET:
+    case WINOUT_OFFSET:
+    case BLDCNT_OFFSET:
+      return &io->registers->half_words[address >> 1u];
+  }
+
+  return NULL;
+}
+
 void GbaPpuIoFree(void *context) {
   GbaPpuIo *io = (GbaPpuIo *)context;
   io->free_routine(io->free_address);
-  free(io);
+  ArenaFreeAllocation(io);
 }
 
 Memory *GbaPpuIoAllocate(GbaPpuRegisters *registers, GbaPpuIoDirtyBits *dirty,
                          MemoryContextFree free_routine, void *free_address) {
-  GbaPpuIo *io = (GbaPpuIo *)malloc(sizeof(GbaPpuIo));
+  GbaPpuIo *io = (GbaPpuIo *)ArenaCalloc(1u, sizeof(GbaPpuIo));
   if (io == NULL) {
     return NULL;
   }
@@ -243,9 +266,11 @@ Memory *GbaPpuIoAllocate(GbaPpuRegisters *registers, GbaPpuIoDirtyBits *dirty,
       io, GbaPpuIoLoad32LE, GbaPpuIoLoad16LE, GbaPpuIoLoad8, GbaPpuIoStore32LE,
       GbaPpuIoStore16LE, GbaPpuIoStore8, GbaPpuIoFree);
   if (result == NULL) {
-    free(io);
+    ArenaFreeAllocation(io);
     return NULL;
   }
 
+  MemorySetRegisterStorage(result, GbaPpuIoRegisterStorage);
+
   return result;
 }
\ No newline at end of file
@@ -18,18 +18,53 @@ typedef union {
 
 #define PALETTE_SIZE 1024u
 
+// Palette entries expanded to XRGB8888
+typedef union {
+  uint32_t large_palette[GBA_LARGE_PALETTE_SIZE];
+  uint32_t small_palettes[GBA_NUM_SMALL_PALETTES][GBA_SMALL_PALETTE_SIZE];
+} GbaPpuHostPaletteSegment;
+
 typedef union {
   struct {
-    GbaPpuPaletteSegment bg;
-    GbaPpuPaletteSegment obj;
+    GbaPpuHostPaletteSegment bg;
+    GbaPpuHostPaletteSegment obj;
+  };
+  uint32_t colors[PALETTE_SIZE >> 1u];
+} GbaPpuPaletteInternalMemory;
+
+typedef struct {
+  union {
+    struct {
+      GbaPpuPaletteSegment bg;
+      GbaPpuPaletteSegment obj;
+    };
+    uint32_t words[PALETTE_SIZE >> 2u];
+    uint16_t half_words[PALETTE_SIZE >> 1u];
+    uint8_t bytes[PALETTE_SIZE];
   };
-  uint32_t words[PALETTE_SIZE >> 2u];
-  uint16_t half_words[PALETTE_SIZE >> 1u];
-  uint8_t bytes[PALETTE_SIZE];
+  GbaPpuPaletteInternalMemory internal;
 } GbaPpuPaletteMemory;
 
-static_assert(sizeof(GbaPpuPaletteMemory) == PALETTE_SIZE,
-              "sizeof(GbaPpuPaletteMemory) != PALETTE_SIZE");
+static_assert(sizeof(GbaPpuPaletteMemory) -
+                      sizeof(GbaPpuPaletteInternalMemory) ==
+                  PALETTE_SIZE,
+              "sizeof(GbaPpuPaletteMemory) - "
+              "sizeof(GbaPpuPaletteInternalMemory) "
+              "!= PALETTE_SIZE");
+
+static inline uint32_t GbaPpuColorToXrgb8888(uint16_t color) {
+  static const uint8_t uint5_to_uint8[32u] = {
+      0u,   8u,   16u,  25u,  33u,  41u,  49u,  58u,  66u,  74u,  82u,
+      90u,  99u,  107u, 115u, 123u, 132u, 140u, 148u, 156u, 165u, 173u,
+      181u, 189u, 197u, 206u, 214u, 222u, 230u, 239u, 247u, 255u,
+  };
+
+  uint32_t r = uint5_to_uint8[color & 0x1Fu];
+  uint32_t g = uint5_to_uint8[(color >> 5u) & 0x1Fu];
+  uint32_t b = uint5_to_uint8[(color >> 10u) & 0x1Fu];
+
+  return (r << 16u) | (g << 8u) | b;
+}
 
 typedef union {
   struct {
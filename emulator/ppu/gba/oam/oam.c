@@ -1,7 +1,8 @@
 #include "emulator/ppu/gba/oam/oam.h"
 
 #include <assert.h>
-#include <stdlib.h>
+
+#include "emulator/arena.h"
 
 #define OAM_ADDRESS_MASK 0x3FFu
 
@@ -110,13 +111,13 @@ static bool OamStore8(void *context, uint32_t address, uint8_t value) {
 static void OamFree(void *context) {
   GbaPpuOam *oam = (GbaPpuOam *)context;
   oam->free_routine(oam->free_address);
-  free(oam);
+  ArenaFreeAllocation(oam);
 }
 
 Memory *OamAllocate(GbaPpuObjectAttributeMemory *oam_memory,
                     GbaPpuOamDirtyBits *dirty, MemoryContextFree free_routine,
                     void *free_address) {
-  GbaPpuOam *oam = (GbaPpuOam *)malloc(sizeof(GbaPpuOam));
+  GbaPpuOam *oam = (GbaPpuOam *)ArenaCalloc(1u, sizeof(GbaPpuOam));
   if (oam == NULL) {
     return NULL;
   }
@@ -130,7 +131,7 @@ Memory *OamAllocate(GbaPpuObjectAttributeMemory *oam_memory,
       MemoryAllocate(oam, OamLoad32LE, OamLoad16LE, OamLoad8, OamStore32LE,
                      OamStore16LE, OamStore8, OamFree);
   if (result == NULL) {
-    free(oam);
+    ArenaFreeAllocation(oam);
     return NULL;
   }
 
@@ -1,7 +1,8 @@
 #include "emulator/ppu/gba/palette/palette.h"
 
 #include <assert.h>
-#include <stdlib.h>
+
+#include "emulator/arena.h"
 
 #define PALETTE_ADDRESS_MASK 0x3FFu
 #define PALETTE_BYTE_ADDRESS_MASK 0x3FEu
@@ -68,6 +69,8 @@ static bool PaletteStore16LE(void *context, uint32_t address, uint16_t value) {
   uint16_t new_value = RotateLeft(value, 1u);
   bool dirty = palette->memory->half_words[address >> 1u] != new_value;
   palette->memory->half_words[address >> 1u] = new_value;
+  palette->memory->internal.colors[address >> 1u] =
+      GbaPpuColorToXrgb8888(value);
 
   palette->dirty->palette[address >> PALETTE_DIRTY_SHIFT] |= dirty;
 
@@ -94,13 +97,14 @@ static bool PaletteStore8(void *context, uint32_t address, uint8_t value) {
 static void PaletteFree(void *context) {
   GbaPpuPalette *palette = (GbaPpuPalette *)context;
   palette->free_routine(palette->free_address);
-  free(palette);
+  ArenaFreeAllocation(palette);
 }
 
 Memory *PaletteAllocate(GbaPpuPaletteMemory *palette_memory,
                         GbaPpuPaletteDirtyBits *dirty,
                         MemoryContextFree free_routine, void *free_address) {
-  GbaPpuPalette *palette = (GbaPpuPalette *)malloc(sizeof(GbaPpuPalette));
+  GbaPpuPalette *palette =
+      (GbaPpuPalette *)ArenaCalloc(1u, sizeof(GbaPpuPalette));
   if (palette == NULL) {
     return NULL;
   }
@@ -114,7 +118,7 @@ Memory *PaletteAllocate(GbaPpuPaletteMemory *palette_memory,
                                   PaletteLoad8, PaletteStore32LE,
                                   PaletteStore16LE, PaletteStore8, PaletteFree);
   if (result == NULL) {
-    free(palette);
+    ArenaFreeAllocation(palette);
     return NULL;
   }
 
@@ -8,6 +8,7 @@ class PaletteTest : public testing::Test {
  public:
   void SetUp() override {
     memset(&palette_memory_, 0, sizeof(GbaPpuPaletteMemory));
+    memset(&dirty_, 0, sizeof(GbaPpuPaletteDirtyBits));
     memory_ = PaletteAllocate(&palette_memory_, &dirty_, FreeRoutine, nullptr);
     ASSERT_NE(nullptr, memory_);
   }
@@ -33,6 +34,16 @@ TEST_F(PaletteTest, LoadStore32Succeeds) {
   EXPECT_EQ(0x20304050u, value);
 }
 
+TEST_F(PaletteTest, StoreUpdatesHostColors) {
+  EXPECT_TRUE(Store16LE(memory_, 0x202u, 0x7C1Fu));
+  EXPECT_EQ(0xFF00FFu, palette_memory_.internal.obj.large_palette[1u]);
+  EXPECT_EQ(0u, palette_memory_.internal.bg.large_palette[1u]);
+
+  EXPECT_TRUE(Store32LE(memory_, 0x4u, 0x03E00010u));
+  EXPECT_EQ(0x840000u, palette_memory_.internal.bg.large_palette[2u]);
+  EXPECT_EQ(0x00FF00u, palette_memory_.internal.bg.large_palette[3u]);
+}
+
 TEST_F(PaletteTest, LoadStore16Succeeds) {
   EXPECT_TRUE(Store16LE(memory_, 0x0u, 0x2030u));
   EXPECT_TRUE(dirty_.palette[0u]);
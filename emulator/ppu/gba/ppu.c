@@ -1,8 +1,9 @@
 #include "emulator/ppu/gba/ppu.h"
 
 #include <assert.h>
-#include <stdlib.h>
+#include <string.h>
 
+#include "emulator/arena.h"
 #include "emulator/ppu/gba/dirty.h"
 #include "emulator/ppu/gba/io/io.h"
 #include "emulator/ppu/gba/memory.h"
@@ -10,7 +11,9 @@
 #include "emulator/ppu/gba/opengl/render.h"
 #include "emulator/ppu/gba/palette/palette.h"
 #include "emulator/ppu/gba/registers.h"
+#include "emulator/ppu/gba/software/bands.h"
 #include "emulator/ppu/gba/software/render.h"
+#include "emulator/ppu/gba/software/worker.h"
 #include "emulator/ppu/gba/vram/vram.h"
 
 #define GBA_PPU_CYCLES_PER_PIXEL 4u
@@ -36,15 +39,22 @@ struct _GbaPpu {
   GbaDmaUnit *dma_unit;
   GbaPlatform *platform;
   GbaPpuSoftwareRenderer *software_renderer;
+  GbaPpuSoftwareWorker *software_worker;  // Allocated on first use
+  GbaPpuSoftwareBands *software_bands;    // Allocated on first use
   GbaPpuOpenGlRenderer *opengl_renderer;
   GbaPpuMemory memory;
   GbaPpuRegisters registers;
   GbaPpuRenderMode next_render_mode;
   uint8_t next_render_scale;
+  GbaPpuRenderMode renderer_mode;
+  uint8_t renderer_scale;
   GbaPpuState next_wake_state;
   GbaPpuState draw_state;
   GbaPpuDirtyBits dirty;
   bool use_hardware_renderer;
+  bool use_software_worker;
+  bool use_software_bands;
+  bool skip_rendering;
   bool render_mode_changed;
   uint32_t cycles_from_hblank_to_draw;
   uint_fast8_t x;
@@ -127,6 +137,25 @@ static void GbaPpuDrawnHBlank(GbaPpu *ppu) {
   ppu->x = 0u;
 }
 
+//
+// Power On State
+//
+
+static void GbaPpuPowerOn(GbaPpu *ppu) {
+  for (uint8_t i = 0; i < OAM_NUM_OBJECTS; i++) {
+    GbaPpuObjectVisibilityHidden(&ppu->memory.oam, i);
+    GbaPpuObjectVisibilityDrawn(&ppu->memory.oam, i);
+  }
+
+  ppu->registers.dispcnt.forced_blank = true;
+  ppu->registers.affine[0u].pa = 0x100;
+  ppu->registers.affine[0u].pd = 0x100;
+  ppu->registers.affine[1u].pa = 0x100;
+  ppu->registers.affine[1u].pd = 0x100;
+  ppu->registers.dispstat.vcount_status = true;
+  GbaPpuDirtyBitsAllDirty(&ppu->dirty);
+}
+
 //
 // Public Functions
 //
@@ -134,7 +163,7 @@ static void GbaPpuDrawnHBlank(GbaPpu *ppu) {
 bool GbaPpuAllocate(GbaDmaUnit *dma_unit, GbaPlatform *platform, GbaPpu **ppu,
                     Memory **palette, Memory **vram, Memory **oam,
                     Memory **registers) {
-  *ppu = (GbaPpu *)calloc(1, sizeof(GbaPpu));
+  *ppu = (GbaPpu *)ArenaCalloc(1, sizeof(GbaPpu));
   if (*ppu == NULL) {
     return false;
   }
@@ -144,7 +173,7 @@ bool GbaPpuAllocate(GbaDmaUnit *dma_unit, GbaPlatform *platform, GbaPpu **ppu,
   *palette = PaletteAllocate(&(*ppu)->memory.palette, &(*ppu)->dirty.palette,
                              GbaPpuRelease, *ppu);
   if (*palette == NULL) {
-    free(*ppu);
+    ArenaFreeAllocation(*ppu);
     return false;
   }
 
@@ -154,7 +183,7 @@ bool GbaPpuAllocate(GbaDmaUnit *dma_unit, GbaPlatform *platform, GbaPpu **ppu,
                        *ppu);
   if (*vram == NULL) {
     MemoryFree(*palette);
-    free(*ppu);
+    ArenaFreeAllocation(*ppu);
     return false;
   }
 
@@ -165,7 +194,7 @@ bool GbaPpuAllocate(GbaDmaUnit *dma_unit, GbaPlatform *platform, GbaPpu **ppu,
   if (*oam == NULL) {
     MemoryFree(*vram);
     MemoryFree(*palette);
-    free(*ppu);
+    ArenaFreeAllocation(*ppu);
     return false;
   }
 
@@ -177,7 +206,7 @@ bool GbaPpuAllocate(GbaDmaUnit *dma_unit, GbaPlatform *platform, GbaPpu **ppu,
     MemoryFree(*oam);
     MemoryFree(*vram);
     MemoryFree(*palette);
-    free(*ppu);
+    ArenaFreeAllocation(*ppu);
     return false;
   }
 
@@ -189,7 +218,7 @@ bool GbaPpuAllocate(GbaDmaUnit *dma_unit, GbaPlatform *platform, GbaPpu **ppu,
     MemoryFree(*vram);
     MemoryFree(*palette);
     MemoryFree(*registers);
-    free(*ppu);
+    ArenaFreeAllocation(*ppu);
     return false;
   }
 
@@ -200,24 +229,14 @@ bool GbaPpuAllocate(GbaDmaUnit *dma_unit, GbaPlatform *platform, GbaPpu **ppu,
     MemoryFree(*palette);
     MemoryFree(*registers);
     GbaPpuSoftwareRendererFree((*ppu)->software_renderer);
-    free(*ppu);
+    ArenaFreeAllocation(*ppu);
     return false;
   }
 
-  for (uint8_t i = 0; i < OAM_NUM_OBJECTS; i++) {
-    GbaPpuObjectVisibilityHidden(&(*ppu)->memory.oam, i);
-    GbaPpuObjectVisibilityDrawn(&(*ppu)->memory.oam, i);
-  }
+  GbaPpuPowerOn(*ppu);
 
   (*ppu)->dma_unit = dma_unit;
   (*ppu)->platform = platform;
-  (*ppu)->registers.dispcnt.forced_blank = true;
-  (*ppu)->registers.affine[0u].pa = 0x100;
-  (*ppu)->registers.affine[0u].pd = 0x100;
-  (*ppu)->registers.affine[1u].pa = 0x100;
-  (*ppu)->registers.affine[1u].pd = 0x100;
-  (*ppu)->registers.dispstat.vcount_status = true;
-  GbaPpuDirtyBitsAllDirty(&(*ppu)->dirty);
 
   GbaPpuSetRenderMode(*ppu, RENDER_MODE_SOFTWARE_ROWS, 1u);
 
@@ -227,6 +246,53 @@ bool GbaPpuAllocate(GbaDmaUnit *dma_unit, GbaPlatform *platform, GbaPpu **ppu,
   return true;
 }
 
+void GbaPpuReset(GbaPpu *ppu) {
+  // Rows already handed to a worker or to bands reference snapshots rather
+  // than this memory, so they do not need to be waited on
+  memset(&ppu->memory, 0, sizeof(GbaPpuMemory));
+  memset(&ppu->registers, 0, sizeof(GbaPpuRegisters));
+  ppu->x = 0u;
+  ppu->cycle_count = 0u;
+
+  GbaPpuPowerOn(ppu);
+
+  GbaPpuSetRenderMode(ppu, ppu->next_render_mode, ppu->next_render_scale);
+}
+
+void GbaPpuCopyState(GbaPpu *destination, const GbaPpu *source) {
+  destination->memory = source->memory;
+  destination->registers = source->registers;
+
+  // The frame in progress continues to use the renderer it was started with
+  if (source->use_software_worker && destination->software_worker == NULL) {
+    destination->software_worker = GbaPpuSoftwareWorkerAllocate();
+  }
+
+  if (source->use_software_bands && destination->software_bands == NULL) {
+    destination->software_bands = GbaPpuSoftwareBandsAllocate(0u);
+  }
+
+  destination->next_render_mode = source->next_render_mode;
+  destination->next_render_scale = source->next_render_scale;
+  destination->renderer_mode = source->renderer_mode;
+  destination->renderer_scale = source->renderer_scale;
+  destination->next_wake_state = source->next_wake_state;
+  destination->draw_state = source->draw_state;
+  destination->use_hardware_renderer = source->use_hardware_renderer;
+  destination->use_software_worker =
+      source->use_software_worker && destination->software_worker != NULL;
+  destination->use_software_bands =
+      source->use_software_bands && destination->software_bands != NULL;
+  destination->skip_rendering = source->skip_rendering;
+  destination->render_mode_changed = source->render_mode_changed;
+  destination->cycles_from_hblank_to_draw = source->cycles_from_hblank_to_draw;
+  destination->x = source->x;
+  destination->cycle_count = source->cycle_count;
+  destination->next_wake = source->next_wake;
+
+  GbaPpuDirtyBitsAllDirty(&destination->dirty);
+}
+
 uint32_t GbaPpuCyclesUntilNextWake(const GbaPpu *ppu) {
   return ppu->next_wake - ppu->cycle_count;
 }
@@ -241,7 +307,9 @@ bool GbaPpuStep(GbaPpu *ppu, Screen *screen, uint32_t num_cycles) {
 
   switch (ppu->next_wake_state) {
     case GBA_PPU_DRAW_ROW:
-      if (ppu->use_hardware_renderer) {
+      if (ppu->skip_rendering) {
+        // Do Nothing
+      } else if (ppu->use_hardware_renderer) {
         if (ppu->registers.vcount == 0u) {
           GbaPpuOpenGlRendererSetScale(ppu->opengl_renderer,
                                        ppu->next_render_scale);
@@ -250,6 +318,26 @@ bool GbaPpuStep(GbaPpu *ppu, Screen *screen, uint32_t num_cycles) {
 
         GbaPpuOpenGlRendererDrawRow(ppu->opengl_renderer, &ppu->memory,
                                     &ppu->registers, &ppu->dirty);
+      } else if (ppu->use_software_bands) {
+        if (ppu->registers.vcount == 0u &&
+            !GbaPpuSoftwareBandsSetScreen(ppu->software_bands, screen)) {
+          // Skips the rest of the frame if the screen has no pixel buffer.
+          // Dirty bits keep accumulating and the render mode is reapplied at
+          // the end of the frame, so the next frame is drawn in full.
+          ppu->skip_rendering = true;
+        } else {
+          GbaPpuSoftwareBandsDrawRow(ppu->software_bands, &ppu->memory,
+                                     &ppu->registers, &ppu->dirty);
+        }
+      } else if (ppu->use_software_worker) {
+        if (ppu->registers.vcount == 0u &&
+            !GbaPpuSoftwareWorkerSetScreen(ppu->software_worker, screen)) {
+          // Skipped the same way as for bands
+          ppu->skip_rendering = true;
+        } else {
+          GbaPpuSoftwareWorkerDrawRow(ppu->software_worker, &ppu->memory,
+                                      &ppu->registers, &ppu->dirty);
+        }
       } else {
         if (ppu->registers.vcount == 0u) {
           // TODO: Handle allocation failure
@@ -303,6 +391,12 @@ bool GbaPpuStep(GbaPpu *ppu, Screen *screen, uint32_t num_cycles) {
 
         GbaDmaUnitSignalVBlank(ppu->dma_unit);
 
+        if (ppu->use_software_worker) {
+          GbaPpuSoftwareWorkerFinish(ppu->software_worker);
+        } else if (ppu->use_software_bands) {
+          GbaPpuSoftwareBandsFinish(ppu->software_bands);
+        }
+
         ppu->next_wake_state = GBA_PPU_PRE_OFFSCREEN_HBLANK;
         ppu->next_wake += GBA_PPU_DRAW_LENGTH_CYCLES;
         return true;
@@ -335,9 +429,16 @@ bool GbaPpuStep(GbaPpu *ppu, Screen *screen, uint32_t num_cycles) {
 
 void GbaPpuSetRenderMode(GbaPpu *ppu, GbaPpuRenderMode render_mode,
                          uint8_t opengl_render_scale) {
-  if (ppu->next_render_mode != render_mode ||
-      ppu->next_render_scale != opengl_render_scale) {
-    ppu->render_mode_changed = true;
+  // Dirty bits keep accumulating while rendering is skipped, so switching to
+  // or from RENDER_MODE_NONE does not require redrawing everything.
+  if (render_mode != RENDER_MODE_NONE) {
+    if (ppu->renderer_mode != render_mode ||
+        ppu->renderer_scale != opengl_render_scale) {
+      ppu->render_mode_changed = true;
+    }
+
+    ppu->renderer_mode = render_mode;
+    ppu->renderer_scale = opengl_render_scale;
   }
 
   ppu->next_render_mode = render_mode;
@@ -354,26 +455,76 @@ void GbaPpuSetRenderMode(GbaPpu *ppu, GbaPpuRenderMode render_mode,
 
   switch (render_mode) {
     case RENDER_MODE_OPENGL_ROWS:
+      ppu->use_software_worker = false;
+      ppu->use_software_bands = false;
       ppu->use_hardware_renderer = true;
+      ppu->skip_rendering = false;
       ppu->next_wake_state = GBA_PPU_DRAW_ROW;
       ppu->next_wake = GBA_PPU_DRAW_LENGTH_CYCLES;
       ppu->draw_state = GBA_PPU_DRAW_ROW;
       ppu->cycles_from_hblank_to_draw = GBA_PPU_DRAW_LENGTH_CYCLES;
       break;
     case RENDER_MODE_SOFTWARE_ROWS:
+      ppu->use_software_worker = false;
+      ppu->use_software_bands = false;
       ppu->use_hardware_renderer = false;
+      ppu->skip_rendering = false;
       ppu->next_wake_state = GBA_PPU_DRAW_ROW;
       ppu->next_wake = GBA_PPU_DRAW_LENGTH_CYCLES;
       ppu->draw_state = GBA_PPU_DRAW_ROW;
       ppu->cycles_from_hblank_to_draw = GBA_PPU_DRAW_LENGTH_CYCLES;
       break;
     case RENDER_MODE_SOFTWARE_PIXELS:
+      ppu->use_software_worker = false;
+      ppu->use_software_bands = false;
       ppu->use_hardware_renderer = false;
+      ppu->skip_rendering = false;
       ppu->next_wake_state = GBA_PPU_DRAW_PIXEL;
       ppu->next_wake = GBA_PPU_CYCLES_PER_PIXEL;
       ppu->draw_state = GBA_PPU_DRAW_PIXEL;
       ppu->cycles_from_hblank_to_draw = GBA_PPU_CYCLES_PER_PIXEL;
       break;
+    case RENDER_MODE_SOFTWARE_ROWS_THREADED:
+      if (ppu->software_worker == NULL) {
+        ppu->software_worker = GbaPpuSoftwareWorkerAllocate();
+      }
+
+      // Falls back to drawing rows on this thread if allocation failed
+      ppu->use_software_worker = ppu->software_worker != NULL;
+      ppu->use_software_bands = false;
+      ppu->use_hardware_renderer = false;
+      ppu->skip_rendering = false;
+      ppu->next_wake_state = GBA_PPU_DRAW_ROW;
+      ppu->next_wake = GBA_PPU_DRAW_LENGTH_CYCLES;
+      ppu->draw_state = GBA_PPU_DRAW_ROW;
+      ppu->cycles_from_hblank_to_draw = GBA_PPU_DRAW_LENGTH_CYCLES;
+      break;
+    case RENDER_MODE_SOFTWARE_ROWS_BANDS:
+      if (ppu->software_bands == NULL) {
+        // One band per online processor
+        ppu->software_bands = GbaPpuSoftwareBandsAllocate(0u);
+      }
+
+      // Falls back to drawing rows as they are reached if allocation failed
+      ppu->use_software_worker = false;
+      ppu->use_software_bands = ppu->software_bands != NULL;
+      ppu->use_hardware_renderer = false;
+      ppu->skip_rendering = false;
+      ppu->next_wake_state = GBA_PPU_DRAW_ROW;
+      ppu->next_wake = GBA_PPU_DRAW_LENGTH_CYCLES;
+      ppu->draw_state = GBA_PPU_DRAW_ROW;
+      ppu->cycles_from_hblank_to_draw = GBA_PPU_DRAW_LENGTH_CYCLES;
+      break;
+    case RENDER_MODE_NONE:
+      ppu->use_software_worker = false;
+      ppu->use_software_bands = false;
+      ppu->use_hardware_renderer = false;
+      ppu->skip_rendering = true;
+      ppu->next_wake_state = GBA_PPU_DRAW_ROW;
+      ppu->next_wake = GBA_PPU_DRAW_LENGTH_CYCLES;
+      ppu->draw_state = GBA_PPU_DRAW_ROW;
+      ppu->cycles_from_hblank_to_draw = GBA_PPU_DRAW_LENGTH_CYCLES;
+      break;
   }
 }
 
@@ -381,10 +532,17 @@ void GbaPpuFree(GbaPpu *ppu) {
   assert(ppu->reference_count != 0u);
   ppu->reference_count -= 1u;
   if (ppu->reference_count == 0u) {
+    GbaDmaUnitRelease(ppu->dma_unit);
     GbaPlatformRelease(ppu->platform);
     GbaPpuSoftwareRendererFree(ppu->software_renderer);
+    if (ppu->software_worker != NULL) {
+      GbaPpuSoftwareWorkerFree(ppu->software_worker);
+    }
+    if (ppu->software_bands != NULL) {
+      GbaPpuSoftwareBandsFree(ppu->software_bands);
+    }
     GbaPpuOpenGlRendererFree(ppu->opengl_renderer);
-    free(ppu);
+    ArenaFreeAllocation(ppu);
   }
 }
 
@@ -12,6 +12,9 @@ typedef enum {
   RENDER_MODE_OPENGL_ROWS = 0u,
   RENDER_MODE_SOFTWARE_ROWS = 1u,
   RENDER_MODE_SOFTWARE_PIXELS = 2u,
+  RENDER_MODE_NONE = 3u,  // Keeps timing and interrupts but draws nothing
+  RENDER_MODE_SOFTWARE_ROWS_THREADED = 4u,
+  RENDER_MODE_SOFTWARE_ROWS_BANDS = 5u,  // Draws rows in parallel at VBlank
 } GbaPpuRenderMode;
 
 typedef struct _GbaPpu GbaPpu;
@@ -21,6 +24,16 @@ bool GbaPpuAllocate(GbaDmaUnit *dma_unit, GbaPlatform *platform, GbaPpu **ppu,
                     Memory **pram, Memory **vram, Memory **oam,
                     Memory **registers);
 
+// Restores the power on memory and registers and restarts the frame. The
+// render mode and renderers are kept.
+void GbaPpuReset(GbaPpu *ppu);
+
+// Copies the memory, registers and position in the frame of another PPU. The
+// destination keeps its own renderers, which redraw everything on their next
+// row. Renderers only pick up a screen as a frame begins, so if the copy is
+// made partway through a frame the rest of that frame is not drawn.
+void GbaPpuCopyState(GbaPpu *destination, const GbaPpu *source);
+
 uint32_t GbaPpuCyclesUntilNextWake(const GbaPpu *ppu);
 
 bool GbaPpuStep(GbaPpu *ppu, Screen *screen, uint32_t num_cycles);
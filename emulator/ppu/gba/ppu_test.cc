@@ -6,6 +6,7 @@ extern "C" {
 
 #define DISPCNT_OFFSET 0x00u
 #define DISPSTAT_OFFSET 0x04u
+#define VCOUNT_OFFSET 0x06u
 
 class PpuTest : public testing::Test {
  public:
@@ -72,4 +73,58 @@ TEST_F(PpuTest, InitialRegisterState) {
   EXPECT_EQ(0x80u, contents);
   EXPECT_TRUE(Load16LE(regs_, DISPSTAT_OFFSET, &contents));
   EXPECT_EQ(0x4u, contents);
+}
+
+TEST_F(PpuTest, NoRenderingKeepsFrameTiming) {
+  GbaPpuSetRenderMode(ppu_, RENDER_MODE_NONE, 1u);
+
+  uint32_t cycles = 0u;
+  bool vblank = false;
+  while (!vblank) {
+    uint32_t step = GbaPpuCyclesUntilNextWake(ppu_);
+    cycles += step;
+    vblank = GbaPpuStep(ppu_, nullptr, step);
+  }
+
+  EXPECT_EQ(160u * 1232u, cycles);
+
+  uint16_t contents;
+  EXPECT_TRUE(Load16LE(regs_, DISPSTAT_OFFSET, &contents));
+  EXPECT_EQ(0x1u, contents & 0x1u);
+  EXPECT_TRUE(Load16LE(regs_, VCOUNT_OFFSET, &contents));
+  EXPECT_EQ(160u, contents);
+}
+
+TEST_F(PpuTest, Reset) {
+  GbaPpuSetRenderMode(ppu_, RENDER_MODE_NONE, 1u);
+  EXPECT_TRUE(Store16LE(regs_, DISPCNT_OFFSET, 0x1F03u));
+  EXPECT_TRUE(Store16LE(pram_, 0u, 0x7FFFu));
+  EXPECT_TRUE(Store16LE(vram_, 0u, 0x1234u));
+  for (uint8_t i = 0u; i < 4u; i++) {
+    GbaPpuStep(ppu_, nullptr, GbaPpuCyclesUntilNextWake(ppu_));
+  }
+
+  GbaPpuReset(ppu_);
+
+  uint16_t contents;
+  EXPECT_TRUE(Load16LE(regs_, DISPCNT_OFFSET, &contents));
+  EXPECT_EQ(0x80u, contents);
+  EXPECT_TRUE(Load16LE(regs_, DISPSTAT_OFFSET, &contents));
+  EXPECT_EQ(0x4u, contents);
+  EXPECT_TRUE(Load16LE(regs_, VCOUNT_OFFSET, &contents));
+  EXPECT_EQ(0u, contents);
+  EXPECT_TRUE(Load16LE(pram_, 0u, &contents));
+  EXPECT_EQ(0u, contents);
+  EXPECT_TRUE(Load16LE(vram_, 0u, &contents));
+  EXPECT_EQ(0u, contents);
+
+  uint32_t cycles = 0u;
+  bool vblank = false;
+  while (!vblank) {
+    uint32_t step = GbaPpuCyclesUntilNextWake(ppu_);
+    cycles += step;
+    vblank = GbaPpuStep(ppu_, nullptr, step);
+  }
+
+  EXPECT_EQ(160u * 1232u, cycles);
 }
\ No newline at end of file
@@ -0,0 +1,259 @@
+#include "emulator/ppu/gba/software/bands.h"
+
+#include <assert.h>
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "emulator/ppu/gba/software/render.h"
+#include "emulator/ppu/gba/software/snapshot.h"
+
+#define GBA_PPU_BANDS_MAX_BANDS 8u
+#define GBA_PPU_BANDS_NUM_SNAPSHOTS 4u
+
+typedef struct {
+  GbaPpuRegisters registers;
+  uint8_t snapshot;
+  bool recorded;
+} GbaPpuBandsRow;
+
+typedef struct {
+  GbaPpuSoftwareBands* bands;
+  GbaPpuSoftwareRenderer* renderer;
+  pthread_t thread;
+  uint8_t start;
+  uint8_t end;
+} GbaPpuBand;
+
+struct _GbaPpuSoftwareBands {
+  GbaPpuMemorySnapshot snapshots[GBA_PPU_BANDS_NUM_SNAPSHOTS];
+  GbaPpuMemoryVersion version;
+  uint8_t num_snapshots_used;
+  GbaPpuBandsRow rows[GBA_SCREEN_HEIGHT];
+  uint8_t num_rows_recorded;
+  GbaPpuBand bands[GBA_PPU_BANDS_MAX_BANDS];
+  uint8_t num_bands;
+  uint8_t num_threads;
+  uint32_t generation;
+  uint8_t bands_remaining;
+  bool exit;
+  pthread_mutex_t lock;
+  pthread_cond_t start;
+  pthread_cond_t done;
+};
+
+static void GbaPpuSoftwareBandsDrawBand(GbaPpuSoftwareBands* bands,
+                                        GbaPpuBand* band) {
+  // Rows are drawn from snapshots that the renderer reads in full, so no
+  // writes are reported to it
+  GbaPpuDirtyBits dirty_bits;
+  memset(&dirty_bits, 0, sizeof(GbaPpuDirtyBits));
+  for (uint8_t y = band->start; y < band->end; y++) {
+    const GbaPpuBandsRow* row = &bands->rows[y];
+    if (!row->recorded) {
+      continue;
+    }
+
+    GbaPpuSoftwareRendererDrawRow(band->renderer,
+                                  &bands->snapshots[row->snapshot].memory,
+                                  &row->registers, &dirty_bits);
+  }
+}
+
+static void* GbaPpuSoftwareBandsMain(void* context) {
+  GbaPpuBand* band = (GbaPpuBand*)context;
+  GbaPpuSoftwareBands* bands = band->bands;
+
+  uint32_t generation = 0u;
+  pthread_mutex_lock(&bands->lock);
+  for (;;) {
+    while (!bands->exit && bands->generation == generation) {
+      pthread_cond_wait(&bands->start, &bands->lock);
+    }
+
+    if (bands->exit) {
+      break;
+    }
+
+    generation = bands->generation;
+    pthread_mutex_unlock(&bands->lock);
+
+    GbaPpuSoftwareBandsDrawBand(bands, band);
+
+    pthread_mutex_lock(&bands->lock);
+    bands->bands_remaining -= 1u;
+    if (bands->bands_remaining == 0u) {
+      pthread_cond_signal(&bands->done);
+    }
+  }
+  pthread_mutex_unlock(&bands->lock);
+
+  return NULL;
+}
+
+GbaPpuSoftwareBands* GbaPpuSoftwareBandsAllocate(uint8_t num_bands) {
+  if (num_bands == 0u) {
+    // The processor count is clamped before it is narrowed so that large
+    // counts cannot wrap around to zero bands
+    long num_processors = sysconf(_SC_NPROCESSORS_ONLN);
+    if (num_processors > (long)GBA_PPU_BANDS_MAX_BANDS) {
+      num_bands = GBA_PPU_BANDS_MAX_BANDS;
+    } else if (num_processors > 0) {
+      num_bands = (uint8_t)num_processors;
+    } else {
+      num_bands = 1u;
+    }
+  }
+
+  if (num_bands > GBA_PPU_BANDS_MAX_BANDS) {
+    num_bands = GBA_PPU_BANDS_MAX_BANDS;
+  }
+
+  GbaPpuSoftwareBands* bands = calloc(1u, sizeof(GbaPpuSoftwareBands));
+  if (bands == NULL) {
+    return NULL;
+  }
+
+  for (uint8_t i = 0u; i < num_bands; i++) {
+    bands->bands[i].bands = bands;
+    bands->bands[i].renderer = GbaPpuSoftwareRendererAllocate();
+    if (bands->bands[i].renderer == NULL) {
+      for (uint8_t j = 0u; j < i; j++) {
+        GbaPpuSoftwareRendererFree(bands->bands[j].renderer);
+      }
+      free(bands);
+      return NULL;
+    }
+  }
+
+  GbaPpuMemoryVersionInitialize(&bands->version);
+
+  pthread_mutex_init(&bands->lock, NULL);
+  pthread_cond_init(&bands->start, NULL);
+  pthread_cond_init(&bands->done, NULL);
+
+  // The calling thread draws the first band. If threads are unavailable the
+  // rows are split between fewer bands.
+  bands->num_bands = 1u;
+  for (uint8_t i = 1u; i < num_bands; i++) {
+    if (pthread_create(&bands->bands[i].thread, NULL, GbaPpuSoftwareBandsMain,
+                       &bands->bands[i]) != 0) {
+      break;
+    }
+    bands->num_bands += 1u;
+  }
+
+  for (uint8_t i = bands->num_bands; i < num_bands; i++) {
+    GbaPpuSoftwareRendererFree(bands->bands[i].renderer);
+  }
+
+  bands->num_threads = bands->num_bands - 1u;
+
+  for (uint8_t i = 0u; i < bands->num_bands; i++) {
+    bands->bands[i].start = GBA_SCREEN_HEIGHT * i / bands->num_bands;
+    bands->bands[i].end = GBA_SCREEN_HEIGHT * (i + 1u) / bands->num_bands;
+  }
+
+  return bands;
+}
+
+bool GbaPpuSoftwareBandsSetScreen(GbaPpuSoftwareBands* bands, Screen* screen) {
+  GbaPpuSoftwareBandsFinish(bands);
+
+  // The buffer is fetched once per frame since each fetch from the screen
+  // moves it on to its next staging texture
+  ScreenPixelBuffer framebuffer;
+  bool result = ScreenGetPixelBuffer(screen, GBA_SCREEN_WIDTH,
+                                     GBA_SCREEN_HEIGHT, &framebuffer);
+  if (!result) {
+    framebuffer.pixels = NULL;
+  }
+
+  for (uint8_t i = 0u; i < bands->num_bands; i++) {
+    GbaPpuSoftwareRendererSetPixelBuffer(bands->bands[i].renderer,
+                                         &framebuffer);
+  }
+
+  return result;
+}
+
+void GbaPpuSoftwareBandsDrawRow(GbaPpuSoftwareBands* bands,
+                                const GbaPpuMemory* memory,
+                                const GbaPpuRegisters* registers,
+                                GbaPpuDirtyBits* dirty_bits) {
+  assert(registers->vcount < GBA_SCREEN_HEIGHT);
+
+  GbaPpuMemoryVersionConsumeDirtyBits(&bands->version, dirty_bits);
+  if (bands->num_snapshots_used == 0u ||
+      !GbaPpuMemorySnapshotIsCurrent(
+          &bands->snapshots[bands->num_snapshots_used - 1u],
+          &bands->version)) {
+    if (bands->num_snapshots_used == GBA_PPU_BANDS_NUM_SNAPSHOTS) {
+      GbaPpuSoftwareBandsFinish(bands);
+    }
+
+    // Snapshots keep their contents between frames so that only the
+    // segments written since they were last used need to be copied
+    GbaPpuMemorySnapshotUpdate(&bands->snapshots[bands->num_snapshots_used],
+                               &bands->version, memory);
+    bands->num_snapshots_used += 1u;
+  }
+
+  GbaPpuBandsRow* row = &bands->rows[registers->vcount];
+  row->registers = *registers;
+  row->snapshot = bands->num_snapshots_used - 1u;
+  row->recorded = true;
+  bands->num_rows_recorded += 1u;
+}
+
+void GbaPpuSoftwareBandsFinish(GbaPpuSoftwareBands* bands) {
+  if (bands->num_rows_recorded == 0u) {
+    return;
+  }
+
+  if (bands->num_threads != 0u) {
+    pthread_mutex_lock(&bands->lock);
+    bands->generation += 1u;
+    bands->bands_remaining = bands->num_threads;
+    pthread_cond_broadcast(&bands->start);
+    pthread_mutex_unlock(&bands->lock);
+  }
+
+  GbaPpuSoftwareBandsDrawBand(bands, &bands->bands[0u]);
+
+  if (bands->num_threads != 0u) {
+    pthread_mutex_lock(&bands->lock);
+    while (bands->bands_remaining != 0u) {
+      pthread_cond_wait(&bands->done, &bands->lock);
+    }
+    pthread_mutex_unlock(&bands->lock);
+  }
+
+  for (uint8_t y = 0u; y < GBA_SCREEN_HEIGHT; y++) {
+    bands->rows[y].recorded = false;
+  }
+
+  bands->num_rows_recorded = 0u;
+  bands->num_snapshots_used = 0u;
+}
+
+void GbaPpuSoftwareBandsFree(GbaPpuSoftwareBands* bands) {
+  pthread_mutex_lock(&bands->lock);
+  bands->exit = true;
+  pthread_cond_broadcast(&bands->start);
+  pthread_mutex_unlock(&bands->lock);
+
+  for (uint8_t i = 1u; i < bands->num_bands; i++) {
+    pthread_join(bands->bands[i].thread, NULL);
+  }
+
+  for (uint8_t i = 0u; i < bands->num_bands; i++) {
+    GbaPpuSoftwareRendererFree(bands->bands[i].renderer);
+  }
+
+  pthread_cond_destroy(&bands->done);
+  pthread_cond_destroy(&bands->start);
+  pthread_mutex_destroy(&bands->lock);
+  free(bands);
+}
\ No newline at end of file
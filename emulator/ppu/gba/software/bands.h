@@ -0,0 +1,32 @@
+#ifndef _WEBGBA_EMULATOR_PPU_GBA_PPU_SOFTWARE_BANDS_
+#define _WEBGBA_EMULATOR_PPU_GBA_PPU_SOFTWARE_BANDS_
+
+#include "emulator/ppu/gba/dirty.h"
+#include "emulator/ppu/gba/memory.h"
+#include "emulator/ppu/gba/registers.h"
+#include "emulator/screen.h"
+
+// Records the registers of each row as it is reached and draws the recorded
+// rows all at once, splitting the screen into horizontal bands which are
+// drawn in parallel. Rows reference a snapshot of PPU memory which is only
+// copied again once the dirty bits show a write.
+typedef struct _GbaPpuSoftwareBands GbaPpuSoftwareBands;
+
+// Uses one band per online processor if num_bands is zero
+GbaPpuSoftwareBands* GbaPpuSoftwareBandsAllocate(uint8_t num_bands);
+
+// Draws any recorded rows before changing the screen
+bool GbaPpuSoftwareBandsSetScreen(GbaPpuSoftwareBands* bands, Screen* screen);
+
+// Consumes the dirty bits
+void GbaPpuSoftwareBandsDrawRow(GbaPpuSoftwareBands* bands,
+                                const GbaPpuMemory* memory,
+                                const GbaPpuRegisters* registers,
+                                GbaPpuDirtyBits* dirty_bits);
+
+// Draws all recorded rows
+void GbaPpuSoftwareBandsFinish(GbaPpuSoftwareBands* bands);
+
+void GbaPpuSoftwareBandsFree(GbaPpuSoftwareBands* bands);
+
+#endif  // _WEBGBA_EMULATOR_PPU_GBA_PPU_SOFTWARE_BANDS_
\ No newline at end of file
@@ -8,56 +8,81 @@ static inline BgCntRegister GetBgCnt(const GbaPpuRegisters* registers,
   return registers->bgcnt[2u + background];
 }
 
-bool GbaPpuAffineBackgroundPixel(const GbaPpuMemory* memory,
-                                 const GbaPpuRegisters* registers,
-                                 GbaPpuAffineBackground background, int32_t x,
-                                 int32_t y, uint16_t* color) {
+static inline uint8_t GbaPpuAffineBackgroundColorIndex(
+    const GbaPpuMemory* memory, BgCntRegister bgcnt, uint_fast8_t mosaic_x,
+    uint_fast8_t mosaic_y, int32_t x, int32_t y) {
   int32_t lookup_x = x >> 8u;
   int32_t lookup_y = y >> 8u;
 
-  if (registers->bgcnt[background].mosaic) {
-    lookup_x -= lookup_x % (registers->mosaic.bg_horiz + 1u);
-    lookup_y -= lookup_y % (registers->mosaic.bg_vert + 1u);
+  if (bgcnt.mosaic) {
+    lookup_x -= lookup_x % mosaic_x;
+    lookup_y -= lookup_y % mosaic_y;
   }
 
-  static const int_fast16_t screen_sizes_pixels[4] = {128u, 256u, 512u, 1024u};
-  static const uint_fast16_t screen_sizes_tiles[4] = {16u, 32u, 64u, 128u};
-
-  BgCntRegister bgcnt = GetBgCnt(registers, background);
-  int_fast16_t screen_size = screen_sizes_pixels[bgcnt.size];
+  // Screens are square and a power of two in size, ranging from 128 pixels
+  // (16 tiles) for size 0 up to 1024 pixels (128 tiles) for size 3.
+  int32_t screen_size_mask = (128 << bgcnt.size) - 1;
 
   if (bgcnt.wraparound) {
-    static const uint_fast16_t screen_size_masks[4] = {0x07Fu, 0x0FFu, 0x1FFu,
-                                                       0x3FFu};
-    lookup_x &= screen_size_masks[bgcnt.size];
-    lookup_y &= screen_size_masks[bgcnt.size];
-  } else if (lookup_x < 0 || screen_size <= lookup_x || lookup_y < 0 ||
-             screen_size <= lookup_y) {
-    return false;
+    lookup_x &= screen_size_mask;
+    lookup_y &= screen_size_mask;
+  } else if ((uint32_t)lookup_x > (uint32_t)screen_size_mask ||
+             (uint32_t)lookup_y > (uint32_t)screen_size_mask) {
+    return 0u;
   }
 
-  uint_fast16_t screen_size_tiles = screen_sizes_tiles[bgcnt.size];
-
-  uint_fast8_t tile_x = lookup_x / GBA_TILE_1D_SIZE;
-  uint_fast8_t tile_y = lookup_y / GBA_TILE_1D_SIZE;
+  uint_fast8_t screen_size_tiles_log2 = 4u + bgcnt.size;
+  uint_fast16_t tile_x = lookup_x / GBA_TILE_1D_SIZE;
+  uint_fast16_t tile_y = lookup_y / GBA_TILE_1D_SIZE;
 
   uint8_t tile_index =
       memory->vram.mode_012.bg.tile_map.blocks[bgcnt.tile_map_base_block]
-          .indices[tile_y * screen_size_tiles + tile_x];
+          .indices[(tile_y << screen_size_tiles_log2) + tile_x];
 
   uint_fast8_t tile_lookup_x = lookup_x % GBA_TILE_1D_SIZE;
   uint_fast8_t tile_lookup_y = lookup_y % GBA_TILE_1D_SIZE;
 
   // TODO: Handle accesses to obj tiles
-  uint8_t color_index =
-      memory->vram.mode_012.bg.tiles.blocks[bgcnt.tile_base_block]
-          .d_tiles[tile_index]
-          .pixels[tile_lookup_y][tile_lookup_x];
+  return memory->vram.mode_012.bg.tiles.blocks[bgcnt.tile_base_block]
+      .d_tiles[tile_index]
+      .pixels[tile_lookup_y][tile_lookup_x];
+}
+
+bool GbaPpuAffineBackgroundPixel(const GbaPpuMemory* memory,
+                                 const GbaPpuRegisters* registers,
+                                 GbaPpuAffineBackground background, int32_t x,
+                                 int32_t y, uint32_t* color) {
+  uint8_t color_index = GbaPpuAffineBackgroundColorIndex(
+      memory, GetBgCnt(registers, background),
+      registers->mosaic.bg_horiz + 1u, registers->mosaic.bg_vert + 1u, x, y);
   if (color_index == 0u) {
     return false;
   }
 
-  *color = memory->palette.bg.large_palette[color_index];
+  *color = memory->palette.internal.bg.large_palette[color_index];
 
   return true;
+}
+
+void GbaPpuAffineBackgroundLineDraw(const GbaPpuMemory* memory,
+                                    const GbaPpuRegisters* registers,
+                                    GbaPpuAffineBackground background,
+                                    GbaPpuBackgroundLine* line) {
+  BgCntRegister bgcnt = GetBgCnt(registers, background);
+  uint_fast8_t mosaic_x = registers->mosaic.bg_horiz + 1u;
+  uint_fast8_t mosaic_y = registers->mosaic.bg_vert + 1u;
+
+  int32_t x = registers->internal.affine[background].current[0u];
+  int32_t y = registers->internal.affine[background].current[1u];
+  int32_t dx = registers->affine[background].pa;
+  int32_t dy = registers->affine[background].pc;
+
+  for (uint_fast8_t i = 0u; i < GBA_SCREEN_WIDTH; i++) {
+    uint8_t color_index = GbaPpuAffineBackgroundColorIndex(
+        memory, bgcnt, mosaic_x, mosaic_y, x, y);
+    line->colors[i] = memory->palette.internal.bg.large_palette[color_index];
+    line->opaque[i] = color_index != 0u;
+    x += dx;
+    y += dy;
+  }
 }
\ No newline at end of file
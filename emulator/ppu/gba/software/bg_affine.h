@@ -3,6 +3,7 @@
 
 #include "emulator/ppu/gba/memory.h"
 #include "emulator/ppu/gba/registers.h"
+#include "emulator/ppu/gba/software/bg_line.h"
 
 typedef enum {
   GBA_PPU_AFFINE_BACKGROUND_2 = 0,
@@ -12,6 +13,11 @@ typedef enum {
 bool GbaPpuAffineBackgroundPixel(const GbaPpuMemory* memory,
                                  const GbaPpuRegisters* registers,
                                  GbaPpuAffineBackground background, int32_t x,
-                                 int32_t y, uint16_t* color);
+                                 int32_t y, uint32_t* color);
+
+void GbaPpuAffineBackgroundLineDraw(const GbaPpuMemory* memory,
+                                    const GbaPpuRegisters* registers,
+                                    GbaPpuAffineBackground background,
+                                    GbaPpuBackgroundLine* line);
 
 #endif  // _WEBGBA_EMULATOR_PPU_GBA_SOFTWARE_BG_AFFINE_
\ No newline at end of file
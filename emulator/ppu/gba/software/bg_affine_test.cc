@@ -0,0 +1,101 @@
+extern "C" {
+#include "emulator/ppu/gba/software/bg_affine.h"
+}
+
+#include <cstdlib>
+#include <cstring>
+
+#include "googletest/include/gtest/gtest.h"
+
+class AffineBackgroundTest : public testing::Test {
+ public:
+  void SetUp() override {
+    memory_ = (GbaPpuMemory*)calloc(1u, sizeof(GbaPpuMemory));
+    ASSERT_NE(nullptr, memory_);
+    memset(&registers_, 0, sizeof(GbaPpuRegisters));
+
+    srand(0u);
+    for (uint32_t i = 0u; i < VRAM_SIZE; i++) {
+      memory_->vram.bytes[i] = rand() % 4u;
+    }
+    for (uint32_t i = 0u; i < GBA_LARGE_PALETTE_SIZE; i++) {
+      memory_->palette.internal.bg.large_palette[i] = i;
+    }
+  }
+
+  void TearDown() override { free(memory_); }
+
+ protected:
+  void ExpectLineMatchesPixels(GbaPpuAffineBackground background) {
+    GbaPpuBackgroundLine line;
+    GbaPpuAffineBackgroundLineDraw(memory_, &registers_, background, &line);
+
+    int32_t x = registers_.internal.affine[background].current[0u];
+    int32_t y = registers_.internal.affine[background].current[1u];
+    for (uint_fast8_t i = 0u; i < GBA_SCREEN_WIDTH; i++) {
+      uint32_t color;
+      bool opaque = GbaPpuAffineBackgroundPixel(memory_, &registers_,
+                                                background, x, y, &color);
+      ASSERT_EQ(opaque, line.opaque[i]) << "pixel " << (int)i;
+      if (opaque) {
+        ASSERT_EQ(color, line.colors[i]) << "pixel " << (int)i;
+      }
+      x += registers_.affine[background].pa;
+      y += registers_.affine[background].pc;
+    }
+  }
+
+  GbaPpuMemory* memory_;
+  GbaPpuRegisters registers_;
+};
+
+TEST_F(AffineBackgroundTest, Transparent) {
+  memset(memory_->vram.bytes, 0, VRAM_SIZE);
+  registers_.affine[0u].pa = 0x100;
+
+  GbaPpuBackgroundLine line;
+  GbaPpuAffineBackgroundLineDraw(memory_, &registers_,
+                                 GBA_PPU_AFFINE_BACKGROUND_2, &line);
+  for (uint_fast8_t i = 0u; i < GBA_SCREEN_WIDTH; i++) {
+    EXPECT_FALSE(line.opaque[i]);
+  }
+}
+
+TEST_F(AffineBackgroundTest, OutOfBounds) {
+  registers_.affine[0u].pa = 0x100;
+  registers_.internal.affine[0u].current[0u] = -16 * 0x100;
+
+  GbaPpuBackgroundLine line;
+  GbaPpuAffineBackgroundLineDraw(memory_, &registers_,
+                                 GBA_PPU_AFFINE_BACKGROUND_2, &line);
+  for (uint_fast8_t i = 0u; i < 16u; i++) {
+    EXPECT_FALSE(line.opaque[i]);
+  }
+  for (uint_fast8_t i = 144u; i < GBA_SCREEN_WIDTH; i++) {
+    EXPECT_FALSE(line.opaque[i]);
+  }
+}
+
+TEST_F(AffineBackgroundTest, MatchesPixels) {
+  static const int16_t steps[] = {0x100, -0x100, 0x80, 0x173, -0x2F1, 0x0};
+  for (uint8_t size = 0u; size < 4u; size++) {
+    for (uint8_t flags = 0u; flags < 4u; flags++) {
+      for (int16_t pa : steps) {
+        for (int16_t pc : steps) {
+          registers_.bgcnt[3u].size = size;
+          registers_.bgcnt[3u].wraparound = flags & 1u;
+          registers_.bgcnt[3u].mosaic = flags & 2u;
+          registers_.bgcnt[3u].tile_map_base_block = 8u + size;
+          registers_.bgcnt[3u].tile_base_block = 1u;
+          registers_.mosaic.bg_horiz = 3u;
+          registers_.mosaic.bg_vert = 2u;
+          registers_.affine[1u].pa = pa;
+          registers_.affine[1u].pc = pc;
+          registers_.internal.affine[1u].current[0u] = 0x1234 * pa;
+          registers_.internal.affine[1u].current[1u] = -0x789 * pc + 0x4000;
+          ExpectLineMatchesPixels(GBA_PPU_AFFINE_BACKGROUND_3);
+        }
+      }
+    }
+  }
+}
\ No newline at end of file
@@ -9,7 +9,7 @@ typedef enum {
 static inline bool GbaPpuBackground2BitmapPixel(
     const GbaPpuMemory* memory, const GbaPpuRegisters* registers,
     GbaPpuBackground2BitmapMode mode, bool back_page, int32_t x, int32_t y,
-    uint16_t* color) {
+    uint32_t* color) {
   int32_t lookup_x = x >> 8u;
   int32_t lookup_y = y >> 8u;
 
@@ -28,7 +28,8 @@ static inline bool GbaPpuBackground2BitmapPixel(
       if (lookup_x >= GBA_SCREEN_WIDTH || lookup_y >= GBA_SCREEN_HEIGHT) {
         return false;
       } else {
-        *color = memory->vram.mode_3.bg.pixels[lookup_y][lookup_x] << 1u;
+        *color = GbaPpuColorToXrgb8888(
+            memory->vram.mode_3.bg.pixels[lookup_y][lookup_x]);
       }
       break;
     case GBA_PPU_BG2_MODE_4:
@@ -41,7 +42,7 @@ static inline bool GbaPpuBackground2BitmapPixel(
           return false;
         }
 
-        *color = memory->palette.bg.large_palette[color_index];
+        *color = memory->palette.internal.bg.large_palette[color_index];
       }
       break;
     case GBA_PPU_BG2_MODE_5:
@@ -49,9 +50,8 @@ static inline bool GbaPpuBackground2BitmapPixel(
           lookup_y >= GBA_REDUCED_FRAME_HEIGHT) {
         return false;
       } else {
-        *color =
-            memory->vram.mode_5.bg.pages[back_page].pixels[lookup_y][lookup_x]
-            << 1u;
+        *color = GbaPpuColorToXrgb8888(
+            memory->vram.mode_5.bg.pages[back_page].pixels[lookup_y][lookup_x]);
       }
       break;
   };
@@ -59,16 +59,33 @@ static inline bool GbaPpuBackground2BitmapPixel(
   return true;
 }
 
+static inline void GbaPpuBackground2BitmapLine(
+    const GbaPpuMemory* memory, const GbaPpuRegisters* registers,
+    GbaPpuBackground2BitmapMode mode, bool back_page,
+    GbaPpuBackgroundLine* line) {
+  int32_t x = registers->internal.affine[0u].current[0u];
+  int32_t y = registers->internal.affine[0u].current[1u];
+  int32_t dx = registers->affine[0u].pa;
+  int32_t dy = registers->affine[0u].pc;
+
+  for (uint_fast8_t i = 0u; i < GBA_SCREEN_WIDTH; i++) {
+    line->opaque[i] = GbaPpuBackground2BitmapPixel(
+        memory, registers, mode, back_page, x, y, &line->colors[i]);
+    x += dx;
+    y += dy;
+  }
+}
+
 bool GbaPpuBitmapMode3Pixel(const GbaPpuMemory* memory,
                             const GbaPpuRegisters* registers, int32_t x,
-                            int32_t y, uint16_t* color) {
+                            int32_t y, uint32_t* color) {
   return GbaPpuBackground2BitmapPixel(memory, registers, GBA_PPU_BG2_MODE_3,
                                       /*back_page=*/false, x, y, color);
 }
 
 bool GbaPpuBitmapMode4Pixel(const GbaPpuMemory* memory,
                             const GbaPpuRegisters* registers, int32_t x,
-                            int32_t y, uint16_t* color) {
+                            int32_t y, uint32_t* color) {
   return GbaPpuBackground2BitmapPixel(
       memory, registers, GBA_PPU_BG2_MODE_4,
       /*back_page=*/registers->dispcnt.page_select, x, y, color);
@@ -76,8 +93,31 @@ bool GbaPpuBitmapMode4Pixel(const GbaPpuMemory* memory,
 
 bool GbaPpuBitmapMode5Pixel(const GbaPpuMemory* memory,
                             const GbaPpuRegisters* registers, int32_t x,
-                            int32_t y, uint16_t* color) {
+                            int32_t y, uint32_t* color) {
   return GbaPpuBackground2BitmapPixel(
       memory, registers, GBA_PPU_BG2_MODE_5,
       /*back_page=*/registers->dispcnt.page_select, x, y, color);
+}
+
+void GbaPpuBitmapMode3LineDraw(const GbaPpuMemory* memory,
+                               const GbaPpuRegisters* registers,
+                               GbaPpuBackgroundLine* line) {
+  GbaPpuBackground2BitmapLine(memory, registers, GBA_PPU_BG2_MODE_3,
+                              /*back_page=*/false, line);
+}
+
+void GbaPpuBitmapMode4LineDraw(const GbaPpuMemory* memory,
+                               const GbaPpuRegisters* registers,
+                               GbaPpuBackgroundLine* line) {
+  GbaPpuBackground2BitmapLine(memory, registers, GBA_PPU_BG2_MODE_4,
+                              /*back_page=*/registers->dispcnt.page_select,
+                              line);
+}
+
+void GbaPpuBitmapMode5LineDraw(const GbaPpuMemory* memory,
+                               const GbaPpuRegisters* registers,
+                               GbaPpuBackgroundLine* line) {
+  GbaPpuBackground2BitmapLine(memory, registers, GBA_PPU_BG2_MODE_5,
+                              /*back_page=*/registers->dispcnt.page_select,
+                              line);
 }
\ No newline at end of file
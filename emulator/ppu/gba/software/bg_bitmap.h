@@ -3,17 +3,30 @@
 
 #include "emulator/ppu/gba/memory.h"
 #include "emulator/ppu/gba/registers.h"
+#include "emulator/ppu/gba/software/bg_line.h"
 
 bool GbaPpuBitmapMode3Pixel(const GbaPpuMemory* memory,
                             const GbaPpuRegisters* registers, int32_t x,
-                            int32_t y, uint16_t* color);
+                            int32_t y, uint32_t* color);
 
 bool GbaPpuBitmapMode4Pixel(const GbaPpuMemory* memory,
                             const GbaPpuRegisters* registers, int32_t x,
-                            int32_t y, uint16_t* color);
+                            int32_t y, uint32_t* color);
 
 bool GbaPpuBitmapMode5Pixel(const GbaPpuMemory* memory,
                             const GbaPpuRegisters* registers, int32_t x,
-                            int32_t y, uint16_t* color);
+                            int32_t y, uint32_t* color);
+
+void GbaPpuBitmapMode3LineDraw(const GbaPpuMemory* memory,
+                               const GbaPpuRegisters* registers,
+                               GbaPpuBackgroundLine* line);
+
+void GbaPpuBitmapMode4LineDraw(const GbaPpuMemory* memory,
+                               const GbaPpuRegisters* registers,
+                               GbaPpuBackgroundLine* line);
+
+void GbaPpuBitmapMode5LineDraw(const GbaPpuMemory* memory,
+                               const GbaPpuRegisters* registers,
+                               GbaPpuBackgroundLine* line);
 
 #endif  // _WEBGBA_EMULATOR_PPU_GBA_SOFTWARE_BG_BITMAP_
\ No newline at end of file
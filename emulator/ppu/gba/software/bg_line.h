@@ -0,0 +1,14 @@
+#ifndef _WEBGBA_EMULATOR_PPU_GBA_SOFTWARE_BG_LINE_
+#define _WEBGBA_EMULATOR_PPU_GBA_SOFTWARE_BG_LINE_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "emulator/ppu/gba/memory.h"
+
+typedef struct {
+  uint32_t colors[GBA_SCREEN_WIDTH];  // XRGB8888
+  bool opaque[GBA_SCREEN_WIDTH];
+} GbaPpuBackgroundLine;
+
+#endif  // _WEBGBA_EMULATOR_PPU_GBA_SOFTWARE_BG_LINE_
\ No newline at end of file
@@ -4,7 +4,7 @@ bool GbaPpuScrollingBackgroundPixel(const GbaPpuMemory* memory,
                                     const GbaPpuRegisters* registers,
                                     GbaPpuScrollingBackground background,
                                     uint_fast8_t x, uint_fast8_t y,
-                                    uint16_t* color) {
+                                    uint32_t* color) {
   static const uint_fast16_t bg_mask_x[4] = {0xFFu, 0x1FFu, 0xFFu, 0x1FFu};
   static const uint_fast16_t bg_mask_y[4] = {0xFFu, 0xFFu, 0x1FFu, 0x1FFu};
   static const uint_fast8_t bg_tile_block_width[4] = {1u, 2u, 1u, 2u};
@@ -57,7 +57,7 @@ bool GbaPpuScrollingBackgroundPixel(const GbaPpuMemory* memory,
       return false;
     }
 
-    *color = memory->palette.bg.large_palette[color_index];
+    *color = memory->palette.internal.bg.large_palette[color_index];
   } else {
     uint8_t color_index_pair =
         memory->vram.mode_012.bg.tiles
@@ -74,7 +74,8 @@ bool GbaPpuScrollingBackgroundPixel(const GbaPpuMemory* memory,
       return false;
     }
 
-    *color = memory->palette.bg.small_palettes[entry.palette][color_index];
+    *color =
+        memory->palette.internal.bg.small_palettes[entry.palette][color_index];
   }
 
   return true;
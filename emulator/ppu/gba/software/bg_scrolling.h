@@ -15,6 +15,6 @@ bool GbaPpuScrollingBackgroundPixel(const GbaPpuMemory* memory,
                                     const GbaPpuRegisters* registers,
                                     GbaPpuScrollingBackground background,
                                     uint_fast8_t x, uint_fast8_t y,
-                                    uint16_t* color);
+                                    uint32_t* color);
 
 #endif  // _WEBGBA_EMULATOR_PPU_GBA_SOFTWARE_BG_SCROLLING_
\ No newline at end of file
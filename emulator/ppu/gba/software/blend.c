@@ -7,20 +7,24 @@
 #define GBA_PPU_LAYER_PRIORITY_BACKDROP 5u
 #define GBA_PPU_LAYER_PRIORITY_NOT_SET 6u
 
-static uint_fast16_t UInt5To8(uint_fast8_t value) {
-  static const uint8_t mapped_values[32u] = {
-      0u,   8u,   16u,  25u,  33u,  41u,  49u,  58u,  66u,  74u,  82u,
-      90u,  99u,  107u, 115u, 123u, 132u, 140u, 148u, 156u, 165u, 173u,
-      181u, 189u, 197u, 206u, 214u, 222u, 230u, 239u, 247u, 255u,
-  };
-
-  assert(value < 32u);
-  return mapped_values[value];
+static inline uint_fast16_t Red(uint32_t color) {
+  return (color >> 16u) & 0xFFu;
+}
+
+static inline uint_fast16_t Green(uint32_t color) {
+  return (color >> 8u) & 0xFFu;
+}
+
+static inline uint_fast16_t Blue(uint32_t color) { return color & 0xFFu; }
+
+static inline uint32_t Xrgb8888(uint_fast16_t r, uint_fast16_t g,
+                                uint_fast16_t b) {
+  return ((uint32_t)r << 16u) | ((uint32_t)g << 8u) | (uint32_t)b;
 }
 
 static void GbaPpuBlendUnitAddBackgroundInternal(GbaPpuBlendUnit* blend_unit,
                                                  bool top, bool bottom,
-                                                 uint16_t color,
+                                                 uint32_t color,
                                                  uint_fast8_t priority) {
   assert(blend_unit->priorities[1u] > priority);
 
@@ -44,19 +48,18 @@ static void GbaPpuBlendUnitAddBackgroundInternal(GbaPpuBlendUnit* blend_unit,
   }
 }
 
-static void GbaPpuBlendUnitAdditiveBlendInternal(
-    const GbaPpuBlendUnit* blend_unit, const GbaPpuRegisters* registers,
-    uint8_t rgb[3u]) {
+static uint32_t GbaPpuBlendUnitAdditiveBlendInternal(
+    const GbaPpuBlendUnit* blend_unit, const GbaPpuRegisters* registers) {
   assert(blend_unit->top[0u]);
   assert(blend_unit->bottom[1u]);
 
-  uint_fast16_t top_r = UInt5To8((blend_unit->layers[0u] & 0x003Eu) >> 1u);
-  uint_fast16_t top_g = UInt5To8((blend_unit->layers[0u] & 0x07C0u) >> 6u);
-  uint_fast16_t top_b = UInt5To8((blend_unit->layers[0u] & 0xF800u) >> 11u);
+  uint_fast16_t top_r = Red(blend_unit->layers[0u]);
+  uint_fast16_t top_g = Green(blend_unit->layers[0u]);
+  uint_fast16_t top_b = Blue(blend_unit->layers[0u]);
 
-  uint_fast16_t bot_r = UInt5To8((blend_unit->layers[1u] & 0x003Eu) >> 1u);
-  uint_fast16_t bot_g = UInt5To8((blend_unit->layers[1u] & 0x07C0u) >> 6u);
-  uint_fast16_t bot_b = UInt5To8((blend_unit->layers[1u] & 0xF800u) >> 11u);
+  uint_fast16_t bot_r = Red(blend_unit->layers[1u]);
+  uint_fast16_t bot_g = Green(blend_unit->layers[1u]);
+  uint_fast16_t bot_b = Blue(blend_unit->layers[1u]);
 
   uint_fast16_t eva =
       registers->bldalpha.eva > 16u ? 16u : registers->bldalpha.eva;
@@ -67,76 +70,64 @@ static void GbaPpuBlendUnitAdditiveBlendInternal(
   uint_fast16_t g = ((top_g * eva) + (bot_g * evb)) >> 4u;
   uint_fast16_t b = ((top_b * eva) + (bot_b * evb)) >> 4u;
 
-  rgb[0u] = r > UINT8_MAX ? UINT8_MAX : r;
-  rgb[1u] = g > UINT8_MAX ? UINT8_MAX : g;
-  rgb[2u] = b > UINT8_MAX ? UINT8_MAX : b;
+  return Xrgb8888(r > UINT8_MAX ? UINT8_MAX : r, g > UINT8_MAX ? UINT8_MAX : g,
+                  b > UINT8_MAX ? UINT8_MAX : b);
 }
 
-static void GbaPpuBlendUnitAdditiveBlend(const GbaPpuBlendUnit* blend_unit,
-                                         const GbaPpuRegisters* registers,
-                                         uint8_t rgb[3u]) {
+static uint32_t GbaPpuBlendUnitAdditiveBlend(const GbaPpuBlendUnit* blend_unit,
+                                             const GbaPpuRegisters* registers) {
   if (!blend_unit->top[0u] | !blend_unit->bottom[1u]) {
-    GbaPpuBlendUnitNoBlend(blend_unit, rgb);
-    return;
+    return GbaPpuBlendUnitNoBlend(blend_unit);
   }
 
-  GbaPpuBlendUnitAdditiveBlendInternal(blend_unit, registers, rgb);
+  return GbaPpuBlendUnitAdditiveBlendInternal(blend_unit, registers);
 }
 
-static void GbaPpuBlendUnitNoBlendInternal(const GbaPpuBlendUnit* blend_unit,
-                                           const GbaPpuRegisters* registers,
-                                           uint8_t rgb[3u]) {
+static uint32_t GbaPpuBlendUnitNoBlendInternal(
+    const GbaPpuBlendUnit* blend_unit, const GbaPpuRegisters* registers) {
   if ((blend_unit->is_blended_object[0u] | blend_unit->is_blended_object[1u]) &
       blend_unit->top[0u] & blend_unit->bottom[1u]) {
-    return GbaPpuBlendUnitAdditiveBlendInternal(blend_unit, registers, rgb);
+    return GbaPpuBlendUnitAdditiveBlendInternal(blend_unit, registers);
   }
 
-  GbaPpuBlendUnitNoBlend(blend_unit, rgb);
+  return GbaPpuBlendUnitNoBlend(blend_unit);
 }
 
-static void GbaPpuBlendUnitDarken(const GbaPpuBlendUnit* blend_unit,
-                                  const GbaPpuRegisters* registers,
-                                  uint8_t rgb[3u]) {
+static uint32_t GbaPpuBlendUnitDarken(const GbaPpuBlendUnit* blend_unit,
+                                      const GbaPpuRegisters* registers) {
   if (!blend_unit->top[0u]) {
-    GbaPpuBlendUnitNoBlend(blend_unit, rgb);
-    return;
+    return GbaPpuBlendUnitNoBlend(blend_unit);
   }
 
   if ((blend_unit->is_blended_object[0u] | blend_unit->is_blended_object[1u]) &
       blend_unit->bottom[1u]) {
-    GbaPpuBlendUnitAdditiveBlendInternal(blend_unit, registers, rgb);
-    return;
+    return GbaPpuBlendUnitAdditiveBlendInternal(blend_unit, registers);
   }
 
-  uint_fast16_t r = UInt5To8((blend_unit->layers[0u] & 0x003Eu) >> 1u);
-  uint_fast16_t g = UInt5To8((blend_unit->layers[0u] & 0x07C0u) >> 6u);
-  uint_fast16_t b = UInt5To8((blend_unit->layers[0u] & 0xF800u) >> 11u);
+  uint_fast16_t r = Red(blend_unit->layers[0u]);
+  uint_fast16_t g = Green(blend_unit->layers[0u]);
+  uint_fast16_t b = Blue(blend_unit->layers[0u]);
 
   uint_fast16_t evy =
       16u - ((registers->bldy.evy > 16u) ? 16u : registers->bldy.evy);
 
-  rgb[0u] = (r * evy) >> 4u;
-  rgb[1u] = (g * evy) >> 4u;
-  rgb[2u] = (b * evy) >> 4u;
+  return Xrgb8888((r * evy) >> 4u, (g * evy) >> 4u, (b * evy) >> 4u);
 }
 
-static void GbaPpuBlendUnitBrighten(const GbaPpuBlendUnit* blend_unit,
-                                    const GbaPpuRegisters* registers,
-                                    uint8_t rgb[3u]) {
+static uint32_t GbaPpuBlendUnitBrighten(const GbaPpuBlendUnit* blend_unit,
+                                        const GbaPpuRegisters* registers) {
   if (!blend_unit->top[0u]) {
-    GbaPpuBlendUnitNoBlend(blend_unit, rgb);
-    return;
+    return GbaPpuBlendUnitNoBlend(blend_unit);
   }
 
   if ((blend_unit->is_blended_object[0u] | blend_unit->is_blended_object[1u]) &
       blend_unit->bottom[1u]) {
-    GbaPpuBlendUnitAdditiveBlendInternal(blend_unit, registers, rgb);
-    return;
+    return GbaPpuBlendUnitAdditiveBlendInternal(blend_unit, registers);
   }
 
-  uint_fast16_t r = UInt5To8((blend_unit->layers[0u] & 0x003Eu) >> 1u);
-  uint_fast16_t g = UInt5To8((blend_unit->layers[0u] & 0x07C0u) >> 6u);
-  uint_fast16_t b = UInt5To8((blend_unit->layers[0u] & 0xF800u) >> 11u);
+  uint_fast16_t r = Red(blend_unit->layers[0u]);
+  uint_fast16_t g = Green(blend_unit->layers[0u]);
+  uint_fast16_t b = Blue(blend_unit->layers[0u]);
 
   uint_fast16_t evy = registers->bldy.evy > 16u ? 16u : registers->bldy.evy;
 
@@ -144,13 +135,12 @@ static void GbaPpuBlendUnitBrighten(const GbaPpuBlendUnit* blend_unit,
   g += ((UINT8_MAX - g) * evy) >> 4u;
   b += ((UINT8_MAX - b) * evy) >> 4u;
 
-  rgb[0u] = r > UINT8_MAX ? UINT8_MAX : r;
-  rgb[1u] = g > UINT8_MAX ? UINT8_MAX : g;
-  rgb[2u] = b > UINT8_MAX ? UINT8_MAX : b;
+  return Xrgb8888(r > UINT8_MAX ? UINT8_MAX : r, g > UINT8_MAX ? UINT8_MAX : g,
+                  b > UINT8_MAX ? UINT8_MAX : b);
 }
 
 void GbaPpuBlendUnitAddObject(GbaPpuBlendUnit* blend_unit,
-                              const GbaPpuRegisters* registers, uint16_t color,
+                              const GbaPpuRegisters* registers, uint32_t color,
                               uint_fast8_t priority, bool semi_transparent) {
   assert(priority < GBA_PPU_LAYER_PRIORITY_BACKDROP);
   assert(blend_unit->priorities[0u] == GBA_PPU_LAYER_PRIORITY_NOT_SET);
@@ -165,7 +155,7 @@ void GbaPpuBlendUnitAddObject(GbaPpuBlendUnit* blend_unit,
 
 void GbaPpuBlendUnitAddBackground0(GbaPpuBlendUnit* blend_unit,
                                    const GbaPpuRegisters* registers,
-                                   uint16_t color) {
+                                   uint32_t color) {
   GbaPpuBlendUnitAddBackgroundInternal(blend_unit, registers->bldcnt.a_bg0,
                                        registers->bldcnt.b_bg0, color,
                                        registers->bgcnt[0u].priority);
@@ -173,7 +163,7 @@ void GbaPpuBlendUnitAddBackground0(GbaPpuBlendUnit* blend_unit,
 
 void GbaPpuBlendUnitAddBackground1(GbaPpuBlendUnit* blend_unit,
                                    const GbaPpuRegisters* registers,
-                                   uint16_t color) {
+                                   uint32_t color) {
   GbaPpuBlendUnitAddBackgroundInternal(blend_unit, registers->bldcnt.a_bg1,
                                        registers->bldcnt.b_bg1, color,
                                        registers->bgcnt[1u].priority);
@@ -181,7 +171,7 @@ void GbaPpuBlendUnitAddBackground1(GbaPpuBlendUnit* blend_unit,
 
 void GbaPpuBlendUnitAddBackground2(GbaPpuBlendUnit* blend_unit,
                                    const GbaPpuRegisters* registers,
-                                   uint16_t color) {
+                                   uint32_t color) {
   GbaPpuBlendUnitAddBackgroundInternal(blend_unit, registers->bldcnt.a_bg2,
                                        registers->bldcnt.b_bg2, color,
                                        registers->bgcnt[2u].priority);
@@ -189,7 +179,7 @@ void GbaPpuBlendUnitAddBackground2(GbaPpuBlendUnit* blend_unit,
 
 void GbaPpuBlendUnitAddBackground3(GbaPpuBlendUnit* blend_unit,
                                    const GbaPpuRegisters* registers,
-                                   uint16_t color) {
+                                   uint32_t color) {
   GbaPpuBlendUnitAddBackgroundInternal(blend_unit, registers->bldcnt.a_bg3,
                                        registers->bldcnt.b_bg3, color,
                                        registers->bgcnt[3u].priority);
@@ -197,7 +187,7 @@ void GbaPpuBlendUnitAddBackground3(GbaPpuBlendUnit* blend_unit,
 
 void GbaPpuBlendUnitAddBackdrop(GbaPpuBlendUnit* blend_unit,
                                 const GbaPpuRegisters* registers,
-                                uint16_t color) {
+                                uint32_t color) {
   if (GBA_PPU_LAYER_PRIORITY_BACKDROP < blend_unit->priorities[1u]) {
     if (GBA_PPU_LAYER_PRIORITY_BACKDROP < blend_unit->priorities[0]) {
       blend_unit->layers[0u] = color;
@@ -213,32 +203,23 @@ void GbaPpuBlendUnitAddBackdrop(GbaPpuBlendUnit* blend_unit,
   }
 }
 
-typedef void (*BlendFunction)(const GbaPpuBlendUnit*, const GbaPpuRegisters*,
-                              uint8_t rgb[3u]);
+typedef uint32_t (*BlendFunction)(const GbaPpuBlendUnit*,
+                                  const GbaPpuRegisters*);
 
-void GbaPpuBlendUnitBlend(const GbaPpuBlendUnit* blend_unit,
-                          const GbaPpuRegisters* registers, uint8_t rgb[3u]) {
+uint32_t GbaPpuBlendUnitBlend(const GbaPpuBlendUnit* blend_unit,
+                              const GbaPpuRegisters* registers) {
   switch (registers->bldcnt.mode) {
     case 0:
-      GbaPpuBlendUnitNoBlendInternal(blend_unit, registers, rgb);
-      break;
+      return GbaPpuBlendUnitNoBlendInternal(blend_unit, registers);
     case 1:
-      GbaPpuBlendUnitAdditiveBlend(blend_unit, registers, rgb);
-      break;
+      return GbaPpuBlendUnitAdditiveBlend(blend_unit, registers);
     case 2:
-      GbaPpuBlendUnitBrighten(blend_unit, registers, rgb);
-      break;
+      return GbaPpuBlendUnitBrighten(blend_unit, registers);
     case 3:
-      GbaPpuBlendUnitDarken(blend_unit, registers, rgb);
-      break;
+      return GbaPpuBlendUnitDarken(blend_unit, registers);
     default:
       codegen_assert(false);
   }
-}
 
-void GbaPpuBlendUnitNoBlend(const GbaPpuBlendUnit* blend_unit,
-                            uint8_t rgb[3u]) {
-  rgb[0u] = UInt5To8((blend_unit->layers[0u] & 0x003Eu) >> 1u);
-  rgb[1u] = UInt5To8((blend_unit->layers[0u] & 0x07C0u) >> 6u);
-  rgb[2u] = UInt5To8((blend_unit->layers[0u] & 0xF800u) >> 11u);
+  return 0u;
 }
\ No newline at end of file
@@ -7,7 +7,7 @@
 #include "emulator/ppu/gba/registers.h"
 
 typedef struct {
-  uint16_t layers[2u];
+  uint32_t layers[2u];  // XRGB8888
   uint_fast8_t priorities[2u];
   bool top[2u];
   bool bottom[2u];
@@ -39,32 +39,36 @@ static inline void GbaPpuBlendUnitReset(GbaPpuBlendUnit* blend_unit) {
 }
 
 void GbaPpuBlendUnitAddObject(GbaPpuBlendUnit* blend_unit,
-                              const GbaPpuRegisters* registers, uint16_t color,
+                              const GbaPpuRegisters* registers, uint32_t color,
                               uint_fast8_t priority, bool semi_transparent);
 
 void GbaPpuBlendUnitAddBackground0(GbaPpuBlendUnit* blend_unit,
                                    const GbaPpuRegisters* registers,
-                                   uint16_t color);
+                                   uint32_t color);
 
 void GbaPpuBlendUnitAddBackground1(GbaPpuBlendUnit* blend_unit,
                                    const GbaPpuRegisters* registers,
-                                   uint16_t color);
+                                   uint32_t color);
 
 void GbaPpuBlendUnitAddBackground2(GbaPpuBlendUnit* blend_unit,
                                    const GbaPpuRegisters* registers,
-                                   uint16_t color);
+                                   uint32_t color);
 
 void GbaPpuBlendUnitAddBackground3(GbaPpuBlendUnit* blend_unit,
                                    const GbaPpuRegisters* registers,
-                                   uint16_t color);
+                                   uint32_t color);
 
 void GbaPpuBlendUnitAddBackdrop(GbaPpuBlendUnit* blend_unit,
                                 const GbaPpuRegisters* registers,
-                                uint16_t color);
+                                uint32_t color);
 
-void GbaPpuBlendUnitBlend(const GbaPpuBlendUnit* blend_unit,
-                          const GbaPpuRegisters* registers, uint8_t rgb[3u]);
+uint32_t GbaPpuBlendUnitBlend(const GbaPpuBlendUnit* blend_unit,
+                              const GbaPpuRegisters* registers);
 
-void GbaPpuBlendUnitNoBlend(const GbaPpuBlendUnit* blend_unit, uint8_t rgb[3u]);
+// Layers already hold XRGB8888, so an unblended pixel is its top layer as is
+static inline uint32_t GbaPpuBlendUnitNoBlend(
+    const GbaPpuBlendUnit* blend_unit) {
+  return blend_unit->layers[0u];
+}
 
 #endif  // _WEBGBA_EMULATOR_PPU_GBA_SOFTWARE_BLEND_
\ No newline at end of file
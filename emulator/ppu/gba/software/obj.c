@@ -1,173 +1,225 @@
 #include "emulator/ppu/gba/software/obj.h"
 
-bool GbaPpuObjectPixel(const GbaPpuMemory* memory,
-                       const GbaPpuRegisters* registers, const uint_fast8_t x,
-                       uint_fast8_t y, uint16_t* color, uint8_t* priority,
-                       bool* semi_transparent, bool* on_obj_mask) {
-  *priority = UINT8_MAX;
-  *on_obj_mask = false;
-  bool found = false;
-
-  GbaPpuSet objects = GbaPpuObjectVisibilityGet(&memory->oam, x, y);
-  while (!GbaPpuSetEmpty(&objects)) {
-    uint_fast8_t object = GbaPpuSetPop(&objects);
-    assert(memory->oam.object_attributes[object].affine ||
-           !memory->oam.object_attributes[object].flex_param_0);
+#include <string.h>
+
+#define GBA_PPU_OBJECT_CYCLES_PER_LINE 1210
+#define GBA_PPU_OBJECT_CYCLES_PER_LINE_HBLANK_FREE 954
+
+static inline uint_fast8_t GbaPpuObjectColorIndex(
+    const GbaPpuMemory* memory, const GbaPpuRegisters* registers,
+    uint_fast8_t object, int32_t lookup_x, int32_t lookup_y) {
+  unsigned short character_name =
+      memory->oam.object_attributes[object].character_name >>
+      memory->oam.object_attributes[object].palette_mode;
+  unsigned short x_tile = lookup_x / 8u;
+  unsigned short y_tile = lookup_y / 8u;
+
+  unsigned short tile_index;
+  if (registers->dispcnt.object_mode) {
+    // One Dimensional Lookup
+    unsigned short x_size_tiles =
+        (memory->oam.internal.object_coordinates[object].pixel_x_size / 8u);
+    tile_index = character_name + y_tile * x_size_tiles + x_tile;
+  } else {
+    // Two Dimensional Lookup
+    unsigned short row_width =
+        32u >> memory->oam.object_attributes[object].palette_mode;
+    tile_index = character_name + y_tile * row_width + x_tile;
+  }
 
-    int32_t lookup_x = x;
-    int32_t lookup_y = y;
+  uint_fast8_t x_tile_pixel = lookup_x & 0x7u;
+  uint_fast8_t y_tile_pixel = lookup_y & 0x7u;
 
-    if (memory->oam.object_attributes[object].affine) {
-      unsigned char group = memory->oam.object_attributes[object].flex_param_1;
+  if (memory->oam.object_attributes[object].palette_mode) {
+    if (memory->oam.object_attributes[object].character_name & 1) {
+      return memory->vram.mode_012.obj.offset_d_tiles[tile_index]
+          .pixels[y_tile_pixel][x_tile_pixel];
+    }
 
-      int_fast16_t center_x =
-          memory->oam.internal.object_coordinates[object].true_x_center;
-      int_fast16_t center_y =
-          memory->oam.internal.object_coordinates[object].true_y_center;
+    return memory->vram.mode_012.obj.d_tiles[tile_index]
+        .pixels[y_tile_pixel][x_tile_pixel];
+  }
 
-      int_fast16_t from_center_x = lookup_x - center_x;
-      int_fast16_t from_center_y = lookup_y - center_y;
+  uint8_t color_index_pair = memory->vram.mode_012.obj.s_tiles[tile_index]
+                                 .pixels[y_tile_pixel][x_tile_pixel >> 1u]
+                                 .value;
+
+  // Select lower 4 bits if lookup_x_tile_pixel is even and upper 4 bits if
+  // lookup_x_tile_pixel is odd.
+  return (color_index_pair >> ((x_tile_pixel & 1u) << 2u)) & 0xFu;
+}
+
+static inline void GbaPpuObjectLineAddPixel(const GbaPpuMemory* memory,
+                                            uint_fast8_t object,
+                                            uint_fast8_t color_index,
+                                            uint_fast8_t x,
+                                            GbaPpuObjectLine* line) {
+  if (color_index == 0u) {
+    return;
+  }
 
-      int_fast32_t x_rotation =
-          memory->oam.rotate_scale[group].pa * from_center_x +
-          memory->oam.rotate_scale[group].pb * from_center_y;
+  if (memory->oam.object_attributes[object].obj_mode == 2u) {
+    line->on_obj_mask[x] = true;
+    return;
+  }
 
-      int_fast32_t y_rotation =
-          memory->oam.rotate_scale[group].pc * from_center_x +
-          memory->oam.rotate_scale[group].pd * from_center_y;
+  // Objects are added in OAM order so on equal priority the first one wins
+  if (memory->oam.object_attributes[object].priority >= line->priorities[x]) {
+    return;
+  }
 
-      lookup_x =
-          (memory->oam.internal.object_coordinates[object].pixel_x_size >> 1) +
-          (x_rotation >> 8u);
+  if (memory->oam.object_attributes[object].palette_mode) {
+    line->colors[x] = memory->palette.internal.obj.large_palette[color_index];
+  } else {
+    line->colors[x] =
+        memory->palette.internal.obj
+            .small_palettes[memory->oam.object_attributes[object].palette]
+                           [color_index];
+  }
 
-      if (lookup_x < 0 ||
-          lookup_x >=
-              memory->oam.internal.object_coordinates[object].pixel_x_size) {
-        continue;
-      }
+  line->priorities[x] = memory->oam.object_attributes[object].priority;
+  line->semi_transparent[x] =
+      memory->oam.object_attributes[object].obj_mode == 1u;
+}
+
+static void GbaPpuObjectLineDrawAffine(const GbaPpuMemory* memory,
+                                       const GbaPpuRegisters* registers,
+                                       uint_fast8_t object, uint_fast8_t y,
+                                       GbaPpuObjectLine* line) {
+  unsigned char group = memory->oam.object_attributes[object].flex_param_1;
+
+  int_fast16_t x_size =
+      memory->oam.internal.object_coordinates[object].pixel_x_size;
+  int_fast16_t y_size =
+      memory->oam.internal.object_coordinates[object].pixel_y_size;
+  uint_fast8_t x_start =
+      memory->oam.internal.object_coordinates[object].pixel_x_start;
+  uint_fast8_t x_end =
+      memory->oam.internal.object_coordinates[object].pixel_x_end;
+
+  int_fast16_t from_center_x =
+      x_start - memory->oam.internal.object_coordinates[object].true_x_center;
+  int_fast16_t from_center_y =
+      y - memory->oam.internal.object_coordinates[object].true_y_center;
+
+  // The rotation is stepped once per pixel instead of being recomputed
+  int_fast32_t x_rotation = memory->oam.rotate_scale[group].pa * from_center_x +
+                            memory->oam.rotate_scale[group].pb * from_center_y;
+  int_fast32_t y_rotation = memory->oam.rotate_scale[group].pc * from_center_x +
+                            memory->oam.rotate_scale[group].pd * from_center_y;
+
+  for (uint_fast8_t x = x_start; x < x_end; x++) {
+    int32_t lookup_x = (x_size >> 1) + (x_rotation >> 8u);
+    int32_t lookup_y = (y_size >> 1) + (y_rotation >> 8u);
+
+    x_rotation += memory->oam.rotate_scale[group].pa;
+    y_rotation += memory->oam.rotate_scale[group].pc;
+
+    if (lookup_x < 0 || lookup_x >= x_size || lookup_y < 0 ||
+        lookup_y >= y_size) {
+      continue;
+    }
 
-      lookup_y =
-          (memory->oam.internal.object_coordinates[object].pixel_y_size >> 1) +
-          (y_rotation >> 8u);
+    if (memory->oam.object_attributes[object].obj_mosaic) {
+      lookup_x -= lookup_x % (registers->mosaic.obj_horiz + 1u);
+      lookup_y -= lookup_y % (registers->mosaic.obj_vert + 1u);
+    }
 
-      if (lookup_y < 0 ||
-          lookup_y >=
-              memory->oam.internal.object_coordinates[object].pixel_y_size) {
-        continue;
-      }
+    uint_fast8_t color_index =
+        GbaPpuObjectColorIndex(memory, registers, object, lookup_x, lookup_y);
+    GbaPpuObjectLineAddPixel(memory, object, color_index, x, line);
+  }
+}
 
-      if (memory->oam.object_attributes[object].obj_mosaic) {
-        lookup_x -= lookup_x % (registers->mosaic.obj_horiz + 1u);
-        lookup_y -= lookup_y % (registers->mosaic.obj_vert + 1u);
-      }
-    } else {
-      lookup_x -= memory->oam.internal.object_coordinates[object].true_x_start;
-      lookup_y -= memory->oam.internal.object_coordinates[object].true_y_start;
+static void GbaPpuObjectLineDrawRegular(const GbaPpuMemory* memory,
+                                        const GbaPpuRegisters* registers,
+                                        uint_fast8_t object, uint_fast8_t y,
+                                        GbaPpuObjectLine* line) {
+  int32_t lookup_y =
+      y - memory->oam.internal.object_coordinates[object].true_y_start;
 
-      if (memory->oam.object_attributes[object].obj_mosaic) {
-        lookup_x -= lookup_x % (registers->mosaic.obj_horiz + 1u);
-        lookup_y -= lookup_y % (registers->mosaic.obj_vert + 1u);
-      }
+  if (memory->oam.object_attributes[object].obj_mosaic) {
+    lookup_y -= lookup_y % (registers->mosaic.obj_vert + 1u);
+  }
 
-      // Horizontal Flip
-      if (memory->oam.object_attributes[object].flex_param_1 & 0x8u) {
-        lookup_x =
-            memory->oam.internal.object_coordinates[object].pixel_x_size -
-            lookup_x - 1;
-      }
+  // Vertical Flip
+  if (memory->oam.object_attributes[object].flex_param_1 & 0x10u) {
+    lookup_y = memory->oam.internal.object_coordinates[object].pixel_y_size -
+               lookup_y - 1;
+  }
 
-      // Vertical Flip
-      if (memory->oam.object_attributes[object].flex_param_1 & 0x10u) {
-        lookup_y =
-            memory->oam.internal.object_coordinates[object].pixel_y_size -
-            lookup_y - 1;
-      }
+  for (uint_fast8_t x =
+           memory->oam.internal.object_coordinates[object].pixel_x_start;
+       x < memory->oam.internal.object_coordinates[object].pixel_x_end; x++) {
+    int32_t lookup_x =
+        x - memory->oam.internal.object_coordinates[object].true_x_start;
+
+    if (memory->oam.object_attributes[object].obj_mosaic) {
+      lookup_x -= lookup_x % (registers->mosaic.obj_horiz + 1u);
     }
 
-    unsigned short character_name =
-        memory->oam.object_attributes[object].character_name >>
-        memory->oam.object_attributes[object].palette_mode;
-    unsigned short x_tile = lookup_x / 8u;
-    unsigned short y_tile = lookup_y / 8u;
-
-    unsigned short tile_index;
-    if (registers->dispcnt.object_mode) {
-      // One Dimensional Lookup
-      unsigned short x_size_tiles =
-          (memory->oam.internal.object_coordinates[object].pixel_x_size / 8u);
-      tile_index = character_name + y_tile * x_size_tiles + x_tile;
+    // Horizontal Flip
+    if (memory->oam.object_attributes[object].flex_param_1 & 0x8u) {
+      lookup_x = memory->oam.internal.object_coordinates[object].pixel_x_size -
+                 lookup_x - 1;
+    }
+
+    uint_fast8_t color_index =
+        GbaPpuObjectColorIndex(memory, registers, object, lookup_x, lookup_y);
+    GbaPpuObjectLineAddPixel(memory, object, color_index, x, line);
+  }
+}
+
+void GbaPpuObjectLineDraw(const GbaPpuMemory* memory,
+                          const GbaPpuRegisters* registers, uint_fast8_t y,
+                          GbaPpuObjectLine* line) {
+  assert(y < GBA_SCREEN_HEIGHT);
+
+  memset(line->priorities, UINT8_MAX, sizeof(line->priorities));
+  memset(line->on_obj_mask, false, sizeof(line->on_obj_mask));
+
+  int_fast16_t cycles_remaining = GBA_PPU_OBJECT_CYCLES_PER_LINE;
+  if (registers->dispcnt.oam_hblank) {
+    cycles_remaining = GBA_PPU_OBJECT_CYCLES_PER_LINE_HBLANK_FREE;
+  }
+
+  GbaPpuSet objects = memory->oam.internal.y_sets[y];
+  while (!GbaPpuSetEmpty(&objects)) {
+    uint_fast8_t object = GbaPpuSetPop(&objects);
+    assert(memory->oam.object_attributes[object].affine ||
+           !memory->oam.object_attributes[object].flex_param_0);
+
+    // Every object on the line consumes rendering cycles, even if it is
+    // horizontally off screen. Objects past the budget are not drawn.
+    int_fast16_t x_size =
+        memory->oam.internal.object_coordinates[object].true_x_size;
+    if (memory->oam.object_attributes[object].affine) {
+      cycles_remaining -= 10 + 2 * x_size;
     } else {
-      // Two Dimensional Lookup
-      unsigned short row_width =
-          32u >> memory->oam.object_attributes[object].palette_mode;
-      tile_index = character_name + y_tile * row_width + x_tile;
+      cycles_remaining -= x_size;
+    }
+
+    if (cycles_remaining < 0) {
+      break;
     }
 
     if (registers->dispcnt.mode >= 3u) {
       static const uint_least16_t minimum_index[2] = {
           GBA_BITMAP_MODE_NUM_OBJECT_S_TILES,
           GBA_BITMAP_MODE_NUM_OBJECT_D_TILES};
+      unsigned short character_name =
+          memory->oam.object_attributes[object].character_name >>
+          memory->oam.object_attributes[object].palette_mode;
       if (character_name <
           minimum_index[memory->oam.object_attributes[object].palette_mode]) {
         continue;
       }
     }
 
-    uint_fast8_t x_tile_pixel = lookup_x & 0x7u;
-    uint_fast8_t y_tile_pixel = lookup_y & 0x7u;
-
-    uint16_t obj_color;
-    if (memory->oam.object_attributes[object].palette_mode) {
-      uint8_t color_index;
-      if (memory->oam.object_attributes[object].character_name & 1) {
-        color_index = memory->vram.mode_012.obj.offset_d_tiles[tile_index]
-                          .pixels[y_tile_pixel][x_tile_pixel];
-      } else {
-        color_index = memory->vram.mode_012.obj.d_tiles[tile_index]
-                          .pixels[y_tile_pixel][x_tile_pixel];
-      }
-
-      if (color_index == 0u) {
-        continue;
-      }
-
-      if (memory->oam.object_attributes[object].obj_mode == 2u) {
-        *on_obj_mask = true;
-        continue;
-      }
-
-      obj_color = memory->palette.obj.large_palette[color_index];
+    if (memory->oam.object_attributes[object].affine) {
+      GbaPpuObjectLineDrawAffine(memory, registers, object, y, line);
     } else {
-      uint8_t color_index_pair = memory->vram.mode_012.obj.s_tiles[tile_index]
-                                     .pixels[y_tile_pixel][x_tile_pixel >> 1u]
-                                     .value;
-
-      // Select lower 4 bits if lookup_x_tile_pixel is even and upper 4 bits
-      // if lookup_x_tile_pixel is odd.
-      uint_fast8_t color_index =
-          (color_index_pair >> ((x_tile_pixel & 1u) << 2u)) & 0xFu;
-      if (color_index == 0u) {
-        continue;
-      }
-
-      if (memory->oam.object_attributes[object].obj_mode == 2u) {
-        *on_obj_mask = true;
-        continue;
-      }
-
-      obj_color =
-          memory->palette.obj
-              .small_palettes[memory->oam.object_attributes[object].palette]
-                             [color_index];
-    }
-
-    found = true;
-    if (memory->oam.object_attributes[object].priority < *priority) {
-      *priority = memory->oam.object_attributes[object].priority;
-      *color = obj_color;
-      *semi_transparent = memory->oam.object_attributes[object].obj_mode == 1u;
+      GbaPpuObjectLineDrawRegular(memory, registers, object, y, line);
     }
   }
-
-  return found;
 }
\ No newline at end of file
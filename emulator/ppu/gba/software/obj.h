@@ -4,9 +4,15 @@
 #include "emulator/ppu/gba/memory.h"
 #include "emulator/ppu/gba/registers.h"
 
-bool GbaPpuObjectPixel(const GbaPpuMemory* memory,
-                       const GbaPpuRegisters* registers, const uint_fast8_t x,
-                       uint_fast8_t y, uint16_t* color, uint8_t* priority,
-                       bool* semi_transparent, bool* on_obj_mask);
+typedef struct {
+  uint32_t colors[GBA_SCREEN_WIDTH];  // XRGB8888
+  uint8_t priorities[GBA_SCREEN_WIDTH];  // UINT8_MAX if no object is drawn
+  bool semi_transparent[GBA_SCREEN_WIDTH];
+  bool on_obj_mask[GBA_SCREEN_WIDTH];
+} GbaPpuObjectLine;
+
+void GbaPpuObjectLineDraw(const GbaPpuMemory* memory,
+                          const GbaPpuRegisters* registers, uint_fast8_t y,
+                          GbaPpuObjectLine* line);
 
 #endif  // _WEBGBA_EMULATOR_PPU_GBA_SOFTWARE_OBJ_
\ No newline at end of file
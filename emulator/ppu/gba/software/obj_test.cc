@@ -0,0 +1,119 @@
+extern "C" {
+#include "emulator/ppu/gba/software/obj.h"
+}
+
+#include <cstdlib>
+#include <cstring>
+
+#include "googletest/include/gtest/gtest.h"
+
+class ObjectLineTest : public testing::Test {
+ public:
+  void SetUp() override {
+    memory_ = (GbaPpuMemory*)calloc(1u, sizeof(GbaPpuMemory));
+    ASSERT_NE(nullptr, memory_);
+    memset(&registers_, 0, sizeof(GbaPpuRegisters));
+
+    // Tile 1 is solid color index 1, all other tiles are transparent
+    memset(&memory_->vram.mode_012.obj.s_tiles[1u], 0x11, sizeof(STile));
+    memory_->palette.internal.obj.small_palettes[0u][1u] = 0x1234u;
+    memory_->palette.internal.obj.small_palettes[1u][1u] = 0x5678u;
+  }
+
+  void TearDown() override { free(memory_); }
+
+ protected:
+  void AddObject(uint_fast8_t object, int16_t x, uint8_t y,
+                 unsigned char size, unsigned char priority,
+                 unsigned char palette) {
+    memory_->oam.object_attributes[object].x_coordinate = x;
+    memory_->oam.object_attributes[object].y_coordinate_u = y;
+    memory_->oam.object_attributes[object].obj_size = size;
+    memory_->oam.object_attributes[object].character_name = 1u;
+    memory_->oam.object_attributes[object].priority = priority;
+    memory_->oam.object_attributes[object].palette = palette;
+    registers_.dispcnt.object_mode = true;
+    GbaPpuObjectVisibilityDrawn(&memory_->oam, object);
+  }
+
+  GbaPpuMemory* memory_;
+  GbaPpuRegisters registers_;
+  GbaPpuObjectLine line_;
+};
+
+TEST_F(ObjectLineTest, Empty) {
+  GbaPpuObjectLineDraw(memory_, &registers_, 0u, &line_);
+  for (uint_fast8_t x = 0u; x < GBA_SCREEN_WIDTH; x++) {
+    EXPECT_EQ(UINT8_MAX, line_.priorities[x]);
+    EXPECT_FALSE(line_.on_obj_mask[x]);
+  }
+}
+
+TEST_F(ObjectLineTest, Draw) {
+  AddObject(0u, 8, 8u, 0u, 2u, 0u);
+
+  GbaPpuObjectLineDraw(memory_, &registers_, 7u, &line_);
+  EXPECT_EQ(UINT8_MAX, line_.priorities[8u]);
+
+  GbaPpuObjectLineDraw(memory_, &registers_, 8u, &line_);
+  EXPECT_EQ(UINT8_MAX, line_.priorities[7u]);
+  for (uint_fast8_t x = 8u; x < 16u; x++) {
+    EXPECT_EQ(0x1234u, line_.colors[x]);
+    EXPECT_EQ(2u, line_.priorities[x]);
+    EXPECT_FALSE(line_.semi_transparent[x]);
+  }
+  EXPECT_EQ(UINT8_MAX, line_.priorities[16u]);
+}
+
+TEST_F(ObjectLineTest, PriorityOrder) {
+  AddObject(0u, 0, 0u, 0u, 1u, 0u);
+  AddObject(1u, 4, 0u, 0u, 1u, 1u);
+  AddObject(2u, 8, 0u, 0u, 0u, 1u);
+
+  GbaPpuObjectLineDraw(memory_, &registers_, 0u, &line_);
+  EXPECT_EQ(0x1234u, line_.colors[0u]);
+  EXPECT_EQ(0x1234u, line_.colors[7u]);
+  EXPECT_EQ(1u, line_.priorities[7u]);
+  EXPECT_EQ(0x5678u, line_.colors[8u]);
+  EXPECT_EQ(0u, line_.priorities[8u]);
+  EXPECT_EQ(0x5678u, line_.colors[15u]);
+}
+
+TEST_F(ObjectLineTest, ObjectWindow) {
+  memory_->oam.object_attributes[0u].obj_mode = 2u;
+  AddObject(0u, 0, 0u, 0u, 0u, 0u);
+
+  GbaPpuObjectLineDraw(memory_, &registers_, 0u, &line_);
+  EXPECT_TRUE(line_.on_obj_mask[0u]);
+  EXPECT_EQ(UINT8_MAX, line_.priorities[0u]);
+  EXPECT_FALSE(line_.on_obj_mask[8u]);
+}
+
+TEST_F(ObjectLineTest, CycleBudget) {
+  // Each 64 pixel wide object costs 64 cycles to render
+  for (uint_fast8_t i = 0u; i < 17u; i++) {
+    AddObject(i, -64, 0u, 3u, 0u, 0u);
+  }
+  AddObject(18u, 0, 0u, 3u, 0u, 0u);
+
+  GbaPpuObjectLineDraw(memory_, &registers_, 0u, &line_);
+  EXPECT_EQ(0u, line_.priorities[0u]);
+
+  AddObject(17u, -64, 0u, 3u, 0u, 0u);
+  GbaPpuObjectLineDraw(memory_, &registers_, 0u, &line_);
+  EXPECT_EQ(UINT8_MAX, line_.priorities[0u]);
+}
+
+TEST_F(ObjectLineTest, CycleBudgetHBlankFree) {
+  for (uint_fast8_t i = 0u; i < 14u; i++) {
+    AddObject(i, -64, 0u, 3u, 0u, 0u);
+  }
+  AddObject(14u, 0, 0u, 3u, 0u, 0u);
+
+  GbaPpuObjectLineDraw(memory_, &registers_, 0u, &line_);
+  EXPECT_EQ(0u, line_.priorities[0u]);
+
+  registers_.dispcnt.oam_hblank = true;
+  GbaPpuObjectLineDraw(memory_, &registers_, 0u, &line_);
+  EXPECT_EQ(UINT8_MAX, line_.priorities[0u]);
+}
\ No newline at end of file
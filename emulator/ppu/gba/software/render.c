@@ -12,38 +12,139 @@
 #include "emulator/screen.h"
 
 struct _GbaPpuSoftwareRenderer {
-  uint8_t* subpixels;
+  ScreenPixelBuffer framebuffer;
+  GbaPpuObjectLine objects;
+  GbaPpuBackgroundLine bg2;
+  GbaPpuBackgroundLine bg3;
+  GbaPpuWindowLine window;
 };
 
-static void GbaPpuSoftwareRendererDrawPixelImpl(
+static void GbaPpuSoftwareRendererDrawBackgroundLines(
     GbaPpuSoftwareRenderer* renderer, const GbaPpuMemory* memory,
-    const GbaPpuRegisters* registers, GbaPpuDirtyBits* dirty_bits, uint8_t x,
-    const int32_t affine_bg2[2], const int32_t affine_bg3[2], uint8_t rgb[3]) {
-  uint16_t obj_color;
-  uint8_t obj_priority;
-  bool object_on_pixel, obj_semi_transparent, on_obj_mask;
-  if (registers->dispcnt.object_enable) {
-    object_on_pixel =
-        GbaPpuObjectPixel(memory, registers, x, registers->vcount, &obj_color,
-                          &obj_priority, &obj_semi_transparent, &on_obj_mask);
-  } else {
-    object_on_pixel = false;
-    on_obj_mask = false;
+    const GbaPpuRegisters* registers) {
+  switch (registers->dispcnt.mode) {
+    case 1:
+      if (registers->dispcnt.bg2_enable) {
+        GbaPpuAffineBackgroundLineDraw(
+            memory, registers, GBA_PPU_AFFINE_BACKGROUND_2, &renderer->bg2);
+      }
+      break;
+    case 2:
+      if (registers->dispcnt.bg2_enable) {
+        GbaPpuAffineBackgroundLineDraw(
+            memory, registers, GBA_PPU_AFFINE_BACKGROUND_2, &renderer->bg2);
+      }
+      if (registers->dispcnt.bg3_enable) {
+        GbaPpuAffineBackgroundLineDraw(
+            memory, registers, GBA_PPU_AFFINE_BACKGROUND_3, &renderer->bg3);
+      }
+      break;
+    case 3:
+      if (registers->dispcnt.bg2_enable) {
+        GbaPpuBitmapMode3LineDraw(memory, registers, &renderer->bg2);
+      }
+      break;
+    case 4:
+      if (registers->dispcnt.bg2_enable) {
+        GbaPpuBitmapMode4LineDraw(memory, registers, &renderer->bg2);
+      }
+      break;
+    case 5:
+      if (registers->dispcnt.bg2_enable) {
+        GbaPpuBitmapMode5LineDraw(memory, registers, &renderer->bg2);
+      }
+      break;
+  }
+}
+
+static void GbaPpuSoftwareRendererDrawBackgroundPixels(
+    GbaPpuSoftwareRenderer* renderer, const GbaPpuMemory* memory,
+    const GbaPpuRegisters* registers, uint8_t x) {
+  const int32_t* affine_bg2 = registers->internal.affine[0u].current;
+  const int32_t* affine_bg3 = registers->internal.affine[1u].current;
+  switch (registers->dispcnt.mode) {
+    case 1:
+      renderer->bg2.opaque[x] = GbaPpuAffineBackgroundPixel(
+          memory, registers, GBA_PPU_AFFINE_BACKGROUND_2, affine_bg2[0u],
+          affine_bg2[1u], &renderer->bg2.colors[x]);
+      break;
+    case 2:
+      renderer->bg2.opaque[x] = GbaPpuAffineBackgroundPixel(
+          memory, registers, GBA_PPU_AFFINE_BACKGROUND_2, affine_bg2[0u],
+          affine_bg2[1u], &renderer->bg2.colors[x]);
+      renderer->bg3.opaque[x] = GbaPpuAffineBackgroundPixel(
+          memory, registers, GBA_PPU_AFFINE_BACKGROUND_3, affine_bg3[0u],
+          affine_bg3[1u], &renderer->bg3.colors[x]);
+      break;
+    case 3:
+      renderer->bg2.opaque[x] =
+          GbaPpuBitmapMode3Pixel(memory, registers, affine_bg2[0u],
+                                 affine_bg2[1u], &renderer->bg2.colors[x]);
+      break;
+    case 4:
+      renderer->bg2.opaque[x] =
+          GbaPpuBitmapMode4Pixel(memory, registers, affine_bg2[0u],
+                                 affine_bg2[1u], &renderer->bg2.colors[x]);
+      break;
+    case 5:
+      renderer->bg2.opaque[x] =
+          GbaPpuBitmapMode5Pixel(memory, registers, affine_bg2[0u],
+                                 affine_bg2[1u], &renderer->bg2.colors[x]);
+      break;
   }
+}
+
+static void GbaPpuSoftwareRendererStorePixels(
+    const ScreenPixelBuffer* framebuffer, uint_fast8_t y, uint_fast8_t x,
+    uint_fast8_t count, const uint32_t* colors) {
+  uint8_t* row = framebuffer->pixels + framebuffer->pitch * y;
+  switch (framebuffer->format) {
+    case SCREEN_PIXEL_FORMAT_RGB888:
+      row += 3u * x;
+      for (uint_fast8_t i = 0u; i < count; i++) {
+        row[3u * i + 0u] = colors[i] >> 16u;
+        row[3u * i + 1u] = colors[i] >> 8u;
+        row[3u * i + 2u] = colors[i];
+      }
+      break;
+    case SCREEN_PIXEL_FORMAT_XRGB8888:
+      memcpy(row + sizeof(uint32_t) * x, colors, sizeof(uint32_t) * count);
+      break;
+    case SCREEN_PIXEL_FORMAT_RGB565:
+      for (uint_fast8_t i = 0u; i < count; i++) {
+        uint16_t color = ((colors[i] >> 8u) & 0xF800u) |
+                         ((colors[i] >> 5u) & 0x07E0u) |
+                         ((colors[i] >> 3u) & 0x001Fu);
+        memcpy(row + sizeof(uint16_t) * (x + i), &color, sizeof(uint16_t));
+      }
+      break;
+  }
+}
+
+static uint32_t GbaPpuSoftwareRendererDrawPixelImpl(
+    GbaPpuSoftwareRenderer* renderer, const GbaPpuMemory* memory,
+    const GbaPpuRegisters* registers, GbaPpuDirtyBits* dirty_bits, uint8_t x,
+    WindowLayerBits window) {
+  bool object_on_pixel = registers->dispcnt.object_enable &&
+                         renderer->objects.priorities[x] != UINT8_MAX;
 
-  bool draw_obj, draw_bg0, draw_bg1, draw_bg2, draw_bg3, enable_blending;
-  GbaPpuWindowCheck(registers, x, registers->vcount, on_obj_mask, &draw_obj,
-                    &draw_bg0, &draw_bg1, &draw_bg2, &draw_bg3,
-                    &enable_blending);
+  bool draw_obj = window.obj;
+  bool draw_bg0 = window.bg0;
+  bool draw_bg1 = window.bg1;
+  bool draw_bg2 = window.bg2;
+  bool draw_bg3 = window.bg3;
+  bool enable_blending = window.bld;
 
   GbaPpuBlendUnit blend_unit;
   GbaPpuBlendUnitReset(&blend_unit);
   if (object_on_pixel && draw_obj) {
-    GbaPpuBlendUnitAddObject(&blend_unit, registers, obj_color, obj_priority,
-                             obj_semi_transparent);
+    GbaPpuBlendUnitAddObject(&blend_unit, registers,
+                             renderer->objects.colors[x],
+                             renderer->objects.priorities[x],
+                             renderer->objects.semi_transparent[x]);
   }
 
-  uint16_t color;
+  uint32_t color;
   bool success;
   switch (registers->dispcnt.mode) {
     case 0:
@@ -109,73 +210,46 @@ static void GbaPpuSoftwareRendererDrawPixelImpl(
       }
 
       if (draw_bg2 && registers->dispcnt.bg2_enable &&
-          blend_unit.priorities[1u] > registers->bgcnt[2u].priority) {
-        success = GbaPpuAffineBackgroundPixel(
-            memory, registers, GBA_PPU_AFFINE_BACKGROUND_2, affine_bg2[0u],
-            affine_bg2[1u], &color);
-        if (success) {
-          GbaPpuBlendUnitAddBackground2(&blend_unit, registers, color);
-        }
+          blend_unit.priorities[1u] > registers->bgcnt[2u].priority &&
+          renderer->bg2.opaque[x]) {
+        GbaPpuBlendUnitAddBackground2(&blend_unit, registers,
+                                      renderer->bg2.colors[x]);
       }
       break;
     case 2:
       if (draw_bg2 && registers->dispcnt.bg2_enable &&
-          blend_unit.priorities[1u] > registers->bgcnt[2u].priority) {
-        success = GbaPpuAffineBackgroundPixel(
-            memory, registers, GBA_PPU_AFFINE_BACKGROUND_2, affine_bg2[0u],
-            affine_bg2[1u], &color);
-        if (success) {
-          GbaPpuBlendUnitAddBackground2(&blend_unit, registers, color);
-        }
+          blend_unit.priorities[1u] > registers->bgcnt[2u].priority &&
+          renderer->bg2.opaque[x]) {
+        GbaPpuBlendUnitAddBackground2(&blend_unit, registers,
+                                      renderer->bg2.colors[x]);
       }
 
       if (draw_bg3 && registers->dispcnt.bg3_enable &&
-          blend_unit.priorities[1u] > registers->bgcnt[3u].priority) {
-        success = GbaPpuAffineBackgroundPixel(
-            memory, registers, GBA_PPU_AFFINE_BACKGROUND_3, affine_bg3[0u],
-            affine_bg3[1u], &color);
-        if (success) {
-          GbaPpuBlendUnitAddBackground3(&blend_unit, registers, color);
-        }
+          blend_unit.priorities[1u] > registers->bgcnt[3u].priority &&
+          renderer->bg3.opaque[x]) {
+        GbaPpuBlendUnitAddBackground3(&blend_unit, registers,
+                                      renderer->bg3.colors[x]);
       }
       break;
     case 3:
-      if (draw_bg2 && registers->dispcnt.bg2_enable) {
-        success = GbaPpuBitmapMode3Pixel(memory, registers, affine_bg2[0u],
-                                         affine_bg2[1u], &color);
-        if (success) {
-          GbaPpuBlendUnitAddBackground2(&blend_unit, registers, color);
-        }
-      }
-      break;
     case 4:
-      if (draw_bg2 && registers->dispcnt.bg2_enable) {
-        success = GbaPpuBitmapMode4Pixel(memory, registers, affine_bg2[0u],
-                                         affine_bg2[1u], &color);
-        if (success) {
-          GbaPpuBlendUnitAddBackground2(&blend_unit, registers, color);
-        }
-      }
-      break;
     case 5:
-      if (draw_bg2 && registers->dispcnt.bg2_enable) {
-        success = GbaPpuBitmapMode5Pixel(memory, registers, affine_bg2[0u],
-                                         affine_bg2[1u], &color);
-        if (success) {
-          GbaPpuBlendUnitAddBackground2(&blend_unit, registers, color);
-        }
+      if (draw_bg2 && registers->dispcnt.bg2_enable &&
+          renderer->bg2.opaque[x]) {
+        GbaPpuBlendUnitAddBackground2(&blend_unit, registers,
+                                      renderer->bg2.colors[x]);
       }
       break;
   }
 
   GbaPpuBlendUnitAddBackdrop(&blend_unit, registers,
-                             memory->palette.bg.large_palette[0u]);
+                             memory->palette.internal.bg.large_palette[0u]);
 
   if (enable_blending) {
-    GbaPpuBlendUnitBlend(&blend_unit, registers, rgb);
-  } else {
-    GbaPpuBlendUnitNoBlend(&blend_unit, rgb);
+    return GbaPpuBlendUnitBlend(&blend_unit, registers);
   }
+
+  return GbaPpuBlendUnitNoBlend(&blend_unit);
 }
 
 GbaPpuSoftwareRenderer* GbaPpuSoftwareRendererAllocate() {
@@ -184,64 +258,84 @@ GbaPpuSoftwareRenderer* GbaPpuSoftwareRendererAllocate() {
 
 bool GbaPpuSoftwareRendererSetScreen(GbaPpuSoftwareRenderer* renderer,
                                      Screen* screen) {
-  renderer->subpixels =
-      ScreenGetPixelBuffer(screen, GBA_SCREEN_WIDTH, GBA_SCREEN_HEIGHT);
-  return renderer->subpixels != NULL;
+  if (!ScreenGetPixelBuffer(screen, GBA_SCREEN_WIDTH, GBA_SCREEN_HEIGHT,
+                            &renderer->framebuffer)) {
+    renderer->framebuffer.pixels = NULL;
+    return false;
+  }
+
+  return true;
+}
+
+void GbaPpuSoftwareRendererSetPixelBuffer(
+    GbaPpuSoftwareRenderer* renderer, const ScreenPixelBuffer* framebuffer) {
+  renderer->framebuffer = *framebuffer;
 }
 
 void GbaPpuSoftwareRendererDrawRow(GbaPpuSoftwareRenderer* renderer,
                                    const GbaPpuMemory* memory,
                                    const GbaPpuRegisters* registers,
                                    GbaPpuDirtyBits* dirty_bits) {
-  if (renderer->subpixels == NULL) {
+  if (renderer->framebuffer.pixels == NULL) {
     return;
   }
 
-  int32_t affine_bg2[2] = {registers->internal.affine[0u].current[0u],
-                           registers->internal.affine[0u].current[1u]};
-  int32_t affine_bg3[2] = {registers->internal.affine[1u].current[0u],
-                           registers->internal.affine[1u].current[1u]};
-
-  uint8_t row = GBA_SCREEN_HEIGHT - registers->vcount - 1u;
+  uint32_t colors[GBA_SCREEN_WIDTH];
   if (!registers->dispcnt.forced_blank) {
-    for (uint8_t i = 0; i < GBA_SCREEN_WIDTH; i++) {
-      GbaPpuSoftwareRendererDrawPixelImpl(
-          renderer, memory, registers, dirty_bits, i, affine_bg2, affine_bg3,
-          &renderer->subpixels[row * 3u * GBA_SCREEN_WIDTH + 3u * i]);
-      affine_bg2[0u] += registers->affine[0u].pa;
-      affine_bg2[1u] += registers->affine[0u].pc;
-      affine_bg3[0u] += registers->affine[1u].pa;
-      affine_bg3[1u] += registers->affine[1u].pc;
+    const bool* on_obj_mask = NULL;
+    if (registers->dispcnt.object_enable) {
+      GbaPpuObjectLineDraw(memory, registers, registers->vcount,
+                           &renderer->objects);
+      on_obj_mask = renderer->objects.on_obj_mask;
     }
-  } else {
+
+    GbaPpuSoftwareRendererDrawBackgroundLines(renderer, memory, registers);
+    GbaPpuWindowLineDraw(registers, registers->vcount, on_obj_mask,
+                         &renderer->window);
+
     for (uint8_t i = 0; i < GBA_SCREEN_WIDTH; i++) {
-      renderer->subpixels[row * 3u * GBA_SCREEN_WIDTH + 3u * i + 0u] = 0u;
-      renderer->subpixels[row * 3u * GBA_SCREEN_WIDTH + 3u * i + 1u] = 0u;
-      renderer->subpixels[row * 3u * GBA_SCREEN_WIDTH + 3u * i + 2u] = 0u;
+      colors[i] = GbaPpuSoftwareRendererDrawPixelImpl(
+          renderer, memory, registers, dirty_bits, i,
+          renderer->window.layers[i]);
     }
+  } else {
+    memset(colors, 0, sizeof(colors));
   }
+
+  GbaPpuSoftwareRendererStorePixels(&renderer->framebuffer, registers->vcount,
+                                    /*x=*/0u, GBA_SCREEN_WIDTH, colors);
 }
 
 void GbaPpuSoftwareRendererDrawPixel(GbaPpuSoftwareRenderer* renderer,
                                      const GbaPpuMemory* memory,
                                      const GbaPpuRegisters* registers,
                                      GbaPpuDirtyBits* dirty_bits, uint8_t x) {
-  if (renderer->subpixels == NULL) {
+  if (renderer->framebuffer.pixels == NULL) {
     return;
   }
 
-  uint8_t row = GBA_SCREEN_HEIGHT - registers->vcount - 1u;
+  // Objects are evaluated once for the whole line before it is drawn, so
+  // changes made to them partway through the line do not take effect.
+  if (x == 0u) {
+    GbaPpuObjectLineDraw(memory, registers, registers->vcount,
+                         &renderer->objects);
+  }
+
+  uint32_t color = 0u;
   if (!registers->dispcnt.forced_blank) {
-    GbaPpuSoftwareRendererDrawPixelImpl(
-        renderer, memory, registers, dirty_bits, x,
-        registers->internal.affine[0u].current,
-        registers->internal.affine[1u].current,
-        &renderer->subpixels[row * 3u * GBA_SCREEN_WIDTH + 3u * x]);
-  } else {
-    renderer->subpixels[row * 3u * GBA_SCREEN_WIDTH + 3u * x + 0u] = 0u;
-    renderer->subpixels[row * 3u * GBA_SCREEN_WIDTH + 3u * x + 1u] = 0u;
-    renderer->subpixels[row * 3u * GBA_SCREEN_WIDTH + 3u * x + 2u] = 0u;
+    GbaPpuSoftwareRendererDrawBackgroundPixels(renderer, memory, registers, x);
+
+    bool on_obj_mask = registers->dispcnt.object_enable &&
+                       renderer->objects.on_obj_mask[x];
+    WindowLayerBits window =
+        GbaPpuWindowCheck(registers, x, registers->vcount, on_obj_mask);
+
+    color = GbaPpuSoftwareRendererDrawPixelImpl(renderer, memory, registers,
+                                                dirty_bits, x, window);
   }
+
+  GbaPpuSoftwareRendererStorePixels(&renderer->framebuffer, registers->vcount,
+                                    x, /*count=*/1u, &color);
 }
 
 void GbaPpuSoftwareRendererFree(GbaPpuSoftwareRenderer* renderer) {
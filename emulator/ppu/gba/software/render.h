@@ -15,6 +15,11 @@ GbaPpuSoftwareRenderer* GbaPpuSoftwareRendererAllocate();
 bool GbaPpuSoftwareRendererSetScreen(GbaPpuSoftwareRenderer* renderer,
                                      Screen* screen);
 
+// Draws into a pixel buffer already fetched from a screen, which lets several
+// renderers share one buffer without fetching it from the screen again
+void GbaPpuSoftwareRendererSetPixelBuffer(GbaPpuSoftwareRenderer* renderer,
+                                          const ScreenPixelBuffer* framebuffer);
+
 void GbaPpuSoftwareRendererDrawRow(GbaPpuSoftwareRenderer* renderer,
                                    const GbaPpuMemory* memory,
                                    const GbaPpuRegisters* registers,
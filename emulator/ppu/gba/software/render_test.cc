@@ -0,0 +1,279 @@
+extern "C" {
+#include "emulator/ppu/gba/software/bands.h"
+#include "emulator/ppu/gba/software/render.h"
+#include "emulator/ppu/gba/software/worker.h"
+}
+
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+#include "googletest/include/gtest/gtest.h"
+
+class RenderTest : public testing::Test {
+ public:
+  void SetUp() override {
+    renderer_ = GbaPpuSoftwareRendererAllocate();
+    ASSERT_NE(nullptr, renderer_);
+    screen_ = ScreenAllocate();
+    ASSERT_NE(nullptr, screen_);
+    memory_ = (GbaPpuMemory*)calloc(1u, sizeof(GbaPpuMemory));
+    ASSERT_NE(nullptr, memory_);
+    memset(&registers_, 0, sizeof(GbaPpuRegisters));
+    memset(&dirty_, 0, sizeof(GbaPpuDirtyBits));
+
+    memory_->palette.internal.bg.large_palette[0u] = 0xFF8410u;
+    registers_.vcount = 5u;
+  }
+
+  void TearDown() override {
+    GbaPpuSoftwareRendererFree(renderer_);
+    ScreenFree(screen_);
+    free(memory_);
+  }
+
+ protected:
+  static void AttachPixels(Screen* screen, std::vector<uint32_t>* pixels,
+                           uint32_t fill) {
+    pixels->assign(GBA_SCREEN_WIDTH * GBA_SCREEN_HEIGHT, fill);
+    ScreenAttachPixelBuffer(screen, pixels->data(), GBA_SCREEN_WIDTH,
+                            GBA_SCREEN_HEIGHT, SCREEN_PIXEL_FORMAT_XRGB8888,
+                            GBA_SCREEN_WIDTH * sizeof(uint32_t),
+                            /*bottom_up=*/false);
+  }
+
+  GbaPpuSoftwareRenderer* renderer_;
+  Screen* screen_;
+  GbaPpuMemory* memory_;
+  GbaPpuRegisters registers_;
+  GbaPpuDirtyBits dirty_;
+};
+
+TEST_F(RenderTest, XRGB8888TopDown) {
+  std::vector<uint32_t> pixels;
+  AttachPixels(screen_, &pixels, 1u);
+  ASSERT_TRUE(GbaPpuSoftwareRendererSetScreen(renderer_, screen_));
+
+  GbaPpuSoftwareRendererDrawRow(renderer_, memory_, &registers_, &dirty_);
+
+  for (uint32_t x = 0u; x < GBA_SCREEN_WIDTH; x++) {
+    EXPECT_EQ(1u, pixels[4u * GBA_SCREEN_WIDTH + x]);
+    EXPECT_EQ(0xFF8410u, pixels[5u * GBA_SCREEN_WIDTH + x]);
+    EXPECT_EQ(1u, pixels[6u * GBA_SCREEN_WIDTH + x]);
+  }
+
+  registers_.dispcnt.forced_blank = true;
+  GbaPpuSoftwareRendererDrawRow(renderer_, memory_, &registers_, &dirty_);
+  EXPECT_EQ(0u, pixels[5u * GBA_SCREEN_WIDTH]);
+}
+
+TEST_F(RenderTest, RGB565BottomUpWithPadding) {
+  static const uint32_t kPitch = GBA_SCREEN_WIDTH + 16u;
+  std::vector<uint16_t> pixels(kPitch * GBA_SCREEN_HEIGHT, 1u);
+  ScreenAttachPixelBuffer(screen_, pixels.data(), GBA_SCREEN_WIDTH,
+                          GBA_SCREEN_HEIGHT, SCREEN_PIXEL_FORMAT_RGB565,
+                          kPitch * sizeof(uint16_t), /*bottom_up=*/true);
+  ASSERT_TRUE(GbaPpuSoftwareRendererSetScreen(renderer_, screen_));
+
+  GbaPpuSoftwareRendererDrawRow(renderer_, memory_, &registers_, &dirty_);
+
+  uint32_t row = GBA_SCREEN_HEIGHT - 1u - 5u;
+  for (uint32_t x = 0u; x < GBA_SCREEN_WIDTH; x++) {
+    EXPECT_EQ(0xFC22u, pixels[row * kPitch + x]);
+  }
+  EXPECT_EQ(1u, pixels[row * kPitch + GBA_SCREEN_WIDTH]);
+  EXPECT_EQ(1u, pixels[(row - 1u) * kPitch]);
+}
+
+TEST_F(RenderTest, RGB888Pixel) {
+  std::vector<uint8_t> pixels(3u * GBA_SCREEN_WIDTH * GBA_SCREEN_HEIGHT, 1u);
+  ScreenAttachPixelBuffer(screen_, pixels.data(), GBA_SCREEN_WIDTH,
+                          GBA_SCREEN_HEIGHT, SCREEN_PIXEL_FORMAT_RGB888,
+                          3u * GBA_SCREEN_WIDTH, /*bottom_up=*/false);
+  ASSERT_TRUE(GbaPpuSoftwareRendererSetScreen(renderer_, screen_));
+
+  GbaPpuSoftwareRendererDrawPixel(renderer_, memory_, &registers_, &dirty_,
+                                  /*x=*/0u);
+  GbaPpuSoftwareRendererDrawPixel(renderer_, memory_, &registers_, &dirty_,
+                                  /*x=*/1u);
+
+  uint32_t offset = 3u * 5u * GBA_SCREEN_WIDTH;
+  EXPECT_EQ(0xFFu, pixels[offset + 0u]);
+  EXPECT_EQ(0x84u, pixels[offset + 1u]);
+  EXPECT_EQ(0x10u, pixels[offset + 2u]);
+  EXPECT_EQ(0xFFu, pixels[offset + 3u]);
+  EXPECT_EQ(0x84u, pixels[offset + 4u]);
+  EXPECT_EQ(0x10u, pixels[offset + 5u]);
+  EXPECT_EQ(1u, pixels[offset + 6u]);
+}
+
+// The ways rows can be drawn in software, each of which must match drawing
+// them directly with a renderer
+struct DrawBackend {
+  const char* name;
+  void* (*allocate)();
+  bool (*set_screen)(void* backend, Screen* screen);
+  void (*draw_row)(void* backend, const GbaPpuMemory* memory,
+                   const GbaPpuRegisters* registers,
+                   GbaPpuDirtyBits* dirty_bits);
+  void (*finish)(void* backend);
+  void (*free)(void* backend);
+  bool draws_at_finish;
+};
+
+const DrawBackend kRenderer = {
+    "Renderer",
+    []() -> void* { return GbaPpuSoftwareRendererAllocate(); },
+    [](void* backend, Screen* screen) {
+      return GbaPpuSoftwareRendererSetScreen(
+          (GbaPpuSoftwareRenderer*)backend, screen);
+    },
+    [](void* backend, const GbaPpuMemory* memory,
+       const GbaPpuRegisters* registers, GbaPpuDirtyBits* dirty_bits) {
+      GbaPpuSoftwareRendererDrawRow((GbaPpuSoftwareRenderer*)backend, memory,
+                                    registers, dirty_bits);
+    },
+    [](void* backend) {},
+    [](void* backend) {
+      GbaPpuSoftwareRendererFree((GbaPpuSoftwareRenderer*)backend);
+    },
+    /*draws_at_finish=*/false,
+};
+
+const DrawBackend kWorker = {
+    "Worker",
+    []() -> void* { return GbaPpuSoftwareWorkerAllocate(); },
+    [](void* backend, Screen* screen) {
+      return GbaPpuSoftwareWorkerSetScreen((GbaPpuSoftwareWorker*)backend,
+                                           screen);
+    },
+    [](void* backend, const GbaPpuMemory* memory,
+       const GbaPpuRegisters* registers, GbaPpuDirtyBits* dirty_bits) {
+      GbaPpuSoftwareWorkerDrawRow((GbaPpuSoftwareWorker*)backend, memory,
+                                  registers, dirty_bits);
+    },
+    [](void* backend) {
+      GbaPpuSoftwareWorkerFinish((GbaPpuSoftwareWorker*)backend);
+    },
+    [](void* backend) {
+      GbaPpuSoftwareWorkerFree((GbaPpuSoftwareWorker*)backend);
+    },
+    /*draws_at_finish=*/false,
+};
+
+#define BANDS_BACKEND(backend_name, num_bands)                              \
+  {                                                                         \
+    backend_name,                                                           \
+        []() -> void* { return GbaPpuSoftwareBandsAllocate(num_bands); },   \
+        [](void* backend, Screen* screen) {                                 \
+          return GbaPpuSoftwareBandsSetScreen((GbaPpuSoftwareBands*)backend, \
+                                              screen);                      \
+        },                                                                  \
+        [](void* backend, const GbaPpuMemory* memory,                       \
+           const GbaPpuRegisters* registers, GbaPpuDirtyBits* dirty_bits) { \
+          GbaPpuSoftwareBandsDrawRow((GbaPpuSoftwareBands*)backend, memory, \
+                                     registers, dirty_bits);                \
+        },                                                                  \
+        [](void* backend) {                                                 \
+          GbaPpuSoftwareBandsFinish((GbaPpuSoftwareBands*)backend);         \
+        },                                                                  \
+        [](void* backend) {                                                 \
+          GbaPpuSoftwareBandsFree((GbaPpuSoftwareBands*)backend);           \
+        },                                                                  \
+        /*draws_at_finish=*/true,                                           \
+  }
+
+const DrawBackend kOneBand = BANDS_BACKEND("OneBand", 1u);
+const DrawBackend kThreeBands = BANDS_BACKEND("ThreeBands", 3u);
+const DrawBackend kBandPerProcessor = BANDS_BACKEND("BandPerProcessor", 0u);
+
+class DrawBackendTest : public RenderTest,
+                        public testing::WithParamInterface<DrawBackend> {
+ public:
+  void SetUp() override {
+    RenderTest::SetUp();
+    backend_ = GetParam().allocate();
+    ASSERT_NE(nullptr, backend_);
+    backend_screen_ = ScreenAllocate();
+    ASSERT_NE(nullptr, backend_screen_);
+
+    AttachPixels(backend_screen_, &backend_pixels_, 1u);
+    ASSERT_TRUE(GetParam().set_screen(backend_, backend_screen_));
+    AttachPixels(screen_, &renderer_pixels_, 2u);
+    ASSERT_TRUE(GbaPpuSoftwareRendererSetScreen(renderer_, screen_));
+  }
+
+  void TearDown() override {
+    GetParam().free(backend_);
+    ScreenFree(backend_screen_);
+    RenderTest::TearDown();
+  }
+
+ protected:
+  void DrawRow() {
+    GbaPpuSoftwareRendererDrawRow(renderer_, memory_, &registers_, &dirty_);
+    GetParam().draw_row(backend_, memory_, &registers_, &dirty_);
+  }
+
+  void* backend_;
+  Screen* backend_screen_;
+  std::vector<uint32_t> backend_pixels_;
+  std::vector<uint32_t> renderer_pixels_;
+};
+
+TEST_P(DrawBackendTest, DrawsRows) {
+  dirty_.palette.palette[0u] = true;
+
+  for (uint16_t y = 0u; y < GBA_SCREEN_HEIGHT; y++) {
+    registers_.vcount = y;
+    DrawRow();
+  }
+
+  if (GetParam().draws_at_finish) {
+    EXPECT_EQ(1u, backend_pixels_[0u]);
+  }
+
+  GetParam().finish(backend_);
+  EXPECT_EQ(renderer_pixels_, backend_pixels_);
+  EXPECT_EQ(0xFF8410u, backend_pixels_[0u]);
+}
+
+TEST_P(DrawBackendTest, MemoryChangesBetweenRows) {
+  registers_.dispcnt.mode = 3u;
+  registers_.dispcnt.bg2_enable = true;
+  registers_.affine[0u].pa = 0x100;
+  registers_.affine[0u].pd = 0x100;
+
+  for (uint16_t y = 0u; y < GBA_SCREEN_HEIGHT; y++) {
+    registers_.vcount = y;
+    registers_.internal.affine[0u].current[1u] = y << 8u;
+
+    memory_->palette.internal.bg.large_palette[0u] = y;
+    dirty_.palette.palette[0u] = true;
+    if (y % 3u == 0u) {
+      memory_->vram.mode_3.bg.pixels[y][y] = 0x7FFFu;
+      dirty_.vram.bitmap_mode_3 = true;
+    }
+
+    DrawRow();
+  }
+
+  GetParam().finish(backend_);
+  EXPECT_EQ(renderer_pixels_, backend_pixels_);
+  EXPECT_EQ(0xFFFFFFu, backend_pixels_[3u * GBA_SCREEN_WIDTH + 3u]);
+}
+
+TEST_P(DrawBackendTest, FreeWithQueuedRows) {
+  for (uint16_t y = 0u; y < GBA_SCREEN_HEIGHT; y++) {
+    registers_.vcount = y;
+    GetParam().draw_row(backend_, memory_, &registers_, &dirty_);
+  }
+}
+
+INSTANTIATE_TEST_SUITE_P(
+    Backends, DrawBackendTest,
+    testing::Values(kRenderer, kWorker, kOneBand, kThreeBands,
+                    kBandPerProcessor),
+    [](const testing::TestParamInfo<DrawBackend>& info) {
+      return std::string(info.param.name);
+    });
\ No newline at end of file
@@ -0,0 +1,60 @@
+#include "emulator/ppu/gba/software/snapshot.h"
+
+#include <string.h>
+
+void GbaPpuMemoryVersionInitialize(GbaPpuMemoryVersion* version) {
+  for (uint8_t i = 0u; i < GBA_PPU_MEMORY_NUM_SEGMENTS; i++) {
+    version->segments[i] = 1u;
+  }
+}
+
+void GbaPpuMemoryVersionConsumeDirtyBits(GbaPpuMemoryVersion* version,
+                                         GbaPpuDirtyBits* dirty_bits) {
+  if (dirty_bits->palette.palette[0u] || dirty_bits->palette.palette[1u]) {
+    version->segments[GBA_PPU_MEMORY_SEGMENT_PALETTE] += 1u;
+  }
+
+  if (dirty_bits->vram.bitmap_mode_3 || dirty_bits->vram.bitmap_mode_4[0u] ||
+      dirty_bits->vram.bitmap_mode_4[1u] ||
+      dirty_bits->vram.bitmap_mode_5[0u] ||
+      dirty_bits->vram.bitmap_mode_5[1u] || dirty_bits->vram.affine_tilemap ||
+      dirty_bits->vram.scrolling_tilemap || dirty_bits->vram.bg_tiles ||
+      dirty_bits->vram.obj_tiles) {
+    version->segments[GBA_PPU_MEMORY_SEGMENT_VRAM] += 1u;
+  }
+
+  if (dirty_bits->oam.transformations || dirty_bits->oam.attributes) {
+    version->segments[GBA_PPU_MEMORY_SEGMENT_OAM] += 1u;
+  }
+
+  memset(dirty_bits, 0, sizeof(GbaPpuDirtyBits));
+}
+
+bool GbaPpuMemorySnapshotIsCurrent(const GbaPpuMemorySnapshot* snapshot,
+                                   const GbaPpuMemoryVersion* version) {
+  return memcmp(&snapshot->version, version, sizeof(GbaPpuMemoryVersion)) ==
+         0;
+}
+
+void GbaPpuMemorySnapshotUpdate(GbaPpuMemorySnapshot* snapshot,
+                                const GbaPpuMemoryVersion* version,
+                                const GbaPpuMemory* memory) {
+  if (snapshot->version.segments[GBA_PPU_MEMORY_SEGMENT_PALETTE] !=
+      version->segments[GBA_PPU_MEMORY_SEGMENT_PALETTE]) {
+    memcpy(&snapshot->memory.palette, &memory->palette,
+           sizeof(GbaPpuPaletteMemory));
+  }
+
+  if (snapshot->version.segments[GBA_PPU_MEMORY_SEGMENT_VRAM] !=
+      version->segments[GBA_PPU_MEMORY_SEGMENT_VRAM]) {
+    memcpy(&snapshot->memory.vram, &memory->vram, sizeof(GbaPpuVideoMemory));
+  }
+
+  if (snapshot->version.segments[GBA_PPU_MEMORY_SEGMENT_OAM] !=
+      version->segments[GBA_PPU_MEMORY_SEGMENT_OAM]) {
+    memcpy(&snapshot->memory.oam, &memory->oam,
+           sizeof(GbaPpuObjectAttributeMemory));
+  }
+
+  snapshot->version = *version;
+}
\ No newline at end of file
@@ -0,0 +1,38 @@
+#ifndef _WEBGBA_EMULATOR_PPU_GBA_PPU_SOFTWARE_SNAPSHOT_
+#define _WEBGBA_EMULATOR_PPU_GBA_PPU_SOFTWARE_SNAPSHOT_
+
+#include "emulator/ppu/gba/dirty.h"
+#include "emulator/ppu/gba/memory.h"
+
+typedef enum {
+  GBA_PPU_MEMORY_SEGMENT_PALETTE = 0u,
+  GBA_PPU_MEMORY_SEGMENT_VRAM = 1u,
+  GBA_PPU_MEMORY_SEGMENT_OAM = 2u,
+  GBA_PPU_MEMORY_NUM_SEGMENTS = 3u,
+} GbaPpuMemorySegment;
+
+typedef struct {
+  uint32_t segments[GBA_PPU_MEMORY_NUM_SEGMENTS];
+} GbaPpuMemoryVersion;
+
+typedef struct {
+  GbaPpuMemory memory;
+  GbaPpuMemoryVersion version;
+} GbaPpuMemorySnapshot;
+
+// Starts at a version no snapshot matches until it is first updated
+void GbaPpuMemoryVersionInitialize(GbaPpuMemoryVersion* version);
+
+// Bumps the version of each segment marked dirty and clears the dirty bits
+void GbaPpuMemoryVersionConsumeDirtyBits(GbaPpuMemoryVersion* version,
+                                         GbaPpuDirtyBits* dirty_bits);
+
+bool GbaPpuMemorySnapshotIsCurrent(const GbaPpuMemorySnapshot* snapshot,
+                                   const GbaPpuMemoryVersion* version);
+
+// Only copies the segments which are out of date
+void GbaPpuMemorySnapshotUpdate(GbaPpuMemorySnapshot* snapshot,
+                                const GbaPpuMemoryVersion* version,
+                                const GbaPpuMemory* memory);
+
+#endif  // _WEBGBA_EMULATOR_PPU_GBA_PPU_SOFTWARE_SNAPSHOT_
\ No newline at end of file
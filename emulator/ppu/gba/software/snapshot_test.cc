@@ -0,0 +1,76 @@
+extern "C" {
+#include "emulator/ppu/gba/software/snapshot.h"
+}
+
+#include <cstdlib>
+#include <cstring>
+
+#include "googletest/include/gtest/gtest.h"
+
+class SnapshotTest : public testing::Test {
+ public:
+  void SetUp() override {
+    memory_ = (GbaPpuMemory*)calloc(1u, sizeof(GbaPpuMemory));
+    ASSERT_NE(nullptr, memory_);
+    snapshot_ =
+        (GbaPpuMemorySnapshot*)calloc(1u, sizeof(GbaPpuMemorySnapshot));
+    ASSERT_NE(nullptr, snapshot_);
+    memset(&dirty_, 0, sizeof(GbaPpuDirtyBits));
+    GbaPpuMemoryVersionInitialize(&version_);
+  }
+
+  void TearDown() override {
+    free(memory_);
+    free(snapshot_);
+  }
+
+ protected:
+  GbaPpuMemory* memory_;
+  GbaPpuMemorySnapshot* snapshot_;
+  GbaPpuMemoryVersion version_;
+  GbaPpuDirtyBits dirty_;
+};
+
+TEST_F(SnapshotTest, InitiallyStale) {
+  EXPECT_FALSE(GbaPpuMemorySnapshotIsCurrent(snapshot_, &version_));
+
+  memory_->palette.half_words[0u] = 1u;
+  memory_->vram.half_words[0u] = 2u;
+  memory_->oam.half_words[0u] = 3u;
+  GbaPpuMemorySnapshotUpdate(snapshot_, &version_, memory_);
+
+  EXPECT_TRUE(GbaPpuMemorySnapshotIsCurrent(snapshot_, &version_));
+  EXPECT_EQ(1u, snapshot_->memory.palette.half_words[0u]);
+  EXPECT_EQ(2u, snapshot_->memory.vram.half_words[0u]);
+  EXPECT_EQ(3u, snapshot_->memory.oam.half_words[0u]);
+}
+
+TEST_F(SnapshotTest, ConsumeDirtyBits) {
+  GbaPpuMemorySnapshotUpdate(snapshot_, &version_, memory_);
+
+  GbaPpuMemoryVersionConsumeDirtyBits(&version_, &dirty_);
+  EXPECT_TRUE(GbaPpuMemorySnapshotIsCurrent(snapshot_, &version_));
+
+  GbaPpuDirtyBitsAllDirty(&dirty_);
+  GbaPpuMemoryVersionConsumeDirtyBits(&version_, &dirty_);
+  EXPECT_FALSE(GbaPpuMemorySnapshotIsCurrent(snapshot_, &version_));
+
+  GbaPpuDirtyBits clean;
+  memset(&clean, 0, sizeof(GbaPpuDirtyBits));
+  EXPECT_EQ(0, memcmp(&clean, &dirty_, sizeof(GbaPpuDirtyBits)));
+}
+
+TEST_F(SnapshotTest, OnlyCopiesStaleSegments) {
+  GbaPpuMemorySnapshotUpdate(snapshot_, &version_, memory_);
+
+  memory_->palette.half_words[0u] = 1u;
+  memory_->vram.half_words[0u] = 2u;
+  memory_->oam.half_words[0u] = 3u;
+  dirty_.vram.obj_tiles = true;
+  GbaPpuMemoryVersionConsumeDirtyBits(&version_, &dirty_);
+  GbaPpuMemorySnapshotUpdate(snapshot_, &version_, memory_);
+
+  EXPECT_EQ(0u, snapshot_->memory.palette.half_words[0u]);
+  EXPECT_EQ(2u, snapshot_->memory.vram.half_words[0u]);
+  EXPECT_EQ(0u, snapshot_->memory.oam.half_words[0u]);
+}
\ No newline at end of file
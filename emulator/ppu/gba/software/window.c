@@ -1,5 +1,10 @@
 #include "emulator/ppu/gba/software/window.h"
 
+#include <string.h>
+
+#define GBA_PPU_WINDOW_ENABLES_MASK 0xE000u
+#define GBA_PPU_WINDOW_ALL_LAYERS 0x3Fu
+
 static inline bool IsInsideWindow1D(uint_fast8_t lower_bound,
                                     uint_fast8_t upper_bound,
                                     uint_fast8_t value) {
@@ -17,66 +22,132 @@ static inline bool IsInsideWindow2D(const WindowBoundsRegister *winh,
          IsInsideWindow1D(winv->start, winv->end, y);
 }
 
-void GbaPpuWindowCheck(const GbaPpuRegisters *registers, uint_fast8_t x,
-                       uint_fast8_t y, bool on_obj_mask, bool *draw_obj,
-                       bool *draw_bg0, bool *draw_bg1, bool *draw_bg2,
-                       bool *draw_bg3, bool *enable_blending) {
+WindowLayerBits GbaPpuWindowCheck(const GbaPpuRegisters *registers,
+                                  uint_fast8_t x, uint_fast8_t y,
+                                  bool on_obj_mask) {
   bool winout_enabled = false;
   if (registers->dispcnt.win0_enable) {
     winout_enabled = true;
     if (IsInsideWindow2D(&registers->win0h, &registers->win0v, x, y)) {
-      *draw_obj = registers->winin.win0.obj;
-      *draw_bg0 = registers->winin.win0.bg0;
-      *draw_bg1 = registers->winin.win0.bg1;
-      *draw_bg2 = registers->winin.win0.bg2;
-      *draw_bg3 = registers->winin.win0.bg3;
-      *enable_blending = registers->winin.win0.bld;
-      return;
+      return registers->winin.win0;
     }
   }
 
   if (registers->dispcnt.win1_enable) {
     winout_enabled = true;
     if (IsInsideWindow2D(&registers->win1h, &registers->win1v, x, y)) {
-      *draw_obj = registers->winin.win1.obj;
-      *draw_bg0 = registers->winin.win1.bg0;
-      *draw_bg1 = registers->winin.win1.bg1;
-      *draw_bg2 = registers->winin.win1.bg2;
-      *draw_bg3 = registers->winin.win1.bg3;
-      *enable_blending = registers->winin.win1.bld;
-      return;
+      return registers->winin.win1;
     }
   }
 
   if (registers->dispcnt.winobj_enable) {
     winout_enabled = true;
     if (on_obj_mask) {
-      *draw_obj = registers->winout.winobj.obj;
-      *draw_bg0 = registers->winout.winobj.bg0;
-      *draw_bg1 = registers->winout.winobj.bg1;
-      *draw_bg2 = registers->winout.winobj.bg2;
-      *draw_bg3 = registers->winout.winobj.bg3;
-      *enable_blending = registers->winout.winobj.bld;
-      return;
+      return registers->winout.winobj;
     }
   }
 
   // If winout is not enabled, then no windows were enabled in which case all
   // layers should be drawn.
   if (!winout_enabled) {
-    *draw_obj = true;
-    *draw_bg0 = true;
-    *draw_bg1 = true;
-    *draw_bg2 = true;
-    *draw_bg3 = true;
-    *enable_blending = true;
+    WindowLayerBits result;
+    result.value = GBA_PPU_WINDOW_ALL_LAYERS;
+    return result;
+  }
+
+  return registers->winout.winout;
+}
+
+static void GbaPpuWindowLineFill(const WindowBoundsRegister *winh,
+                                 WindowLayerBits layers,
+                                 GbaPpuWindowLine *line) {
+  uint_fast8_t start = winh->start;
+  uint_fast8_t end = winh->end;
+  if (end > GBA_SCREEN_WIDTH) {
+    end = GBA_SCREEN_WIDTH;
+  }
+
+  if (winh->end < start) {
+    for (uint_fast8_t x = 0u; x < end; x++) {
+      line->cache.layers[x] = layers;
+      line->cache.outside[x] = false;
+    }
+    end = GBA_SCREEN_WIDTH;
+  }
+
+  for (uint_fast8_t x = start; x < end; x++) {
+    line->cache.layers[x] = layers;
+    line->cache.outside[x] = false;
+  }
+}
+
+static void GbaPpuWindowLineUpdateCache(const GbaPpuRegisters *registers,
+                                        uint_fast8_t y,
+                                        GbaPpuWindowLine *line) {
+  uint16_t window_enables =
+      registers->dispcnt.value & GBA_PPU_WINDOW_ENABLES_MASK;
+  bool inside_win0_vertical =
+      registers->dispcnt.win0_enable &&
+      IsInsideWindow1D(registers->win0v.start, registers->win0v.end, y);
+  bool inside_win1_vertical =
+      registers->dispcnt.win1_enable &&
+      IsInsideWindow1D(registers->win1v.start, registers->win1v.end, y);
+
+  // The spans only depend on the window registers and which windows
+  // vertically overlap the line, so most lines reuse the previous result.
+  if (line->cache.valid && line->cache.window_enables == window_enables &&
+      line->cache.inside_win0_vertical == inside_win0_vertical &&
+      line->cache.inside_win1_vertical == inside_win1_vertical &&
+      line->cache.win0h == registers->win0h.value &&
+      line->cache.win1h == registers->win1h.value &&
+      line->cache.winin == registers->winin.value &&
+      line->cache.winout == registers->winout.value) {
     return;
   }
 
-  *draw_obj = registers->winout.winout.obj;
-  *draw_bg0 = registers->winout.winout.bg0;
-  *draw_bg1 = registers->winout.winout.bg1;
-  *draw_bg2 = registers->winout.winout.bg2;
-  *draw_bg3 = registers->winout.winout.bg3;
-  *enable_blending = registers->winout.winout.bld;
+  line->cache.valid = true;
+  line->cache.window_enables = window_enables;
+  line->cache.inside_win0_vertical = inside_win0_vertical;
+  line->cache.inside_win1_vertical = inside_win1_vertical;
+  line->cache.win0h = registers->win0h.value;
+  line->cache.win1h = registers->win1h.value;
+  line->cache.winin = registers->winin.value;
+  line->cache.winout = registers->winout.value;
+
+  WindowLayerBits outside;
+  if (window_enables) {
+    outside = registers->winout.winout;
+  } else {
+    outside.value = GBA_PPU_WINDOW_ALL_LAYERS;
+  }
+
+  memset(line->cache.layers, outside.value, sizeof(line->cache.layers));
+  memset(line->cache.outside, true, sizeof(line->cache.outside));
+
+  // WIN0 takes priority over WIN1 so it is filled in last
+  if (inside_win1_vertical) {
+    GbaPpuWindowLineFill(&registers->win1h, registers->winin.win1, line);
+  }
+
+  if (inside_win0_vertical) {
+    GbaPpuWindowLineFill(&registers->win0h, registers->winin.win0, line);
+  }
+}
+
+void GbaPpuWindowLineDraw(const GbaPpuRegisters *registers, uint_fast8_t y,
+                          const bool on_obj_mask[GBA_SCREEN_WIDTH],
+                          GbaPpuWindowLine *line) {
+  GbaPpuWindowLineUpdateCache(registers, y, line);
+
+  memcpy(line->layers, line->cache.layers, sizeof(line->layers));
+
+  if (!registers->dispcnt.winobj_enable || on_obj_mask == NULL) {
+    return;
+  }
+
+  for (uint_fast8_t x = 0u; x < GBA_SCREEN_WIDTH; x++) {
+    if (line->cache.outside[x] && on_obj_mask[x]) {
+      line->layers[x] = registers->winout.winobj;
+    }
+  }
 }
\ No newline at end of file
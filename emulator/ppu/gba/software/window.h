@@ -1,11 +1,32 @@
 #ifndef _WEBGBA_EMULATOR_PPU_GBA_PPU_SOFTWARE_WINDOW_
 #define _WEBGBA_EMULATOR_PPU_GBA_PPU_SOFTWARE_WINDOW_
 
+#include "emulator/ppu/gba/memory.h"
 #include "emulator/ppu/gba/registers.h"
 
-void GbaPpuWindowCheck(const GbaPpuRegisters *registers, uint_fast8_t x,
-                       uint_fast8_t y, bool on_obj_mask, bool *draw_obj,
-                       bool *draw_bg0, bool *draw_bg1, bool *draw_bg2,
-                       bool *draw_bg3, bool *enable_blending);
+typedef struct {
+  WindowLayerBits layers[GBA_SCREEN_WIDTH];
+  struct {
+    bool valid;
+    uint16_t window_enables;
+    bool inside_win0_vertical;
+    bool inside_win1_vertical;
+    uint16_t win0h;
+    uint16_t win1h;
+    uint16_t winin;
+    uint16_t winout;
+    WindowLayerBits layers[GBA_SCREEN_WIDTH];
+    bool outside[GBA_SCREEN_WIDTH];
+  } cache;
+} GbaPpuWindowLine;
+
+WindowLayerBits GbaPpuWindowCheck(const GbaPpuRegisters *registers,
+                                  uint_fast8_t x, uint_fast8_t y,
+                                  bool on_obj_mask);
+
+// on_obj_mask may be NULL if objects are disabled
+void GbaPpuWindowLineDraw(const GbaPpuRegisters *registers, uint_fast8_t y,
+                          const bool on_obj_mask[GBA_SCREEN_WIDTH],
+                          GbaPpuWindowLine *line);
 
 #endif  // _WEBGBA_EMULATOR_PPU_GBA_PPU_SOFTWARE_WINDOW_
\ No newline at end of file
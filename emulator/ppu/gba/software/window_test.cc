@@ -0,0 +1,96 @@
+extern "C" {
+#include "emulator/ppu/gba/software/window.h"
+}
+
+#include <cstdlib>
+#include <cstring>
+
+#include "googletest/include/gtest/gtest.h"
+
+class WindowTest : public testing::Test {
+ public:
+  void SetUp() override {
+    memset(&registers_, 0, sizeof(GbaPpuRegisters));
+    memset(&line_, 0, sizeof(GbaPpuWindowLine));
+    for (uint_fast8_t x = 0u; x < GBA_SCREEN_WIDTH; x++) {
+      on_obj_mask_[x] = (x / 7u) % 2u;
+    }
+  }
+
+ protected:
+  void ExpectLineMatchesCheck(uint_fast8_t y) {
+    GbaPpuWindowLineDraw(&registers_, y, on_obj_mask_, &line_);
+    for (uint_fast8_t x = 0u; x < GBA_SCREEN_WIDTH; x++) {
+      ASSERT_EQ(GbaPpuWindowCheck(&registers_, x, y, on_obj_mask_[x]).value,
+                line_.layers[x].value)
+          << "x " << (int)x << " y " << (int)y;
+    }
+  }
+
+  GbaPpuRegisters registers_;
+  GbaPpuWindowLine line_;
+  bool on_obj_mask_[GBA_SCREEN_WIDTH];
+};
+
+TEST_F(WindowTest, NoWindows) {
+  GbaPpuWindowLineDraw(&registers_, 0u, on_obj_mask_, &line_);
+  for (uint_fast8_t x = 0u; x < GBA_SCREEN_WIDTH; x++) {
+    EXPECT_EQ(0x3Fu, line_.layers[x].value);
+  }
+}
+
+TEST_F(WindowTest, Win0) {
+  registers_.dispcnt.win0_enable = true;
+  registers_.win0h.start = 10u;
+  registers_.win0h.end = 20u;
+  registers_.win0v.start = 5u;
+  registers_.win0v.end = 6u;
+  registers_.winin.win0.bg1 = true;
+  registers_.winout.winout.obj = true;
+
+  GbaPpuWindowLineDraw(&registers_, 5u, on_obj_mask_, &line_);
+  EXPECT_EQ(0x10u, line_.layers[9u].value);
+  EXPECT_EQ(0x02u, line_.layers[10u].value);
+  EXPECT_EQ(0x02u, line_.layers[19u].value);
+  EXPECT_EQ(0x10u, line_.layers[20u].value);
+
+  GbaPpuWindowLineDraw(&registers_, 6u, on_obj_mask_, &line_);
+  EXPECT_EQ(0x10u, line_.layers[10u].value);
+}
+
+TEST_F(WindowTest, WraparoundAndObjectWindow) {
+  registers_.dispcnt.win1_enable = true;
+  registers_.dispcnt.winobj_enable = true;
+  registers_.win1h.start = 200u;
+  registers_.win1h.end = 30u;
+  registers_.win1v.start = 150u;
+  registers_.win1v.end = 10u;
+  registers_.winin.win1.bld = true;
+  registers_.winout.winobj.bg3 = true;
+
+  GbaPpuWindowLineDraw(&registers_, 0u, on_obj_mask_, &line_);
+  EXPECT_EQ(0x20u, line_.layers[0u].value);
+  EXPECT_EQ(0x20u, line_.layers[29u].value);
+  EXPECT_EQ(0x08u, line_.layers[35u].value);
+  EXPECT_EQ(0x00u, line_.layers[42u].value);
+  EXPECT_EQ(0x20u, line_.layers[200u].value);
+
+  GbaPpuWindowLineDraw(&registers_, 0u, nullptr, &line_);
+  EXPECT_EQ(0x00u, line_.layers[35u].value);
+}
+
+TEST_F(WindowTest, MatchesCheck) {
+  srand(0u);
+  for (uint32_t i = 0u; i < 2000u; i++) {
+    registers_.dispcnt.value = rand() & 0xE000u;
+    registers_.winin.value = rand();
+    registers_.winout.value = rand();
+    registers_.win0h.value = rand();
+    registers_.win1h.value = rand();
+    registers_.win0v.value = rand();
+    registers_.win1v.value = rand();
+    for (uint_fast8_t y = 0u; y < GBA_SCREEN_HEIGHT; y += 13u) {
+      ExpectLineMatchesCheck(y);
+    }
+  }
+}
\ No newline at end of file
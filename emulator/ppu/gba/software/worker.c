@@ -0,0 +1,214 @@
+#include "emulator/ppu/gba/software/worker.h"
+
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "emulator/ppu/gba/software/render.h"
+#include "emulator/ppu/gba/software/snapshot.h"
+
+#define GBA_PPU_WORKER_NUM_SNAPSHOTS 4u
+#define GBA_PPU_WORKER_QUEUE_SIZE GBA_SCREEN_HEIGHT
+
+typedef struct {
+  GbaPpuMemorySnapshot snapshot;
+  atomic_uint pending_rows;
+} GbaPpuWorkerSnapshot;
+
+typedef struct {
+  GbaPpuRegisters registers;
+  uint8_t snapshot;
+} GbaPpuWorkerRow;
+
+struct _GbaPpuSoftwareWorker {
+  GbaPpuSoftwareRenderer* renderer;
+  GbaPpuWorkerSnapshot snapshots[GBA_PPU_WORKER_NUM_SNAPSHOTS];
+  GbaPpuWorkerRow rows[GBA_PPU_WORKER_QUEUE_SIZE];
+  GbaPpuMemoryVersion version;
+  uint8_t current_snapshot;
+  atomic_size_t head;  // Only written by the emulation thread
+  atomic_size_t tail;  // Only written by the render thread
+  atomic_bool sleeping;
+  bool exit;
+  bool threaded;
+  pthread_t thread;
+  pthread_mutex_t lock;
+  pthread_cond_t work_available;
+  pthread_cond_t idle;
+};
+
+static void* GbaPpuSoftwareWorkerMain(void* context) {
+  GbaPpuSoftwareWorker* worker = (GbaPpuSoftwareWorker*)context;
+
+  // Rows are drawn from snapshots that the renderer reads in full, so no
+  // writes are reported to it
+  GbaPpuDirtyBits dirty_bits;
+  memset(&dirty_bits, 0, sizeof(GbaPpuDirtyBits));
+  size_t tail = 0u;
+  for (;;) {
+    if (tail == atomic_load(&worker->head)) {
+      pthread_mutex_lock(&worker->lock);
+      atomic_store(&worker->sleeping, true);
+      while (!worker->exit && tail == atomic_load(&worker->head)) {
+        pthread_cond_broadcast(&worker->idle);
+        pthread_cond_wait(&worker->work_available, &worker->lock);
+      }
+      atomic_store(&worker->sleeping, false);
+      bool exit = worker->exit;
+      pthread_mutex_unlock(&worker->lock);
+
+      if (exit) {
+        break;
+      }
+
+      continue;
+    }
+
+    const GbaPpuWorkerRow* row =
+        &worker->rows[tail % GBA_PPU_WORKER_QUEUE_SIZE];
+    GbaPpuWorkerSnapshot* snapshot = &worker->snapshots[row->snapshot];
+    GbaPpuSoftwareRendererDrawRow(worker->renderer, &snapshot->snapshot.memory,
+                                  &row->registers, &dirty_bits);
+    atomic_fetch_sub_explicit(&snapshot->pending_rows, 1u,
+                              memory_order_release);
+
+    tail += 1u;
+    atomic_store_explicit(&worker->tail, tail, memory_order_release);
+  }
+
+  return NULL;
+}
+
+static uint8_t GbaPpuSoftwareWorkerAcquireSnapshot(
+    GbaPpuSoftwareWorker* worker) {
+  for (;;) {
+    // Starting with the current snapshot minimizes the amount of copying
+    for (uint8_t i = 0u; i < GBA_PPU_WORKER_NUM_SNAPSHOTS; i++) {
+      uint8_t index =
+          (worker->current_snapshot + i) % GBA_PPU_WORKER_NUM_SNAPSHOTS;
+      if (atomic_load_explicit(&worker->snapshots[index].pending_rows,
+                               memory_order_acquire) == 0u) {
+        return index;
+      }
+    }
+
+    GbaPpuSoftwareWorkerFinish(worker);
+  }
+}
+
+GbaPpuSoftwareWorker* GbaPpuSoftwareWorkerAllocate() {
+  GbaPpuSoftwareWorker* worker = calloc(1u, sizeof(GbaPpuSoftwareWorker));
+  if (worker == NULL) {
+    return NULL;
+  }
+
+  worker->renderer = GbaPpuSoftwareRendererAllocate();
+  if (worker->renderer == NULL) {
+    free(worker);
+    return NULL;
+  }
+
+  for (uint8_t i = 0u; i < GBA_PPU_WORKER_NUM_SNAPSHOTS; i++) {
+    atomic_init(&worker->snapshots[i].pending_rows, 0u);
+  }
+
+  GbaPpuMemoryVersionInitialize(&worker->version);
+
+  atomic_init(&worker->head, 0u);
+  atomic_init(&worker->tail, 0u);
+  atomic_init(&worker->sleeping, false);
+
+  pthread_mutex_init(&worker->lock, NULL);
+  pthread_cond_init(&worker->work_available, NULL);
+  pthread_cond_init(&worker->idle, NULL);
+
+  // Rows are drawn synchronously if threads are unavailable
+  worker->threaded = pthread_create(&worker->thread, NULL,
+                                    GbaPpuSoftwareWorkerMain, worker) == 0;
+
+  return worker;
+}
+
+bool GbaPpuSoftwareWorkerSetScreen(GbaPpuSoftwareWorker* worker,
+                                   Screen* screen) {
+  GbaPpuSoftwareWorkerFinish(worker);
+  return GbaPpuSoftwareRendererSetScreen(worker->renderer, screen);
+}
+
+void GbaPpuSoftwareWorkerDrawRow(GbaPpuSoftwareWorker* worker,
+                                 const GbaPpuMemory* memory,
+                                 const GbaPpuRegisters* registers,
+                                 GbaPpuDirtyBits* dirty_bits) {
+  if (!worker->threaded) {
+    GbaPpuSoftwareRendererDrawRow(worker->renderer, memory, registers,
+                                  dirty_bits);
+    return;
+  }
+
+  GbaPpuMemoryVersionConsumeDirtyBits(&worker->version, dirty_bits);
+  if (!GbaPpuMemorySnapshotIsCurrent(
+          &worker->snapshots[worker->current_snapshot].snapshot,
+          &worker->version)) {
+    worker->current_snapshot = GbaPpuSoftwareWorkerAcquireSnapshot(worker);
+    GbaPpuMemorySnapshotUpdate(
+        &worker->snapshots[worker->current_snapshot].snapshot,
+        &worker->version, memory);
+  }
+
+  size_t head = atomic_load_explicit(&worker->head, memory_order_relaxed);
+  if (head - atomic_load_explicit(&worker->tail, memory_order_acquire) ==
+      GBA_PPU_WORKER_QUEUE_SIZE) {
+    GbaPpuSoftwareWorkerFinish(worker);
+  }
+
+  GbaPpuWorkerRow* row = &worker->rows[head % GBA_PPU_WORKER_QUEUE_SIZE];
+  row->registers = *registers;
+  row->snapshot = worker->current_snapshot;
+  atomic_fetch_add_explicit(
+      &worker->snapshots[worker->current_snapshot].pending_rows, 1u,
+      memory_order_relaxed);
+
+  atomic_store(&worker->head, head + 1u);
+  if (atomic_load(&worker->sleeping)) {
+    pthread_mutex_lock(&worker->lock);
+    pthread_cond_signal(&worker->work_available);
+    pthread_mutex_unlock(&worker->lock);
+  }
+}
+
+void GbaPpuSoftwareWorkerFinish(GbaPpuSoftwareWorker* worker) {
+  if (!worker->threaded) {
+    return;
+  }
+
+  size_t head = atomic_load_explicit(&worker->head, memory_order_relaxed);
+  if (atomic_load_explicit(&worker->tail, memory_order_acquire) == head) {
+    return;
+  }
+
+  pthread_mutex_lock(&worker->lock);
+  while (atomic_load_explicit(&worker->tail, memory_order_acquire) != head) {
+    pthread_cond_wait(&worker->idle, &worker->lock);
+  }
+  pthread_mutex_unlock(&worker->lock);
+}
+
+void GbaPpuSoftwareWorkerFree(GbaPpuSoftwareWorker* worker) {
+  if (worker->threaded) {
+    GbaPpuSoftwareWorkerFinish(worker);
+
+    pthread_mutex_lock(&worker->lock);
+    worker->exit = true;
+    pthread_cond_signal(&worker->work_available);
+    pthread_mutex_unlock(&worker->lock);
+
+    pthread_join(worker->thread, NULL);
+  }
+
+  pthread_cond_destroy(&worker->idle);
+  pthread_cond_destroy(&worker->work_available);
+  pthread_mutex_destroy(&worker->lock);
+  GbaPpuSoftwareRendererFree(worker->renderer);
+  free(worker);
+}
\ No newline at end of file
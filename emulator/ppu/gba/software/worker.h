@@ -0,0 +1,31 @@
+#ifndef _WEBGBA_EMULATOR_PPU_GBA_PPU_SOFTWARE_WORKER_
+#define _WEBGBA_EMULATOR_PPU_GBA_PPU_SOFTWARE_WORKER_
+
+#include "emulator/ppu/gba/dirty.h"
+#include "emulator/ppu/gba/memory.h"
+#include "emulator/ppu/gba/registers.h"
+#include "emulator/screen.h"
+
+// Draws rows with the software renderer on a dedicated thread. Each row is
+// queued along with a copy of the registers and a reference to a snapshot of
+// PPU memory which is only copied again once the dirty bits show a write.
+typedef struct _GbaPpuSoftwareWorker GbaPpuSoftwareWorker;
+
+GbaPpuSoftwareWorker* GbaPpuSoftwareWorkerAllocate();
+
+// Waits for all queued rows to be drawn before changing the screen
+bool GbaPpuSoftwareWorkerSetScreen(GbaPpuSoftwareWorker* worker,
+                                   Screen* screen);
+
+// Consumes the dirty bits
+void GbaPpuSoftwareWorkerDrawRow(GbaPpuSoftwareWorker* worker,
+                                 const GbaPpuMemory* memory,
+                                 const GbaPpuRegisters* registers,
+                                 GbaPpuDirtyBits* dirty_bits);
+
+// Waits for all queued rows to be drawn
+void GbaPpuSoftwareWorkerFinish(GbaPpuSoftwareWorker* worker);
+
+void GbaPpuSoftwareWorkerFree(GbaPpuSoftwareWorker* worker);
+
+#endif  // _WEBGBA_EMULATOR_PPU_GBA_PPU_SOFTWARE_WORKER_
\ No newline at end of file
@@ -1,7 +1,8 @@
 #include "emulator/ppu/gba/vram/vram.h"
 
 #include <assert.h>
-#include <stdlib.h>
+
+#include "emulator/arena.h"
 
 #define BITMAP_MODE_3_SIZE_BYTES \
   (GBA_SCREEN_WIDTH * GBA_SCREEN_HEIGHT * sizeof(uint16_t))
@@ -148,13 +149,13 @@ static bool VRamStore8(void *context, uint32_t address, uint8_t value) {
 static void VRamFree(void *context) {
   GbaPpuVRam *vram = (GbaPpuVRam *)context;
   vram->free_routine(vram->free_address);
-  free(vram);
+  ArenaFreeAllocation(vram);
 }
 
 Memory *VRamAllocate(GbaPpuVideoMemory *video_memory,
                      GbaPpuVramDirtyBits *dirty, MemoryContextFree free_routine,
                      void *free_address) {
-  GbaPpuVRam *vram = (GbaPpuVRam *)malloc(sizeof(GbaPpuVRam));
+  GbaPpuVRam *vram = (GbaPpuVRam *)ArenaCalloc(1u, sizeof(GbaPpuVRam));
   if (vram == NULL) {
     return NULL;
   }
@@ -168,7 +169,7 @@ Memory *VRamAllocate(GbaPpuVideoMemory *video_memory,
       MemoryAllocate(vram, VRamLoad32LE, VRamLoad16LE, VRamLoad8, VRamStore32LE,
                      VRamStore16LE, VRamStore8, VRamFree);
   if (result == NULL) {
-    free(vram);
+    ArenaFreeAllocation(vram);
     return NULL;
   }
 
@@ -7,7 +7,8 @@
 typedef enum _RenderMode {
   RENDER_MODE_DIRECT = 0,
   RENDER_MODE_SOFTWARE = 1,
-  RENDER_MODE_HARDWARE = 2
+  RENDER_MODE_HARDWARE = 2,
+  RENDER_MODE_EXTERNAL = 3
 } RenderMode;
 
 struct _Screen {
@@ -28,6 +29,9 @@ struct _Screen {
   GLuint upscale_pixels;
   GLint upscale_pixels_image;
   GLint upscale_pixels_texscale;
+  ScreenPixelBuffer external_pixels;
+  GLsizei external_pixels_width;
+  GLsizei external_pixels_height;
 };
 
 static GLuint ScreenCreateUpscalePixels() {
@@ -163,30 +167,64 @@ void ScreenAttachFramebuffer(Screen *screen, GLuint framebuffer, GLsizei width,
   screen->framebuffer_height = height;
 }
 
-uint8_t *ScreenGetPixelBuffer(Screen *screen, GLsizei width, GLsizei height) {
+void ScreenAttachPixelBuffer(Screen *screen, void *pixels, GLsizei width,
+                             GLsizei height, ScreenPixelFormat format,
+                             size_t pitch, bool bottom_up) {
+  if (pixels == NULL) {
+    screen->external_pixels.pixels = NULL;
+    screen->external_pixels_width = 0;
+    screen->external_pixels_height = 0;
+    return;
+  }
+
+  screen->external_pixels.pixels = pixels;
+  screen->external_pixels.pitch = pitch;
+  screen->external_pixels.format = format;
+  screen->external_pixels_width = width;
+  screen->external_pixels_height = height;
+
+  if (bottom_up) {
+    screen->external_pixels.pixels += (height - 1) * pitch;
+    screen->external_pixels.pitch = -screen->external_pixels.pitch;
+  }
+}
+
+bool ScreenGetPixelBuffer(Screen *screen, GLsizei width, GLsizei height,
+                          ScreenPixelBuffer *buffer) {
   assert(width != 0 && height != 0);
 
+  if (screen->external_pixels.pixels != NULL &&
+      screen->external_pixels_width == width &&
+      screen->external_pixels_height == height) {
+    screen->render_mode = RENDER_MODE_EXTERNAL;
+    *buffer = screen->external_pixels;
+    return true;
+  }
+
   screen->pixels_staging_index = (screen->pixels_staging_index + 1u) % 2u;
   screen->render_mode = RENDER_MODE_SOFTWARE;
 
-  if (screen->pixels_width == width && screen->pixels_height == height) {
-    return screen->subpixels;
-  }
+  if (screen->pixels_width != width || screen->pixels_height != height) {
+    void *new_buffer =
+        realloc(screen->subpixels, 3u * sizeof(uint8_t) * width * height);
 
-  void *new_buffer =
-      realloc(screen->subpixels, 3u * sizeof(uint8_t) * width * height);
+    if (new_buffer == NULL) {
+      return false;
+    }
 
-  if (new_buffer == NULL) {
-    return NULL;
-  }
+    screen->subpixels = new_buffer;
 
-  screen->subpixels = new_buffer;
+    screen->pixels_width = width;
+    screen->pixels_height = height;
+    ScreenAllocateStaging(screen);
+  }
 
-  screen->pixels_width = width;
-  screen->pixels_height = height;
-  ScreenAllocateStaging(screen);
+  // OpenGL textures are uploaded starting from the bottom row
+  buffer->pixels = screen->subpixels + 3u * width * (height - 1);
+  buffer->pitch = -3 * (ptrdiff_t)width;
+  buffer->format = SCREEN_PIXEL_FORMAT_RGB888;
 
-  return screen->subpixels;
+  return true;
 }
 
 GLuint ScreenGetFrameBuffer(Screen *screen, GLsizei width, GLsizei height,
@@ -229,6 +267,7 @@ void ScreenClear(const Screen *screen) {
 
 void ScreenRenderToFramebuffer(const Screen *screen, bool lock_aspect_ratio) {
   if (screen->render_mode == RENDER_MODE_DIRECT ||
+      screen->render_mode == RENDER_MODE_EXTERNAL ||
       screen->framebuffer_height == 0u || screen->framebuffer_width == 0u) {
     return;
   }
@@ -3,16 +3,37 @@
 
 #include <GLES3/gl3.h>
 #include <stdbool.h>
+#include <stddef.h>
 #include <stdint.h>
 
 typedef struct _Screen Screen;
 
+typedef enum {
+  SCREEN_PIXEL_FORMAT_RGB888,    // Three bytes per pixel in R, G, B order
+  SCREEN_PIXEL_FORMAT_XRGB8888,  // Native endian uint32_t per pixel
+  SCREEN_PIXEL_FORMAT_RGB565,    // Native endian uint16_t per pixel
+} ScreenPixelFormat;
+
+typedef struct {
+  uint8_t *pixels;  // First pixel of the top row
+  ptrdiff_t pitch;  // Bytes from one row to the next, negative if bottom up
+  ScreenPixelFormat format;
+} ScreenPixelBuffer;
+
 Screen *ScreenAllocate();
 
 void ScreenAttachFramebuffer(Screen *screen, GLuint framebuffer, GLsizei width,
                              GLsizei height);
 
-uint8_t *ScreenGetPixelBuffer(Screen *screen, GLsizei width, GLsizei height);
+// Software renderers write directly into an attached pixel buffer of
+// matching size instead of into the screen's OpenGL staging buffer. The buffer
+// must remain valid until it is detached by passing NULL.
+void ScreenAttachPixelBuffer(Screen *screen, void *pixels, GLsizei width,
+                             GLsizei height, ScreenPixelFormat format,
+                             size_t pitch, bool bottom_up);
+
+bool ScreenGetPixelBuffer(Screen *screen, GLsizei width, GLsizei height,
+                          ScreenPixelBuffer *buffer);
 
 GLuint ScreenGetFrameBuffer(Screen *screen, GLsizei width, GLsizei height,
                             bool new_framebuffer);
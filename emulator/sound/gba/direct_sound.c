@@ -43,6 +43,15 @@ bool DirectSoundChannelPop(DirectSoundChannel* channel, int8_t* value) {
   return channel->num_samples <= LOW_WATER_MARK;
 }
 
+uint_fast8_t DirectSoundChannelPopsUntilRefill(
+    const DirectSoundChannel* channel) {
+  if (channel->num_samples <= LOW_WATER_MARK + 1) {
+    return 1u;
+  }
+
+  return channel->num_samples - LOW_WATER_MARK;
+}
+
 void DirectSoundChannelClear(DirectSoundChannel* channel) {
   channel->front_index = 0u;
   channel->num_samples = 0u;
@@ -27,6 +27,10 @@ void DirectSoundChannelPushFour(DirectSoundChannel* channel,
 
 bool DirectSoundChannelPop(DirectSoundChannel* channel, int8_t* value);
 
+// The number of pops up to and including the first that requests a refill
+uint_fast8_t DirectSoundChannelPopsUntilRefill(
+    const DirectSoundChannel* channel);
+
 void DirectSoundChannelClear(DirectSoundChannel* channel);
 
 #endif  // _WEBGBA_EMULATOR_SOUND_GBA_DIRECT_SOUND_
\ No newline at end of file
@@ -195,6 +195,24 @@ TEST_F(DirectSoundTest, RepeatedPushAndPops) {
 }
 */
 
+TEST_F(DirectSoundTest, PopsUntilRefill) {
+  EXPECT_EQ(1u, DirectSoundChannelPopsUntilRefill(&channel_));
+
+  for (int8_t i = 1; i <= 20; i++) {
+    DirectSoundChannelPush(&channel_, i);
+  }
+
+  EXPECT_EQ(4u, DirectSoundChannelPopsUntilRefill(&channel_));
+
+  int8_t value;
+  EXPECT_FALSE(DirectSoundChannelPop(&channel_, &value));
+  EXPECT_FALSE(DirectSoundChannelPop(&channel_, &value));
+  EXPECT_FALSE(DirectSoundChannelPop(&channel_, &value));
+  EXPECT_EQ(1u, DirectSoundChannelPopsUntilRefill(&channel_));
+  EXPECT_TRUE(DirectSoundChannelPop(&channel_, &value));
+  EXPECT_EQ(1u, DirectSoundChannelPopsUntilRefill(&channel_));
+}
+
 TEST_F(DirectSoundTest, PushTwo) {
   DirectSoundChannelPushTwo(&channel_, 0x2211);
 
@@ -1,8 +1,9 @@
 #include "emulator/sound/gba/sound.h"
 
 #include <assert.h>
-#include <stdlib.h>
+#include <string.h>
 
+#include "emulator/arena.h"
 #include "emulator/sound/gba/direct_sound.h"
 
 #define GBA_SPU_CYCLES_PER_AUDIO_SAMPLE 128u
@@ -239,6 +240,8 @@ typedef union {
 } GbaSpuRegisters;
 
 struct _GbaSpu {
+  GbaSpuRenderAudioSample audio_sample_callback;
+  uint32_t pending_cycles;
   uint32_t cycle_counter;
   uint32_t fifo_counter;
   int8_t current_fifo_a;
@@ -247,11 +250,113 @@ struct _GbaSpu {
   int8_t last_fifo_b;
   GbaSpuRegisters registers;
   GbaDmaUnit *dma_unit;
+  GbaSpuTimerSyncFunction timer_sync;
+  void *timer_sync_context;
   DirectSoundChannel direct_sound_a;
   DirectSoundChannel direct_sound_b;
   uint16_t reference_count;
 };
 
+static void GbaSpuMix(const GbaSpu *spu, int16_t *left_out,
+                      int16_t *right_out) {
+  int16_t left = spu->registers.soundbias.level;
+  int16_t right = spu->registers.soundbias.level;
+
+  if (spu->registers.soundcnt_x.fifo_master_enable) {
+    int16_t fifo_a = (int16_t)spu->current_fifo_a
+                     << spu->registers.soundcnt_h.dma_sound_a_volume;
+    if (spu->registers.soundcnt_h.dma_sound_a_left_enabled) {
+      left += fifo_a;
+    }
+
+    if (spu->registers.soundcnt_h.dma_sound_a_right_enabled) {
+      right += fifo_a;
+    }
+
+    int16_t fifo_b = (int16_t)spu->current_fifo_b
+                     << spu->registers.soundcnt_h.dma_sound_b_volume;
+
+    if (spu->registers.soundcnt_h.dma_sound_b_left_enabled) {
+      left += fifo_b;
+    }
+
+    if (spu->registers.soundcnt_h.dma_sound_b_right_enabled) {
+      right += fifo_b;
+    }
+  }
+
+  if (left < 0) {
+    left = 0;
+  } else if (left > 0x3FF) {
+    left = 0x3FF;
+  }
+
+  if (right < 0) {
+    right = 0;
+  } else if (right > 0x3FF) {
+    right = 0x3FF;
+  }
+
+  left -= 0x200u;
+  right -= 0x200u;
+
+  switch (spu->registers.soundbias.level) {
+    case 1:
+      left &= 0xFFFE;
+      right &= 0xFFFE;
+      break;
+    case 2:
+      left &= 0xFFFC;
+      right &= 0xFFFC;
+      break;
+    case 3:
+      left &= 0xFFF8;
+      right &= 0xFFF8;
+      break;
+  }
+
+  *left_out = left << 5;
+  *right_out = right << 5;
+}
+
+// Synthesizes the samples for all of the cycles that have elapsed. This must
+// be called before any state that affects the output is changed.
+static void GbaSpuCatchUp(GbaSpu *spu) {
+  if (spu->pending_cycles == 0u) {
+    return;
+  }
+
+  uint32_t cycles = spu->cycle_counter + spu->pending_cycles;
+  uint32_t num_samples = cycles / GBA_SPU_CYCLES_PER_AUDIO_SAMPLE;
+  spu->cycle_counter = cycles % GBA_SPU_CYCLES_PER_AUDIO_SAMPLE;
+  spu->pending_cycles = 0u;
+
+  if (num_samples == 0u) {
+    return;
+  }
+
+  // The output only changes when the FIFO samples are latched
+  int16_t left, right;
+  GbaSpuMix(spu, &left, &right);
+  for (uint32_t i = 0u; i < num_samples; i++) {
+    spu->fifo_counter += 1u;
+    if (spu->fifo_counter == GBA_SPU_AUDIO_SAMPLES_PER_FIFO_SAMPLE) {
+      spu->current_fifo_a = spu->last_fifo_a;
+      spu->current_fifo_b = spu->last_fifo_b;
+      spu->fifo_counter = 0u;
+      GbaSpuMix(spu, &left, &right);
+    }
+
+    spu->audio_sample_callback(left, right);
+  }
+}
+
+static void GbaSpuSyncTimers(GbaSpu *spu) {
+  if (spu->timer_sync != NULL) {
+    spu->timer_sync(spu->timer_sync_context);
+  }
+}
+
 static bool GbaSpuRegistersLoad16LE(const void *context, uint32_t address,
                                     uint16_t *value) {
   assert((address & 0x1u) == 0u);
@@ -374,6 +479,8 @@ static bool GbaSpuRegistersStore16LE(void *context, uint32_t address,
 
   GbaSpu *spu = (GbaSpu *)context;
 
+  GbaSpuSyncTimers(spu);
+
   switch (address) {
     case FIFO_A_LL_OFFSET:
     case FIFO_A_HL_OFFSET:
@@ -385,6 +492,8 @@ static bool GbaSpuRegistersStore16LE(void *context, uint32_t address,
       return true;
   }
 
+  GbaSpuCatchUp(spu);
+
   spu->registers.half_words[address >> 1u] = value;
 
   if (!spu->registers.soundcnt_x.fifo_master_enable) {
@@ -417,9 +526,11 @@ static bool GbaSpuRegistersStore32LE(void *context, uint32_t address,
 
   switch (address) {
     case FIFO_A_LL_OFFSET:
+      GbaSpuSyncTimers(spu);
       DirectSoundChannelPushFour(&spu->direct_sound_a, value);
       return true;
     case FIFO_B_LL_OFFSET:
+      GbaSpuSyncTimers(spu);
       DirectSoundChannelPushFour(&spu->direct_sound_b, value);
       return true;
   }
@@ -439,12 +550,14 @@ static bool GbaSpuRegistersStore8(void *context, uint32_t address,
     case FIFO_A_LH_OFFSET:
     case FIFO_A_HL_OFFSET:
     case FIFO_A_HH_OFFSET:
+      GbaSpuSyncTimers(spu);
       DirectSoundChannelPush(&spu->direct_sound_a, value);
       return true;
     case FIFO_B_LL_OFFSET:
     case FIFO_B_LH_OFFSET:
     case FIFO_B_HL_OFFSET:
     case FIFO_B_HH_OFFSET:
+      GbaSpuSyncTimers(spu);
       DirectSoundChannelPush(&spu->direct_sound_b, value);
       return true;
   }
@@ -464,13 +577,46 @@ static bool GbaSpuRegistersStore8(void *context, uint32_t address,
   return true;
 }
 
+static const uint16_t *GbaSpuRegisterStorage(const void *context,
+                                             uint32_t address) {
+  const GbaSpu *spu = (const GbaSpu *)context;
+
+  switch (address) {
+    case SOUND1CNT_L_OFFSET:
+    case SOUND1CNT_H_OFFSET:
+    case SOUND1CNT_X_OFFSET:
+    case SOUND2CNT_L_OFFSET:
+    case SOUND2CNT_H_OFFSET:
+    case SOUND3CNT_L_OFFSET:
+    case SOUND3CNT_H_OFFSET:
+    case SOUND3CNT_X_OFFSET:
+    case SOUND4CNT_L_OFFSET:
+    case SOUND4CNT_H_OFFSET:
+    case SOUNDCNT_L_OFFSET:
+    case SOUNDCNT_H_OFFSET:
+    case SOUNDCNT_X_OFFSET:
+    case SOUNDBIAS_OFFSET:
+    case WAVE_RAM0_L_OFFSET:
+    case WAVE_RAM0_H_OFFSET:
+    case WAVE_RAM1_L_OFFSET:
+    case WAVE_RAM1_H_OFFSET:
+    case WAVE_RAM2_L_OFFSET:
+    case WAVE_RAM2_H_OFFSET:
+    case WAVE_RAM3_L_OFFSET:
+    case WAVE_RAM3_H_OFFSET:
+      return &spu->registers.half_words[address >> 1u];
+  }
+
+  return NULL;
+}
+
 void GbaSpuMemoryFree(void *context) {
   GbaSpu *spu = (GbaSpu *)context;
   GbaSpuRelease(spu);
 }
 
 bool GbaSpuAllocate(GbaDmaUnit *dma_unit, GbaSpu **spu, Memory **registers) {
-  *spu = (GbaSpu *)calloc(1, sizeof(GbaSpu));
+  *spu = (GbaSpu *)ArenaCalloc(1, sizeof(GbaSpu));
   if (*spu == NULL) {
     return false;
   }
@@ -480,10 +626,12 @@ bool GbaSpuAllocate(GbaDmaUnit *dma_unit, GbaSpu **spu, Memory **registers) {
       GbaSpuRegistersLoad8, GbaSpuRegistersStore32LE, GbaSpuRegistersStore16LE,
       GbaSpuRegistersStore8, GbaSpuMemoryFree);
   if (*registers == NULL) {
-    free(*spu);
+    ArenaFreeAllocation(*spu);
     return false;
   }
 
+  MemorySetRegisterStorage(*registers, GbaSpuRegisterStorage);
+
   GbaDmaUnitRetain(dma_unit);
 
   (*spu)->dma_unit = dma_unit;
@@ -493,106 +641,115 @@ bool GbaSpuAllocate(GbaDmaUnit *dma_unit, GbaSpu **spu, Memory **registers) {
   return true;
 }
 
-uint32_t GbaSpuCyclesUntilNextWake(const GbaSpu *spu) {
-  return GBA_SPU_CYCLES_PER_AUDIO_SAMPLE - spu->cycle_counter;
+void GbaSpuReset(GbaSpu *spu) {
+  spu->pending_cycles = 0u;
+  spu->cycle_counter = 0u;
+  spu->fifo_counter = 0u;
+  spu->current_fifo_a = 0;
+  spu->current_fifo_b = 0;
+  spu->last_fifo_a = 0;
+  spu->last_fifo_b = 0;
+  memset(&spu->registers, 0, sizeof(GbaSpuRegisters));
+  spu->registers.soundbias.level = 0x200u;
+  DirectSoundChannelClear(&spu->direct_sound_a);
+  DirectSoundChannelClear(&spu->direct_sound_b);
+}
+
+void GbaSpuCopyState(GbaSpu *destination, const GbaSpu *source) {
+  destination->pending_cycles = source->pending_cycles;
+  destination->cycle_counter = source->cycle_counter;
+  destination->fifo_counter = source->fifo_counter;
+  destination->current_fifo_a = source->current_fifo_a;
+  destination->current_fifo_b = source->current_fifo_b;
+  destination->last_fifo_a = source->last_fifo_a;
+  destination->last_fifo_b = source->last_fifo_b;
+  destination->registers = source->registers;
+  destination->direct_sound_a = source->direct_sound_a;
+  destination->direct_sound_b = source->direct_sound_b;
 }
 
 void GbaSpuStep(GbaSpu *spu, uint32_t num_cycles,
                 GbaSpuRenderAudioSample audio_sample_callback) {
-  spu->cycle_counter += num_cycles;
-  assert(spu->cycle_counter <= GBA_SPU_CYCLES_PER_AUDIO_SAMPLE);
+  spu->audio_sample_callback = audio_sample_callback;
+  spu->pending_cycles += num_cycles;
+}
 
-  if (spu->cycle_counter != GBA_SPU_CYCLES_PER_AUDIO_SAMPLE) {
-    return;
-  }
+void GbaSpuFlush(GbaSpu *spu) {
+  GbaSpuSyncTimers(spu);
+  GbaSpuCatchUp(spu);
+}
 
-  spu->cycle_counter = 0u;
+void GbaSpuSetTimerSync(GbaSpu *spu, GbaSpuTimerSyncFunction timer_sync,
+                        void *context) {
+  spu->timer_sync = timer_sync;
+  spu->timer_sync_context = context;
+}
 
-  spu->fifo_counter += 1u;
-  if (spu->fifo_counter == GBA_SPU_AUDIO_SAMPLES_PER_FIFO_SAMPLE) {
-    spu->current_fifo_a = spu->last_fifo_a;
-    spu->current_fifo_b = spu->last_fifo_b;
-    spu->fifo_counter = 0u;
+uint32_t GbaSpuTimerTicksUntilRefill(const GbaSpu *spu, bool timer_index) {
+  uint32_t ticks = UINT32_MAX;
+  if (!spu->registers.soundcnt_x.fifo_master_enable) {
+    return ticks;
   }
 
-  int16_t left = spu->registers.soundbias.level;
-  int16_t right = spu->registers.soundbias.level;
-
-  if (spu->registers.soundcnt_x.fifo_master_enable) {
-    int16_t fifo_a = (int16_t)spu->current_fifo_a
-                     << spu->registers.soundcnt_h.dma_sound_a_volume;
-    if (spu->registers.soundcnt_h.dma_sound_a_left_enabled) {
-      left += fifo_a;
-    }
-
-    if (spu->registers.soundcnt_h.dma_sound_a_right_enabled) {
-      right += fifo_a;
-    }
-
-    int16_t fifo_b = (int16_t)spu->current_fifo_b
-                     << spu->registers.soundcnt_h.dma_sound_b_volume;
-
-    if (spu->registers.soundcnt_h.dma_sound_b_left_enabled) {
-      left += fifo_b;
-    }
-
-    if (spu->registers.soundcnt_h.dma_sound_b_right_enabled) {
-      right += fifo_b;
-    }
+  if (spu->registers.soundcnt_h.dma_sound_a_timer_select == timer_index) {
+    ticks = DirectSoundChannelPopsUntilRefill(&spu->direct_sound_a);
   }
 
-  if (left < 0) {
-    left = 0;
-  } else if (left > 0x3FF) {
-    left = 0x3FF;
+  if (spu->registers.soundcnt_h.dma_sound_b_timer_select == timer_index) {
+    uint32_t ticks_b = DirectSoundChannelPopsUntilRefill(&spu->direct_sound_b);
+    if (ticks_b < ticks) {
+      ticks = ticks_b;
+    }
   }
 
-  if (right < 0) {
-    right = 0;
-  } else if (right > 0x3FF) {
-    right = 0x3FF;
-  }
+  return ticks;
+}
 
-  left -= 0x200u;
-  right -= 0x200u;
+void GbaSpuTimerTicks(GbaSpu *spu, bool timer_index, uint32_t num_ticks,
+                      uint32_t cycles_per_tick,
+                      uint32_t cycles_after_last_tick) {
+  assert(num_ticks != 0u);
 
-  switch (spu->registers.soundbias.level) {
-    case 1:
-      left &= 0xFFFE;
-      right &= 0xFFFE;
-      break;
-    case 2:
-      left &= 0xFFFC;
-      right &= 0xFFFC;
-      break;
-    case 3:
-      left &= 0xFFF8;
-      right &= 0xFFF8;
-      break;
+  if (!spu->registers.soundcnt_x.fifo_master_enable) {
+    return;
   }
 
-  audio_sample_callback(left << 5, right << 5);
-}
-
-void GbaSpuTimerTick(GbaSpu *spu, bool timer_index) {
-  if (!spu->registers.soundcnt_x.fifo_master_enable) {
+  bool pop_a =
+      spu->registers.soundcnt_h.dma_sound_a_timer_select == timer_index;
+  bool pop_b =
+      spu->registers.soundcnt_h.dma_sound_b_timer_select == timer_index;
+  if (!pop_a && !pop_b) {
     return;
   }
 
-  if (spu->registers.soundcnt_h.dma_sound_a_timer_select == timer_index) {
-    bool refill_needed =
-        DirectSoundChannelPop(&spu->direct_sound_a, &spu->last_fifo_a);
-    if (refill_needed) {
-      GbaDmaUnitSignalFifoRefresh(spu->dma_unit, 0x40000A0u);
+  uint32_t cycles_after_tick =
+      cycles_after_last_tick + (num_ticks - 1u) * cycles_per_tick;
+  for (uint32_t tick = 0u; tick < num_ticks; tick++) {
+    // Audio that was already rendered by a register write keeps the samples
+    // that were current at the time
+    if (spu->pending_cycles > cycles_after_tick) {
+      spu->pending_cycles -= cycles_after_tick;
+      GbaSpuCatchUp(spu);
+      spu->pending_cycles = cycles_after_tick;
     }
-  }
 
-  if (spu->registers.soundcnt_h.dma_sound_b_timer_select == timer_index) {
-    bool refill_needed =
-        DirectSoundChannelPop(&spu->direct_sound_b, &spu->last_fifo_b);
-    if (refill_needed) {
-      GbaDmaUnitSignalFifoRefresh(spu->dma_unit, 0x40000A4u);
+    if (pop_a) {
+      bool refill_needed =
+          DirectSoundChannelPop(&spu->direct_sound_a, &spu->last_fifo_a);
+      if (refill_needed) {
+        GbaDmaUnitSignalFifoRefresh(spu->dma_unit, 0x40000A0u);
+      }
     }
+
+    if (pop_b) {
+      bool refill_needed =
+          DirectSoundChannelPop(&spu->direct_sound_b, &spu->last_fifo_b);
+      if (refill_needed) {
+        GbaDmaUnitSignalFifoRefresh(spu->dma_unit, 0x40000A4u);
+      }
+    }
+
+    cycles_after_tick -= cycles_per_tick;
   }
 }
 
@@ -606,7 +763,7 @@ void GbaSpuRelease(GbaSpu *spu) {
   spu->reference_count -= 1u;
   if (spu->reference_count == 0u) {
     GbaDmaUnitRelease(spu->dma_unit);
-    free(spu);
+    ArenaFreeAllocation(spu);
   }
 }
 
@@ -8,15 +8,42 @@ typedef struct _GbaSpu GbaSpu;
 
 bool GbaSpuAllocate(GbaDmaUnit *dma_unit, GbaSpu **spu, Memory **registers);
 
-uint32_t GbaSpuCyclesUntilNextWake(const GbaSpu *spu);
+// Silences all channels and restores the power on registers
+void GbaSpuReset(GbaSpu *spu);
+
+// Copies the registers, FIFOs and audio not yet synthesized of another SPU
+void GbaSpuCopyState(GbaSpu *destination, const GbaSpu *source);
 
 // Callback type for one sample's worth of audio data
 typedef void (*GbaSpuRenderAudioSample)(int16_t left, int16_t right);
 
+// Audio is synthesized lazily. Stepping only records the elapsed cycles,
+// which are rendered when a sound register is written, when a timer pops a
+// FIFO sample, or when the SPU is flushed. The SPU never needs to wake.
 void GbaSpuStep(GbaSpu *spu, uint32_t num_cycles,
                 GbaSpuRenderAudioSample audio_sample_callback);
 
-void GbaSpuTimerTick(GbaSpu *spu, bool timer_index);
+// Renders the samples for all of the cycles stepped so far
+void GbaSpuFlush(GbaSpu *spu);
+
+// Called before the FIFOs or the sound registers change and before audio is
+// flushed so that the timers can deliver any overflows they have batched
+typedef void (*GbaSpuTimerSyncFunction)(void *context);
+
+void GbaSpuSetTimerSync(GbaSpu *spu, GbaSpuTimerSyncFunction timer_sync,
+                        void *context);
+
+// The number of overflows of a timer up to and including the first that makes
+// a FIFO request a refill, or UINT32_MAX if no FIFO is driven by the timer
+uint32_t GbaSpuTimerTicksUntilRefill(const GbaSpu *spu, bool timer_index);
+
+// Pops the FIFOs driven by a timer once for each of its overflows. The
+// overflows are cycles_per_tick apart and the last one happened
+// cycles_after_last_tick cycles ago. The audio preceding each overflow is
+// rendered before its samples are popped.
+void GbaSpuTimerTicks(GbaSpu *spu, bool timer_index, uint32_t num_ticks,
+                      uint32_t cycles_per_tick,
+                      uint32_t cycles_after_last_tick);
 
 void GbaSpuRetain(GbaSpu *spu);
 
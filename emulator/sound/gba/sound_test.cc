@@ -2,6 +2,9 @@ extern "C" {
 #include "emulator/sound/gba/sound.h"
 }
 
+#include <utility>
+#include <vector>
+
 #include "googletest/include/gtest/gtest.h"
 
 #define SOUND1CNT_L_OFFSET 0x00u
@@ -67,6 +70,12 @@ class SoundTest : public testing::Test {
     // Do Nothing
   }
 
+  static void RenderAudioSample(int16_t left, int16_t right) {
+    samples_.push_back(std::make_pair(left, right));
+  }
+
+  static std::vector<std::pair<int16_t, int16_t>> samples_;
+
  protected:
   GbaPlatform *platform_;
   Memory *platform_registers_;
@@ -76,6 +85,21 @@ class SoundTest : public testing::Test {
   Memory *regs_;
 };
 
+std::vector<std::pair<int16_t, int16_t>> SoundTest::samples_;
+
+TEST_F(SoundTest, Reset) {
+  EXPECT_TRUE(Store16LE(regs_, SOUNDCNT_H_OFFSET, 0xFFFFu));
+  EXPECT_TRUE(Store16LE(regs_, SOUNDBIAS_OFFSET, 0xC000u));
+
+  GbaSpuReset(spu_);
+
+  uint16_t contents;
+  EXPECT_TRUE(Load16LE(regs_, SOUNDCNT_H_OFFSET, &contents));
+  EXPECT_EQ(0u, contents);
+  EXPECT_TRUE(Load16LE(regs_, SOUNDBIAS_OFFSET, &contents));
+  EXPECT_EQ(0x200u, contents);
+}
+
 TEST_F(SoundTest, GbaSpuRegistersLoad32FifoFails) {
   uint32_t contents;
   EXPECT_FALSE(Load32LE(regs_, FIFO_A_OFFSET, &contents));
@@ -146,4 +170,58 @@ TEST_F(SoundTest, GbaSpuRegistersStore8Unaligned) {
   EXPECT_TRUE(Store8(regs_, WAVE_RAM0_L_OFFSET + 1u, 0x33u));
   EXPECT_TRUE(Load16LE(regs_, WAVE_RAM0_L_OFFSET, &contents));
   EXPECT_EQ(0x3322u, contents);
+}
+
+TEST_F(SoundTest, AudioIsSynthesizedLazily) {
+  samples_.clear();
+  GbaSpuStep(spu_, 100u, RenderAudioSample);
+  GbaSpuStep(spu_, 156u, RenderAudioSample);
+  EXPECT_TRUE(samples_.empty());
+
+  EXPECT_TRUE(Store16LE(regs_, SOUNDBIAS_OFFSET, 0x300u));
+  ASSERT_EQ(2u, samples_.size());
+  EXPECT_EQ(0, samples_[0].first);
+  EXPECT_EQ(0, samples_[0].second);
+  EXPECT_EQ(0, samples_[1].first);
+  EXPECT_EQ(0, samples_[1].second);
+
+  GbaSpuStep(spu_, 200u, RenderAudioSample);
+  EXPECT_EQ(2u, samples_.size());
+
+  GbaSpuFlush(spu_);
+  ASSERT_EQ(3u, samples_.size());
+  EXPECT_EQ(0x2000, samples_[2].first);
+  EXPECT_EQ(0x2000, samples_[2].second);
+
+  GbaSpuStep(spu_, 56u, RenderAudioSample);
+  GbaSpuFlush(spu_);
+  EXPECT_EQ(4u, samples_.size());
+}
+
+TEST_F(SoundTest, TimerTicks) {
+  EXPECT_EQ(UINT32_MAX, GbaSpuTimerTicksUntilRefill(spu_, false));
+
+  EXPECT_TRUE(Store16LE(regs_, SOUNDCNT_X_OFFSET, 0x80u));
+  EXPECT_TRUE(Store16LE(regs_, SOUNDCNT_H_OFFSET, 0x0300u));
+  EXPECT_EQ(1u, GbaSpuTimerTicksUntilRefill(spu_, false));
+  EXPECT_EQ(UINT32_MAX, GbaSpuTimerTicksUntilRefill(spu_, true));
+
+  for (uint32_t i = 0u; i < 6u; i++) {
+    EXPECT_TRUE(Store32LE(regs_, FIFO_A_OFFSET, 0x01010101u));
+  }
+
+  for (uint32_t i = 0u; i < 5u; i++) {
+    EXPECT_TRUE(Store32LE(regs_, FIFO_B_OFFSET, 0x01010101u));
+  }
+
+  EXPECT_EQ(4u, GbaSpuTimerTicksUntilRefill(spu_, false));
+
+  samples_.clear();
+  GbaSpuStep(spu_, 256u, RenderAudioSample);
+  GbaSpuTimerTicks(spu_, false, 2u, 128u, 0u);
+  EXPECT_EQ(2u, samples_.size());
+  EXPECT_EQ(2u, GbaSpuTimerTicksUntilRefill(spu_, false));
+
+  GbaSpuTimerTicks(spu_, false, 2u, 16u, 0u);
+  EXPECT_EQ(1u, GbaSpuTimerTicksUntilRefill(spu_, false));
 }
\ No newline at end of file
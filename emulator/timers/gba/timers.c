@@ -1,7 +1,9 @@
 #include "emulator/timers/gba/timers.h"
 
 #include <assert.h>
-#include <stdlib.h>
+#include <string.h>
+
+#include "emulator/arena.h"
 
 #define TM0CNT_L_OFFSET 0x00u
 #define TM0CNT_H_OFFSET 0x02u
@@ -40,12 +42,21 @@ typedef union {
   uint8_t bytes[16u];
 } GbaTimerRegisters;
 
+// When a timer next overflows and how many cycles pass between its overflows
+// after that. Timers that never overflow have a period of zero.
+typedef struct {
+  uint64_t next_overflow_cycle;
+  uint64_t period;
+} TimerSchedule;
+
 struct _GbaTimers {
   uint32_t next_overflow_cycle;
+  uint32_t next_interrupt_cycle;
   uint32_t current_cycle;
   uint32_t overflow_cycle[GBA_NUM_TIMERS];
   uint32_t write_mask[GBA_NUM_TIMERS];
   bool cascades[GBA_NUM_TIMERS];
+  TimerSchedule sound_schedule[GBA_SPU_TIMER_MAX_INDEX + 1u];
   uint_fast8_t start_timer;
   uint_fast8_t end_timer;
   GbaTimerRegisters read;
@@ -55,18 +66,183 @@ struct _GbaTimers {
   uint16_t reference_count;
 };
 
-static inline uint32_t TimerTicksRemaining(GbaTimers *timers, uint_fast8_t i) {
+static inline uint32_t TimerTicksRemaining(const GbaTimers *timers,
+                                           uint_fast8_t i) {
   assert(i < GBA_NUM_TIMERS);
   return UINT16_MAX + 1u - timers->read.registers[i].tmcnt_l;
 }
 
+static inline uint32_t TimerTicksPerOverflow(const GbaTimers *timers,
+                                             uint_fast8_t i) {
+  assert(i < GBA_NUM_TIMERS);
+  return UINT16_MAX + 1u - timers->write.registers[i].tmcnt_l;
+}
+
 static inline uint32_t CyclesPerTick(const GbaTimers *timers, uint_fast8_t i) {
   assert(i < GBA_NUM_TIMERS);
   static const uint16_t tick_rates[4] = {1u, 64u, 256u, 1024u};
   return tick_rates[timers->read.registers[i].tmcnt_h.prescalar];
 }
 
+static inline bool TimerIsCascading(const GbaTimers *timers, uint_fast8_t i) {
+  assert(i < GBA_NUM_TIMERS);
+  return i != 0u && timers->cascades[i - 1u];
+}
+
+// Overflows are only delivered when they are observable, so the schedule is
+// relative to the cycle at which they were last delivered. Cascading timers
+// overflow at a fixed multiple of the period of the timer before them.
+static void TimersSchedule(const GbaTimers *timers,
+                           TimerSchedule schedule[GBA_NUM_TIMERS]) {
+  memset(schedule, 0, sizeof(TimerSchedule) * GBA_NUM_TIMERS);
+  for (uint_fast8_t i = timers->start_timer; i < timers->end_timer; i++) {
+    if (timers->write_mask[i] == 0u) {
+      schedule[i].next_overflow_cycle = timers->overflow_cycle[i];
+      schedule[i].period =
+          (uint64_t)CyclesPerTick(timers, i) * TimerTicksPerOverflow(timers, i);
+    } else if (TimerIsCascading(timers, i) && schedule[i - 1u].period != 0u) {
+      schedule[i].next_overflow_cycle =
+          schedule[i - 1u].next_overflow_cycle +
+          (TimerTicksRemaining(timers, i) - 1u) * schedule[i - 1u].period;
+      schedule[i].period =
+          schedule[i - 1u].period * TimerTicksPerOverflow(timers, i);
+    }
+  }
+}
+
+static uint64_t TimerOverflowsThrough(const TimerSchedule *schedule,
+                                      uint32_t cycle) {
+  if (schedule->period == 0u || cycle < schedule->next_overflow_cycle) {
+    return 0u;
+  }
+
+  return 1u + (cycle - schedule->next_overflow_cycle) / schedule->period;
+}
+
+static uint16_t CascadingTimerTicks(const GbaTimers *timers, uint_fast8_t i,
+                                    uint64_t ticks) {
+  uint32_t ticks_remaining = TimerTicksRemaining(timers, i);
+  if (ticks < ticks_remaining) {
+    return timers->read.registers[i].tmcnt_l + ticks;
+  }
+
+  ticks -= ticks_remaining;
+  return timers->write.registers[i].tmcnt_l +
+         ticks % TimerTicksPerOverflow(timers, i);
+}
+
+static void ScheduleTimers(GbaTimers *timers) {
+  TimerSchedule schedule[GBA_NUM_TIMERS];
+  TimersSchedule(timers, schedule);
+
+  uint64_t next_overflow_cycle = UINT32_MAX;
+  uint64_t next_interrupt_cycle = UINT32_MAX;
+  for (uint_fast8_t i = timers->start_timer; i < timers->end_timer; i++) {
+    if (schedule[i].period == 0u) {
+      continue;
+    }
+
+    if (schedule[i].next_overflow_cycle < next_overflow_cycle) {
+      next_overflow_cycle = schedule[i].next_overflow_cycle;
+    }
+
+    if (timers->read.registers[i].tmcnt_h.irq_enable &&
+        schedule[i].next_overflow_cycle < next_interrupt_cycle) {
+      next_interrupt_cycle = schedule[i].next_overflow_cycle;
+    }
+  }
+
+  timers->next_overflow_cycle = next_overflow_cycle;
+  timers->next_interrupt_cycle = next_interrupt_cycle;
+  memcpy(timers->sound_schedule, schedule, sizeof(timers->sound_schedule));
+}
+
+// Interrupts must be raised on time, as must the FIFO pops that request a
+// refill. Every other overflow is delivered in bulk when one of those is
+// reached or when its effects are about to be observed.
+static uint32_t NextWakeCycle(const GbaTimers *timers) {
+  uint64_t next_wake_cycle = timers->next_interrupt_cycle;
+  for (uint_fast8_t i = 0u; i <= GBA_SPU_TIMER_MAX_INDEX; i++) {
+    const TimerSchedule *schedule = &timers->sound_schedule[i];
+    if (schedule->period == 0u) {
+      continue;
+    }
+
+    uint32_t ticks = GbaSpuTimerTicksUntilRefill(timers->spu, i);
+    if (ticks == UINT32_MAX) {
+      continue;
+    }
+
+    uint64_t refill_cycle =
+        schedule->next_overflow_cycle + (ticks - 1u) * schedule->period;
+    if (refill_cycle < next_wake_cycle) {
+      next_wake_cycle = refill_cycle;
+    }
+  }
+
+  return next_wake_cycle;
+}
+
+static void DeliverOverflows(GbaTimers *timers) {
+  if (timers->current_cycle < timers->next_overflow_cycle) {
+    return;
+  }
+
+  TimerSchedule schedule[GBA_NUM_TIMERS];
+  TimersSchedule(timers, schedule);
+
+  uint64_t carried_ticks = 0u;
+  for (uint_fast8_t i = timers->start_timer; i < timers->end_timer; i++) {
+    uint64_t overflows =
+        TimerOverflowsThrough(&schedule[i], timers->current_cycle);
+    uint64_t cycles_after_last_overflow = 0u;
+    if (overflows != 0u) {
+      cycles_after_last_overflow =
+          (timers->current_cycle - schedule[i].next_overflow_cycle) %
+          schedule[i].period;
+    }
+
+    if (timers->write_mask[i] == 0u) {
+      if (overflows != 0u) {
+        timers->read.registers[i].tmcnt_l = timers->write.registers[i].tmcnt_l;
+        timers->overflow_cycle[i] =
+            schedule[i].period - cycles_after_last_overflow;
+      } else {
+        timers->overflow_cycle[i] -= timers->current_cycle;
+      }
+    } else if (TimerIsCascading(timers, i)) {
+      timers->read.registers[i].tmcnt_l =
+          CascadingTimerTicks(timers, i, carried_ticks);
+    }
+
+    carried_ticks = overflows;
+    if (overflows == 0u) {
+      continue;
+    }
+
+    if (timers->read.registers[i].tmcnt_h.irq_enable) {
+      GbaPlatformRaiseTimerInterrupt(timers->platform, i);
+    }
+
+    if (i <= GBA_SPU_TIMER_MAX_INDEX) {
+      uint64_t cycles_per_overflow = schedule[i].period;
+      if (cycles_per_overflow > UINT32_MAX) {
+        assert(overflows == 1u);
+        cycles_per_overflow = UINT32_MAX;
+      }
+
+      GbaSpuTimerTicks(timers->spu, i, overflows, cycles_per_overflow,
+                       cycles_after_last_overflow);
+    }
+  }
+
+  timers->current_cycle = 0u;
+  ScheduleTimers(timers);
+}
+
 static void UpdateTimersBeforeWrite(GbaTimers *timers) {
+  DeliverOverflows(timers);
+
   for (uint_fast8_t i = timers->start_timer; i < timers->end_timer; i++) {
     timers->overflow_cycle[i] -= timers->current_cycle;
     timers->overflow_cycle[i] |= timers->write_mask[i];
@@ -79,7 +255,6 @@ static void UpdateTimersAfterWrite(GbaTimers *timers) {
   timers->start_timer = GBA_NUM_TIMERS;
   timers->end_timer = GBA_NUM_TIMERS;
 
-  timers->next_overflow_cycle = UINT32_MAX;
   for (uint_fast8_t i = 0u; i < GBA_NUM_TIMERS; i++) {
     bool timer_just_started = timers->write.registers[i].tmcnt_h.started &&
                               !timers->read.registers[i].tmcnt_h.started;
@@ -118,30 +293,55 @@ static void UpdateTimersAfterWrite(GbaTimers *timers) {
       timers->overflow_cycle[i] |= timers->write_mask[i];
     }
 
-    if (timers->overflow_cycle[i] < timers->next_overflow_cycle) {
-      timers->next_overflow_cycle = timers->overflow_cycle[i];
-    }
-
     if (timers->start_timer == GBA_NUM_TIMERS) {
       timers->start_timer = i;
     }
 
     timers->end_timer = i + 1u;
   }
+
+  ScheduleTimers(timers);
+}
+
+static void GbaTimersSyncSpu(void *context) {
+  GbaTimers *timers = (GbaTimers *)context;
+  DeliverOverflows(timers);
 }
 
 static uint16_t ReadTimerTicks(const GbaTimers *timers, uint_fast8_t i) {
   assert(i < GBA_NUM_TIMERS);
 
-  if (!timers->read.registers[i].tmcnt_h.started ||
-      (i != 0u && timers->read.registers[i].tmcnt_h.cascade)) {
+  if (!timers->read.registers[i].tmcnt_h.started) {
     return timers->read.registers[i].tmcnt_l;
   }
 
-  uint32_t cycles_remaining = timers->overflow_cycle[i] - timers->current_cycle;
-  assert(cycles_remaining != 0u);
+  if (timers->write_mask[i] != 0u) {
+    if (!TimerIsCascading(timers, i)) {
+      return timers->read.registers[i].tmcnt_l;
+    }
+
+    TimerSchedule schedule[GBA_NUM_TIMERS];
+    TimersSchedule(timers, schedule);
+
+    uint64_t ticks =
+        TimerOverflowsThrough(&schedule[i - 1u], timers->current_cycle);
+
+    return CascadingTimerTicks(timers, i, ticks);
+  }
 
   uint32_t cycles_per_tick = CyclesPerTick(timers, i);
+
+  uint32_t cycles_remaining;
+  if (timers->current_cycle < timers->overflow_cycle[i]) {
+    cycles_remaining = timers->overflow_cycle[i] - timers->current_cycle;
+  } else {
+    uint32_t period = cycles_per_tick * TimerTicksPerOverflow(timers, i);
+    cycles_remaining =
+        period - (timers->current_cycle - timers->overflow_cycle[i]) % period;
+  }
+
+  assert(cycles_remaining != 0u);
+
   uint32_t ticks_remaining = (cycles_remaining - 1u) / cycles_per_tick;
 
   return UINT16_MAX - ticks_remaining;
@@ -272,6 +472,21 @@ static bool GbaTimersRegistersStore8(void *context, uint32_t address,
   return true;
 }
 
+static const uint16_t *GbaTimersRegisterStorage(const void *context,
+                                                uint32_t address) {
+  const GbaTimers *timers = (const GbaTimers *)context;
+
+  switch (address) {
+    case TM0CNT_H_OFFSET:
+    case TM1CNT_H_OFFSET:
+    case TM2CNT_H_OFFSET:
+    case TM3CNT_H_OFFSET:
+      return &timers->read.half_words[address >> 1u];
+  }
+
+  return NULL;
+}
+
 void GbaTimersMemoryFree(void *context) {
   GbaTimers *timers = (GbaTimers *)context;
   GbaTimersFree(timers);
@@ -279,7 +494,7 @@ void GbaTimersMemoryFree(void *context) {
 
 bool GbaTimersAllocate(GbaPlatform *platform, GbaSpu *spu, GbaTimers **timers,
                        Memory **registers) {
-  *timers = (GbaTimers *)calloc(1, sizeof(GbaTimers));
+  *timers = (GbaTimers *)ArenaCalloc(1, sizeof(GbaTimers));
   if (*timers == NULL) {
     return false;
   }
@@ -290,11 +505,14 @@ bool GbaTimersAllocate(GbaPlatform *platform, GbaSpu *spu, GbaTimers **timers,
                      GbaTimersRegistersStore32LE, GbaTimersRegistersStore16LE,
                      GbaTimersRegistersStore8, GbaTimersMemoryFree);
   if (*registers == NULL) {
-    free(*timers);
+    ArenaFreeAllocation(*timers);
     return false;
   }
 
+  MemorySetRegisterStorage(*registers, GbaTimersRegisterStorage);
+
   (*timers)->next_overflow_cycle = UINT32_MAX;
+  (*timers)->next_interrupt_cycle = UINT32_MAX;
   (*timers)->platform = platform;
   (*timers)->spu = spu;
   (*timers)->reference_count = 2u;
@@ -302,70 +520,63 @@ bool GbaTimersAllocate(GbaPlatform *platform, GbaSpu *spu, GbaTimers **timers,
   GbaPlatformRetain(platform);
   GbaSpuRetain(spu);
 
+  GbaSpuSetTimerSync(spu, GbaTimersSyncSpu, *timers);
+
   return true;
 }
 
+void GbaTimersReset(GbaTimers *timers) {
+  timers->next_overflow_cycle = UINT32_MAX;
+  timers->next_interrupt_cycle = UINT32_MAX;
+  timers->current_cycle = 0u;
+  memset(timers->overflow_cycle, 0, sizeof(timers->overflow_cycle));
+  memset(timers->write_mask, 0, sizeof(timers->write_mask));
+  memset(timers->cascades, 0, sizeof(timers->cascades));
+  memset(timers->sound_schedule, 0, sizeof(timers->sound_schedule));
+  timers->start_timer = 0u;
+  timers->end_timer = 0u;
+  memset(&timers->read, 0, sizeof(GbaTimerRegisters));
+  memset(&timers->write, 0, sizeof(GbaTimerRegisters));
+}
+
+void GbaTimersCopyState(GbaTimers *destination, const GbaTimers *source) {
+  destination->next_overflow_cycle = source->next_overflow_cycle;
+  destination->next_interrupt_cycle = source->next_interrupt_cycle;
+  destination->current_cycle = source->current_cycle;
+  memcpy(destination->overflow_cycle, source->overflow_cycle,
+         sizeof(source->overflow_cycle));
+  memcpy(destination->write_mask, source->write_mask,
+         sizeof(source->write_mask));
+  memcpy(destination->cascades, source->cascades, sizeof(source->cascades));
+  memcpy(destination->sound_schedule, source->sound_schedule,
+         sizeof(source->sound_schedule));
+  destination->start_timer = source->start_timer;
+  destination->end_timer = source->end_timer;
+  destination->read = source->read;
+  destination->write = source->write;
+}
+
 uint32_t GbaTimersCyclesUntilNextWake(const GbaTimers *timers) {
-  return timers->next_overflow_cycle - timers->current_cycle;
+  return NextWakeCycle(timers) - timers->current_cycle;
 }
 
 void GbaTimersStep(GbaTimers *timers, uint32_t num_cycles) {
   timers->current_cycle += num_cycles;
-  assert(timers->current_cycle <= timers->next_overflow_cycle);
-
-  if (timers->current_cycle != timers->next_overflow_cycle) {
+  if (timers->current_cycle < NextWakeCycle(timers)) {
     return;
   }
 
-  uint32_t overflow_mask = UINT32_MAX;
-  timers->next_overflow_cycle = UINT32_MAX;
-  for (uint_fast8_t i = timers->start_timer; i < timers->end_timer; i++) {
-    timers->overflow_cycle[i] -= timers->current_cycle;
-    timers->overflow_cycle[i] |= timers->write_mask[i];
-
-    if ((timers->overflow_cycle[i] & overflow_mask) == 0u) {
-      timers->read.registers[i].tmcnt_l = timers->write.registers[i].tmcnt_l;
-
-      timers->overflow_cycle[i] =
-          CyclesPerTick(timers, i) * TimerTicksRemaining(timers, i);
-      timers->overflow_cycle[i] |= timers->write_mask[i];
-
-      if (timers->overflow_cycle[i] < timers->next_overflow_cycle) {
-        timers->next_overflow_cycle = timers->overflow_cycle[i];
-      }
-
-      if (timers->read.registers[i].tmcnt_h.irq_enable) {
-        GbaPlatformRaiseTimerInterrupt(timers->platform, i);
-      }
-
-      if (i <= GBA_SPU_TIMER_MAX_INDEX) {
-        GbaSpuTimerTick(timers->spu, i);
-      }
-
-      overflow_mask = UINT32_MAX;
-      if (timers->cascades[i]) {
-        timers->read.registers[i + 1u].tmcnt_l += 1u;
-        if (timers->read.registers[i + 1u].tmcnt_l == 0u) {
-          overflow_mask = 0u;
-        }
-      }
-    }
-
-    if (timers->overflow_cycle[i] < timers->next_overflow_cycle) {
-      timers->next_overflow_cycle = timers->overflow_cycle[i];
-    }
-  }
-
-  timers->current_cycle = 0u;
+  DeliverOverflows(timers);
 }
 
 void GbaTimersFree(GbaTimers *timers) {
   assert(timers->reference_count != 0u);
   timers->reference_count -= 1u;
   if (timers->reference_count == 0u) {
+    GbaSpuSetTimerSync(timers->spu, NULL, NULL);
     GbaPlatformRelease(timers->platform);
     GbaSpuRelease(timers->spu);
-    free(timers);
+    ArenaFreeAllocation(timers);
   }
 }
 
@@ -10,6 +10,12 @@ typedef struct _GbaTimers GbaTimers;
 bool GbaTimersAllocate(GbaPlatform *platform, GbaSpu *spu, GbaTimers **timers,
                        Memory **registers);
 
+// Stops all timers and restores the power on registers
+void GbaTimersReset(GbaTimers *timers);
+
+// Copies the registers and counters of another set of timers
+void GbaTimersCopyState(GbaTimers *destination, const GbaTimers *source);
+
 uint32_t GbaTimersCyclesUntilNextWake(const GbaTimers *timers);
 
 void GbaTimersStep(GbaTimers *timers, uint32_t num_cycles);
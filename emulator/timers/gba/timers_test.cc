@@ -17,6 +17,10 @@ extern "C" {
 #define TM3CNT_L_OFFSET 0x0Cu
 #define TM3CNT_H_OFFSET 0x0Eu
 
+#define SOUNDCNT_H_OFFSET 0x22u
+#define SOUNDCNT_X_OFFSET 0x24u
+#define FIFO_A_OFFSET 0x40u
+
 class TimersTest : public testing::Test {
  public:
   void SetUp() override {
@@ -243,6 +247,24 @@ TEST_F(TimersTest, OutOfBounds) {
   EXPECT_FALSE(raised_);
 }
 
+TEST_F(TimersTest, Reset) {
+  EXPECT_TRUE(Store16LE(regs_, TM0CNT_L_OFFSET, 0xFFFFu));
+  EXPECT_TRUE(Store16LE(regs_, TM0CNT_H_OFFSET, 0xC0u));
+  EXPECT_EQ(1u, GbaTimersCyclesUntilNextWake(timers_));
+
+  GbaTimersReset(timers_);
+  EXPECT_EQ(UINT32_MAX, GbaTimersCyclesUntilNextWake(timers_));
+
+  uint16_t contents;
+  EXPECT_TRUE(Load16LE(regs_, TM0CNT_L_OFFSET, &contents));
+  EXPECT_EQ(0u, contents);
+  EXPECT_TRUE(Load16LE(regs_, TM0CNT_H_OFFSET, &contents));
+  EXPECT_EQ(0u, contents);
+
+  GbaTimersStep(timers_, 1u);
+  EXPECT_FALSE(raised_);
+}
+
 TEST_F(TimersTest, OneCycleCounter) {
   EXPECT_TRUE(Store16LE(regs_, TM0CNT_L_OFFSET, 0xFFFFu));
   EXPECT_TRUE(Store16LE(regs_, TM0CNT_H_OFFSET, 0xC0u));
@@ -611,4 +633,59 @@ TEST_F(TimersTest, TwoSixtyFourCycleCounters) {
 
   EXPECT_TRUE(Load16LE(regs_, TM3CNT_L_OFFSET, &contents));
   EXPECT_EQ(0xFFFFu, contents);
+}
+
+TEST_F(TimersTest, OverflowsWithoutInterruptsAreBatched) {
+  EXPECT_TRUE(Store16LE(regs_, TM0CNT_L_OFFSET, 0xFFF0u));
+  EXPECT_TRUE(Store16LE(regs_, TM0CNT_H_OFFSET, 0x80u));
+  EXPECT_EQ(UINT32_MAX, GbaTimersCyclesUntilNextWake(timers_));
+
+  EXPECT_TRUE(Store16LE(regs_, TM1CNT_L_OFFSET, 0xFFFDu));
+  EXPECT_TRUE(Store16LE(regs_, TM1CNT_H_OFFSET, 0xC4u));
+  EXPECT_EQ(48u, GbaTimersCyclesUntilNextWake(timers_));
+
+  GbaTimersStep(timers_, 40u);
+  EXPECT_FALSE(raised_);
+
+  uint16_t contents;
+  EXPECT_TRUE(Load16LE(regs_, TM0CNT_L_OFFSET, &contents));
+  EXPECT_EQ(0xFFF8u, contents);
+  EXPECT_TRUE(Load16LE(regs_, TM1CNT_L_OFFSET, &contents));
+  EXPECT_EQ(0xFFFFu, contents);
+  EXPECT_EQ(8u, GbaTimersCyclesUntilNextWake(timers_));
+
+  GbaTimersStep(timers_, 8u);
+  EXPECT_TRUE(raised_);
+
+  EXPECT_TRUE(Load16LE(plat_regs_, IF_OFFSET, &contents));
+  EXPECT_EQ(1u << 4u, contents);
+
+  EXPECT_TRUE(Load16LE(regs_, TM0CNT_L_OFFSET, &contents));
+  EXPECT_EQ(0xFFF0u, contents);
+  EXPECT_TRUE(Load16LE(regs_, TM1CNT_L_OFFSET, &contents));
+  EXPECT_EQ(0xFFFDu, contents);
+  EXPECT_EQ(48u, GbaTimersCyclesUntilNextWake(timers_));
+}
+
+TEST_F(TimersTest, SoundTimersWakeForFifoRefills) {
+  EXPECT_TRUE(Store16LE(spu_registers_, SOUNDCNT_X_OFFSET, 0x80u));
+  EXPECT_TRUE(Store16LE(spu_registers_, SOUNDCNT_H_OFFSET, 0x4300u));
+  for (uint32_t i = 0u; i < 5u; i++) {
+    EXPECT_TRUE(Store32LE(spu_registers_, FIFO_A_OFFSET, 0u));
+  }
+
+  EXPECT_TRUE(Store16LE(regs_, TM0CNT_L_OFFSET, 0xFFF0u));
+  EXPECT_TRUE(Store16LE(regs_, TM0CNT_H_OFFSET, 0x80u));
+  EXPECT_EQ(64u, GbaTimersCyclesUntilNextWake(timers_));
+
+  GbaTimersStep(timers_, 24u);
+  EXPECT_TRUE(Store32LE(spu_registers_, FIFO_A_OFFSET, 0u));
+  EXPECT_EQ(104u, GbaTimersCyclesUntilNextWake(timers_));
+
+  GbaTimersStep(timers_, 104u);
+  EXPECT_EQ(16u, GbaTimersCyclesUntilNextWake(timers_));
+
+  uint16_t contents;
+  EXPECT_TRUE(Load16LE(regs_, TM0CNT_L_OFFSET, &contents));
+  EXPECT_EQ(0xFFF0u, contents);
 }
\ No newline at end of file
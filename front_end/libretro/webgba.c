@@ -25,6 +25,20 @@ static GbaEmulator *emulator = NULL;
 static Screen *screen = NULL;
 static GamePad *gamepad = NULL;
 static uint8_t render_scale = 1u;
+static bool use_opengl = false;
+
+// Only used when rendering in software
+static uint32_t pixels[BASE_WIDTH * BASE_HEIGHT];
+static ScreenPixelFormat pixel_format = SCREEN_PIXEL_FORMAT_RGB565;
+static size_t pixel_pitch = BASE_WIDTH * sizeof(uint16_t);
+
+static bool UseOpenGl() {
+  struct retro_variable var;
+  var.key = "webgba_renderer";
+
+  return environ_cb(RETRO_ENVIRONMENT_GET_VARIABLE, &var) &&
+         var.value != NULL && strcmp(var.value, "opengl") == 0;
+}
 
 static void UpdateVariables() {
   struct retro_variable var;
@@ -86,7 +100,7 @@ void retro_get_system_info(struct retro_system_info *info) {
 
   info->library_name = "WebGBA";
   info->library_version = "v0.1";
-  info->need_fullpath = false;
+  info->need_fullpath = true;
   info->valid_extensions = "gba";
 }
 
@@ -109,6 +123,7 @@ void retro_set_environment(retro_environment_t cb) {
   environ_cb = cb;
 
   struct retro_variable variables[] = {
+      {"webgba_renderer", "Renderer (restart); software|opengl"},
       {"webgba_resolution",
        "Output Resolution; "
        "240x160|"
@@ -151,18 +166,48 @@ void retro_run() {
     UpdateVariables();
   }
 
+  GbaGraphicsRenderOptions options;
+  if (!use_opengl) {
+    options.renderer = GBA_RENDERER_SCANLINES_SOFTWARE;
+    options.opengl_render_scale = 1u;
+    GbaEmulatorStep(emulator, screen, &options, audio_cb);
+    video_cb(pixels, BASE_WIDTH, BASE_HEIGHT, pixel_pitch);
+    return;
+  }
+
   ScreenAttachFramebuffer(screen, hw_render.get_current_framebuffer(),
                           /*width=*/BASE_WIDTH * render_scale,
                           /*height=*/BASE_HEIGHT * render_scale);
 
-  GbaGraphicsRenderOptions options;
-  options.renderer = GBA_RENDERER_SCANLINES_SOFTWARE;
+  options.renderer = GBA_RENDERER_SCANLINES_OPENGL;
   options.opengl_render_scale = render_scale;
   GbaEmulatorStep(emulator, screen, &options, audio_cb);
   video_cb(RETRO_HW_FRAME_BUFFER_VALID, BASE_WIDTH * render_scale,
            BASE_HEIGHT * render_scale, 0);
 }
 
+static bool retro_init_pixel_buffer() {
+  enum retro_pixel_format fmt = RETRO_PIXEL_FORMAT_RGB565;
+  if (environ_cb(RETRO_ENVIRONMENT_SET_PIXEL_FORMAT, &fmt)) {
+    pixel_format = SCREEN_PIXEL_FORMAT_RGB565;
+    pixel_pitch = BASE_WIDTH * sizeof(uint16_t);
+  } else {
+    fmt = RETRO_PIXEL_FORMAT_XRGB8888;
+    if (!environ_cb(RETRO_ENVIRONMENT_SET_PIXEL_FORMAT, &fmt)) {
+      return false;
+    }
+
+    pixel_format = SCREEN_PIXEL_FORMAT_XRGB8888;
+    pixel_pitch = BASE_WIDTH * sizeof(uint32_t);
+  }
+
+  // The software renderer draws straight into the buffer handed to video_cb
+  ScreenAttachPixelBuffer(screen, pixels, BASE_WIDTH, BASE_HEIGHT,
+                          pixel_format, pixel_pitch, /*bottom_up=*/false);
+
+  return true;
+}
+
 static bool retro_init_hw_context() {
   memset(&hw_render, 0, sizeof(struct retro_hw_render_callback));
 
@@ -183,8 +228,11 @@ static bool retro_init_hw_context() {
 }
 
 bool retro_load_game(const struct retro_game_info *info) {
+  // The ROM is mapped from its path when the frontend provides one
   bool success =
-      GbaEmulatorAllocate(info->data, info->size, &emulator, &gamepad);
+      info->path != NULL
+          ? GbaEmulatorAllocateFromFile(info->path, &emulator, &gamepad)
+          : GbaEmulatorAllocate(info->data, info->size, &emulator, &gamepad);
   if (!success) {
     return false;
   }
@@ -196,16 +244,14 @@ bool retro_load_game(const struct retro_game_info *info) {
 
   UpdateVariables();
 
-  enum retro_pixel_format fmt = RETRO_PIXEL_FORMAT_RGB565;
-  if (!environ_cb(RETRO_ENVIRONMENT_SET_PIXEL_FORMAT, &fmt)) {
-    return false;
-  }
-
-  if (!retro_init_hw_context()) {
-    return false;
+  // Frontends without hardware rendering fall back to software rendering
+  use_opengl = UseOpenGl() && retro_init_hw_context();
+  if (use_opengl) {
+    enum retro_pixel_format fmt = RETRO_PIXEL_FORMAT_RGB565;
+    return environ_cb(RETRO_ENVIRONMENT_SET_PIXEL_FORMAT, &fmt);
   }
 
-  return true;
+  return retro_init_pixel_buffer();
 }
 
 void retro_unload_game() {
@@ -231,7 +277,7 @@ void *retro_get_memory_data(unsigned id) { return NULL; }
 
 size_t retro_get_memory_size(unsigned id) { return 0; }
 
-void retro_reset() {}
+void retro_reset() { GbaEmulatorReset(emulator); }
 
 void retro_cheat_reset() {}
 
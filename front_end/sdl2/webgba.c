@@ -1,5 +1,6 @@
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 
 #ifdef __EMSCRIPTEN__
 #include <emscripten/emscripten.h>
@@ -11,6 +12,44 @@
 
 #include "emulator/gba.h"
 
+#define GBA_WIDTH 240
+#define GBA_HEIGHT 160
+#define GBA_FRAME_PITCH (3 * GBA_WIDTH)
+#define GBA_FRAME_SIZE (GBA_FRAME_PITCH * GBA_HEIGHT)
+
+// The GBA produces one sample every 128 cycles
+#define AUDIO_SOURCE_RATE (16777216.0 / 128.0)
+#define AUDIO_DEVICE_RATE 48000
+#define AUDIO_DEVICE_SAMPLES 1024
+
+// Must be a power of two
+#define AUDIO_RING_SIZE 16384u
+#define AUDIO_RING_MASK (AUDIO_RING_SIZE - 1u)
+
+// How far the output rate may be adjusted to keep the ring near its target
+#define AUDIO_MAX_RATE_ADJUSTMENT 0.005
+
+#define FRAME_INDEX_MASK 0x3
+#define FRAME_READY 0x4
+
+typedef enum {
+  BUTTON_A = 1 << 0,
+  BUTTON_B = 1 << 1,
+  BUTTON_L = 1 << 2,
+  BUTTON_R = 1 << 3,
+  BUTTON_START = 1 << 4,
+  BUTTON_SELECT = 1 << 5,
+  BUTTON_UP = 1 << 6,
+  BUTTON_DOWN = 1 << 7,
+  BUTTON_LEFT = 1 << 8,
+  BUTTON_RIGHT = 1 << 9,
+} Button;
+
+typedef struct {
+  int16_t left;
+  int16_t right;
+} AudioFrame;
+
 static SDL_GameController *g_gamecontroller = NULL;
 static SDL_Window *g_window = NULL;
 static SDL_GLContext *g_glcontext = NULL;
@@ -35,18 +74,111 @@ bool g_accept_mode_change = true;
 bool g_accept_reset = true;
 bool g_main_loop_running = true;
 
-static void RenderAudioSample(int16_t left, int16_t right) {
-  if (g_audio_unlocked) {
-    int16_t buffer[2] = {left, right};
-    SDL_QueueAudio(g_audiodevice, buffer, sizeof(buffer));
+// Resampled audio is handed from the emulator to the audio callback through a
+// single producer single consumer ring
+static AudioFrame g_audio_ring[AUDIO_RING_SIZE];
+static SDL_atomic_t g_audio_read;   // Only written by the audio callback
+static SDL_atomic_t g_audio_write;  // Only written by the emulator
+static AudioFrame g_audio_last = {0, 0};  // Only used by the audio callback
+static Uint32 g_audio_target_fill = 0u;
+
+// Resampler state only used by the emulator
+static double g_audio_step = 0.0;
+static double g_audio_phase = 1.0;
+static AudioFrame g_audio_previous = {0, 0};
+
+#ifndef __EMSCRIPTEN__
+// State shared with the emulation thread
+static SDL_atomic_t g_emulation_running;
+static SDL_atomic_t g_emulation_buttons;
+static SDL_atomic_t g_emulation_renderer;
+
+// Completed frames are handed from the emulation thread to the main thread
+// through a triple buffer. The index of the most recently completed frame is
+// kept in g_ready_frame along with FRAME_READY if it has not been presented.
+static uint8_t g_frames[3][GBA_FRAME_SIZE];
+static SDL_atomic_t g_ready_frame;
+static int g_back_frame = 0;   // Only used by the emulation thread
+static int g_front_frame = 1;  // Only used by the main thread
+static bool g_has_frame = false;
+static Screen *g_emulation_screen = NULL;
+#endif  // __EMSCRIPTEN__
+
+static Uint32 AudioRingFill() {
+  return (Uint32)SDL_AtomicGet(&g_audio_write) -
+         (Uint32)SDL_AtomicGet(&g_audio_read);
+}
+
+static void AudioCallback(void *userdata, Uint8 *stream, int len) {
+  AudioFrame *frames = (AudioFrame *)stream;
+  Uint32 num_frames = (Uint32)len / sizeof(AudioFrame);
+
+  Uint32 read = (Uint32)SDL_AtomicGet(&g_audio_read);
+  Uint32 available = (Uint32)SDL_AtomicGet(&g_audio_write) - read;
+  if (available > num_frames) {
+    available = num_frames;
   }
+
+  for (Uint32 i = 0u; i < available; i++) {
+    frames[i] = g_audio_ring[(read + i) & AUDIO_RING_MASK];
+  }
+
+  if (available != 0u) {
+    g_audio_last = frames[available - 1u];
+  }
+
+  // Holding the last frame through an underrun avoids an audible pop
+  for (Uint32 i = available; i < num_frames; i++) {
+    frames[i] = g_audio_last;
+  }
+
+  SDL_AtomicSet(&g_audio_read, (int)(read + available));
 }
 
-static void RenderNextFrame() {
-  //
-  // Check for events
-  //
+static void RenderAudioSample(int16_t left, int16_t right) {
+  if (!g_audio_unlocked) {
+    return;
+  }
+
+  Uint32 write = (Uint32)SDL_AtomicGet(&g_audio_write);
+  Uint32 fill = write - (Uint32)SDL_AtomicGet(&g_audio_read);
+
+  // Consuming input slightly faster while the ring is above its target and
+  // slightly slower while it is below keeps latency steady without drifting
+  double error = ((double)fill - (double)g_audio_target_fill) /
+                 (double)g_audio_target_fill;
+  if (error > 1.0) {
+    error = 1.0;
+  } else if (error < -1.0) {
+    error = -1.0;
+  }
+
+  double step = g_audio_step * (1.0 + AUDIO_MAX_RATE_ADJUSTMENT * error);
+
+  // Output frames are linearly interpolated between the previous sample at a
+  // phase of 0.0 and this sample at a phase of 1.0
+  while (g_audio_phase <= 1.0) {
+    if (fill < AUDIO_RING_SIZE) {
+      AudioFrame *frame = &g_audio_ring[write & AUDIO_RING_MASK];
+      frame->left = g_audio_previous.left +
+                    (int16_t)((left - g_audio_previous.left) * g_audio_phase);
+      frame->right =
+          g_audio_previous.right +
+          (int16_t)((right - g_audio_previous.right) * g_audio_phase);
+      write += 1u;
+      fill += 1u;
+    }
+    g_audio_phase += step;
+  }
 
+  g_audio_phase -= 1.0;
+  g_audio_previous.left = left;
+  g_audio_previous.right = right;
+
+  SDL_AtomicSet(&g_audio_write, (int)write);
+}
+
+static bool ProcessEvents() {
   SDL_Event event;
   while (SDL_PollEvent(&event)) {
     switch (event.type) {
@@ -55,7 +187,7 @@ static void RenderNextFrame() {
 #if __EMSCRIPTEN__
         emscripten_cancel_main_loop();
 #endif  // __EMSCRIPTEN__
-        return;
+        return false;
       case SDL_FINGERUP:
       case SDL_KEYUP:
       case SDL_MOUSEBUTTONUP:
@@ -68,7 +200,7 @@ static void RenderNextFrame() {
 #if __EMSCRIPTEN__
             emscripten_cancel_main_loop();
 #endif  // __EMSCRIPTEN__
-            return;
+            return false;
           case SDL_WINDOWEVENT_RESIZED:
             g_width = event.window.data1;
             g_height = event.window.data2;
@@ -78,23 +210,11 @@ static void RenderNextFrame() {
     }
   }
 
-  //
-  // Update gamepad
-  //
+  return true;
+}
 
+static void UpdateRenderOptions() {
   const Uint8 *keyboard_state = SDL_GetKeyboardState(NULL);
-  bool a_pressed = keyboard_state[SDL_SCANCODE_X] != 0;
-  bool b_pressed = keyboard_state[SDL_SCANCODE_Z] != 0;
-  bool l_pressed = keyboard_state[SDL_SCANCODE_A] != 0;
-  bool r_pressed = keyboard_state[SDL_SCANCODE_S] != 0;
-  bool start_pressed = keyboard_state[SDL_SCANCODE_RETURN] != 0;
-  bool select_pressed = keyboard_state[SDL_SCANCODE_BACKSPACE] != 0;
-  bool up_pressed = keyboard_state[SDL_SCANCODE_UP] != 0;
-  bool down_pressed = keyboard_state[SDL_SCANCODE_DOWN] != 0;
-  bool left_pressed = keyboard_state[SDL_SCANCODE_LEFT] != 0;
-  bool right_pressed = keyboard_state[SDL_SCANCODE_RIGHT] != 0;
-
-  // Render Control
   bool raise_pressed = keyboard_state[SDL_SCANCODE_J] != 0;
   bool lower_pressed = keyboard_state[SDL_SCANCODE_H] != 0;
   bool change_mode_pressed = keyboard_state[SDL_SCANCODE_G] != 0;
@@ -132,9 +252,16 @@ static void RenderNextFrame() {
         g_render_options.renderer = GBA_RENDERER_SCANLINES_SOFTWARE;
         break;
       case GBA_RENDERER_SCANLINES_SOFTWARE:
+        g_render_options.renderer = GBA_RENDERER_SCANLINES_SOFTWARE_THREADED;
+        break;
+      case GBA_RENDERER_SCANLINES_SOFTWARE_THREADED:
+        g_render_options.renderer = GBA_RENDERER_SCANLINES_SOFTWARE_BANDS;
+        break;
+      case GBA_RENDERER_SCANLINES_SOFTWARE_BANDS:
         g_render_options.renderer = GBA_RENDERER_SCANLINES_OPENGL;
         break;
       case GBA_RENDERER_SCANLINES_OPENGL:
+      case GBA_RENDERER_NONE:
         g_render_options.renderer = GBA_RENDERER_PIXELS_SOFTWARE;
         break;
     }
@@ -148,6 +275,20 @@ static void RenderNextFrame() {
     g_render_options.opengl_render_scale = 1u;
     g_accept_reset = false;
   }
+}
+
+static int ReadButtons() {
+  const Uint8 *keyboard_state = SDL_GetKeyboardState(NULL);
+  bool a_pressed = keyboard_state[SDL_SCANCODE_X] != 0;
+  bool b_pressed = keyboard_state[SDL_SCANCODE_Z] != 0;
+  bool l_pressed = keyboard_state[SDL_SCANCODE_A] != 0;
+  bool r_pressed = keyboard_state[SDL_SCANCODE_S] != 0;
+  bool start_pressed = keyboard_state[SDL_SCANCODE_RETURN] != 0;
+  bool select_pressed = keyboard_state[SDL_SCANCODE_BACKSPACE] != 0;
+  bool up_pressed = keyboard_state[SDL_SCANCODE_UP] != 0;
+  bool down_pressed = keyboard_state[SDL_SCANCODE_DOWN] != 0;
+  bool left_pressed = keyboard_state[SDL_SCANCODE_LEFT] != 0;
+  bool right_pressed = keyboard_state[SDL_SCANCODE_RIGHT] != 0;
 
   if (!g_gamecontroller && SDL_NumJoysticks() > 0) {
     for (int i = 0; i < SDL_NumJoysticks(); ++i) {
@@ -235,16 +376,42 @@ static void RenderNextFrame() {
     }
   }
 
-  GamePadToggleA(g_gamepad, a_pressed);
-  GamePadToggleB(g_gamepad, b_pressed);
-  GamePadToggleL(g_gamepad, l_pressed);
-  GamePadToggleR(g_gamepad, r_pressed);
-  GamePadToggleStart(g_gamepad, start_pressed);
-  GamePadToggleSelect(g_gamepad, select_pressed);
-  GamePadToggleUp(g_gamepad, up_pressed);
-  GamePadToggleDown(g_gamepad, down_pressed);
-  GamePadToggleLeft(g_gamepad, left_pressed);
-  GamePadToggleRight(g_gamepad, right_pressed);
+  return (a_pressed ? BUTTON_A : 0) | (b_pressed ? BUTTON_B : 0) |
+         (l_pressed ? BUTTON_L : 0) | (r_pressed ? BUTTON_R : 0) |
+         (start_pressed ? BUTTON_START : 0) |
+         (select_pressed ? BUTTON_SELECT : 0) | (up_pressed ? BUTTON_UP : 0) |
+         (down_pressed ? BUTTON_DOWN : 0) | (left_pressed ? BUTTON_LEFT : 0) |
+         (right_pressed ? BUTTON_RIGHT : 0);
+}
+
+static void ApplyButtons(int buttons) {
+  GamePadToggleA(g_gamepad, buttons & BUTTON_A);
+  GamePadToggleB(g_gamepad, buttons & BUTTON_B);
+  GamePadToggleL(g_gamepad, buttons & BUTTON_L);
+  GamePadToggleR(g_gamepad, buttons & BUTTON_R);
+  GamePadToggleStart(g_gamepad, buttons & BUTTON_START);
+  GamePadToggleSelect(g_gamepad, buttons & BUTTON_SELECT);
+  GamePadToggleUp(g_gamepad, buttons & BUTTON_UP);
+  GamePadToggleDown(g_gamepad, buttons & BUTTON_DOWN);
+  GamePadToggleLeft(g_gamepad, buttons & BUTTON_LEFT);
+  GamePadToggleRight(g_gamepad, buttons & BUTTON_RIGHT);
+}
+
+static void RenderNextFrame() {
+  //
+  // Check for events
+  //
+
+  if (!ProcessEvents()) {
+    return;
+  }
+
+  //
+  // Update gamepad
+  //
+
+  UpdateRenderOptions();
+  ApplyButtons(ReadButtons());
 
   //
   // Run emulation
@@ -262,12 +429,89 @@ static void RenderNextFrame() {
   SDL_GL_SwapWindow(g_window);
 }
 
+#ifndef __EMSCRIPTEN__
+static int RunEmulation(void *context) {
+  GbaGraphicsRenderOptions render_options = {GBA_RENDERER_SCANLINES_SOFTWARE,
+                                             1u};
+
+  while (SDL_AtomicGet(&g_emulation_running)) {
+    ScreenAttachPixelBuffer(g_emulation_screen, g_frames[g_back_frame],
+                            GBA_WIDTH, GBA_HEIGHT, SCREEN_PIXEL_FORMAT_RGB888,
+                            GBA_FRAME_PITCH, /*bottom_up=*/false);
+
+    // Input is sampled as late as possible to minimize latency
+    render_options.renderer = SDL_AtomicGet(&g_emulation_renderer);
+    ApplyButtons(SDL_AtomicGet(&g_emulation_buttons));
+
+    GbaEmulatorStep(g_emulator, g_emulation_screen, &render_options,
+                    RenderAudioSample);
+
+    g_back_frame = SDL_AtomicSet(&g_ready_frame, g_back_frame | FRAME_READY) &
+                   FRAME_INDEX_MASK;
+
+    // The audio device draining the ring paces emulation
+    while (SDL_AtomicGet(&g_emulation_running) &&
+           AudioRingFill() > g_audio_target_fill) {
+      SDL_Delay(1);
+    }
+  }
+
+  return 0;
+}
+
+static void PresentNextFrame() {
+  if (!ProcessEvents()) {
+    return;
+  }
+
+  UpdateRenderOptions();
+  SDL_AtomicSet(&g_emulation_buttons, ReadButtons());
+
+  // OpenGL rendering is only possible on the thread owning the context
+  GbaGraphicsRenderer renderer = g_render_options.renderer;
+  if (renderer == GBA_RENDERER_SCANLINES_OPENGL) {
+    renderer = GBA_RENDERER_SCANLINES_SOFTWARE;
+  }
+  SDL_AtomicSet(&g_emulation_renderer, renderer);
+
+  if (SDL_AtomicGet(&g_ready_frame) & FRAME_READY) {
+    g_front_frame =
+        SDL_AtomicSet(&g_ready_frame, g_front_frame) & FRAME_INDEX_MASK;
+    g_has_frame = true;
+  }
+
+  ScreenAttachFramebuffer(g_screen, /*fbo=*/0u, /*width=*/g_width,
+                          /*height=*/g_height);
+
+  ScreenPixelBuffer buffer;
+  if (g_has_frame &&
+      ScreenGetPixelBuffer(g_screen, GBA_WIDTH, GBA_HEIGHT, &buffer) &&
+      buffer.format == SCREEN_PIXEL_FORMAT_RGB888) {
+    for (int y = 0; y < GBA_HEIGHT; y++) {
+      memcpy(buffer.pixels + y * buffer.pitch,
+             g_frames[g_front_frame] + y * GBA_FRAME_PITCH, GBA_FRAME_PITCH);
+    }
+
+    ScreenRenderToFramebuffer(g_screen, true);
+  } else {
+    ScreenClear(g_screen);
+  }
+
+  SDL_GL_SwapWindow(g_window);
+}
+#endif  // __EMSCRIPTEN__
+
 int main(int argc, char *argv[]) {
 #ifndef __EMSCRIPTEN__
   if (argc < 2) {
-    printf("usage: webgba <game>");
+    printf("usage: webgba <game> [--emulation-thread]");
     return EXIT_SUCCESS;
   }
+
+  // Runs emulation on its own thread paced by the audio device so that
+  // presentation stalls do not delay it
+  bool emulation_thread =
+      argc > 2 && strcmp(argv[2], "--emulation-thread") == 0;
 #endif  // __EMSCRIPTEN__
 
   //
@@ -285,59 +529,19 @@ int main(int argc, char *argv[]) {
   //
 
 #ifdef __EMSCRIPTEN__
-  SDL_RWops *file = SDL_RWFromFile("/game.gba", "rb");
+  const char *game_path = "/game.gba";
 #else
-  SDL_RWops *file = SDL_RWFromFile(argv[1], "rb");
+  const char *game_path = argv[1];
 #endif  // __EMSCRIPTEN__
 
-  if (file == NULL) {
-    printf("ERROR: Failed to load game file\n");
-    SDL_Quit();
-    return EXIT_FAILURE;
-  }
-
-  Sint64 size = SDL_RWsize(file);
-  if (size < 0) {
-    printf("ERROR: Failed to get game file size\n");
-    SDL_RWclose(file);
-    SDL_Quit();
-    return EXIT_FAILURE;
-  }
-
-  if ((uint64_t)size > SIZE_MAX) {
-    printf("ERROR: Out of memory\n");
-    SDL_RWclose(file);
-    SDL_Quit();
-    return EXIT_FAILURE;
-  }
-
-  void *game = SDL_malloc((size_t)size);
-  if (!game) {
-    printf("ERROR: Out of memory\n");
-    SDL_RWclose(file);
-    SDL_Quit();
-    return EXIT_FAILURE;
-  }
-
-  size_t objects_read = SDL_RWread(file, game, size, /*maxnum=*/1);
-  SDL_RWclose(file);
-
-  if (objects_read != 1) {
-    printf("ERROR: Failed to read game file\n");
-    SDL_free(game);
-    SDL_Quit();
-    return EXIT_FAILURE;
-  }
-
   //
   // Create Emulator
   //
 
-  bool success = GbaEmulatorAllocate(game, size, &g_emulator, &g_gamepad);
-  SDL_free(game);
-
+  bool success =
+      GbaEmulatorAllocateFromFile(game_path, &g_emulator, &g_gamepad);
   if (!success) {
-    printf("ERROR: Out of memory\n");
+    printf("ERROR: Failed to load game file\n");
     SDL_Quit();
     return EXIT_FAILURE;
   }
@@ -410,15 +614,17 @@ int main(int argc, char *argv[]) {
   SDL_AudioSpec want;
 
   SDL_memset(&want, 0, sizeof(want));
-  want.format = AUDIO_S16;
-  want.freq = 131072.0 * 60.0 / (16777216.0 / 280896.0);
+  want.format = AUDIO_S16SYS;
+  want.freq = AUDIO_DEVICE_RATE;
   want.channels = 2;
-  want.samples = 4096;
+  want.samples = AUDIO_DEVICE_SAMPLES;
+  want.callback = AudioCallback;
 
   SDL_AudioSpec have;
-  g_audiodevice =
-      SDL_OpenAudioDevice(/*device=*/NULL, /*iscapture=*/0, &want, &have,
-                          /*allowed_changes=*/0);
+  g_audiodevice = SDL_OpenAudioDevice(
+      /*device=*/NULL, /*iscapture=*/0, &want, &have,
+      /*allowed_changes=*/SDL_AUDIO_ALLOW_FREQUENCY_CHANGE |
+          SDL_AUDIO_ALLOW_SAMPLES_CHANGE);
   if (g_audiodevice == 0) {
     printf("ERROR: Failed to open audio device (%s)\n", SDL_GetError());
     SDL_GL_DeleteContext(g_glcontext);
@@ -429,6 +635,14 @@ int main(int argc, char *argv[]) {
     return EXIT_FAILURE;
   }
 
+  // Keeping two device buffers in the ring leaves room for the rate control
+  // to absorb jitter in both directions
+  g_audio_step = AUDIO_SOURCE_RATE / have.freq;
+  g_audio_target_fill = 2u * have.samples;
+  if (g_audio_target_fill > AUDIO_RING_SIZE / 2u) {
+    g_audio_target_fill = AUDIO_RING_SIZE / 2u;
+  }
+
   SDL_PauseAudioDevice(g_audiodevice, /*pause_on=*/0);
 
   //
@@ -460,8 +674,42 @@ int main(int argc, char *argv[]) {
   emscripten_set_main_loop(RenderNextFrame, /*fps=*/0,
                            /*simulate_infinite_loop=*/true);
 #else
+  SDL_Thread *thread = NULL;
+  if (emulation_thread) {
+    g_emulation_screen = ScreenAllocate();
+    if (!g_emulation_screen) {
+      printf("ERROR: Out of memory\n");
+      g_main_loop_running = false;
+    }
+
+    SDL_AtomicSet(&g_ready_frame, 2);
+    SDL_AtomicSet(&g_emulation_renderer, GBA_RENDERER_SCANLINES_SOFTWARE);
+    SDL_AtomicSet(&g_emulation_running, 1);
+
+    if (g_emulation_screen) {
+      thread = SDL_CreateThread(RunEmulation, "emulation", /*data=*/NULL);
+      if (!thread) {
+        printf("ERROR: Failed to create thread (%s)\n", SDL_GetError());
+        g_main_loop_running = false;
+      }
+    }
+  }
+
   while (g_main_loop_running) {
-    RenderNextFrame();
+    if (emulation_thread) {
+      PresentNextFrame();
+    } else {
+      RenderNextFrame();
+    }
+  }
+
+  if (thread) {
+    SDL_AtomicSet(&g_emulation_running, 0);
+    SDL_WaitThread(thread, /*status=*/NULL);
+  }
+
+  if (g_emulation_screen) {
+    ScreenFree(g_emulation_screen);
   }
 #endif  // __EMSCRIPTEN__
 
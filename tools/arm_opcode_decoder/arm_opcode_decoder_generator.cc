@@ -222,13 +222,20 @@ std::string MatchesSingleDataTransfer(const std::bitset<32>& instruction) {
   return opcode;
 }
 
-std::string MatchesDataProcessing(const std::bitset<32>& instruction) {
+struct DataProcessingInstruction {
+  std::string operation;
+  bool s;
+  std::string shifter;
+};
+
+bool DecodeDataProcessing(const std::bitset<32>& instruction,
+                          DataProcessingInstruction* decoded) {
   if (instruction[26] != 0 || instruction[27] != 0) {
-    return std::string();
+    return false;
   }
 
   if (instruction[4] == 1 && instruction[7] == 1 && instruction[25] == 0) {
-    return std::string();
+    return false;
   }
 
   bool s = instruction[20];
@@ -267,28 +274,28 @@ std::string MatchesDataProcessing(const std::bitset<32>& instruction) {
       break;
     case 8:
       if (!s) {
-        return std::string();
+        return false;
       }
       opcode = "TST";
       s = false;
       break;
     case 9:
       if (!s) {
-        return std::string();
+        return false;
       }
       opcode = "TEQ";
       s = false;
       break;
     case 10:
       if (!s) {
-        return std::string();
+        return false;
       }
       opcode = "CMP";
       s = false;
       break;
     case 11:
       if (!s) {
-        return std::string();
+        return false;
       }
       opcode = "CMN";
       s = false;
@@ -309,17 +316,54 @@ std::string MatchesDataProcessing(const std::bitset<32>& instruction) {
       assert(false);
   }
 
-  if (s) {
-    opcode += "S";
-  }
+  decoded->operation = opcode;
+  decoded->s = s;
 
   bool i = instruction[25];
-
   if (i) {
-    opcode += "_@32";
+    decoded->shifter = "_@32";
+    return true;
   }
 
-  return opcode;
+  std::bitset<2> shift;
+  shift[0] = instruction[5];
+  shift[1] = instruction[6];
+
+  switch (shift.to_ulong()) {
+    case 0:
+      decoded->shifter = "_LSL";
+      break;
+    case 1:
+      decoded->shifter = "_LSR";
+      break;
+    case 2:
+      decoded->shifter = "_ASR";
+      break;
+    case 3:
+      decoded->shifter = "_ROR";
+      break;
+    default:
+      assert(false);
+  }
+
+  bool r = instruction[4];
+  decoded->shifter += r ? "_REG" : "_@5";
+
+  return true;
+}
+
+std::string MatchesDataProcessing(const std::bitset<32>& instruction) {
+  DataProcessingInstruction decoded;
+  if (!DecodeDataProcessing(instruction, &decoded)) {
+    return std::string();
+  }
+
+  std::string opcode = decoded.operation;
+  if (decoded.s) {
+    opcode += "S";
+  }
+
+  return opcode + decoded.shifter;
 }
 
 std::string MatchesBlockDataTransfer(const std::bitset<32>& instruction) {
@@ -453,39 +497,236 @@ std::string MatchInstruction(const std::bitset<32>& instruction) {
   return "ARM_OPCODE_" + match;
 }
 
-}  // namespace
+std::string DataProcessingOperandFunction(const std::string& shifter) {
+  if (shifter == "_@32") {
+    return "ArmOperandDataProcessingImmediate";
+  }
 
-int main(int argc, char* argv[]) {
-  std::vector<std::string> opcodes;
-  for (uint32_t index = 0; index < 4096; index++) {
-    std::bitset<13> bits(index);
-    std::bitset<32> instruction;
-    instruction[4] = bits[0];
-    instruction[5] = bits[1];
-    instruction[6] = bits[2];
-    instruction[7] = bits[3];
-    instruction[20] = bits[4];
-    instruction[21] = bits[5];
-    instruction[22] = bits[6];
-    instruction[23] = bits[7];
-    instruction[24] = bits[8];
-    instruction[25] = bits[9];
-    instruction[26] = bits[10];
-    instruction[27] = bits[11];
-    std::string opcode = MatchInstruction(instruction);
-    if (opcode.empty()) {
-      return EXIT_FAILURE;
+  std::string shift = shifter.substr(1u, 3u);
+  if (shifter.substr(4u) == "_REG") {
+    return "ArmOperandDataProcessing" + shift + "Register";
+  }
+
+  return "ArmOperandDataProcessing" + shift + "Immediate";
+}
+
+bool DataProcessingUsesShifterCarry(const DataProcessingInstruction& decoded) {
+  bool logical = decoded.operation == "AND" || decoded.operation == "BIC" ||
+                 decoded.operation == "EOR" || decoded.operation == "ORR";
+  bool move = decoded.operation == "MOV" || decoded.operation == "MVN";
+  bool test = decoded.operation == "TEQ" || decoded.operation == "TST";
+  return ((logical || move) && decoded.s) || test;
+}
+
+// Returns the condition under which the shifter reads the carry flag, which
+// must be materialized first if it is still pending. RRX reads it into the
+// result while the other shifters only pass it through as the carry out when
+// shifting by zero, which matters only to instructions that use that carry.
+std::string DataProcessingReadsCarryCondition(
+    const DataProcessingInstruction& decoded) {
+  if (decoded.shifter == "_ROR_@5") {
+    return "(instruction & 0xF80u) == 0u";
+  }
+
+  if (!DataProcessingUsesShifterCarry(decoded)) {
+    return "";
+  }
+
+  if (decoded.shifter == "_@32") {
+    return "(instruction & 0xF00u) == 0u";
+  }
+
+  if (decoded.shifter == "_LSL_@5") {
+    return "(instruction & 0xF80u) == 0u";
+  }
+
+  if (decoded.shifter.substr(4u) == "_REG") {
+    return "(uint8_t)registers->current.user.gprs.gprs[(instruction >> 8u) & "
+           "0xFu] == 0u";
+  }
+
+  return "";
+}
+
+// Returns the suffix of the instruction variant which defers computing the
+// condition flags, if the instruction sets flags and has such a variant.
+std::string DataProcessingLazySuffix(const DataProcessingInstruction& decoded) {
+  if (decoded.operation == "ADC" || decoded.operation == "RSC" ||
+      decoded.operation == "SBC") {
+    return "";
+  }
+
+  if (decoded.s || decoded.operation == "CMN" || decoded.operation == "CMP" ||
+      decoded.operation == "TEQ" || decoded.operation == "TST") {
+    return "Lazy";
+  }
+
+  return "";
+}
+
+std::string DataProcessingArguments(const DataProcessingInstruction& decoded) {
+  bool move = decoded.operation == "MOV" || decoded.operation == "MVN";
+
+  std::string arguments = "registers, rd, ";
+  if (!move) {
+    arguments += "operand1, ";
+  }
+  arguments += "operand2";
+
+  if (DataProcessingUsesShifterCarry(decoded)) {
+    arguments += ", shifter_carry_out";
+  }
+
+  return arguments;
+}
+
+std::string ToOpcodeName(std::string opcode) {
+  std::replace(opcode.begin(), opcode.end(), '=', '_');
+  std::replace(opcode.begin(), opcode.end(), '@', 'I');
+  return opcode;
+}
+
+void PrintDataProcessing(
+    const std::map<std::string, DataProcessingInstruction>& instructions) {
+  std::cout << "#ifndef _TOOLS_ARM_OPCODE_DECODER_DATA_PROCESSING_"
+            << std::endl;
+  std::cout << "#define _TOOLS_ARM_OPCODE_DECODER_DATA_PROCESSING_"
+            << std::endl
+            << std::endl;
+
+  std::cout << "#include <stdbool.h>" << std::endl;
+  std::cout << "#include <stdint.h>" << std::endl << std::endl;
+
+  std::cout << "#include \"emulator/cpu/arm7tdmi/decoders/arm/operand.h\""
+            << std::endl;
+  std::cout
+      << "#include \"emulator/cpu/arm7tdmi/instructions/data_processing.h\""
+      << std::endl;
+  std::cout << "#include \"tools/arm_opcode_decoder/decoder.h\"" << std::endl
+            << std::endl;
+
+  for (const auto& entry : instructions) {
+    std::string name = ToOpcodeName(entry.first).substr(11u);
+    std::string operation = entry.second.operation;
+    if (entry.second.s) {
+      operation += "S";
     }
-    std::replace(opcode.begin(), opcode.end(), '_', '=');
-    opcodes.push_back(opcode);
+
+    std::cout << "static inline void ArmDataProcessing" << name
+              << "(ArmAllRegisters *registers, uint32_t instruction) {"
+              << std::endl;
+    std::cout << "  ArmRegisterIndex rd;" << std::endl;
+    std::cout << "  uint32_t operand1, operand2;" << std::endl;
+    std::cout << "  bool shifter_carry_out;" << std::endl;
+    std::string reads_carry = DataProcessingReadsCarryCondition(entry.second);
+    if (!reads_carry.empty()) {
+      std::cout << "  if (" << reads_carry << ") {" << std::endl;
+      std::cout << "    ArmMaterializeCarryFlag(registers);" << std::endl;
+      std::cout << "  }" << std::endl;
+    }
+    std::cout << "  " << DataProcessingOperandFunction(entry.second.shifter)
+              << "(instruction, &registers->current.user, &rd, &operand1, "
+                 "&operand2, &shifter_carry_out);"
+              << std::endl;
+    std::cout << "  Arm" << operation
+              << DataProcessingLazySuffix(entry.second) << "("
+              << DataProcessingArguments(entry.second) << ");" << std::endl;
+    std::cout << "}" << std::endl << std::endl;
+  }
+
+  std::cout << "static inline bool ArmDataProcessingExecute(ArmOpcode opcode, "
+               "uint32_t instruction, ArmAllRegisters *registers) {"
+            << std::endl;
+  std::cout << "  switch (opcode) {" << std::endl;
+  for (const auto& entry : instructions) {
+    std::string name = ToOpcodeName(entry.first);
+    std::cout << "    case " << name << ":" << std::endl;
+    std::cout << "      ArmDataProcessing" << name.substr(11u)
+              << "(registers, instruction);" << std::endl;
+    std::cout << "      return true;" << std::endl;
+  }
+  std::cout << "    default:" << std::endl;
+  std::cout << "      return false;" << std::endl;
+  std::cout << "  }" << std::endl;
+  std::cout << "}" << std::endl << std::endl;
+
+  std::cout << "#endif  // _TOOLS_ARM_OPCODE_DECODER_DATA_PROCESSING_"
+            << std::endl;
+}
+
+bool ConditionPasses(uint32_t condition, bool n, bool z, bool c, bool v) {
+  switch (condition) {
+    case 0u:  // EQ
+      return z;
+    case 1u:  // NE
+      return !z;
+    case 2u:  // CS
+      return c;
+    case 3u:  // CC
+      return !c;
+    case 4u:  // MI
+      return n;
+    case 5u:  // PL
+      return !n;
+    case 6u:  // VS
+      return v;
+    case 7u:  // VC
+      return !v;
+    case 8u:  // HI
+      return c && !z;
+    case 9u:  // LS
+      return !c || z;
+    case 10u:  // GE
+      return n == v;
+    case 11u:  // LT
+      return n != v;
+    case 12u:  // GT
+      return !z && n == v;
+    case 13u:  // LE
+      return z || n != v;
+    case 14u:  // AL
+      return true;
+    default:  // NV
+      return false;
   }
+}
+
+void PrintCondition() {
+  std::cout << "#ifndef _TOOLS_ARM_OPCODE_DECODER_CONDITION_" << std::endl;
+  std::cout << "#define _TOOLS_ARM_OPCODE_DECODER_CONDITION_" << std::endl
+            << std::endl;
+
+  std::cout << "#include <stdint.h>" << std::endl << std::endl;
 
+  std::cout << "// Indexed by condition code. Bit NZCV of each entry is set if "
+               "the condition"
+            << std::endl;
+  std::cout << "// passes with those flags." << std::endl;
+  std::cout << "static const uint16_t arm_condition_table[16] = {"
+            << std::endl;
+  for (uint32_t condition = 0u; condition < 16u; condition++) {
+    uint32_t mask = 0u;
+    for (uint32_t nzcv = 0u; nzcv < 16u; nzcv++) {
+      if (ConditionPasses(condition, nzcv & 0x8u, nzcv & 0x4u, nzcv & 0x2u,
+                          nzcv & 0x1u)) {
+        mask |= 1u << nzcv;
+      }
+    }
+    std::cout << "    0x" << std::hex << std::uppercase << std::setw(4)
+              << std::setfill('0') << mask << std::dec << "u," << std::endl;
+  }
+  std::cout << "};" << std::endl << std::endl;
+
+  std::cout << "#endif  // _TOOLS_ARM_OPCODE_DECODER_CONDITION_" << std::endl;
+}
+
+bool PrintDecoder(const std::vector<std::string>& opcodes) {
   std::set<std::string> sorted_opcodes;
   sorted_opcodes.insert(opcodes.begin(), opcodes.end());
 
-  if (UINT8_MAX < sorted_opcodes.size()) {
-    std::cout << "ERROR: Cannot represent opcodes in a uint8_t" << std::endl;
-    return EXIT_FAILURE;
+  if (UINT16_MAX < sorted_opcodes.size()) {
+    std::cout << "ERROR: Cannot represent opcodes in a uint16_t" << std::endl;
+    return false;
   }
 
   std::map<std::string, uint32_t> opcode_number;
@@ -503,19 +744,20 @@ int main(int argc, char* argv[]) {
   uint32_t value = 0u;
   for (const auto& entry : sorted_opcodes) {
     opcode_number[entry] = value;
-    std::string opcode = entry;
-    std::replace(opcode.begin(), opcode.end(), '=', '_');
-    std::replace(opcode.begin(), opcode.end(), '@', 'I');
-    std::cout << "  " << opcode << " = " << value++ << "u," << std::endl;
+    std::cout << "  " << ToOpcodeName(entry) << " = " << value++ << "u,"
+              << std::endl;
   }
   std::cout << "  ARM_OPCODE_UNDEF = " << value << "u," << std::endl;
   opcode_number["ARM=OPCODE=UNDEF"] = value++;
 
   std::cout << "} ArmOpcode;" << std::endl << std::endl;
 
+  std::string table_type = (value <= UINT8_MAX) ? "uint8_t" : "uint16_t";
+
   std::cout << "static inline ArmOpcode ArmDecodeOpcode(uint32_t instruction) {"
             << std::endl;
-  std::cout << "  static const uint8_t opcode_table[4096] = {" << std::endl;
+  std::cout << "  static const " << table_type << " opcode_table[4096] = {"
+            << std::endl;
   for (const auto& entry : opcodes) {
     std::cout << "    " << opcode_number.at(entry) << "u," << std::endl;
   }
@@ -537,5 +779,58 @@ int main(int argc, char* argv[]) {
 
   std::cout << "#endif  // _TOOLS_ARM_OPCODE_DECODER_DECODER_" << std::endl;
 
+  return true;
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+  bool data_processing =
+      argc == 2 && std::string(argv[1]) == "--data_processing";
+
+  if (argc == 2 && std::string(argv[1]) == "--condition") {
+    PrintCondition();
+    return EXIT_SUCCESS;
+  }
+
+  std::vector<std::string> opcodes;
+  std::map<std::string, DataProcessingInstruction> data_processing_opcodes;
+  for (uint32_t index = 0; index < 4096; index++) {
+    std::bitset<13> bits(index);
+    std::bitset<32> instruction;
+    instruction[4] = bits[0];
+    instruction[5] = bits[1];
+    instruction[6] = bits[2];
+    instruction[7] = bits[3];
+    instruction[20] = bits[4];
+    instruction[21] = bits[5];
+    instruction[22] = bits[6];
+    instruction[23] = bits[7];
+    instruction[24] = bits[8];
+    instruction[25] = bits[9];
+    instruction[26] = bits[10];
+    instruction[27] = bits[11];
+    std::string opcode = MatchInstruction(instruction);
+    if (opcode.empty()) {
+      return EXIT_FAILURE;
+    }
+    std::replace(opcode.begin(), opcode.end(), '_', '=');
+    opcodes.push_back(opcode);
+
+    DataProcessingInstruction decoded;
+    if (DecodeDataProcessing(instruction, &decoded)) {
+      data_processing_opcodes[opcode] = decoded;
+    }
+  }
+
+  if (data_processing) {
+    PrintDataProcessing(data_processing_opcodes);
+    return EXIT_SUCCESS;
+  }
+
+  if (!PrintDecoder(opcodes)) {
+    return EXIT_FAILURE;
+  }
+
   return EXIT_SUCCESS;
-}
\ No newline at end of file
+}
@@ -4,9 +4,7 @@
 
 #include <chrono>
 #include <cstring>
-#include <fstream>
 #include <iostream>
-#include <vector>
 
 extern "C" {
 #include "emulator/gba.h"
@@ -17,14 +15,16 @@ void NoOpAudioCallback(int16_t left, int16_t right) {}
 int main(int argc, char **argv) {
 #ifndef __EMSCRIPTEN__
   if (argc < 3) {
-    std::cout << "Usage: benchmark <num-frames> <rom>" << std::endl;
+    std::cout << "Usage: benchmark <num-frames> <rom> [--skip-rendering]"
+              << std::endl;
     return EXIT_SUCCESS;
   }
 #endif  // __EMSCRIPTEN__
 
 #if __EMSCRIPTEN__
   int frame_count = 60u * 60u;  // 60 seconds * 60 frames per second.
-  std::ifstream file("/game.gba", std::ios::binary);
+  const char *rom_path = "/game.gba";
+  bool skip_rendering = false;
 #else
   int frame_count = std::atoi(argv[1u]);
   if (frame_count < 0) {
@@ -32,30 +32,16 @@ int main(int argc, char **argv) {
     return EXIT_FAILURE;
   }
 
-  std::ifstream file(argv[2u], std::ios::binary);
-#endif  // __EMSCRIPTEN__
+  const char *rom_path = argv[2u];
 
-  if (file.fail()) {
-    std::cout << "ERROR: Failed to open ROM file" << std::endl;
-    return EXIT_FAILURE;
-  }
-
-  char c;
-  std::vector<unsigned char> buffer;
-  while (file.read(&c, sizeof(unsigned char))) {
-    buffer.push_back(static_cast<unsigned char>(c));
-  }
-
-  if (buffer.empty()) {
-    std::cout << "ERROR: Failed to read ROM file" << std::endl;
-    return EXIT_FAILURE;
-  }
+  bool skip_rendering = argc > 3 && strcmp(argv[3u], "--skip-rendering") == 0;
+#endif  // __EMSCRIPTEN__
 
   GbaEmulator *emulator;
   GamePad *gamepad;
-  bool success =
-      GbaEmulatorAllocate(buffer.data(), buffer.size(), &emulator, &gamepad);
+  bool success = GbaEmulatorAllocateFromFile(rom_path, &emulator, &gamepad);
   if (!success) {
+    std::cout << "ERROR: Failed to load ROM file" << std::endl;
     return EXIT_FAILURE;
   }
 
@@ -73,7 +59,8 @@ int main(int argc, char **argv) {
 #endif  // __EMSCRIPTEN__
 
   GbaGraphicsRenderOptions options;
-  options.renderer = GBA_RENDERER_SCANLINES_SOFTWARE;
+  options.renderer = skip_rendering ? GBA_RENDERER_NONE
+                                    : GBA_RENDERER_SCANLINES_SOFTWARE;
   options.opengl_render_scale = 1u;
   for (int i = 0; i < frame_count; i++) {
     GbaEmulatorStep(emulator, screen, &options, NoOpAudioCallback);
@@ -0,0 +1,115 @@
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+extern "C" {
+#include "emulator/cpu/arm7tdmi/decoders/arm/condition.h"
+}
+
+// The condition evaluation that the lookup table replaced
+static bool __attribute__((noinline))
+SwitchShouldExecute(ArmProgramStatusRegister cpsr, uint32_t instruction) {
+  switch (instruction >> 28u) {
+    case 0u:
+      return cpsr.zero;
+    case 1u:
+      return !cpsr.zero;
+    case 2u:
+      return cpsr.carry;
+    case 3u:
+      return !cpsr.carry;
+    case 4u:
+      return cpsr.negative;
+    case 5u:
+      return !cpsr.negative;
+    case 6u:
+      return cpsr.overflow;
+    case 7u:
+      return !cpsr.overflow;
+    case 8u:
+      return !cpsr.zero & cpsr.carry;
+    case 9u:
+      return cpsr.zero | !cpsr.carry;
+    case 10u:
+      return cpsr.negative == cpsr.overflow;
+    case 11u:
+      return cpsr.negative != cpsr.overflow;
+    case 12u:
+      return !cpsr.zero & (cpsr.negative == cpsr.overflow);
+    case 13u:
+      return cpsr.zero | (cpsr.negative != cpsr.overflow);
+    case 14u:
+      return true;
+    default:
+      return false;
+  }
+}
+
+static bool __attribute__((noinline))
+TableShouldExecute(ArmProgramStatusRegister cpsr, uint32_t instruction) {
+  return ArmInstructionShouldExecute(cpsr, instruction);
+}
+
+template <typename Function>
+static int64_t Measure(Function function,
+                       const std::vector<ArmProgramStatusRegister> &flags,
+                       const std::vector<uint32_t> &instructions,
+                       int iterations, uint32_t *executed) {
+  auto begin = std::chrono::steady_clock::now();
+
+  uint32_t count = 0u;
+  for (int i = 0; i < iterations; i++) {
+    for (size_t j = 0u; j < instructions.size(); j++) {
+      count += function(flags[j], instructions[j]);
+    }
+  }
+
+  auto end = std::chrono::steady_clock::now();
+
+  *executed = count;
+
+  return std::chrono::duration_cast<std::chrono::milliseconds>(end - begin)
+      .count();
+}
+
+int main(int argc, char **argv) {
+  if (argc < 2) {
+    std::cout << "Usage: condition_benchmark <iterations>" << std::endl;
+    return EXIT_SUCCESS;
+  }
+
+  int iterations = std::atoi(argv[1u]);
+  if (iterations < 0) {
+    std::cout << "ERROR: Negative iteration count" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // Conditional instructions with unpredictable flags, as the unconditional
+  // ones never reach the condition check
+  std::vector<ArmProgramStatusRegister> flags(1u << 16u);
+  std::vector<uint32_t> instructions(1u << 16u);
+  uint32_t state = 1u;
+  for (size_t i = 0u; i < instructions.size(); i++) {
+    state = state * 1664525u + 1013904223u;
+    flags[i].value = state & 0xF0000000u;
+    instructions[i] = ((state >> 8u) % 14u) << 28u;
+  }
+
+  uint32_t switch_executed, table_executed;
+  int64_t switch_ms = Measure(SwitchShouldExecute, flags, instructions,
+                              iterations, &switch_executed);
+  int64_t table_ms = Measure(TableShouldExecute, flags, instructions,
+                             iterations, &table_executed);
+
+  if (switch_executed != table_executed) {
+    std::cout << "ERROR: Results differ" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  std::cout << "Switch: " << switch_ms << " ms" << std::endl;
+  std::cout << "Table: " << table_ms << " ms" << std::endl;
+
+  return EXIT_SUCCESS;
+}
\ No newline at end of file